@@ -0,0 +1,444 @@
+/**
+ * @file compile_bench.c
+ * @author გიორგი მაღრაძე (magradze.giorgi@gmail.com)
+ * @brief კომპილატორის ეტაპების (ლექსირება, პარსინგი, ანალიზი, C კოდის გენერაცია) გამტარუნარიანობის ბენჩმარკი.
+ * @version 0.1
+ *
+ * აგენერირებს მოცემული ზომისა და ფორმის სინთეზურ `.მს` კორპუსს და ზომავს
+ * თითოეულ ეტაპს ცალ-ცალკე (საუკეთესო N გაშვებიდან). შედეგი იბეჭდება
+ * MB/წმ-ში, ტოკენი/წმ-ში და კვანძი/წმ-ში, --json-ით კი ფაილშიც იწერება.
+ *
+ * ფორმები:
+ *   identifiers   გრძელი ქართული იდენტიფიკატორები და სტრიქონები
+ *   expressions   ღრმად ჩადგმული და გრძელი გამოსახულებები (--depth)
+ *   declarations  ბევრი მოკლე ცვლადის გამოცხადება
+ *   comments      კომენტარებით დატვირთული ფაილი
+ *
+ * გამოყენება: compile_bench [--shape ფორმა|all] [--size MB] [--depth N]
+ *                           [--runs N] [--seed N] [--json ფაილი] [--emit]
+ * --emit-ით კორპუსი stdout-ზე იწერება (მაგ. `manuscript`-ით შესამოწმებლად).
+ *
+ * კოდის გენერაცია ოპტიმიზაციამდე ხეზე იზომება: სინთეზურ კორპუსში ყველა
+ * ცვლადი მუდმივია, ოპტიმიზატორი მას თითქმის მთლიანად კეცავს და გენერატორს
+ * სამუშაო აღარ რჩებოდა.
+ */
+#define _POSIX_C_SOURCE 200809L
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "ast.h"
+#include "codegen.h"
+#include "optimizer.h"
+#include "parser.h"
+#include "token_stream.h"
+#include "type_infer.h"
+
+/** @brief კორპუსის ფორმა. */
+typedef enum {
+    SHAPE_IDENTIFIERS,
+    SHAPE_EXPRESSIONS,
+    SHAPE_DECLARATIONS,
+    SHAPE_COMMENTS,
+    SHAPE_COUNT
+} CorpusShape;
+
+static const char* shape_names[SHAPE_COUNT] = { "identifiers", "expressions", "declarations", "comments" };
+
+/** @brief გაზომილი ეტაპი. */
+typedef enum {
+    PHASE_LEX,
+    PHASE_PARSE,
+    PHASE_ANALYZE,
+    PHASE_CODEGEN,
+    PHASE_COUNT
+} BenchPhase;
+
+static const char* phase_names[PHASE_COUNT] = { "lex", "parse", "analyze", "codegen" };
+
+/** @brief ერთი კორპუსის გაზომვის შედეგი. */
+typedef struct {
+    CorpusShape shape;
+    size_t bytes;                  // კორპუსის ზომა
+    long tokens;                   // ტოკენები (EOF-ის ჩათვლით)
+    long nodes;                    // პარსერის აგებული კვანძები
+    size_t output_bytes;           // გენერირებული C კოდის ზომა
+    double seconds[PHASE_COUNT];   // საუკეთესო დრო თითოეული ეტაპისთვის
+} BenchResult;
+
+/** @brief მზარდი ტექსტური ბუფერი კორპუსისთვის. */
+typedef struct {
+    char* data;
+    size_t size;
+    size_t capacity;
+} Corpus;
+
+static const char* stems[] = {
+    "მომხმარებლის_სრული_სახელი", "პროდუქტის_ერთეულის_ფასი", "შეკვეთის_საერთო_რაოდენობა",
+    "ფასდაკლების_პროცენტი", "მიწოდების_ღირებულება", "საწყობის_მიმდინარე_ნაშთი",
+    "გადასახადის_განაკვეთი", "თვიური_შემოსავალი",
+};
+
+static const char* sentences[] = {
+    "ეს ფუნქცია ითვლის შეკვეთის საბოლოო ღირებულებას ყველა ფასდაკლების გათვალისწინებით",
+    "მნიშვნელობა ინახება მომდევნო გამოთვლებისთვის, რომ ერთი და იგივე არ ვითვალოთ ორჯერ",
+    "TODO: გადასახადის განაკვეთი კონფიგურაციიდან უნდა წავიკითხოთ",
+    "შენიშვნა: საწყობის ნაშთი შეიძლება უარყოფითი იყოს, თუ მიწოდება დაგვიანდა",
+    "აქ არაფერი რთული არ ხდება, უბრალოდ ვაჯამებთ წინა შედეგებს",
+};
+
+static const char* messages[] = {
+    "გამარჯობა, სამყარო! ეს არის საკმაოდ გრძელი სტრიქონი",
+    "შეკვეთა წარმატებით დამუშავდა",
+    "მიწოდების მისამართი: თბილისი, რუსთაველის გამზირი",
+};
+
+#define COUNT_OF(array) (int)(sizeof(array) / sizeof((array)[0]))
+
+static const char operators[] = { '+', '-', '*', '/' };
+
+/** @brief მიმდინარე დრო წამებში (მონოტონური საათი). */
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/** @brief დეტერმინისტული ფსევდოშემთხვევითი რიცხვი (xorshift64). */
+static uint64_t next_random(uint64_t* state) {
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return x;
+}
+
+/** @brief შემთხვევითი რიცხვი [0, bound) შუალედში. */
+static int random_below(uint64_t* state, int bound) {
+    return (int)(next_random(state) % (uint64_t)bound);
+}
+
+/** @brief ამატებს ფორმატირებულ ტექსტს კორპუსის ბოლოს. */
+static void corpus_append(Corpus* corpus, const char* format, ...) {
+    for (;;) {
+        size_t available = corpus->capacity - corpus->size;
+        va_list args;
+        va_start(args, format);
+        int written = vsnprintf(corpus->data + corpus->size, available, format, args);
+        va_end(args);
+        if (written < 0) {
+            fprintf(stderr, "FATAL: Corpus formatting failed.\n");
+            exit(1);
+        }
+        if ((size_t)written < available) {
+            corpus->size += (size_t)written;
+            return;
+        }
+        size_t capacity = corpus->capacity * 2;
+        while (capacity - corpus->size <= (size_t)written) capacity *= 2;
+        char* data = realloc(corpus->data, capacity);
+        if (data == NULL) {
+            fprintf(stderr, "FATAL: Memory allocation failed for corpus.\n");
+            exit(1);
+        }
+        corpus->data = data;
+        corpus->capacity = capacity;
+    }
+}
+
+
+/** @brief იდენტიფიკატორების ფორმა: გრძელი ქართული სახელები, მათზე გამოთვლები და სტრიქონების ბეჭდვა. */
+static void generate_identifiers(Corpus* corpus, uint64_t* random, size_t target) {
+    for (long count = 0; corpus->size < target; count++) {
+        const char* stem = stems[count % COUNT_OF(stems)];
+        if (count < 3) {
+            corpus_append(corpus, "ცვლადი %s_%ld = %d\n", stem, count, 1 + random_below(random, 100));
+            continue;
+        }
+        corpus_append(corpus, "ცვლადი %s_%ld = ", stem, count);
+        for (int term = 0; term < 3; term++) {
+            long index = (long)(next_random(random) % (uint64_t)count);
+            if (term > 0) corpus_append(corpus, " %c ", operators[random_below(random, 3)]);
+            corpus_append(corpus, "%s_%ld", stems[index % COUNT_OF(stems)], index);
+        }
+        corpus_append(corpus, "\n");
+        if (count % 8 == 0) {
+            corpus_append(corpus, "დაბეჭდე(\"%s\")\n", messages[random_below(random, COUNT_OF(messages))]);
+        }
+    }
+}
+
+/**
+ * @brief ამატებს რიცხვს ან უკვე გამოცხადებულ `გამოსახულება_k` ცვლადს.
+ * ყოველი მეოთხე განცხადება (0-ის გარდა) ბეჭდვაა და ცვლადს არ აცხადებს.
+ */
+static void append_operand(Corpus* corpus, uint64_t* random, long count) {
+    if (count == 0 || random_below(random, 4) == 0) {
+        corpus_append(corpus, "%d", 1 + random_below(random, 999));
+        return;
+    }
+    long index = (long)(next_random(random) % (uint64_t)count);
+    if (index > 0 && index % 4 == 0) index--;
+    corpus_append(corpus, "გამოსახულება_%ld", index);
+}
+
+/**
+ * @brief გამოსახულებების ფორმა: სიღრმე [1, depth]. ყოველ დონეზე ან ახალი
+ * ფრჩხილი იხსნება (მარჯვნივ ღრმა ხე), ან ბრტყელი ჯაჭვი გრძელდება.
+ */
+static void generate_expressions(Corpus* corpus, uint64_t* random, size_t target, int depth) {
+    for (long count = 0; corpus->size < target; count++) {
+        bool print = count > 0 && count % 4 == 0;
+        if (print) corpus_append(corpus, "დაბეჭდე(");
+        else corpus_append(corpus, "ცვლადი გამოსახულება_%ld = ", count);
+
+        int levels = 1 + random_below(random, depth);
+        int open = 0;
+        for (int level = 0; level < levels; level++) {
+            if (random_below(random, 8) == 0) corpus_append(corpus, "-");
+            append_operand(corpus, random, count);
+            corpus_append(corpus, " %c ", operators[random_below(random, COUNT_OF(operators))]);
+            if (random_below(random, 2) == 0) {
+                corpus_append(corpus, "(");
+                open++;
+            }
+        }
+        append_operand(corpus, random, count);
+        for (int i = 0; i < open; i++) corpus_append(corpus, ")");
+        corpus_append(corpus, print ? ")\n" : "\n");
+    }
+}
+
+/** @brief დეკლარაციების ფორმა: ბევრი მოკლე გამოცხადება, ზოგი წინა ცვლადებზე დამოკიდებული. */
+static void generate_declarations(Corpus* corpus, uint64_t* random, size_t target) {
+    for (long count = 0; corpus->size < target; count++) {
+        if (count >= 3 && count % 5 == 0) {
+            corpus_append(corpus, "ცვლადი x_%ld = x_%ld + x_%ld\n", count, count - 1, count - 3);
+        } else {
+            corpus_append(corpus, "ცვლადი x_%ld = %d\n", count, random_below(random, 10000));
+        }
+        if (count % 16 == 15) corpus_append(corpus, "დაბეჭდე(x_%ld)\n", count);
+    }
+}
+
+/** @brief კომენტარების ფორმა: რამდენიმე ხაზი კომენტარი და ცარიელი ხაზი ყოველი განცხადების წინ. */
+static void generate_comments(Corpus* corpus, uint64_t* random, size_t target) {
+    for (long count = 0; corpus->size < target; count++) {
+        int lines = 2 + random_below(random, 4);
+        for (int line = 0; line < lines; line++) {
+            corpus_append(corpus, "# %s\n", sentences[random_below(random, COUNT_OF(sentences))]);
+        }
+        corpus_append(corpus, "ცვლადი შენიშვნა_%ld = %d * 2\n\n",
+                      count, random_below(random, 1000));
+    }
+}
+
+/** @brief აგებს `shape` ფორმის კორპუსს, რომლის ზომა `target` ბაიტს აღემატება (ბოლო ხაზი სრულია). */
+static Corpus build_corpus(CorpusShape shape, size_t target, int depth, uint64_t seed) {
+    Corpus corpus;
+    corpus.capacity = target + 4096;
+    corpus.size = 0;
+    corpus.data = malloc(corpus.capacity);
+    if (corpus.data == NULL) {
+        fprintf(stderr, "FATAL: Memory allocation failed for corpus.\n");
+        exit(1);
+    }
+    corpus.data[0] = '\0';
+    uint64_t random = seed != 0 ? seed : 1;
+    switch (shape) {
+        case SHAPE_IDENTIFIERS:  generate_identifiers(&corpus, &random, target); break;
+        case SHAPE_EXPRESSIONS:  generate_expressions(&corpus, &random, target, depth); break;
+        case SHAPE_DECLARATIONS: generate_declarations(&corpus, &random, target); break;
+        case SHAPE_COMMENTS:     generate_comments(&corpus, &random, target); break;
+        default: break;
+    }
+    return corpus;
+}
+
+/**
+ * @brief ზომავს ყველა ეტაპს `runs`-ჯერ და თითოეულისთვის საუკეთესო დროს ინახავს.
+ * @return bool false, თუ კორპუსის პარსინგი შეცდომით დასრულდა.
+ */
+static bool measure(const Corpus* corpus, int runs, BenchResult* result) {
+    for (int phase = 0; phase < PHASE_COUNT; phase++) result->seconds[phase] = 1e30;
+    result->bytes = corpus->size;
+
+    for (int run = 0; run < runs; run++) {
+        double times[PHASE_COUNT];
+        TokenStream tokens;
+        double start = now_seconds();
+        lex_all(&tokens, corpus->data, corpus->size);
+        times[PHASE_LEX] = now_seconds() - start;
+
+        AstContext ast;
+        init_ast_context(&ast);
+        Parser parser;
+        start = now_seconds();
+        init_parser_from_stream(&parser, &tokens, &ast);
+        AstNode* program = parse(&parser);
+        times[PHASE_PARSE] = now_seconds() - start;
+        if (program == NULL || parser.had_error) {
+            free_ast_context(&ast);
+            free_token_stream(&tokens);
+            return false;
+        }
+
+        start = now_seconds();
+        infer_types(program, &ast);
+        optimize_program(program, &ast, NULL);
+        times[PHASE_ANALYZE] = now_seconds() - start;
+
+        CodeBuffer code;
+        init_code_buffer(&code);
+        start = now_seconds();
+        generate_code_to_buffer(program, &code);
+        times[PHASE_CODEGEN] = now_seconds() - start;
+
+        result->tokens = tokens.count;
+        result->nodes = ast_count_nodes(program);
+        result->output_bytes = code.length;
+        for (int phase = 0; phase < PHASE_COUNT; phase++) {
+            if (times[phase] < result->seconds[phase]) result->seconds[phase] = times[phase];
+        }
+        free_code_buffer(&code);
+        free_ast_context(&ast);
+        free_token_stream(&tokens);
+    }
+    return true;
+}
+
+/** @brief ბეჭდავს კორპუსის შედეგების ცხრილს. */
+static void print_result(const BenchResult* result) {
+    double megabytes = (double)result->bytes / (1024 * 1024);
+    printf("%s: %.1f MB, %ld ტოკენი, %ld კვანძი, %.1f MB C კოდი\n", shape_names[result->shape], megabytes,
+           result->tokens, result->nodes, (double)result->output_bytes / (1024 * 1024));
+    for (int phase = 0; phase < PHASE_COUNT; phase++) {
+        double seconds = result->seconds[phase];
+        printf("  %-8s %9.2f ms %8.1f MB/s  %8.2f M ტოკენი/წმ  %8.2f M კვანძი/წმ\n", phase_names[phase],
+               seconds * 1e3, megabytes / seconds, (double)result->tokens / seconds / 1e6,
+               (double)result->nodes / seconds / 1e6);
+    }
+}
+
+/** @brief წერს შედეგებს JSON ფორმატში (რეგრესიების ავტომატური შედარებისთვის). */
+static bool write_json(const char* path, const BenchResult* results, int count, int runs, int depth, uint64_t seed) {
+    FILE* file = fopen(path, "w");
+    if (file == NULL) return false;
+    fprintf(file, "{\n  \"benchmark\": \"compile_bench\",\n  \"runs\": %d,\n  \"depth\": %d,\n"
+                  "  \"seed\": %llu,\n  \"results\": [\n", runs, depth, (unsigned long long)seed);
+    for (int i = 0; i < count; i++) {
+        const BenchResult* result = &results[i];
+        fprintf(file, "    {\n      \"shape\": \"%s\",\n      \"bytes\": %zu,\n      \"tokens\": %ld,\n"
+                      "      \"nodes\": %ld,\n      \"output_bytes\": %zu,\n      \"phases\": {\n",
+                shape_names[result->shape], result->bytes, result->tokens, result->nodes, result->output_bytes);
+        for (int phase = 0; phase < PHASE_COUNT; phase++) {
+            double seconds = result->seconds[phase];
+            fprintf(file, "        \"%s\": { \"seconds\": %.9f, \"mb_per_s\": %.3f, \"tokens_per_s\": %.1f, "
+                          "\"nodes_per_s\": %.1f }%s\n",
+                    phase_names[phase], seconds, (double)result->bytes / (1024 * 1024) / seconds,
+                    (double)result->tokens / seconds, (double)result->nodes / seconds,
+                    phase + 1 < PHASE_COUNT ? "," : "");
+        }
+        fprintf(file, "      }\n    }%s\n", i + 1 < count ? "," : "");
+    }
+    fprintf(file, "  ]\n}\n");
+    return fclose(file) == 0;
+}
+
+/** @brief ბეჭდავს გამოყენების ინსტრუქციას. */
+static void print_usage(const char* program) {
+    fprintf(stderr, "გამოყენება: %s [--shape ფორმა|all] [--size MB] [--depth N] [--runs N] [--seed N]"
+                    " [--json ფაილი] [--emit]\n", program);
+    fprintf(stderr, "ფორმები: identifiers, expressions, declarations, comments\n");
+}
+
+int main(int argc, char* argv[]) {
+    int shape = -1;              // -1: ყველა ფორმა
+    double megabytes = 8;
+    int depth = 256;
+    int runs = 3;
+    uint64_t seed = 0x9E3779B97F4A7C15ull;
+    const char* json_path = NULL;
+    bool emit = false;
+
+    for (int i = 1; i < argc; i++) {
+        const char* argument = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : NULL;
+        if (strcmp(argument, "--emit") == 0) {
+            emit = true;
+            continue;
+        }
+        if (value == NULL) {
+            print_usage(argv[0]);
+            return 1;
+        }
+        i++;
+        if (strcmp(argument, "--shape") == 0) {
+            shape = -2;
+            if (strcmp(value, "all") == 0) shape = -1;
+            for (int s = 0; s < SHAPE_COUNT; s++) {
+                if (strcmp(value, shape_names[s]) == 0) shape = s;
+            }
+            if (shape == -2) {
+                fprintf(stderr, "შეცდომა: უცნობი ფორმა '%s'.\n", value);
+                print_usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argument, "--size") == 0) {
+            megabytes = atof(value);
+        } else if (strcmp(argument, "--depth") == 0) {
+            depth = atoi(value);
+        } else if (strcmp(argument, "--runs") == 0) {
+            runs = atoi(value);
+        } else if (strcmp(argument, "--seed") == 0) {
+            seed = strtoull(value, NULL, 0);
+        } else if (strcmp(argument, "--json") == 0) {
+            json_path = value;
+        } else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+    if (megabytes <= 0 || depth < 1 || runs < 1) {
+        fprintf(stderr, "შეცდომა: --size, --depth და --runs დადებითი უნდა იყოს.\n");
+        return 1;
+    }
+    size_t target = (size_t)(megabytes * 1024 * 1024);
+
+    if (emit) {
+        if (shape < 0) {
+            fprintf(stderr, "შეცდომა: --emit-ს ერთი ფორმა სჭირდება (--shape).\n");
+            return 1;
+        }
+        Corpus corpus = build_corpus((CorpusShape)shape, target, depth, seed);
+        fwrite(corpus.data, 1, corpus.size, stdout);
+        free(corpus.data);
+        return 0;
+    }
+
+    BenchResult results[SHAPE_COUNT];
+    int count = 0;
+    for (int s = 0; s < SHAPE_COUNT; s++) {
+        if (shape >= 0 && s != shape) continue;
+        Corpus corpus = build_corpus((CorpusShape)s, target, depth, seed);
+        BenchResult* result = &results[count];
+        result->shape = (CorpusShape)s;
+        bool ok = measure(&corpus, runs, result);
+        free(corpus.data);
+        if (!ok) {
+            fprintf(stderr, "შეცდომა: '%s' კორპუსის პარსინგი ვერ მოხერხდა.\n", shape_names[s]);
+            return 1;
+        }
+        print_result(result);
+        count++;
+    }
+
+    if (json_path != NULL && !write_json(json_path, results, count, runs, depth, seed)) {
+        fprintf(stderr, "შეცდომა: ფაილში '%s' ჩაწერა ვერ მოხერხდა.\n", json_path);
+        return 1;
+    }
+    return 0;
+}
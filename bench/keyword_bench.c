@@ -0,0 +1,174 @@
+/**
+ * @file keyword_bench.c
+ * @author გიორგი მაღრაძე (magradze.giorgi@gmail.com)
+ * @brief საკვანძო სიტყვების ამოცნობის მიკრობენჩმარკი.
+ * @version 0.4
+ *
+ * ზომავს სრული ლექსირების (scan_token) გამტარუნარიანობას იდენტიფიკატორებით
+ * გაჯერებულ სინთეზურ ტექსტზე — საუკეთესო დროს LEX_ROUNDS გავლიდან — და
+ * ცალკე ადარებს ძველ `strncmp`-ების ჯაჭვს სრულყოფილ ჰეშთან იმავე სახელებზე.
+ * გამოყენება: keyword_bench [კორპუსის_ზომა_MB]
+ */
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "lexer.h"
+
+static const char* keywords[] = {
+    "თუ", "სხვა", "სხვა_თუ", "და", "ან", "არ", "ჭეშმარიტი", "მცდარი",
+    "არარა", "ფუნქცია", "დაბრუნე", "სანამ", "ყოველი", "ში", "ცვლადი", "დაბეჭდე",
+    "პარალელური",
+};
+
+static const char* identifiers[] = {
+    "მომხმარებელი", "სახელი", "რაოდენობა", "ჯამი", "მნიშვნელობა", "შედეგი",
+    "ინდექსი", "სიგრძე", "მასივი", "ელემენტი", "დათვლა", "მრიცხველი",
+};
+
+#define ROUNDS 500
+#define LEX_ROUNDS 5
+#define KEYWORD_COUNT (int)(sizeof(keywords) / sizeof(keywords[0]))
+#define IDENTIFIER_COUNT (int)(sizeof(identifiers) / sizeof(identifiers[0]))
+
+/** @brief მიმდინარე დრო წამებში (მონოტონური საათი). */
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/** @brief ლექსერის წინა ვერსიის კლასიფიკატორი (მხოლოდ 5 საკვანძო სიტყვას ცნობდა). */
+static TokenType legacy_identifier_type(const char* str, int len) {
+    if (len == 6 && strncmp(str, "თუ", 6) == 0) return TOKEN_თუ;
+    if (len == 12 && strncmp(str, "სხვა", 12) == 0) return TOKEN_სხვა;
+    if (len == 21 && strncmp(str, "ფუნქცია", 21) == 0) return TOKEN_ფუნქცია;
+    if (len == 18 && strncmp(str, "ცვლადი", 18) == 0) return TOKEN_ცვლადი;
+    if (len == 21 && strncmp(str, "დაბეჭდე", 21) == 0) return TOKEN_დაბეჭდე;
+    return TOKEN_IDENTIFIER;
+}
+
+/** @brief აგებს იდენტიფიკატორებით გაჯერებულ კორპუსს (~30% საკვანძო სიტყვა). */
+static char* build_corpus(size_t target_size, size_t* out_size) {
+    char* buffer = malloc(target_size + 256);
+    if (!buffer) {
+        fprintf(stderr, "FATAL: Memory allocation failed for corpus.\n");
+        exit(1);
+    }
+    size_t size = 0;
+    unsigned int seed = 12345;
+    int words_on_line = 0;
+    while (size < target_size) {
+        seed = seed * 1103515245u + 12345u;
+        const char* word = (seed >> 16) % 10 < 3
+            ? keywords[(seed >> 8) % KEYWORD_COUNT]
+            : identifiers[(seed >> 8) % IDENTIFIER_COUNT];
+        size_t length = strlen(word);
+        memcpy(buffer + size, word, length);
+        size += length;
+        if (++words_on_line == 8) {
+            buffer[size++] = '\n';
+            words_on_line = 0;
+        } else {
+            buffer[size++] = ' ';
+        }
+    }
+    buffer[size] = '\0';
+    *out_size = size;
+    return buffer;
+}
+
+int main(int argc, char* argv[]) {
+    size_t megabytes = argc > 1 ? (size_t)atol(argv[1]) : 16;
+    if (megabytes == 0) megabytes = 1;
+
+    // სისწორე: ყველა საკვანძო სიტყვა უნდა ამოიცნოს, ჩვეულებრივი სახელი — არა.
+    if (!check_keyword_table()) return 1;
+    for (int i = 0; i < KEYWORD_COUNT; i++) {
+        if (lookup_keyword(keywords[i], (int)strlen(keywords[i])) == TOKEN_IDENTIFIER) {
+            fprintf(stderr, "შეცდომა: '%s' არ ამოიცნო საკვანძო სიტყვად.\n", keywords[i]);
+            return 1;
+        }
+    }
+    for (int i = 0; i < IDENTIFIER_COUNT; i++) {
+        if (lookup_keyword(identifiers[i], (int)strlen(identifiers[i])) != TOKEN_IDENTIFIER) {
+            fprintf(stderr, "შეცდომა: '%s' შეცდომით ამოიცნო საკვანძო სიტყვად.\n", identifiers[i]);
+            return 1;
+        }
+    }
+
+    size_t size;
+    char* corpus = build_corpus(megabytes * 1024 * 1024, &size);
+
+    // სრული ლექსირება: საუკეთესო გავლა, რომ ერთჯერადმა ხმაურმა შედეგი არ გააფუჭოს.
+    long token_count = 0;
+    long keyword_count = 0;
+    double lex_time = 0.0;
+    for (int round = 0; round < LEX_ROUNDS; round++) {
+        Lexer lexer;
+        init_lexer(&lexer, corpus, size);
+        long tokens = 0;
+        long found = 0;
+        double start = now_seconds();
+        for (;;) {
+            Token token = scan_token(&lexer);
+            tokens++;
+            if (token.type == TOKEN_EOF) break;
+            found += token.type != TOKEN_IDENTIFIER && token.type != TOKEN_NEWLINE;
+        }
+        double elapsed = now_seconds() - start;
+        if (round == 0 || elapsed < lex_time) lex_time = elapsed;
+        token_count = tokens;
+        keyword_count = found;
+    }
+
+    // კლასიფიკატორების შესადარებლად სახელების ნიმუში ქეშში ეტევა, რომ
+    // გაზომვაში მეხსიერების შეყოვნება არ ჭარბობდეს.
+    int capacity = 1 << 14;
+    int name_count = 0;
+    Token* names = malloc(sizeof(Token) * (size_t)capacity);
+    if (!names) {
+        fprintf(stderr, "FATAL: Memory allocation failed for names.\n");
+        exit(1);
+    }
+    Lexer lexer;
+    init_lexer(&lexer, corpus, size);
+    while (name_count < capacity) {
+        Token token = scan_token(&lexer);
+        if (token.type == TOKEN_EOF) break;
+        if (token.type != TOKEN_NEWLINE && token.type != TOKEN_ERROR) names[name_count++] = token;
+    }
+
+    long legacy_keywords = 0;
+    double start = now_seconds();
+    for (int round = 0; round < ROUNDS; round++) {
+        for (int i = 0; i < name_count; i++) {
+            legacy_keywords += legacy_identifier_type(names[i].start, names[i].length) != TOKEN_IDENTIFIER;
+        }
+    }
+    double legacy_time = now_seconds() - start;
+
+    long hashed_keywords = 0;
+    start = now_seconds();
+    for (int round = 0; round < ROUNDS; round++) {
+        for (int i = 0; i < name_count; i++) {
+            hashed_keywords += lookup_keyword(names[i].start, names[i].length) != TOKEN_IDENTIFIER;
+        }
+    }
+    double hashed_time = now_seconds() - start;
+
+    double lookups = (double)name_count * ROUNDS;
+    printf("კორპუსი: %.1f MB, %ld ტოკენი\n", (double)size / (1024 * 1024), token_count);
+    printf("ლექსირება (scan_token, საუკეთესო %d-დან): %8.1f MB/s  %8.2f M ტოკენი/წმ  %6.2f ns/ტოკენი  (%ld საკვანძო სიტყვა)\n",
+           LEX_ROUNDS, (double)size / (1024 * 1024) / lex_time, (double)token_count / lex_time / 1e6,
+           lex_time / (double)token_count * 1e9, keyword_count);
+    printf("კლასიფიკაცია, strncmp ჯაჭვი: %8.2f ns/სახელი  (%ld საკვანძო სიტყვა, 5/%d მხარდაჭერილი)\n",
+           legacy_time / lookups * 1e9, legacy_keywords / ROUNDS, KEYWORD_COUNT);
+    printf("კლასიფიკაცია, სრულყოფილი ჰეში: %6.2f ns/სახელი  (%ld საკვანძო სიტყვა, %d/%d მხარდაჭერილი)\n",
+           hashed_time / lookups * 1e9, hashed_keywords / ROUNDS, KEYWORD_COUNT, KEYWORD_COUNT);
+
+    free(names);
+    free(corpus);
+    return 0;
+}
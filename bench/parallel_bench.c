@@ -0,0 +1,88 @@
+/**
+ * @file parallel_bench.c
+ * @author გიორგი მაღრაძე (magradze.giorgi@gmail.com)
+ * @brief ms_parallel_for-ის მასშტაბირების ბენჩმარკი (1-დან N ნაკადამდე).
+ * @version 0.2
+ *
+ * ერთსა და იმავე ციკლს (კოლაცის მიმდევრობის სიგრძეები: ჯამი და მაქსიმუმი)
+ * ასრულებს 1, 2, 4, ... N ნაკადით და დროს, აჩქარებასა და ეფექტიანობას
+ * (აჩქარება / ნაკადები) ერთ ნაკადთან შედარებით markdown ცხრილად ბეჭდავს,
+ * რომ ის README-ის შედეგებში პირდაპირ ჩაისვას. პროცესორებზე მეტი ნაკადის
+ * სტრიქონი `*`-ით აღინიშნება: იქ აჩქარება მასშტაბირებას აღარ ზომავს.
+ * იტერაციების ღირებულება არათანაბარია, ამიტომ ბენჩმარკი სამუშაოს
+ * მოპარვასაც ამოწმებს. რედუქციები მთელია, ამიტომ შედეგი ყველა ნაკადის
+ * რაოდენობაზე ზუსტად ერთნაირი უნდა იყოს.
+ * გამოყენება: parallel_bench [ნაკადები] [იტერაციები]
+ */
+#define _POSIX_C_SOURCE 200809L
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include "runtime.h"
+
+/** @brief მიმდინარე დრო წამებში (მონოტონური საათი). */
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/** @brief ციკლის სხეული: partials[0] — ნაბიჯების ჯამი, partials[1] — მაქსიმუმი. */
+static void collatz_body(int64_t start, int64_t end, const void* context, int64_t* partials) {
+    (void)context;
+    int64_t total = partials[0];
+    int64_t longest = partials[1];
+    for (int64_t i = start; i < end; i++) {
+        int64_t steps = 0;
+        for (uint64_t n = (uint64_t)i + 1; n != 1; steps++) n = n % 2 == 0 ? n / 2 : 3 * n + 1;
+        total += steps;
+        if (steps > longest) longest = steps;
+    }
+    partials[0] = total;
+    partials[1] = longest;
+}
+
+int main(int argc, char* argv[]) {
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    int max_threads = argc > 1 ? atoi(argv[1]) : (int)(online > 0 ? online : 1);
+    int64_t iterations = argc > 2 ? atoll(argv[2]) : 2000000;
+    if (max_threads < 1) max_threads = 1;
+    if (iterations < 1) iterations = 1;
+
+    static const uint8_t reductions[] = { MS_REDUCE_SUM, MS_REDUCE_MAX };
+    int64_t expected[2] = { 0, 0 };
+    double baseline = 0.0;
+    printf("%" PRId64 " იტერაცია, პროცესორები: %ld\n\n", iterations, online);
+    printf("| ნაკადები | დრო (ms) | აჩქარება | ეფექტიანობა |\n");
+    printf("|---:|---:|---:|---:|\n");
+    for (int threads = 1;; threads = threads * 2 < max_threads ? threads * 2 : max_threads) {
+        ms_parallel_set_workers(threads);
+        double best = 1e30;
+        int64_t results[2] = { 0, 0 };
+        for (int run = 0; run < 3; run++) {
+            results[0] = 0;
+            results[1] = 0;
+            double start = now_seconds();
+            ms_parallel_for(0, iterations, collatz_body, NULL, results, reductions, 2);
+            double elapsed = now_seconds() - start;
+            if (elapsed < best) best = elapsed;
+        }
+        if (threads == 1) {
+            expected[0] = results[0];
+            expected[1] = results[1];
+            baseline = best;
+        } else if (results[0] != expected[0] || results[1] != expected[1]) {
+            fprintf(stderr, "შეცდომა: %d ნაკადმა მისცა %" PRId64 "/%" PRId64 " (მოსალოდნელი: %" PRId64 "/%" PRId64 ").\n",
+                    threads, results[0], results[1], expected[0], expected[1]);
+            return 1;
+        }
+        printf("| %d%s | %.2f | %.2fx | %.0f%% |\n", threads, threads > online ? " *" : "", best * 1e3, baseline / best,
+               100.0 * baseline / best / threads);
+        if (threads == max_threads) break;
+    }
+    if (max_threads > online) printf("\n\\* ნაკადები პროცესორებზე მეტია: ზედმეტი ნაკადები ბირთვებს იყოფს.\n");
+    printf("\nნაბიჯების ჯამი: %" PRId64 ", უგრძესი: %" PRId64 "\n", expected[0], expected[1]);
+    return 0;
+}
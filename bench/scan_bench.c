@@ -0,0 +1,85 @@
+/**
+ * @file scan_bench.c
+ * @author გიორგი მაღრაძე (magradze.giorgi@gmail.com)
+ * @brief ლექსერის სკანირების ბირთვების (scalar/SSE2/AVX2) შედარებითი ბენჩმარკი.
+ * @version 0.1
+ *
+ * ერთსა და იმავე კორპუსს (ქართული იდენტიფიკატორები, კომენტარები, სტრიქონები)
+ * ლექსირებს ყველა ხელმისაწვდომი ბირთვით და ბეჭდავს გამტარუნარიანობას.
+ * გამოყენება: scan_bench [კორპუსის_ზომა_MB]
+ */
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "lexer.h"
+#include "scan_simd.h"
+
+static const char* lines[] = {
+    "ცვლადი მომხმარებლის_სრული_სახელი = პირველი_მნიშვნელობა + მეორე_მნიშვნელობა\n",
+    "# ეს არის გრძელი კომენტარი, რომელიც აღწერს შემდეგი გამოთვლის დანიშნულებას\n",
+    "დაბეჭდე(\"გამარჯობა, სამყარო! ეს არის საკმაოდ გრძელი სტრიქონი\")\n",
+    "ცვლადი შედეგი = რაოდენობა * ერთეულის_ფასი - ფასდაკლება\n",
+    "\n",
+};
+
+#define LINE_COUNT (int)(sizeof(lines) / sizeof(lines[0]))
+
+/** @brief მიმდინარე დრო წამებში (მონოტონური საათი). */
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char* argv[]) {
+    size_t megabytes = argc > 1 ? (size_t)atol(argv[1]) : 32;
+    if (megabytes == 0) megabytes = 1;
+    size_t target = megabytes * 1024 * 1024;
+
+    char* corpus = malloc(target + 256);
+    if (!corpus) {
+        fprintf(stderr, "FATAL: Memory allocation failed for corpus.\n");
+        return 1;
+    }
+    size_t size = 0;
+    for (int i = 0; size < target; i++) {
+        const char* line = lines[i % LINE_COUNT];
+        size_t length = strlen(line);
+        memcpy(corpus + size, line, length);
+        size += length;
+    }
+    corpus[size] = '\0';
+
+    const char* kernels[] = { "scalar", "sse2", "avx2" };
+    long expected_tokens = -1;
+    for (int k = 0; k < 3; k++) {
+        if (!select_scan_kernels(kernels[k])) {
+            printf("%-7s მიუწვდომელია ამ პროცესორზე\n", kernels[k]);
+            continue;
+        }
+        double best = 1e30;
+        long token_count = 0;
+        for (int run = 0; run < 3; run++) {
+            Lexer lexer;
+            init_lexer(&lexer, corpus, size);
+            token_count = 0;
+            double start = now_seconds();
+            while (scan_token(&lexer).type != TOKEN_EOF) token_count++;
+            double elapsed = now_seconds() - start;
+            if (elapsed < best) best = elapsed;
+        }
+        if (expected_tokens >= 0 && token_count != expected_tokens) {
+            fprintf(stderr, "შეცდომა: %s ბირთვმა %ld ტოკენი მისცა (მოსალოდნელი: %ld).\n",
+                    kernels[k], token_count, expected_tokens);
+            return 1;
+        }
+        expected_tokens = token_count;
+        printf("%-7s %8.1f MB/s  %8.2f M ტოკენი/წმ\n", kernels[k],
+               (double)size / (1024 * 1024) / best, (double)token_count / best / 1e6);
+    }
+
+    free(corpus);
+    return 0;
+}
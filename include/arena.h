@@ -0,0 +1,50 @@
+/**
+ * @file arena.h
+ * @author გიორგი მაღრაძე (magradze.giorgi@gmail.com)
+ * @brief კომპილაციის არენის (bump allocator) დეკლარაციები.
+ * @version 0.1
+ *
+ * არენა მეხსიერებას გასცემს დიდი ბლოკებიდან (chunk) უბრალოდ მაჩვენებლის
+ * წანაცვლებით. ცალკეული ობიექტები არ თავისუფლდება — მთელი არენა
+ * ერთიანად თავისუფლდება `free_arena`-ით კომპილაციის ბოლოს.
+ */
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+typedef struct ArenaChunk ArenaChunk;
+
+/**
+ * @brief არენის სტრუქტურა.
+ */
+typedef struct {
+    ArenaChunk* head;         // ბოლოს გამოყოფილი ბლოკი (ბლოკები ჯაჭვშია)
+    char* cursor;             // თავისუფალი ადგილის დასაწყისი მიმდინარე ბლოკში
+    char* limit;              // მიმდინარე ბლოკის დასასრული
+    size_t next_chunk_size;   // შემდეგი ბლოკის ზომა (იზრდება ორჯერ)
+    size_t bytes_allocated;   // არენიდან გაცემული ბაიტების ჯამი
+    size_t bytes_reserved;    // ბლოკებისთვის სისტემიდან აღებული ბაიტები
+} Arena;
+
+/**
+ * @brief არენის ინიციალიზაცია. პირველი ბლოკი გამოიყოფა პირველივე მოთხოვნისას.
+ * @param arena არენის ობიექტის მისამართი.
+ */
+void init_arena(Arena* arena);
+
+/**
+ * @brief გასცემს `size` ბაიტს არენიდან (გასწორებულს 16 ბაიტზე).
+ * @param arena არენის ობიექტის მისამართი.
+ * @param size მოთხოვნილი ზომა ბაიტებში.
+ * @return void* გამოყოფილი მეხსიერების მისამართი. შეცდომისას პროგრამა სრულდება.
+ */
+void* arena_alloc(Arena* arena, size_t size);
+
+/**
+ * @brief ათავისუფლებს არენის ყველა ბლოკს ერთიანად.
+ * @param arena არენის ობიექტის მისამართი.
+ */
+void free_arena(Arena* arena);
+
+#endif // ARENA_H
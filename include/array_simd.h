@@ -0,0 +1,71 @@
+/**
+ * @file array_simd.h
+ * @author გიორგი მაღრაძე (magradze.giorgi@gmail.com)
+ * @brief მასივების ელემენტური ოპერაციების SIMD ბირთვების (kernels) დეკლარაციები.
+ * @version 0.2
+ *
+ * ბირთვები უწყვეტ ბუფერებზე მუშაობს და კუდს (ვექტორის სიგანეზე ნაკლებ
+ * ბოლო ელემენტებს) სკალარულად ამუშავებს. რედუქციები (ჯამი, სკალარული
+ * ნამრავლი, მინიმუმი, მაქსიმუმი) ყველა იმპლემენტაციაში ერთნაირი რვა
+ * ზოლით (lane) და ერთნაირი გაერთიანების რიგით სრულდება, ამიტომ შედეგი
+ * ბიტ-ბიტ არ არის დამოკიდებული არჩეულ ბირთვზე. FMA არ გამოიყენება
+ * (გამრავლება და მიმატება ცალკე მრგვალდება). იმპლემენტაცია (AVX2, SSE2
+ * ან სკალარული) გაშვებისას ირჩევა; MANUSCRIPT_SIMD=scalar|sse2|avx2
+ * მას იძულებით ირჩევს, ლექსერის ბირთვების მსგავსად (scan_simd.h).
+ */
+#ifndef ARRAY_SIMD_H
+#define ARRAY_SIMD_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** @brief ელემენტური ოპერაცია. */
+typedef enum {
+    MS_ARRAY_ADD,
+    MS_ARRAY_SUB,
+    MS_ARRAY_MUL,
+    MS_ARRAY_DIV,
+} MsArrayOp;
+
+/** @brief მთელი ჯამის ბლოკი: 512 * 2^53 < 2^63, ამიტომ ბლოკის ჯამი არ გადაივსება. */
+#define MS_ARRAY_INT_SUM_BLOCK 512
+
+/**
+ * @brief მასივების ბირთვების ნაკრები.
+ */
+typedef struct {
+    const char* name;   // იმპლემენტაციის სახელი: "avx2", "sse2" ან "scalar"
+    /** @brief out[i] = left[i] op right[i]. */
+    void (*map)(MsArrayOp op, double* out, const double* left, const double* right, size_t n);
+    /** @brief out[i] = left[i] op scalar (`swap`-ით — scalar op left[i]). */
+    void (*map_scalar)(MsArrayOp op, double* out, const double* left, double scalar, bool swap, size_t n);
+    /**
+     * @brief მთელი `+`/`-` (|ელემენტი| <= 2^53, ამიტომ int64 არ გადაივსება) და
+     * შემოწმებული `*` (ყოველთვის სკალარული ბირთვით).
+     * @return bool false, თუ რომელიმე შედეგი ±2^53-ს გასცდა (ან `*` -0.0-ს
+     * იძლევა) და double-ში უნდა გადაითვალოს.
+     */
+    bool (*map_int)(MsArrayOp op, int64_t* out, const int64_t* left, const int64_t* right, size_t n);
+    bool (*map_int_scalar)(MsArrayOp op, int64_t* out, const int64_t* left, int64_t scalar, bool swap, size_t n);
+    /** @brief ჯამი რვა ზოლით: ზოლი j აგროვებს x[j], x[j+8], ...; შემდეგ ((0+1)+(2+3))+((4+5)+(6+7)). */
+    double (*sum)(const double* x, size_t n);
+    /** @brief სკალარული ნამრავლი იმავე ზოლებით. */
+    double (*dot)(const double* x, const double* y, size_t n);
+    /** @brief მინიმუმი (`x < m ? x : m`) და მაქსიმუმი (`x > m ? x : m`) ზოლებით; n > 0. */
+    double (*min)(const double* x, size_t n);
+    double (*max)(const double* x, size_t n);
+    /** @brief მთელი ჯამი; n <= MS_ARRAY_INT_SUM_BLOCK. */
+    int64_t (*sum_int)(const int64_t* x, size_t n);
+} MsArrayKernels;
+
+/** @brief მიმდინარე (არჩეული) ბირთვები. */
+extern MsArrayKernels ms_array_kernels;
+
+/**
+ * @brief ირჩევს ბირთვებს სახელით ("scalar", "sse2", "avx2").
+ * @return bool false, თუ ეს იმპლემენტაცია ამ პროცესორზე მიუწვდომელია.
+ */
+bool ms_select_array_kernels(const char* name);
+
+#endif // ARRAY_SIMD_H
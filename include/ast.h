@@ -2,12 +2,14 @@
  * @file ast.h
  * @author გიორგი მაღრაძე (magradze.giorgi@gmail.com)
  * @brief აბსტრაქტული სინტაქსური ხის (AST) სტრუქტურების დეკლარაციები.
- * @version 0.5
+ * @version 0.18
  */
 #ifndef AST_H
 #define AST_H
 
+#include <stdint.h>
 #include "lexer.h"
+#include "arena.h"
 
 /** @brief AST კვანძის შესაძლო ტიპები. */
 typedef enum {
@@ -18,28 +20,144 @@ typedef enum {
     NODE_UNARY_OP,
     NODE_VARIABLE,
     NODE_NUMBER,
+    NODE_BOOLEAN,
+    NODE_NONE,
+    NODE_STRING,
+    NODE_ASSIGN,
+    NODE_BLOCK,
+    NODE_IF,
+    NODE_WHILE,
+    NODE_FUNCTION,
+    NODE_CALL,
+    NODE_RETURN,
+    NODE_EXPRESSION_STMT,
+    NODE_FOR,
+    NODE_RANGE,
+    NODE_ARRAY,
+    NODE_INDEX,
+    NODE_INDEX_ASSIGN,
+    NODE_BUILTIN,
+    NODE_PARALLEL_FOR,    // `პარალელური ყოველი`: ForNode, იტერაციები ნაკადებს შორის ნაწილდება
 } AstNodeType;
 
+/**
+ * @brief გამოსახულების სტატიკური ტიპი (ტიპების გამოყვანის შედეგი).
+ * TYPE_INT ნიშნავს მთელ რიცხვს, რომლის მოდული 2^53-ს არ აღემატება და
+ * რომელიც -0.0 არ არის, ამიტომ int64_t და double გამოთვლა ერთსა და იმავე
+ * შედეგს იძლევა. `wide` კვანძი ამ ზღვარს შეიძლება გასცდეს: მაშინ
+ * მნიშვნელობა double-ზე გადადის, თუმცა int64_t-ში ზუსტად ინახება. TYPE_STRING სტრიქონია (C-ში MsValue). TYPE_VALUE — ტიპი, რომელსაც გამოყვანა ვერ ავიწროებს;
+ * C ბექენდი მას runtime-ის MsValue-თი (NaN-boxing) წარმოადგენს. TYPE_ARRAY რიცხვების
+ * მასივია (C-შიც MsValue).
+ */
+typedef enum {
+    TYPE_UNKNOWN,
+    TYPE_INT,
+    TYPE_NUMBER,
+    TYPE_BOOL,
+    TYPE_STRING,
+    TYPE_VALUE,
+    TYPE_ARRAY,
+} ValueType;
+
 typedef struct AstNode AstNode;
 
+/**
+ * @brief ინტერნირებული სახელი. ერთნაირ სახელებს ერთი და იგივე Symbol შეესაბამება,
+ * ამიტომ სახელების შედარება მაჩვენებლების შედარებაა.
+ */
+typedef struct Symbol {
+    const char* chars;     // სახელის ბაიტები (არენაში დაკოპირებული, NUL-ით დასრულებული)
+    int length;            // სიგრძე ბაიტებში
+    int id;                // მკვრივი ნომერი: 0..symbol_count-1
+    unsigned int hash;     // სახელის ჰეში
+    struct Symbol* next;   // ჰეშ-ცხრილის ჯაჭვის შემდეგი ელემენტი
+} Symbol;
+
+/**
+ * @brief ერთი კომპილაციის AST-ის მფლობელი კონტექსტი.
+ * ყველა კვანძი და სიმბოლო არენიდან გამოიყოფა და ერთიანად თავისუფლდება.
+ */
+typedef struct {
+    Arena arena;              // კვანძების, სიებისა და სიმბოლოების არენა
+    Symbol** symbols;         // სიმბოლოების ჰეშ-ცხრილი (ჯაჭვებით)
+    int symbol_capacity;      // ცხრილის ზომა (ორის ხარისხი)
+    int symbol_count;         // ინტერნირებული სახელების რაოდენობა
+} AstContext;
+
 /** @brief პროგრამის კვანძი, რომელიც შეიცავს განცხადებების სიას. */
 typedef struct { AstNode** statements; int count; int capacity; } ProgramNode;
 /** @brief ცვლადის დეკლარაციის კვანძი. */
-typedef struct { Token name; AstNode* initializer; } VarDeclNode;
+typedef struct { Symbol* name; AstNode* initializer; } VarDeclNode;
 /** @brief "დაბეჭდე" განცხადების კვანძი. */
 typedef struct { AstNode* expression; } PrintStmtNode;
 /** @brief ორობითი ოპერაციის კვანძი. */
-typedef struct { AstNode* left; Token operator; AstNode* right; } BinaryOpNode;
+typedef struct { AstNode* left; AstNode* right; TokenType operator; } BinaryOpNode;
 /** @brief ერთმაგი ოპერაციის კვანძი. */
-typedef struct { Token operator; AstNode* right; } UnaryOpNode;
+typedef struct { AstNode* right; TokenType operator; } UnaryOpNode;
 /** @brief ცვლადის გამოყენების კვანძი. */
-typedef struct { Token name; } VariableNode;
+typedef struct { Symbol* name; } VariableNode;
 /** @brief რიცხვითი ლიტერალის კვანძი. */
 typedef struct { double value; } NumberNode;
+/** @brief ლოგიკური ლიტერალის კვანძი (ჭეშმარიტი/მცდარი). */
+typedef struct { bool value; } BooleanNode;
+/** @brief სტრიქონული ლიტერალის კვანძი (ბრჭყალების გარეშე, არენაში დაკოპირებული). */
+typedef struct { const char* chars; int length; } StringNode;
+/** @brief უკვე გამოცხადებული ცვლადისთვის ახალი მნიშვნელობის მინიჭება. */
+typedef struct { Symbol* name; AstNode* value; } AssignNode;
+/** @brief შეწეული ბლოკი: განცხადებების სია პროგრამის კვანძის ველებით. */
+typedef ProgramNode BlockNode;
+/** @brief `თუ` განცხადება; `სხვა_თუ` ჯაჭვი else შტოში ჩადგმული IfNode-ია. */
+typedef struct { AstNode* condition; AstNode* then_branch; AstNode* else_branch; } IfNode;
+/** @brief `სანამ` ციკლი. */
+typedef struct { AstNode* condition; AstNode* body; } WhileNode;
+/**
+ * @brief ფუნქციის განსაზღვრა. პარამეტრები ბლოკის კვანძშია VARIABLE კვანძებად
+ * (მათი value_type პარამეტრის ტიპია); თავად კვანძის value_type — დაბრუნების ტიპი.
+ */
+typedef struct { Symbol* name; AstNode* parameters; AstNode* body; } FunctionNode;
+/** @brief ფუნქციის გამოძახება; არგუმენტების მასივი არენაშია. */
+typedef struct { Symbol* callee; AstNode** arguments; int count; } CallNode;
+/** @brief `დაბრუნე` განცხადება (value == NULL — `არარა`). */
+typedef struct { AstNode* value; } ReturnNode;
+/** @brief გამოსახულება განცხადების როლში (მაგ. ფუნქციის გამოძახება). */
+typedef struct { AstNode* expression; } ExpressionStmtNode;
+/**
+ * @brief `ყოველი ცვლადი ში დიაპაზონი:` ციკლი. iterable NODE_RANGE-ია ან
+ * (`ყოველი ე ში მასივი:`) გამოსახულება, რომლის ელემენტებსაც ციკლი გადის.
+ * კვანძის value_type ციკლის ცვლადის ტიპია; ცვლადი მხოლოდ სხეულში ჩანს და
+ * მას ვერ მიენიჭება. NODE_PARALLEL_FOR იგივე სტრუქტურას იყენებს.
+ */
+typedef struct { Symbol* variable; AstNode* iterable; AstNode* body; } ForNode;
+/** @brief ნახევრად ღია დიაპაზონი `start..end` (end არ შედის); მხოლოდ `ყოველი`-ს თავში. */
+typedef struct { AstNode* start; AstNode* end; } RangeNode;
+/** @brief მასივის ლიტერალი `[ა, ბ]`; ელემენტების მასივი არენაშია. */
+typedef struct { AstNode** elements; int count; } ArrayNode;
+/** @brief ელემენტის წაკითხვა `მასივი[ინდექსი]`. */
+typedef struct { AstNode* array; AstNode* index; } IndexNode;
+/** @brief ელემენტისთვის მნიშვნელობის მინიჭება `მასივი[ინდექსი] = მნიშვნელობა`. */
+typedef struct { AstNode* array; AstNode* index; AstNode* value; } IndexAssignNode;
+
+/** @brief ჩაშენებული ფუნქციები; მათი სახელით მომხმარებლის ფუნქცია ვერ განისაზღვრება. */
+typedef enum {
+    BUILTIN_LENGTH,    // სიგრძე(ა) — მასივის ელემენტების ან სტრიქონის ბაიტების რაოდენობა
+    BUILTIN_ARRAY,     // მასივი(ნ) — ნ ნულისგან შემდგარი მასივი
+    BUILTIN_PUSH,      // დაამატე(ა, x) — ამატებს ელემენტს მასივის ბოლოს
+    BUILTIN_SUM,       // ჯამი(ა)
+    BUILTIN_MIN,       // მინიმუმი(ა)
+    BUILTIN_MAX,       // მაქსიმუმი(ა)
+    BUILTIN_DOT,       // სკალარული(ა, ბ) — სკალარული ნამრავლი
+    BUILTIN_COUNT,
+} BuiltinFunction;
+
+/** @brief ჩაშენებული ფუნქციის გამოძახება; არგუმენტების მასივი არენაშია. */
+typedef struct { AstNode** arguments; int count; int function; } BuiltinNode;
 
 /** @brief AST-ის ერთიანი კვანძის სტრუქტურა. */
 struct AstNode {
-    AstNodeType type;
+    uint8_t type;          // AstNodeType
+    uint8_t value_type;    // ValueType; ივსება infer_types()-ით (დეკლარაციასა და მინიჭებაზე — ცვლადის ტიპი)
+    bool wide;             // TYPE_INT, რომლის მნიშვნელობამ შეიძლება ±2^53 გადალახოს (იხ. type_infer.h)
+    int line;              // ოპერატორის წყაროს ხაზი დიაგნოსტიკისთვის (parse_declaration ავსებს); 0 — უცნობი
     union {
         ProgramNode program;
         VarDeclNode var_decl;
@@ -48,28 +166,140 @@ struct AstNode {
         UnaryOpNode unary_op;
         VariableNode variable;
         NumberNode number;
+        BooleanNode boolean;
+        StringNode string;
+        AssignNode assign;
+        BlockNode block;
+        IfNode if_stmt;
+        WhileNode while_stmt;
+        FunctionNode function;
+        CallNode call;
+        ReturnNode return_stmt;
+        ExpressionStmtNode expression_stmt;
+        ForNode for_stmt;
+        RangeNode range;
+        ArrayNode array;
+        IndexNode index;
+        IndexAssignNode index_assign;
+        BuiltinNode builtin;
     } as;
 };
 
+/** @brief AST კონტექსტის ინიციალიზაცია. */
+void init_ast_context(AstContext* ctx);
+/** @brief ათავისუფლებს კონტექსტის მთელ მეხსიერებას (ყველა კვანძს ერთიანად). */
+void free_ast_context(AstContext* ctx);
+/** @brief აბრუნებს სახელის ინტერნირებულ სიმბოლოს (საჭიროებისას ქმნის ახალს). */
+Symbol* intern_symbol(AstContext* ctx, const char* chars, int length);
+/** @brief აბრუნებს ოპერატორის ტოკენის ტექსტურ ჩანაწერს (მაგ. "+"). */
+const char* operator_lexeme(TokenType op);
+
 /** @brief ქმნის ცარიელ პროგრამის კვანძს. */
-AstNode* create_program_node();
+AstNode* create_program_node(AstContext* ctx);
 /** @brief ამატებს განცხადებას პროგრამის კვანძში. */
-void add_statement_to_program(AstNode* program_node, AstNode* statement);
+void add_statement_to_program(AstContext* ctx, AstNode* program_node, AstNode* statement);
+/** @brief ქმნის ცარიელ ბლოკის კვანძს. */
+AstNode* create_block_node(AstContext* ctx);
+/** @brief ამატებს განცხადებას ბლოკის კვანძში. */
+void add_statement_to_block(AstContext* ctx, AstNode* block_node, AstNode* statement);
 /** @brief ქმნის ცვლადის დეკლარაციის კვანძს. */
-AstNode* create_var_decl_node(Token name, AstNode* initializer);
+AstNode* create_var_decl_node(AstContext* ctx, Symbol* name, AstNode* initializer);
+/** @brief ქმნის მინიჭების კვანძს. */
+AstNode* create_assign_node(AstContext* ctx, Symbol* name, AstNode* value);
+/** @brief ქმნის `თუ` განცხადების კვანძს (else_branch შეიძლება NULL იყოს). */
+AstNode* create_if_node(AstContext* ctx, AstNode* condition, AstNode* then_branch, AstNode* else_branch);
+/** @brief ქმნის `სანამ` ციკლის კვანძს. */
+AstNode* create_while_node(AstContext* ctx, AstNode* condition, AstNode* body);
+/** @brief ქმნის ფუნქციის განსაზღვრის კვანძს (parameters — VARIABLE კვანძების ბლოკი). */
+AstNode* create_function_node(AstContext* ctx, Symbol* name, AstNode* parameters, AstNode* body);
+/** @brief ქმნის გამოძახების კვანძს; არგუმენტების მასივი კონტექსტის არენიდან უნდა იყოს გამოყოფილი. */
+AstNode* create_call_node(AstContext* ctx, Symbol* callee, AstNode** arguments, int count);
+/** @brief ქმნის `დაბრუნე` განცხადების კვანძს (value შეიძლება NULL იყოს). */
+AstNode* create_return_node(AstContext* ctx, AstNode* value);
+/** @brief ქმნის გამოსახულება-განცხადების კვანძს. */
+AstNode* create_expression_stmt_node(AstContext* ctx, AstNode* expression);
+/** @brief ქმნის `ყოველი` (`parallel`-ით — `პარალელური ყოველი`) ციკლის კვანძს. */
+AstNode* create_for_node(AstContext* ctx, Symbol* variable, AstNode* iterable, AstNode* body, bool parallel);
+/** @brief ქმნის დიაპაზონის კვანძს. */
+AstNode* create_range_node(AstContext* ctx, AstNode* start, AstNode* end);
+/** @brief ქმნის მასივის ლიტერალის კვანძს; ელემენტების მასივი არენიდან უნდა იყოს გამოყოფილი. */
+AstNode* create_array_node(AstContext* ctx, AstNode** elements, int count);
+/** @brief ქმნის ელემენტის წაკითხვის კვანძს. */
+AstNode* create_index_node(AstContext* ctx, AstNode* array, AstNode* index);
+/** @brief ქმნის ელემენტისთვის მინიჭების კვანძს. */
+AstNode* create_index_assign_node(AstContext* ctx, AstNode* array, AstNode* index, AstNode* value);
+/** @brief ქმნის ჩაშენებული ფუნქციის გამოძახების კვანძს. */
+AstNode* create_builtin_node(AstContext* ctx, BuiltinFunction function, AstNode** arguments, int count);
+/** @brief ეძებს ჩაშენებულ ფუნქციას სახელით; -1 — ასეთი არ არსებობს. */
+int lookup_builtin(const char* chars, int length);
+/** @brief აბრუნებს ჩაშენებული ფუნქციის სახელს. */
+const char* builtin_name(BuiltinFunction function);
+/** @brief აბრუნებს ჩაშენებული ფუნქციის პარამეტრების რაოდენობას. */
+int builtin_arity(BuiltinFunction function);
 /** @brief ქმნის "დაბეჭდე" განცხადების კვანძს. */
-AstNode* create_print_stmt_node(AstNode* expression);
+AstNode* create_print_stmt_node(AstContext* ctx, AstNode* expression);
 /** @brief ქმნის ორობითი ოპერაციის კვანძს. */
-AstNode* create_binary_op_node(AstNode* left, Token op, AstNode* right);
+AstNode* create_binary_op_node(AstContext* ctx, AstNode* left, TokenType op, AstNode* right);
 /** @brief ქმნის ერთმაგი ოპერაციის კვანძს. */
-AstNode* create_unary_op_node(Token op, AstNode* right);
+AstNode* create_unary_op_node(AstContext* ctx, TokenType op, AstNode* right);
 /** @brief ქმნის ცვლადის გამოყენების კვანძს. */
-AstNode* create_variable_node(Token name);
+AstNode* create_variable_node(AstContext* ctx, Symbol* name);
 /** @brief ქმნის რიცხვითი ლიტერალის კვანძს. */
-AstNode* create_number_node(double value);
+AstNode* create_number_node(AstContext* ctx, double value);
+/** @brief ქმნის ლოგიკური ლიტერალის კვანძს. */
+AstNode* create_boolean_node(AstContext* ctx, bool value);
+/** @brief ქმნის `არარა` ლიტერალის კვანძს. */
+AstNode* create_none_node(AstContext* ctx);
+/** @brief ქმნის სტრიქონული ლიტერალის კვანძს (ბაიტები არენაში კოპირდება). */
+AstNode* create_string_node(AstContext* ctx, const char* chars, int length);
 /** @brief ბეჭდავს AST ხის სტრუქტურას კონსოლში. */
 void print_ast(AstNode* node);
-/** @brief ათავისუფლებს AST ხის მიერ დაკავებულ მეხსიერებას. */
-void free_ast(AstNode* node);
 
-#endif // AST_H
\ No newline at end of file
+/** @brief აბრუნებს კვანძის შვილების რაოდენობას (NULL-ისთვის 0). */
+int ast_child_count(const AstNode* node);
+/** @brief აბრუნებს კვანძის `index`-ე შვილს (შეიძლება NULL იყოს შეცდომიან ხეში). */
+AstNode* ast_child(const AstNode* node, int index);
+
+/**
+ * @brief ხის იტერაციული გავლის ჩარჩო: კვანძი და მისი გავლის ეტაპი
+ * (ჩვეულებრივ — უკვე დამუშავებული შვილების რაოდენობა).
+ */
+typedef struct {
+    AstNode* node;
+    int stage;
+} AstFrame;
+
+/**
+ * @brief ჩარჩოების მზარდი სტეკი. ხის გამვლელები მას C სტეკის ნაცვლად
+ * იყენებენ, ამიტომ ავტომატურად გენერირებული, ათიათასობით დონით ჩადგმული
+ * გამოსახულებები სტეკს ვერ გაავსებს.
+ */
+typedef struct {
+    AstFrame* frames;
+    int count;
+    int capacity;
+} AstStack;
+
+/** @brief სტეკის ინიციალიზაცია (მეხსიერება პირველ ჩადებაზე გამოიყოფა). */
+void init_ast_stack(AstStack* stack);
+/** @brief ათავისუფლებს სტეკის მეხსიერებას. */
+void free_ast_stack(AstStack* stack);
+/** @brief დებს კვანძს სტეკზე ეტაპით 0. წინა ჩარჩოების მაჩვენებლები შეიძლება გაუქმდეს. */
+void ast_stack_push(AstStack* stack, AstNode* node);
+
+/** @brief აბრუნებს ზედა ჩარჩოს. */
+static inline AstFrame* ast_stack_top(AstStack* stack) {
+    return &stack->frames[stack->count - 1];
+}
+
+/**
+ * @brief აბრუნებს პოსტ-ორდერში მომდევნო კვანძს (შვილები მარცხნიდან
+ * მარჯვნივ, შემდეგ მშობელი) და მას სტეკიდან იღებს. გავლა იწყება
+ * ფესვის ast_stack_push-ით; ცარიელ სტეკზე აბრუნებს false-ს.
+ */
+bool ast_stack_next_postorder(AstStack* stack, AstNode** node);
+
+/** @brief ითვლის ხის კვანძებს (NULL შვილების გარეშე). */
+int ast_count_nodes(AstNode* root);
+
+#endif // AST_H
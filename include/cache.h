@@ -0,0 +1,79 @@
+/**
+ * @file cache.h
+ * @author გიორგი მაღრაძე (magradze.giorgi@gmail.com)
+ * @brief კომპილირებული პროგრამების შიგთავსით მისამართებადი ქეშის დეკლარაციები.
+ * @version 0.1
+ *
+ * ყოველი ჩანაწერი ერთი შესრულებადი ფაილია, რომლის სახელი გასაღების
+ * SHA-256 ჰეშია (64 hex სიმბოლო). გასაღები მოიცავს წყაროს ბაიტებს,
+ * მანუსკრიპტის ვერსიას, C კომპილატორს და მის პარამეტრებს.
+ *
+ * ჩანაწერი ჯერ დროებით ფაილში იქმნება და საბოლოო სახელს ატომური
+ * rename()-ით იღებს, ამიტომ რამდენიმე პროცესს შეუძლია ქეშის ერთდროულად
+ * შევსება: მკითხველი ან სრულ ფაილს ხედავს, ან არაფერს. LRU რიგისთვის
+ * გამოიყენება ფაილის mtime, რომელიც ყოველ მოხვედრაზე ახლდება.
+ */
+#ifndef CACHE_H
+#define CACHE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define CACHE_KEY_SIZE 65              // 64 hex სიმბოლო + NUL
+#define CACHE_DEFAULT_MAX_BYTES (256ull * 1024 * 1024)
+
+/** @brief ქეშის დირექტორია და ზომის ლიმიტი. */
+typedef struct {
+    char* directory;       // ქეშის დირექტორია (მალოკით დაკოპირებული)
+    uint64_t max_bytes;    // ჩანაწერების ჯამური ზომის ზედა ზღვარი
+} CompileCache;
+
+/**
+ * @brief ქეშის ინიციალიზაცია; საჭიროებისას ქმნის დირექტორიას.
+ * @param directory დირექტორია; NULL-ის შემთხვევაში $MANUSCRIPT_CACHE_DIR,
+ *        $XDG_CACHE_HOME/manuscript ან ~/.cache/manuscript.
+ * @param max_bytes ზომის ლიმიტი; 0-ის შემთხვევაში $MANUSCRIPT_CACHE_SIZE ან 256 MiB.
+ * @return bool false, თუ დირექტორიის შექმნა ვერ მოხერხდა.
+ */
+bool init_compile_cache(CompileCache* cache, const char* directory, uint64_t max_bytes);
+
+/** @brief ათავისუფლებს ქეშის სტრუქტურას (ფაილები რჩება). */
+void free_compile_cache(CompileCache* cache);
+
+/**
+ * @brief ითვლის გასაღებს წყაროსა და კონფიგურაციის სტრიქონიდან.
+ * @param config ყველაფერი, რაც შედეგზე მოქმედებს (ვერსია, კომპილატორი, პარამეტრები).
+ */
+void compute_cache_key(char key[CACHE_KEY_SIZE], const char* source, size_t length, const char* config);
+
+/**
+ * @brief ეძებს ჩანაწერს; მოხვედრისას ანახლებს მის LRU დროს.
+ * @param path შესავსები ბუფერი ჩანაწერის ბილიკისთვის.
+ * @return bool true, თუ ჩანაწერი არსებობს.
+ */
+bool cache_lookup(CompileCache* cache, const char* key, char* path, size_t path_size);
+
+/**
+ * @brief ქმნის უნიკალურ დროებით ფაილს ქეშის დირექტორიაში (იმავე ფაილურ სისტემაზე,
+ * რათა rename() ატომური იყოს).
+ */
+bool cache_temp_path(CompileCache* cache, char* path, size_t path_size);
+
+/**
+ * @brief ათავსებს დროებით ფაილს ქეშში ატომური rename()-ით და საჭიროებისას
+ * ძველ ჩანაწერებს შლის.
+ * @param path შესავსები ბუფერი საბოლოო ბილიკისთვის.
+ */
+bool cache_store(CompileCache* cache, const char* key, const char* temp_path, char* path, size_t path_size);
+
+/**
+ * @brief შლის ყველაზე დიდხანს გამოუყენებელ ჩანაწერებს, სანამ ჯამური
+ * ზომა ლიმიტს არ ჩამოსცდება. ასევე შლის მიტოვებულ დროებით ფაილებს.
+ */
+void cache_evict(CompileCache* cache);
+
+/** @brief არჩევს ზომას სუფიქსით (K, M, G); 0 — არასწორი ჩანაწერისას. */
+uint64_t parse_cache_size(const char* text);
+
+#endif // CACHE_H
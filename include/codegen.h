@@ -16,10 +16,33 @@
 #include <stdio.h> // FILE* ტიპისთვის
 
 /**
- * @brief გენერირებულ C კოდს წერს მითითებულ ფაილში.
+ * @brief მზარდი სტრიქონის ბუფერი გენერირებული C კოდისთვის.
+ * კოდი ჯერ მეხსიერებაში გროვდება და გამოსავალში ერთიანად იწერება.
+ */
+typedef struct {
+    char* data;        // NUL-ით დასრულებული ტექსტი
+    size_t length;     // ტექსტის სიგრძე ბაიტებში
+    size_t capacity;   // გამოყოფილი ზომა
+} CodeBuffer;
+
+/** @brief ბუფერის ინიციალიზაცია (მეხსიერება პირველ ჩაწერაზე გამოიყოფა). */
+void init_code_buffer(CodeBuffer* buffer);
+/** @brief ათავისუფლებს ბუფერის მეხსიერებას. */
+void free_code_buffer(CodeBuffer* buffer);
+
+/**
+ * @brief გენერირებულ C კოდს ამატებს ბუფერში.
+ * @param node დასამუშავებელი AST ხის ფესვი.
+ * @param buffer ბუფერი, რომელსაც კოდი ბოლოში დაემატება.
+ */
+void generate_code_to_buffer(AstNode* node, CodeBuffer* buffer);
+
+/**
+ * @brief გენერირებულ C კოდს წერს მითითებულ ფაილში (ან pipe-ში) ერთი ჩაწერით.
  * @param node დასამუშავებელი AST ხის ფესვი.
  * @param outfile ფაილი, რომელშიც ჩაიწერება C კოდი.
+ * @return bool false, თუ ჩაწერა ვერ მოხერხდა.
  */
-void generate_code(AstNode* node, FILE* outfile);
+bool generate_code(AstNode* node, FILE* outfile);
 
 #endif // CODEGEN_H
\ No newline at end of file
@@ -0,0 +1,82 @@
+/**
+ * @file incremental.h
+ * @author გიორგი მაღრაძე (magradze.giorgi@gmail.com)
+ * @brief ინკრემენტული ლექსირებისა და პარსინგის (რედაქტორი, --watch) დეკლარაციები.
+ * @version 0.2
+ *
+ * დოკუმენტი ინახავს ტექსტს, მის ტოკენებს და პარსინგის ხეს ცვლილებებს
+ * შორის. ცვლილებისას ტოკენები ხელახლა იკითხება მხოლოდ ცვლილებამდე ბოლო
+ * შეწევის გარეშე ხაზიდან მანამ, სანამ ნაკადი ძველს არ დაემთხვევა
+ * (იხ. relex_token_stream). შემდეგ ხელახლა ირჩევა მხოლოდ ის უმაღლესი
+ * დონის განცხადებები, რომელთა ტოკენებიც (ან მომდევნო ტოკენი, რომელსაც
+ * პარსერი წინასწარ ათვალიერებს) შეიცვალა; დანარჩენი კვანძები ProgramNode-ში
+ * უცვლელად რჩება.
+ *
+ * ხელახლა არჩეული განცხადებების ძველი კვანძები არენაში რჩება. როცა არენა
+ * ბოლო სრული პარსინგის შემდეგ საგრძნობლად გაიზრდება, დოკუმენტი მთლიანად
+ * თავიდან იგება.
+ */
+#ifndef INCREMENTAL_H
+#define INCREMENTAL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "ast.h"
+#include "token_stream.h"
+
+/** @brief უმაღლესი დონის განცხადება და მისი პირველი ტოკენი. */
+typedef struct {
+    int first_token;      // განცხადების პირველი ტოკენის ინდექსი ნაკადში
+    AstNode* node;        // არჩეული კვანძი (NULL, თუ განცხადებაში შეცდომაა)
+    bool had_error;       // განცხადების პარსინგისას შეცდომა დაფიქსირდა
+} DocumentStatement;
+
+/** @brief ბოლო ცვლილების დამუშავების სტატისტიკა. */
+typedef struct {
+    int tokens_relexed;       // ხელახლა დასკანერებული ტოკენები
+    int token_count;          // ტოკენები ნაკადში
+    int statements_reparsed;  // ხელახლა არჩეული განცხადებები
+    int statement_count;      // განცხადებები დოკუმენტში
+    bool full_rebuild;        // დოკუმენტი მთლიანად თავიდან აიგო
+} DocumentStats;
+
+/** @brief ინკრემენტულად განახლებადი დოკუმენტი. */
+typedef struct {
+    char* text;                     // მიმდინარე ტექსტი (დოკუმენტის საკუთრება)
+    size_t length;                  // ტექსტის სიგრძე ბაიტებში
+    TokenStream tokens;             // text-ის ტოკენები
+    AstContext ast;                 // კვანძებისა და სიმბოლოების მფლობელი კონტექსტი
+    AstNode* program;               // პარსინგის ხე (ოპტიმიზაციამდე)
+    DocumentStatement* statements;  // უმაღლესი დონის განცხადებები რიგით
+    int statement_count;
+    int statement_capacity;
+    size_t arena_baseline;          // არენის ზომა ბოლო სრული პარსინგის შემდეგ
+    int max_depth;                  // პარსერის ჩადგმულობის ზღვარი (Parser.max_depth)
+    bool had_error;                 // ერთ განცხადებაში მაინც შეცდომაა
+} SourceDocument;
+
+/**
+ * @brief ქმნის დოკუმენტს ტექსტის ასლიდან და სრულად არჩევს მას.
+ * შეცდომები stderr-ზე იბეჭდება; მათი არსებობა document->had_error-შია.
+ * @param max_depth გამოსახულების ჩადგმულობის ზღვარი (PARSER_DEFAULT_MAX_DEPTH).
+ */
+void init_document(SourceDocument* document, const char* text, size_t length, int max_depth, DocumentStats* stats);
+
+/**
+ * @brief ცვლის ტექსტის [start, end) ნაწილს `replacement`-ით და ინკრემენტულად
+ * ანახლებს ტოკენებსა და ხეს. შეცდომიანი განცხადებების დიაგნოსტიკა ყოველ
+ * ცვლილებაზე ხელახლა იბეჭდება.
+ */
+void edit_document(SourceDocument* document, size_t start, size_t end, const char* replacement,
+                   size_t replacement_length, DocumentStats* stats);
+
+/**
+ * @brief ცვლის დოკუმენტის მთელ ტექსტს. ცვლილების შუალედი საერთო თავსართისა
+ * და ბოლოსართის მიხედვით დგინდება, ამიტომ ფაილის ხელახლა წაკითხვაც ინკრემენტულია.
+ */
+void replace_document_text(SourceDocument* document, const char* text, size_t length, DocumentStats* stats);
+
+/** @brief ათავისუფლებს დოკუმენტის მთელ მეხსიერებას. */
+void free_document(SourceDocument* document);
+
+#endif // INCREMENTAL_H
@@ -0,0 +1,40 @@
+/**
+ * @file jit.h
+ * @author გიორგი მაღრაძე (magradze.giorgi@gmail.com)
+ * @brief x86-64 მანქანური კოდის პირდაპირი გენერატორის (JIT) დეკლარაციები.
+ * @version 0.1
+ *
+ * `--jit` რეჟიმში რიცხვითი პროგრამა კომპილირდება x86-64 SSE2 ინსტრუქციებად
+ * შესრულებად mmap რეგიონში და სრულდება იმავე პროცესში. ცვლადები ინახება
+ * ჩარჩოში (frame) — double-ების მასივში, რომლის მისამართიც rbx-შია.
+ * რეფერენსულ იმპლემენტაციად რჩება C ბექენდი.
+ */
+#ifndef JIT_H
+#define JIT_H
+
+#include <stddef.h>
+#include "ast.h"
+
+/** @brief JIT-ით კომპილირებული პროგრამა. */
+typedef struct {
+    void* code;           // შესრულებადი რეგიონი (mmap)
+    size_t size;          // რეგიონის ზომა ბაიტებში
+    int frame_size;       // ჩარჩოს ზომა (ცვლადების რაოდენობა)
+} JitProgram;
+
+/**
+ * @brief აკომპილირებს პროგრამის AST-ს მანქანურ კოდში.
+ * @return bool false შეცდომისას ან x86-64-ის გარდა სხვა პლატფორმაზე (შეტყობინება დაბეჭდილია).
+ */
+bool jit_compile(AstNode* program, AstContext* ctx, JitProgram* jit);
+
+/**
+ * @brief ასრულებს კომპილირებულ პროგრამას.
+ * @return int გამოსვლის კოდი (0 წარმატებისას).
+ */
+int jit_run(JitProgram* jit);
+
+/** @brief ათავისუფლებს შესრულებად რეგიონს. */
+void jit_free(JitProgram* jit);
+
+#endif // JIT_H
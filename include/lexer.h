@@ -2,7 +2,7 @@
  * @file lexer.h
  * @author გიორგი მაღრაძე (magradze.giorgi@gmail.com)
  * @brief ლექსიკური ანალიზატორის (ლექსერის) დეკლარაციები.
- * @version 0.2
+ * @version 0.5
  * @date 2024-05-21
  *
  * @copyright Copyright (c) 2024
@@ -20,7 +20,7 @@
  */
 typedef enum {
     // ერთსიმბოლოიანი ტოკენები
-    TOKEN_LPAREN, TOKEN_RPAREN, TOKEN_COMMA, TOKEN_DOT, TOKEN_MINUS,
+    TOKEN_LPAREN, TOKEN_RPAREN, TOKEN_LBRACKET, TOKEN_RBRACKET, TOKEN_COMMA, TOKEN_DOT, TOKEN_MINUS,
     TOKEN_PLUS, TOKEN_SLASH, TOKEN_STAR, TOKEN_COLON,
 
     // ერთ ან ორსიმბოლოიანი ტოკენები
@@ -33,7 +33,7 @@ typedef enum {
     // საკვანძო სიტყვები (Keywords)
     TOKEN_თუ, TOKEN_სხვა, TOKEN_სხვა_თუ, TOKEN_და, TOKEN_ან, TOKEN_არ,
     TOKEN_ჭეშმარიტი, TOKEN_მცდარი, TOKEN_არარა, TOKEN_ფუნქცია, TOKEN_დაბრუნე,
-    TOKEN_სანამ, TOKEN_ყოველი, TOKEN_ში, TOKEN_ცვლადი, TOKEN_დაბეჭდე,
+    TOKEN_სანამ, TOKEN_ყოველი, TOKEN_ში, TOKEN_ცვლადი, TOKEN_დაბეჭდე, TOKEN_პარალელური,
 
     // Python-ის სტილის სინტაქსისთვის
     TOKEN_NEWLINE,    // ახალი ხაზის სიმბოლო (\n)
@@ -45,6 +45,11 @@ typedef enum {
     TOKEN_EOF         // ფაილის დასასრული (End Of File)
 } TokenType;
 
+// საკვანძო სიტყვების ტოკენების დიაპაზონი: ახალი საკვანძო სიტყვა მის შიგნით
+// ემატება, რომ check_keyword_table-მა და tools/keyword_hash-მა ის დაინახონ.
+#define TOKEN_FIRST_KEYWORD TOKEN_თუ
+#define TOKEN_LAST_KEYWORD TOKEN_პარალელური
+
 /**
  * @brief ტოკენის სტრუქტურა.
  */
@@ -64,6 +69,7 @@ typedef struct {
 typedef struct {
     const char* start;
     const char* current;
+    const char* end;         // საწყისი კოდის დასასრული (მის მიღმა არაფერი იკითხება)
     int line;
     bool at_start_of_line; // დროშა, რომელიც აღნიშნავს, ვართ თუ არა ხაზის დასაწყისში
     int indent_stack[MAX_INDENT_LEVELS]; // შეწევის დონეების დასტა (stack)
@@ -74,9 +80,10 @@ typedef struct {
 /**
  * @brief ლექსერის ინიციალიზაცია.
  * @param lexer ლექსერის ობიექტის მისამართი.
- * @param source დასამუშავებელი საწყისი კოდი.
+ * @param source დასამუშავებელი საწყისი კოდი (NUL-ით დასრულება საჭირო არ არის).
+ * @param length კოდის სიგრძე ბაიტებში.
  */
-void init_lexer(Lexer* lexer, const char* source);
+void init_lexer(Lexer* lexer, const char* source, size_t length);
 
 /**
  * @brief სკანირებს და აბრუნებს შემდეგ ტოკენს.
@@ -85,4 +92,25 @@ void init_lexer(Lexer* lexer, const char* source);
  */
 Token scan_token(Lexer* lexer);
 
+/**
+ * @brief ამოწმებს, არის თუ არა სახელი საკვანძო სიტყვა (ერთი ჰეში და ერთი შედარება).
+ * @param str სახელის UTF-8 ბაიტები.
+ * @param length სიგრძე ბაიტებში.
+ * @return TokenType საკვანძო სიტყვის ტოკენი ან TOKEN_IDENTIFIER.
+ */
+TokenType lookup_keyword(const char* str, int length);
+
+/**
+ * @brief ამოწმებს, რომ TOKEN_FIRST_KEYWORD..TOKEN_LAST_KEYWORD-ის ყოველი
+ * საკვანძო სიტყვა ჰეშის ცხრილის საკუთარ უჯრაშია და ცხრილში ზედმეტი ჩანაწერი
+ * არ არის. შეუსაბამობას stderr-ზე ბეჭდავს.
+ * @return bool true, თუ ყოველი საკვანძო სიტყვა ამოიცნობა.
+ */
+bool check_keyword_table(void);
+
+/**
+ * @brief აბრუნებს ტოკენის ტიპის სახელს (მაგ. "IDENTIFIER", "KEYWORD_თუ") დიაგნოსტიკისთვის.
+ */
+const char* token_type_name(TokenType type);
+
 #endif // LEXER_H
\ No newline at end of file
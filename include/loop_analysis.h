@@ -0,0 +1,62 @@
+/**
+ * @file loop_analysis.h
+ * @author გიორგი მაღრაძე (magradze.giorgi@gmail.com)
+ * @brief `ყოველი` ციკლის იტერაციების დამოუკიდებლობის ანალიზის დეკლარაციები.
+ * @version 0.1
+ *
+ * ანალიზი ადგენს, შეიძლება თუ არა ციკლის იტერაციების ერთდროულად
+ * შესრულება: C ბექენდი მას `#pragma omp simd`-ისა და `პარალელური ყოველი`-ს
+ * გენერაციისას იყენებს, ტიპების გამოყვანა კი — `პარალელური ყოველი`-ს
+ * შეცდომების დასაბეჭდად. სხეულში დასაშვებია მხოლოდ გვერდითი ეფექტების
+ * გარეშე რიცხვითი გამოთვლა (გამოძახების, ბეჭდვისა და ჰიპის მნიშვნელობის
+ * გარეშე); გარე ცვლადს მხოლოდ მთელი ჯამის, მინიმუმის ან მაქსიმუმის
+ * რედუქცია შეიძლება ცვლიდეს, რომელიც ცვლადს სხვაგან არ კითხულობს. მთელი
+ * ჯამი ასოციაციურია, ამიტომ შედეგი რიგითობისგან დამოუკიდებელია; ათწილადი
+ * აკუმულატორი ბიტ-ბიტ სიზუსტისთვის თანმიმდევრული რჩება.
+ * ანალიზი value_type ველებს კითხულობს, ამიტომ infer_types()-ის შემდეგ სრულდება.
+ */
+#ifndef LOOP_ANALYSIS_H
+#define LOOP_ANALYSIS_H
+
+#include "ast.h"
+
+/** @brief ციკლის სხეულის ცვლადის როლი. */
+typedef enum {
+    LOOP_VARIABLE_NONE,        // გარე ცვლადი, რომელსაც სხეული მხოლოდ კითხულობს
+    LOOP_VARIABLE_PRIVATE,     // სხეულში ცხადდება (ან ჩადგმული ციკლის ცვლადია): ყოველ იტერაციას საკუთარი ასლი აქვს
+    LOOP_VARIABLE_REDUCTION,   // გარე ცვლადი, რომელსაც მხოლოდ რედუქცია ცვლის
+} LoopVariableRole;
+
+/** @brief სხეულის ცვლადის ანალიზის ჩანაწერი. */
+typedef struct {
+    Symbol* name;
+    LoopVariableRole role;
+    const char* operation;     // რედუქციის ოპერაცია ("+", "min", "max"); NULL — არ არის
+    int assignments;
+    int reads;
+    ValueType type;            // წაკითხვის C ტიპი (გარე ცვლადის დასაჭერად)
+} LoopVariable;
+
+/** @brief ანალიზის შედეგი: სხეულის ცვლადები პირველი გამოჩენის რიგით. */
+typedef struct {
+    LoopVariable* variables;
+    int count;
+    int capacity;
+    const char* failure;       // რატომ არ არის იტერაციები დამოუკიდებელი (დიაგნოსტიკა); NULL — არიან
+    Symbol* culprit;           // ცვლადი, რომლის ცვლილებაც დაუშვებელია (სხვა მიზეზისას NULL)
+} LoopAnalysis;
+
+/**
+ * @brief აანალიზებს `ყოველი` (ან `პარალელური ყოველი`) კვანძის სხეულს.
+ * @param walk ქვეხის გასავლელი სტეკი (ცარიელი).
+ * @param nested_loops ჩადგმული ციკლები დასაშვებია: ისინი იტერაციის შიგნით
+ * თანმიმდევრულად სრულდება (ნაკადებისთვის — კი, SIMD ზოლებისთვის — არა).
+ * @return bool true, თუ იტერაციები დამოუკიდებელია; წინააღმდეგ შემთხვევაში
+ * analysis->failure მიზეზს აღწერს.
+ */
+bool analyze_loop(AstNode* node, AstStack* walk, bool nested_loops, LoopAnalysis* analysis);
+
+/** @brief ათავისუფლებს ანალიზის ცვლადების სიას. */
+void free_loop_analysis(LoopAnalysis* analysis);
+
+#endif // LOOP_ANALYSIS_H
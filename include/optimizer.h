@@ -0,0 +1,48 @@
+/**
+ * @file optimizer.h
+ * @author გიორგი მაღრაძე (magradze.giorgi@gmail.com)
+ * @brief AST-ის ოპტიმიზაციის (მუდმივების დაკეცვა/გავრცელება) დეკლარაციები.
+ * @version 0.1
+ *
+ * ოპტიმიზატორი პარსინგსა და ნებისმიერ ბექენდს (C, ბაიტკოდი, JIT) შორის
+ * სრულდება. ის საწყის ხეს არ ცვლის: შეცვლილი ქვეხეები ახალ კვანძებად
+ * იქმნება იმავე არენაში, უცვლელი ქვეხეები კი ორივე ხეს შორის საერთოა.
+ * ყველა გარდაქმნა IEEE-754 სემანტიკას ინარჩუნებს.
+ */
+#ifndef OPTIMIZER_H
+#define OPTIMIZER_H
+
+#include <stdio.h>
+#include "ast.h"
+
+/** @brief ოპტიმიზაციის ეტაპები (სტატისტიკის ინდექსები). */
+typedef enum {
+    OPT_PASS_PROPAGATE,    // უცვლელი ცვლადის მუდმივი მნიშვნელობის ჩასმა
+    OPT_PASS_FOLD,         // მუდმივი ქვეხეების გამოთვლა
+    OPT_PASS_SIMPLIFY,     // ალგებრული იგივეობები (x*1, x/1, x-0, --x)
+    OPT_PASS_COUNT
+} OptimizerPass;
+
+/** @brief ოპტიმიზაციის სტატისტიკა. */
+typedef struct {
+    int rewrites[OPT_PASS_COUNT];   // თითოეული ეტაპის გარდაქმნების რაოდენობა
+    int nodes_before;               // კვანძები ოპტიმიზაციამდე
+    int nodes_after;                // კვანძები ოპტიმიზაციის შემდეგ
+} OptimizerStats;
+
+/**
+ * @brief ოპტიმიზაციას უკეთებს პროგრამას.
+ * @param program NODE_PROGRAM კვანძი (არ იცვლება).
+ * @param ctx AST კონტექსტი, რომლის არენაშიც ახალი კვანძები იქმნება.
+ * @param stats შესავსები სტატისტიკა (შეიძლება იყოს NULL).
+ * @return AstNode* ოპტიმიზირებული პროგრამა.
+ */
+AstNode* optimize_program(AstNode* program, AstContext* ctx, OptimizerStats* stats);
+
+/** @brief აბრუნებს ეტაპის სახელს სტატისტიკის ბეჭდვისთვის. */
+const char* optimizer_pass_name(OptimizerPass pass);
+
+/** @brief ბეჭდავს ოპტიმიზაციის სტატისტიკას. */
+void print_optimizer_stats(const OptimizerStats* stats, FILE* out);
+
+#endif // OPTIMIZER_H
@@ -2,7 +2,7 @@
 * @file parser.h
  * @author გიორგი მაღრაძე (magradze.giorgi@gmail.com)
  * @brief სინტაქსური ანალიზატორის (პარსერის) დეკლარაციები.
- * @version 0.1
+ * @version 0.4
  * @date 2024-05-21
  *
  * @copyright Copyright (c) 2024
@@ -13,15 +13,23 @@
 #define PARSER_H
 
 #include "lexer.h"
+#include "token_stream.h"
 #include "ast.h"
 
+/** @brief გამოსახულების ჩადგმულობის ნაგულისხმევი ზღვარი (იხ. Parser.max_depth). */
+#define PARSER_DEFAULT_MAX_DEPTH 100000
+
 /**
  * @brief პარსერის სტრუქტურა, რომელიც ინახავს პარსინგის მდგომარეობას.
  */
 typedef struct {
     Lexer* lexer;          // ლექსერის მისამართი, საიდანაც ვიღებთ ტოკენებს
+    TokenStream* tokens;   // წინასწარ დასკანერებული ნაკადი (NULL, თუ ტოკენებს ლექსერიდან ვიღებთ)
+    int position;          // შემდეგი წასაკითხი ტოკენის ინდექსი ნაკადში
+    AstContext* ast;       // კონტექსტი, რომლის არენიდანაც იქმნება კვანძები
     Token current;         // მიმდინარე ტოკენი
     Token previous;        // წინა ტოკენი
+    int max_depth;         // გამოსახულების მაქსიმალური ჩადგმულობა; მარცხენა ოპერანდი მას არ ზრდის (init-ის შემდეგ შეიძლება შეიცვალოს)
     bool had_error;        // დროშა, რომელიც აღნიშნავს, მოხდა თუ არა სინტაქსური შეცდომა
     bool panic_mode;       // პანიკის რეჟიმი შეცდომების შემდეგ აღდგენისთვის
 } Parser;
@@ -30,8 +38,25 @@ typedef struct {
  * @brief პარსერის ინიციალიზაცია.
  * @param parser პარსერის ობიექტის მისამართი.
  * @param lexer ინიციალიზებული ლექსერის მისამართი.
+ * @param ast AST კონტექსტი, რომელიც ფლობს აგებულ კვანძებს.
+ */
+void init_parser(Parser* parser, Lexer* lexer, AstContext* ast);
+
+/**
+ * @brief პარსერის ინიციალიზაცია წინასწარ დასკანერებული ნაკადით.
+ * ამ რეჟიმში პარსერი ტოკენებს ნაკადის მასივებიდან კითხულობს და შეცდომებისას
+ * ბეჭდავს საწყისი კოდის შესაბამის ხაზს.
+ * @param parser პარსერის ობიექტის მისამართი.
+ * @param tokens `lex_all`-ით შევსებული ნაკადი.
+ * @param ast AST კონტექსტი, რომელიც ფლობს აგებულ კვანძებს.
+ */
+void init_parser_from_stream(Parser* parser, TokenStream* tokens, AstContext* ast);
+
+/**
+ * @brief პარსერის ინიციალიზაცია ნაკადის `index`-ე ტოკენიდან. ინკრემენტული
+ * პარსინგი ასე იწყებს ცალკეული განცხადებების ხელახლა არჩევას.
  */
-void init_parser(Parser* parser, Lexer* lexer);
+void init_parser_at(Parser* parser, TokenStream* tokens, int index, AstContext* ast);
 
 /**
  * @brief არჩევს ტოკენების ნაკადს და აბრუნებს აგებულ AST-ს.
@@ -40,4 +65,16 @@ void init_parser(Parser* parser, Lexer* lexer);
  */
 AstNode* parse(Parser* parser);
 
+/**
+ * @brief არჩევს ერთ უმაღლესი დონის დეკლარაციას. შეცდომისას ტოკენებს
+ * მომდევნო ხაზამდე გამოტოვებს, ასე რომ შემდეგი გამოძახება ახალ განცხადებას იწყებს.
+ * @return AstNode* განცხადება. NULL, თუ ის შეცდომით დასრულდა.
+ */
+AstNode* parse_declaration(Parser* parser);
+
+/** @brief აბრუნებს მიმდინარე (ჯერ მოუხმარებელი) ტოკენის ინდექსს ნაკადში. */
+static inline int parser_position(const Parser* parser) {
+    return parser->position - 1;
+}
+
 #endif // PARSER_H
\ No newline at end of file
@@ -1,18 +1,607 @@
 /**
-* @file runtime.h
+ * @file runtime.h
  * @author გიორგი მაღრაძე (magradze.giorgi@gmail.com)
  * @brief "მანუსკრიპტი" ენის დამხმარე (runtime) ფუნქციების დეკლარაციები.
- * @version 0.1
- * @date 2024-05-21
+ * @version 0.13
  *
- * @copyright Copyright (c) 2024
- * Website: https://magradze.dev
- * GitHub: https://github.com/magradze
+ * დინამიური მნიშვნელობა (MsValue) ერთ 64-ბიტიან სიტყვაშია შეფუთული
+ * (NaN-boxing). ნებისმიერი double, რომელიც "ჩუმი" NaN-ის ნიმუშს არ
+ * ემთხვევა, თავისი ბიტებით ინახება; დანარჩენი ტიპები ამ ნიმუშის შიგნით
+ * ცხოვრობენ:
+ *
+ *   რიცხვი        — ჩვეულებრივი double (NaN-ები კანონიკურ ფორმაზე დაიყვანება);
+ *   არარა/ლოგიკური — MS_QNAN | 1..3;
+ *   მოკლე სტრიქონი — MS_QNAN | MS_SMALL_STRING_BIT | <=6 ბაიტი (NUL-ით შევსებული);
+ *   ობიექტი      — MS_SIGN_BIT | MS_QNAN | 48-ბიტიანი მაჩვენებელი.
+ *
+ * სტრიქონი, რომელიც <=6 ბაიტია და NUL-ს არ შეიცავს, ყოველთვის მოკლე
+ * ფორმითაა (გამოყოფის გარეშე), ამიტომ ასეთი სტრიქონების ტოლობა სიტყვების
+ * შედარებაა. ლიტერალები კომპილაციისას სტატიკურ ცხრილში ინტერნირდება და
+ * მათი ტოლობა მაჩვენებლების შედარებაა. `+` გრძელ სტრიქონებზე თოკს (rope)
+ * აგებს, რომელიც საჭიროებისას ერთხელ "გაბრტყელდება", ასე რომ ციკლში
+ * მიმატება კვადრატული არ ხდება.
+ *
+ * მასივი (MsArray) რიცხვების უწყვეტი ბუფერია: მთელი (int64_t) ან
+ * ნამდვილი (double) ელემენტებით, 64 ბაიტზე გასწორებული. ბუფერი GC ჰიპის
+ * გარეთაა და ობიექტთან ერთად თავისუფლდება; ელემენტები მაჩვენებლები არ
+ * არის, ამიტომ მასივის შეცვლა თაობებიან შემგროვებელს ბარიერს არ სჭირდება.
+ * ელემენტებზე არითმეტიკა (array.c) SIMD ბირთვებით სრულდება.
+ *
+ * `პარალელური ყოველი`-ს სხეული ცალკე C ფუნქციად გამოიტანება და
+ * ms_parallel_for-ით ნაკადების აუზზე სრულდება (parallel.c). სხეული ჰიპს
+ * არ ეხება, ამიტომ შემგროვებელი ერთნაკადიანი რჩება.
+ *
+ * ობიექტებს თაობებიანი შემგროვებელი (gc.c) მართავს: ახალი ობიექტები
+ * ბაგის (nursery) არეში bump-ით გამოიყოფა, გადარჩენილები კი ძველ თაობაში
+ * გადაიტანება, რომელიც ადგილზე (გადატანის გარეშე) mark-sweep-ით იწმინდება.
+ * შეგროვება მხოლოდ უსაფრთხო წერტილებში (ms_gc_safepoint) ხდება, სადაც
+ * ყველა ცოცხალი მნიშვნელობა რეგისტრირებულ ფესვებშია. ფუნქციის
+ * გამოძახება, რომლის დროსაც გამომძახებლის დროებით მნიშვნელობებს ფესვები
+ * არ აქვს, ms_gc_defer_depth-ით გადადებს შეგროვებას, სანამ ის არ დაბრუნდება.
+ *
+ * ფაილი გენერირებულ C კოდშიც ჩაირთვება, ამიტომ ის თვითკმარია და ცხელი
+ * გზები (ტიპის შემოწმება, რიცხვითი არითმეტიკა) static inline-ია. ნელი
+ * გზები runtime.c-შია (libmanuscript_rt.a).
  */
 #ifndef RUNTIME_H
 #define RUNTIME_H
 
-// მომავალში აქ დაემატება ისეთი ფუნქციების დეკლარაციები, როგორიცაა `დაბეჭდე`,
-// დინამიური ტიპების სტრუქტურები და მათი მართვა.
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+/** @brief დინამიური მნიშვნელობა. */
+typedef uint64_t MsValue;
+
+#define MS_SIGN_BIT      ((uint64_t)0x8000000000000000ULL)
+#define MS_QNAN          ((uint64_t)0x7ffc000000000000ULL)
+#define MS_CANONICAL_NAN ((uint64_t)0x7ff8000000000000ULL)
+
+#define MS_TAG_NONE  1
+#define MS_TAG_FALSE 2
+#define MS_TAG_TRUE  3
+
+#define MS_SMALL_STRING_BIT ((uint64_t)0x0002000000000000ULL)
+#define MS_SMALL_STRING_MAX 6
+
+#define MS_NONE  ((MsValue)(MS_QNAN | MS_TAG_NONE))
+#define MS_FALSE ((MsValue)(MS_QNAN | MS_TAG_FALSE))
+#define MS_TRUE  ((MsValue)(MS_QNAN | MS_TAG_TRUE))
+
+/** @brief ჰიპ-ობიექტის სახეობა. */
+typedef enum {
+    MS_OBJ_STRING,       // ბრტყელი სტრიქონი (MsString)
+    MS_OBJ_ROPE,         // ორი სტრიქონის შეერთება (MsRope)
+    MS_OBJ_ARRAY,        // რიცხვების მასივი (MsArray)
+} MsObjectType;
+
+#define MS_FLAG_STATIC   1u   // სტატიკური მეხსიერება (ლიტერალების ცხრილი), არ თავისუფლდება
+#define MS_FLAG_INTERNED 2u   // თითო შიგთავსზე ერთი ობიექტი: ტოლობა მაჩვენებლების შედარებაა
+#define MS_FLAG_MARKED   4u   // GC: მიღწევადია (დიდი შეგროვების დროს)
+#define MS_FLAG_FORWARDED 8u  // GC: ბაგიდან გადატანილია; ახალი მისამართი სათაურის შემდეგაა
+
+/** @brief ყველა ჰიპ-ობიექტის საერთო სათაური. */
+typedef struct MsObject {
+    uint32_t type;       // MsObjectType
+    uint32_t flags;      // MS_FLAG_*
+} MsObject;
+
+/** @brief ბრტყელი სტრიქონი. */
+typedef struct {
+    MsObject object;
+    size_t length;
+    const char* chars;   // ლიტერალისთვის — C სტრიქონი, სხვა შემთხვევაში — ობიექტის ბოლოში
+} MsString;
+
+/** @brief შეერთება, რომელიც ბაიტებს არ აკოპირებს, სანამ ისინი არ დასჭირდება. */
+typedef struct {
+    MsObject object;
+    size_t length;
+    MsValue left;
+    MsValue right;
+    MsValue flat;        // გაბრტყელებული ასლი (MS_NONE — ჯერ არ შექმნილა)
+} MsRope;
+
+/** @brief მასივის ელემენტების წარმოდგენა. */
+typedef enum {
+    MS_ARRAY_INT,        // int64_t, ყველა ელემენტი ms_fits_int()-ს აკმაყოფილებს
+    MS_ARRAY_DOUBLE,     // double
+} MsArrayKind;
+
+/**
+ * @brief მასივის ელემენტების უდიდესი რაოდენობა (2^40, 8 TB). ტიპების გამოყვანა
+ * (TYPE_ARRAY_MAX_LENGTH) მასივის `ყოველი`-ს იტერაციების რაოდენობას ამით ზღუდავს.
+ */
+#define MS_ARRAY_MAX_LENGTH ((int64_t)1 << 40)
+
+/** @brief მასივის ბუფერის გასწორება ბაიტებში (ქეშის ხაზი, AVX-512-ის ჩათვლით). */
+#define MS_ARRAY_ALIGNMENT 64
+
+/** @brief რიცხვების მასივი; `data` GC ჰიპის გარეთაა (aligned_alloc). */
+typedef struct {
+    MsObject object;
+    uint32_t kind;       // MsArrayKind
+    size_t length;
+    size_t capacity;
+    void* data;          // int64_t[capacity] ან double[capacity]; ცარიელისთვის NULL
+} MsArray;
+
+/** @brief ინტერნირებული ლიტერალის ინიციალიზატორი გენერირებული კოდის ცხრილისთვის. */
+#define MS_STRING_LITERAL(text, length) { { MS_OBJ_STRING, MS_FLAG_STATIC | MS_FLAG_INTERNED }, (length), (text) }
+
+// --- შეფუთვა და ტიპის შემოწმება ---
+
+static inline bool ms_is_number(MsValue value) { return (value & MS_QNAN) != MS_QNAN; }
+static inline bool ms_is_none(MsValue value) { return value == MS_NONE; }
+static inline bool ms_is_bool(MsValue value) { return (value | 1) == MS_TRUE; }
+static inline bool ms_is_object(MsValue value) { return (value & (MS_QNAN | MS_SIGN_BIT)) == (MS_QNAN | MS_SIGN_BIT); }
+
+/**
+ * @brief ფუთავს double-ს. NaN-ის payload-ი შეიძლება ტეგს დაემთხვეს,
+ * ამიტომ ყველა NaN კანონიკურ ფორმაზე (ნიშნის შენარჩუნებით) დაიყვანება.
+ */
+static inline MsValue ms_number(double number) {
+    MsValue value;
+    memcpy(&value, &number, sizeof(value));
+    if (number != number) value = MS_CANONICAL_NAN | (value & MS_SIGN_BIT);
+    return value;
+}
+
+static inline double ms_as_number(MsValue value) {
+    double number;
+    memcpy(&number, &value, sizeof(number));
+    return number;
+}
+
+static inline MsValue ms_bool(bool flag) { return flag ? MS_TRUE : MS_FALSE; }
+static inline bool ms_as_bool(MsValue value) { return value == MS_TRUE; }
+
+static inline MsValue ms_object(MsObject* object) { return MS_SIGN_BIT | MS_QNAN | (uint64_t)(uintptr_t)object; }
+static inline MsObject* ms_as_object(MsValue value) { return (MsObject*)(uintptr_t)(value & ~(MS_SIGN_BIT | MS_QNAN)); }
+
+// --- სტრიქონები ---
+
+static inline bool ms_is_small_string(MsValue value) {
+    return (value & (MS_SIGN_BIT | MS_QNAN | MS_SMALL_STRING_BIT)) == (MS_QNAN | MS_SMALL_STRING_BIT);
+}
+
+/** @brief ეტევა თუ არა სტრიქონი მოკლე ფორმაში (NUL ბაიტი სიგრძის ნიშანია). */
+static inline bool ms_fits_small_string(const char* chars, size_t length) {
+    return length <= MS_SMALL_STRING_MAX && memchr(chars, '\0', length) == NULL;
+}
+
+/** @brief ფუთავს მოკლე სტრიქონს; ms_fits_small_string() უნდა იყოს ჭეშმარიტი. */
+static inline MsValue ms_small_string(const char* chars, size_t length) {
+    uint64_t payload = 0;
+    for (size_t i = 0; i < length; i++) payload |= (uint64_t)(uint8_t)chars[i] << (8 * i);
+    return MS_QNAN | MS_SMALL_STRING_BIT | payload;
+}
+
+static inline size_t ms_small_string_length(MsValue value) {
+    size_t length = 0;
+    while (length < MS_SMALL_STRING_MAX && ((value >> (8 * length)) & 0xFF) != 0) length++;
+    return length;
+}
+
+static inline bool ms_is_string(MsValue value) {
+    if (ms_is_small_string(value)) return true;
+    if (!ms_is_object(value)) return false;
+    uint32_t type = ms_as_object(value)->type;
+    return type == MS_OBJ_STRING || type == MS_OBJ_ROPE;
+}
+
+static inline MsValue ms_string_value(MsString* string) { return ms_object(&string->object); }
+
+// --- მასივები ---
+
+static inline bool ms_is_array(MsValue value) {
+    return ms_is_object(value) && ms_as_object(value)->type == MS_OBJ_ARRAY;
+}
+
+static inline MsArray* ms_as_array(MsValue value) { return (MsArray*)ms_as_object(value); }
+
+/** @brief `capacity` ელემენტის ბუფერის ზომა, MS_ARRAY_ALIGNMENT-ის ჯერადი (aligned_alloc-ის მოთხოვნა). */
+static inline size_t ms_array_data_bytes(size_t capacity) {
+    return (capacity * 8 + MS_ARRAY_ALIGNMENT - 1) & ~(size_t)(MS_ARRAY_ALIGNMENT - 1);
+}
+
+/** @brief ეტევა თუ არა რიცხვი მთელ მასივში უდანაკარგოდ (მთელია, |x| <= 2^53 და არა -0.0). */
+static inline bool ms_fits_int(double number) {
+    return number >= -9007199254740992.0 && number <= 9007199254740992.0 &&
+           (double)(int64_t)number == number && ms_number(number) != MS_SIGN_BIT;
+}
+
+/** @brief `ა[ი]` ნელი გზა: არამასივი ან საზღვრებს გარეთ ინდექსი (შეცდომაა). */
+double ms_array_get_slow(MsValue value, int64_t index);
+
+/** @brief `ა[ი] = x` ნელი გზა: შეცდომები და მთელი მასივის ნამდვილზე გადაყვანა. */
+void ms_array_set_slow(MsValue value, int64_t index, double element);
+
+/** @brief არამთელი ინდექსი: მთელი მნიშვნელობის შემთხვევაში აბრუნებს, სხვა შემთხვევაში შეცდომაა. */
+int64_t ms_index_slow(double number);
+
+/** @brief ინდექსი double-იდან. */
+static inline int64_t ms_index(double number) {
+    if (number > -9007199254740992.0 && number < 9007199254740992.0) {
+        int64_t index = (int64_t)number;
+        if ((double)index == number) return index;
+    }
+    return ms_index_slow(number);
+}
+
+/** @brief ინდექსი დინამიური მნიშვნელობიდან (არარიცხვი შეცდომაა). */
+int64_t ms_index_value(MsValue value);
+
+/** @brief მასივის ელემენტი დინამიური მნიშვნელობიდან (არარიცხვი შეცდომაა). */
+double ms_element_value(MsValue value);
+
+static inline double ms_array_get(MsValue value, int64_t index) {
+    if (ms_is_array(value)) {
+        MsArray* array = ms_as_array(value);
+        if ((uint64_t)index < array->length) {
+            if (array->kind == MS_ARRAY_INT) return (double)((const int64_t*)array->data)[index];
+            return ((const double*)array->data)[index];
+        }
+    }
+    return ms_array_get_slow(value, index);
+}
+
+static inline void ms_array_set(MsValue value, int64_t index, double element) {
+    if (ms_is_array(value)) {
+        MsArray* array = ms_as_array(value);
+        if ((uint64_t)index < array->length) {
+            if (array->kind == MS_ARRAY_DOUBLE) {
+                ((double*)array->data)[index] = element;
+                return;
+            }
+            if (ms_fits_int(element)) {
+                ((int64_t*)array->data)[index] = (int64_t)element;
+                return;
+            }
+        }
+    }
+    ms_array_set_slow(value, index, element);
+}
+
+/**
+ * @brief ჭეშმარიტია, თუ `value` `kind` სახის მასივია და [start, end) მის
+ * საზღვრებშია: ინდექსების ციკლის ბირთვი მაშინ ბუფერს პირდაპირ ინდექსირებს.
+ */
+static inline bool ms_array_spans(MsValue value, uint32_t kind, int64_t start, int64_t end) {
+    return ms_is_array(value) && ms_as_array(value)->kind == kind && start >= 0 &&
+           end <= (int64_t)ms_as_array(value)->length;
+}
+
+/** @brief მასივის ლიტერალი მთელი ელემენტებით (`items`-ის ასლი). */
+MsValue ms_array_from_int(size_t count, const int64_t* items);
+
+/** @brief მასივის ლიტერალი ნამდვილი ელემენტებით (`items`-ის ასლი). */
+MsValue ms_array_from_double(size_t count, const double* items);
+
+/** @brief `მასივი(n)`: n ნულისგან შემდგარი მასივი. */
+MsValue ms_array_new(int64_t length);
+
+/** @brief `სიგრძე(x)`: მასივის ელემენტების ან სტრიქონის ბაიტების რაოდენობა. */
+int64_t ms_length(MsValue value);
+
+/** @brief `ყოველი ე ში ა:`: ამოწმებს, რომ ა მასივია, და აბრუნებს მას. */
+MsValue ms_array_iterable(MsValue value);
+
+/** @brief `დაამატე(ა, x)`: ამატებს ელემენტს ბოლოში (ამორტიზებული O(1)) და აბრუნებს არარას. */
+MsValue ms_push(MsValue value, double element);
+
+/** @brief `ჯამი(ა)`. */
+double ms_sum(MsValue value);
+
+/** @brief `მინიმუმი(ა)`; ცარიელი მასივი შეცდომაა. */
+double ms_min(MsValue value);
+
+/** @brief `მაქსიმუმი(ა)`; ცარიელი მასივი შეცდომაა. */
+double ms_max(MsValue value);
+
+/**
+ * @brief `ჯამი(ა)` მთელ მასივზე (ტიპების გამოყვანამ ა მთელ მასივად იცნო):
+ * ზუსტი მთელი ჯამი; ±2^53-ს მიღმა ის double-ად ზუსტად აღარ გამოისახება,
+ * ამიტომ ეს გაშვების შეცდომაა.
+ */
+int64_t ms_sum_int(MsValue value);
+
+/** @brief `მინიმუმი(ა)` მთელ მასივზე. */
+int64_t ms_min_int(MsValue value);
+
+/** @brief `მაქსიმუმი(ა)` მთელ მასივზე. */
+int64_t ms_max_int(MsValue value);
+
+/** @brief `სკალარული(ა, ბ)`: ტოლი სიგრძის მასივების სკალარული ნამრავლი. */
+double ms_dot(MsValue left, MsValue right);
+
+/** @brief ელემენტებზე ოპერაცია: მასივი და მასივი (ტოლი სიგრძის) ან მასივი და რიცხვი. */
+MsValue ms_array_binary(char op, MsValue left, MsValue right);
+
+/** @brief ერთმაგი მინუსი მასივის ყველა ელემენტზე. */
+MsValue ms_array_negate(MsValue value);
+
+/** @brief ჭეშმარიტობა: მცდარი, არარა, ნული და ცარიელი სტრიქონი მცდარია, დანარჩენი — ჭეშმარიტი. */
+static inline bool ms_truthy(MsValue value) {
+    if (ms_is_number(value)) return ms_as_number(value) != 0.0;
+    return value != MS_FALSE && value != MS_NONE && value != (MS_QNAN | MS_SMALL_STRING_BIT);
+}
+
+// --- ნელი გზები (runtime.c) ---
+
+/** @brief აბრუნებს მნიშვნელობის ტიპის სახელს შეცდომის შეტყობინებებისთვის. */
+const char* ms_type_name(MsValue value);
+
+/** @brief ბეჭდავს გაშვების შეცდომას და ასრულებს პროგრამას. */
+_Noreturn void ms_type_error(const char* message);
+
+/**
+ * @brief ms_add_int/ms_sub_int-ის ნელი გზა: შედეგი ±2^53-ს სცდება, ამიტომ
+ * უახლოეს double-მდე მრგვალდება. მრგვალებული მნიშვნელობა მთელია და
+ * int64_t-ში ზუსტად ინახება; ±2^63-ის მიღმა პროგრამა შეცდომით სრულდება.
+ */
+int64_t ms_promote_int(double value);
+
+/**
+ * @brief ორობითი ოპერაცია არარიცხვით ოპერანდებზე. `op` არის '+', '-',
+ * '*' ან '/'. დაუშვებელი კომბინაცია პროგრამას შეცდომით ასრულებს.
+ */
+MsValue ms_binary_slow(char op, MsValue left, MsValue right);
+
+/** @brief `ყოველი`-ს არარიცხვითი დიაპაზონის საზღვარი: პროგრამას შეცდომით ასრულებს. */
+double ms_range_bound_slow(MsValue value);
+
+/** @brief ერთმაგი მინუსი არარიცხვით ოპერანდზე (მასივის გარდა შეცდომაა). */
+MsValue ms_negate_slow(MsValue value);
+
+/** @brief ბეჭდავს მნიშვნელობას ახალი ხაზით (`დაბეჭდე`). */
+void ms_print(MsValue value);
+
+/** @brief ბეჭდავს მთელ ცვლადს: ±2^53-ის მიღმა (double-ზე გადასული) — ათწილადივით. */
+void ms_print_int(int64_t value);
+
+/** @brief ქმნის სტრიქონს ბაიტების ასლით (მოკლე ფორმით, თუ ეტევა). */
+MsValue ms_string_from(const char* chars, size_t length);
+
+/** @brief აბრუნებს სტრიქონის სიგრძეს ბაიტებში. */
+size_t ms_string_length(MsValue value);
+
+/** @brief აერთებს ორ სტრიქონს; გრძელი შედეგი თოკია და ბაიტებს არ აკოპირებს. */
+MsValue ms_concat(MsValue left, MsValue right);
+
+/** @brief ტოლობა, როცა სწრაფმა გზამ პასუხი ვერ გასცა (შიგთავსის შედარება). */
+bool ms_equals_slow(MsValue left, MsValue right);
+
+/**
+ * @brief ტოლობა (`==`). ერთნაირი სიტყვა — ტოლია (რიცხვების გარდა, NaN-ის
+ * გამო); ორი სხვადასხვა ინტერნირებული ობიექტი — განსხვავებულია.
+ */
+static inline bool ms_equals(MsValue left, MsValue right) {
+    if (ms_is_number(left) && ms_is_number(right)) return ms_as_number(left) == ms_as_number(right);
+    if (left == right) return true;
+    if (ms_is_object(left) && ms_is_object(right) &&
+        (ms_as_object(left)->flags & ms_as_object(right)->flags & MS_FLAG_INTERNED)) {
+        return false;
+    }
+    return ms_equals_slow(left, right);
+}
+
+/**
+ * @brief რიგის შედარება, როცა ერთ-ერთი ოპერანდი რიცხვი არ არის: ორი
+ * სტრიქონი ბაიტების ლექსიკოგრაფიული რიგით დარდება (უარყოფითი, ნული ან
+ * დადებითი შედეგი), სხვა კომბინაცია `op`-ის შეცდომით ასრულებს პროგრამას.
+ */
+int ms_compare_slow(const char* op, MsValue left, MsValue right);
+
+static inline bool ms_less(MsValue left, MsValue right) {
+    if (ms_is_number(left) && ms_is_number(right)) return ms_as_number(left) < ms_as_number(right);
+    return ms_compare_slow("<", left, right) < 0;
+}
+
+static inline bool ms_less_equal(MsValue left, MsValue right) {
+    if (ms_is_number(left) && ms_is_number(right)) return ms_as_number(left) <= ms_as_number(right);
+    return ms_compare_slow("<=", left, right) <= 0;
+}
+
+static inline bool ms_greater(MsValue left, MsValue right) {
+    if (ms_is_number(left) && ms_is_number(right)) return ms_as_number(left) > ms_as_number(right);
+    return ms_compare_slow(">", left, right) > 0;
+}
+
+static inline bool ms_greater_equal(MsValue left, MsValue right) {
+    if (ms_is_number(left) && ms_is_number(right)) return ms_as_number(left) >= ms_as_number(right);
+    return ms_compare_slow(">=", left, right) >= 0;
+}
+
+// --- მეხსიერების მართვა (gc.c) ---
+
+/** @brief შემგროვებლის სტატისტიკა. */
+typedef struct {
+    uint64_t allocations;        // გამოყოფილი ობიექტების რაოდენობა
+    uint64_t allocated_bytes;    // გამოყოფილი ბაიტები ჯამში
+    uint64_t promoted_bytes;     // ძველ თაობაში გადატანილი ბაიტები
+    uint64_t freed_bytes;        // დიდი შეგროვებებით გათავისუფლებული ბაიტები
+    uint64_t minor_collections;
+    uint64_t major_collections;
+    uint64_t peak_heap_bytes;    // ბაგის დაკავებული ნაწილი + ძველი თაობა, მაქსიმუმი
+    double total_pause_ms;
+    double max_pause_ms;
+    double elapsed_seconds;      // ჰიპის ინიციალიზაციიდან გასული დრო
+} MsGcStats;
+
+/** @brief ჭეშმარიტია, როცა ბაგი შეივსო ან ძველი თაობა ზღვარს გასცდა. */
+extern bool ms_gc_pending;
+
+/** @brief გამოყოფს ახალ ობიექტს ბაგში (თუ ადგილი აღარაა — ძველ თაობაში). */
+void* ms_gc_alloc(size_t size);
+
+/**
+ * @brief გამოყოფს ობიექტს პირდაპირ ძველ თაობაში. გამოიყენება, როცა ძველი
+ * ობიექტი ახალს მიუთითებს (მაგ. თოკის გაბრტყელება), რომ ძველი → ახალი
+ * მაჩვენებელი არ გაჩნდეს.
+ */
+void* ms_gc_alloc_tenured(size_t size);
+
+/** @brief არეგისტრირებს ახალი მასივის ბუფერს: ის ობიექტის სიკვდილისას თავისუფლდება. */
+void ms_gc_track_array(MsArray* array);
+
+/** @brief მასივის ბუფერი `old_capacity`-დან მის ამჟამინდელ capacity-მდე გაიზარდა. */
+void ms_gc_array_resized(MsArray* array, size_t old_capacity);
+
+/** @brief ეკუთვნის თუ არა ობიექტი ბაგს. */
+bool ms_gc_is_young(const MsObject* object);
+
+/** @brief არეგისტრირებს ცვლადს ფესვად; შემგროვებელი მის მნიშვნელობას ანახლებს. */
+void ms_gc_add_root(MsValue* slot);
+
+/** @brief აბრუნებს ფესვების დასტის ამჟამინდელ სიმაღლეს (ფუნქციის ჩარჩოსთვის). */
+size_t ms_gc_root_mark(void);
+
+/** @brief შლის `mark`-ის შემდეგ დარეგისტრირებულ ფესვებს. */
+void ms_gc_release_roots(size_t mark);
+
+/** @brief ასრულებს შეგროვებას (მცირეს და, საჭიროებისას, დიდს). */
+void ms_gc_collect(void);
+
+/** @brief ავსებს სტატისტიკას. */
+void ms_gc_stats(MsGcStats* stats);
+
+/**
+ * @brief 0-ზე მეტი, სანამ გამოძახება გამოსახულების შუაშია და გამომძახებლის
+ * დროებითი მნიშვნელობები ფესვებში არაა: უსაფრთხო წერტილები მაშინ შეგროვებას
+ * არ იწყებს (ობიექტები ძველ თაობაში გამოიყოფა).
+ */
+extern int ms_gc_defer_depth;
+
+/** @brief უსაფრთხო წერტილი: გენერირებული კოდი მას განცხადებებს შორის იძახებს. */
+static inline void ms_gc_safepoint(void) {
+    if (ms_gc_pending && ms_gc_defer_depth == 0) ms_gc_collect();
+}
+
+// გადადებული გამოძახება: `(ms_gc_defer_depth++, ms_gc_resume_int(f(...)))`.
+static inline int64_t ms_gc_resume_int(int64_t value) {
+    ms_gc_defer_depth--;
+    return value;
+}
+
+static inline double ms_gc_resume_number(double value) {
+    ms_gc_defer_depth--;
+    return value;
+}
+
+static inline bool ms_gc_resume_bool(bool value) {
+    ms_gc_defer_depth--;
+    return value;
+}
+
+static inline MsValue ms_gc_resume_value(MsValue value) {
+    ms_gc_defer_depth--;
+    return value;
+}
+
+/** @brief გენერირებული კოდის პატარა ფოთოლი ფუნქციები (ოპტიმიზაციის გარეშეც ჩაშენდება). */
+#if defined(__GNUC__)
+#define MS_INLINE static inline __attribute__((always_inline))
+#else
+#define MS_INLINE static inline
+#endif
+
+// --- პარალელური ციკლები (parallel.c) ---
+
+/** @brief `პარალელური ყოველი`-ს რედუქციის ოპერაცია. */
+typedef enum {
+    MS_REDUCE_SUM,
+    MS_REDUCE_MIN,
+    MS_REDUCE_MAX,
+} MsReduction;
+
+/**
+ * @brief ციკლის გამოტანილი სხეული: ასრულებს [start, end) იტერაციებს.
+ * context დაჭერილი ცვლადების სტრუქტურაა, partials კი ამ ნაკადის
+ * რედუქციების შუალედური მნიშვნელობები, რომლებსაც სხეული აგრძელებს.
+ */
+typedef void (*MsParallelBody)(int64_t start, int64_t end, const void* context, int64_t* partials);
+
+/**
+ * @brief ასრულებს [start, end) იტერაციებს სამუშაოს მოპარვის ნაკადების აუზზე.
+ * results[k] შესვლისას რედუქციის ცვლადის მიმდინარე მნიშვნელობაა, დაბრუნებისას
+ * კი — ყველა ნაკადის შუალედურებთან reductions[k] ოპერაციით გაერთიანებული.
+ */
+void ms_parallel_for(int64_t start, int64_t end, MsParallelBody body, const void* context, int64_t* results,
+                     const uint8_t* reductions, int reduction_count);
+
+/** @brief აუზის ნაკადების რაოდენობა (MANUSCRIPT_THREADS ან პროცესორების რაოდენობა). */
+int ms_parallel_workers(void);
+
+/** @brief ცვლის ნაკადების რაოდენობას (ბენჩმარკისთვის): აუზი ჩერდება და მომდევნო ციკლისას თავიდან იქმნება. */
+void ms_parallel_set_workers(int count);
+
+// --- არითმეტიკის სწრაფი გზები ---
+
+static inline MsValue ms_add(MsValue left, MsValue right) {
+    if (ms_is_number(left) && ms_is_number(right)) return ms_number(ms_as_number(left) + ms_as_number(right));
+    return ms_binary_slow('+', left, right);
+}
+
+static inline MsValue ms_sub(MsValue left, MsValue right) {
+    if (ms_is_number(left) && ms_is_number(right)) return ms_number(ms_as_number(left) - ms_as_number(right));
+    return ms_binary_slow('-', left, right);
+}
+
+static inline MsValue ms_mul(MsValue left, MsValue right) {
+    if (ms_is_number(left) && ms_is_number(right)) return ms_number(ms_as_number(left) * ms_as_number(right));
+    return ms_binary_slow('*', left, right);
+}
+
+static inline MsValue ms_div(MsValue left, MsValue right) {
+    if (ms_is_number(left) && ms_is_number(right)) return ms_number(ms_as_number(left) / ms_as_number(right));
+    return ms_binary_slow('/', left, right);
+}
+
+static inline MsValue ms_neg(MsValue value) {
+    if (ms_is_number(value)) return ms_number(-ms_as_number(value));
+    return ms_negate_slow(value);
+}
+
+/** @brief დინამიური ტიპის `ყოველი`-ს საზღვარი double-ად. */
+static inline double ms_range_bound(MsValue value) {
+    if (ms_is_number(value)) return ms_as_number(value);
+    return ms_range_bound_slow(value);
+}
+
+/**
+ * @brief მთელი ნამრავლი double შედეგით: გადავსებისას (ან -0.0-ის
+ * შესაძლებლობისას) გამოთვლა double-ზე გადადის.
+ */
+static inline double ms_mul_int(int64_t left, int64_t right) {
+    int64_t result;
+    if (__builtin_mul_overflow(left, right, &result) || result == 0) return (double)left * (double)right;
+    return (double)result;
+}
+
+/**
+ * @brief მთელი ჯამი, რომლის შუალედიც ტიპების გამოყვანამ ვერ დაამტკიცა.
+ * მთელი ცვლადები (int64_t) ყოველთვის double-ში ზუსტად წარმოდგენად
+ * მნიშვნელობას ინახავს, ამიტომ სანამ შედეგი ±2^53-შია, ის double-ის
+ * ჯამს ემთხვევა; მის გარეთ ms_promote_int double-ის შედეგს აბრუნებს.
+ */
+static inline int64_t ms_add_int(int64_t left, int64_t right) {
+    int64_t result;
+    if (!__builtin_add_overflow(left, right, &result) && result >= -9007199254740992LL &&
+        result <= 9007199254740992LL) {
+        return result;
+    }
+    return ms_promote_int((double)left + (double)right);
+}
+
+/** @brief მთელი სხვაობა გადავსების შემოწმებით (იხ. ms_add_int). */
+static inline int64_t ms_sub_int(int64_t left, int64_t right) {
+    int64_t result;
+    if (!__builtin_sub_overflow(left, right, &result) && result >= -9007199254740992LL &&
+        result <= 9007199254740992LL) {
+        return result;
+    }
+    return ms_promote_int((double)left - (double)right);
+}
 
-#endif // RUNTIME_H
\ No newline at end of file
+#endif // RUNTIME_H
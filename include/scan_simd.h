@@ -0,0 +1,42 @@
+/**
+ * @file scan_simd.h
+ * @author გიორგი მაღრაძე (magradze.giorgi@gmail.com)
+ * @brief ლექსერის SIMD სკანირების ბირთვების (kernels) დეკლარაციები.
+ * @version 0.1
+ *
+ * თითოეული ბირთვი იღებს დიაპაზონს [p, end) და აბრუნებს პირველი ისეთი ბაიტის
+ * მისამართს, რომელიც შესაბამის კლასს აღარ ეკუთვნის (ან end-ს). ბირთვები
+ * არასდროს კითხულობენ end-ის მიღმა. იმპლემენტაცია (AVX2, SSE2 ან სკალარული)
+ * პროგრამის გაშვებისას ერთხელ ირჩევა პროცესორის შესაძლებლობების მიხედვით;
+ * გარემოს ცვლადით MANUSCRIPT_SIMD=scalar|sse2|avx2 შეიძლება მისი იძულებით არჩევა.
+ */
+#ifndef SCAN_SIMD_H
+#define SCAN_SIMD_H
+
+#include <stdbool.h>
+
+/**
+ * @brief სკანირების ბირთვების ნაკრები.
+ */
+typedef struct {
+    const char* name;   // იმპლემენტაციის სახელი: "avx2", "sse2" ან "scalar"
+    /** @brief გამოტოვებს იდენტიფიკატორის ბაიტებს: [A-Za-z0-9_] და ყველა ბაიტი > 127. */
+    const char* (*identifier)(const char* p, const char* end);
+    /** @brief გამოტოვებს ცარიელ ადგილებს: ' ', '\t', '\r'. */
+    const char* (*spaces)(const char* p, const char* end);
+    /** @brief პოულობს ხაზის დასასრულს ('\n') — კომენტარების გამოსატოვებლად. */
+    const char* (*line_end)(const char* p, const char* end);
+    /** @brief პოულობს სტრიქონის დამხურავ '"'-ს და `newlines`-ს უმატებს გზად შემხვედრ '\n'-ებს. */
+    const char* (*string_body)(const char* p, const char* end, int* newlines);
+} ScanKernels;
+
+/** @brief მიმდინარე (არჩეული) ბირთვები. */
+extern ScanKernels scan_kernels;
+
+/**
+ * @brief ირჩევს ბირთვებს სახელით ("scalar", "sse2", "avx2").
+ * @return bool false, თუ ეს იმპლემენტაცია ამ პროცესორზე მიუწვდომელია.
+ */
+bool select_scan_kernels(const char* name);
+
+#endif // SCAN_SIMD_H
@@ -0,0 +1,34 @@
+/**
+ * @file sha256.h
+ * @author გიორგი მაღრაძე (magradze.giorgi@gmail.com)
+ * @brief SHA-256 ჰეშის დეკლარაციები (FIPS 180-4).
+ * @version 0.1
+ *
+ * გამოიყენება კომპილაციის ქეშის გასაღებისთვის, სადაც შემთხვევითი
+ * დამთხვევა არასწორი ბინარის გაშვებას ნიშნავს, ამიტომ FNV-ის მსგავსი
+ * სწრაფი ჰეში აქ საკმარისი არ არის.
+ */
+#ifndef SHA256_H
+#define SHA256_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define SHA256_DIGEST_SIZE 32
+
+/** @brief ჰეშირების ინკრემენტული მდგომარეობა. */
+typedef struct {
+    uint32_t state[8];
+    uint64_t total_length;     // დამუშავებული ბაიტები
+    uint8_t block[64];         // დაუსრულებელი ბლოკი
+    size_t block_length;
+} Sha256;
+
+/** @brief ჰეშირების დაწყება. */
+void sha256_init(Sha256* sha);
+/** @brief ამატებს მონაცემებს ჰეშში. */
+void sha256_update(Sha256* sha, const void* data, size_t length);
+/** @brief ასრულებს ჰეშირებას და წერს 32-ბაიტიან შედეგს. */
+void sha256_final(Sha256* sha, uint8_t digest[SHA256_DIGEST_SIZE]);
+
+#endif // SHA256_H
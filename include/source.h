@@ -0,0 +1,38 @@
+/**
+ * @file source.h
+ * @author გიორგი მაღრაძე (magradze.giorgi@gmail.com)
+ * @brief საწყისი კოდის ფაილის ჩატვირთვის დეკლარაციები.
+ * @version 0.1
+ *
+ * ჩვეულებრივი ფაილები მეხსიერებაში აისახება (mmap) კოპირების გარეშე, ხოლო
+ * stdin და არხები (pipe) იკითხება მზარდ ბუფერში. შედეგი NUL-ით დასრულებული
+ * არ არის — ლექსერი მონაცემების საზღვარს სიგრძით ამოწმებს.
+ */
+#ifndef SOURCE_H
+#define SOURCE_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+/**
+ * @brief ჩატვირთული საწყისი კოდი.
+ */
+typedef struct {
+    const char* data;      // კოდის ბაიტები (ასახვა ან ბუფერი)
+    size_t length;         // სიგრძე ბაიტებში
+    void* mapping;         // mmap-ის მისამართი (NULL, თუ ფაილი ბუფერშია)
+    char* buffer;          // მზარდი ბუფერი stdin-ისა და არხებისთვის
+} SourceFile;
+
+/**
+ * @brief ტვირთავს საწყის კოდს. ბილიკი "-" ნიშნავს სტანდარტულ შესასვლელს (stdin).
+ * @param source შესავსები სტრუქტურის მისამართი.
+ * @param path ფაილის ბილიკი.
+ * @return bool false შეცდომისას (შეტყობინება უკვე დაბეჭდილია).
+ */
+bool load_source(SourceFile* source, const char* path);
+
+/** @brief ათავისუფლებს ასახვას ან ბუფერს. */
+void free_source(SourceFile* source);
+
+#endif // SOURCE_H
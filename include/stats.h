@@ -0,0 +1,76 @@
+/**
+ * @file stats.h
+ * @author გიორგი მაღრაძე (magradze.giorgi@gmail.com)
+ * @brief კომპილაციის ეტაპების სტატისტიკის (--stats) დეკლარაციები.
+ * @version 0.1
+ *
+ * თითოეული ეტაპისთვის ინახება კედლის და CPU დრო. CPU დროში შედის
+ * დასრულებული შვილობილი პროცესების (C კომპილატორი, გაშვებული პროგრამა)
+ * დროც, ამიტომ გარე ეტაპებიც სწორად ჩანს. გამორთული სტატისტიკა (NULL
+ * მაჩვენებელი) სისტემურ გამოძახებებს საერთოდ არ აკეთებს.
+ */
+#ifndef STATS_H
+#define STATS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+/** @brief გაზომვადი ეტაპები. */
+typedef enum {
+    STATS_PHASE_LEX,       // ლექსირება (lex_all)
+    STATS_PHASE_PARSE,     // პარსინგი
+    STATS_PHASE_ANALYZE,   // ტიპების გამოყვანა და ოპტიმიზაცია
+    STATS_PHASE_CODEGEN,   // C კოდის, ბაიტკოდის ან მანქანური კოდის გენერაცია
+    STATS_PHASE_CC,        // გარე C კომპილატორი (PGO-ს სავარჯიშო გაშვების ჩათვლით)
+    STATS_PHASE_RUN,       // პროგრამის შესრულება
+    STATS_PHASE_COUNT
+} StatsPhase;
+
+/** @brief ეტაპის ჯამური დრო. */
+typedef struct {
+    double wall;     // კედლის დრო წამებში
+    double cpu;      // CPU დრო წამებში (შვილობილი პროცესების ჩათვლით)
+    bool measured;   // ეტაპი ერთხელ მაინც შესრულდა
+} PhaseTime;
+
+/** @brief დროის ანაბეჭდი ეტაპის დასაწყისში. */
+typedef struct {
+    double wall;
+    double cpu;
+} StatsMark;
+
+/** @brief ერთი კომპილაციის სტატისტიკა. */
+typedef struct {
+    PhaseTime phases[STATS_PHASE_COUNT];
+    StatsMark start;              // init_compile_stats-ის მომენტი (სულ დროისთვის)
+    size_t source_bytes;          // საწყისი კოდის ზომა
+    long tokens;                  // ტოკენები (EOF-ის ჩათვლით)
+    long nodes;                   // პარსერის აგებული კვანძები
+    long nodes_optimized;         // კვანძები ოპტიმიზაციის შემდეგ
+    size_t token_bytes;           // ტოკენების ნაკადის მასივები
+    size_t arena_bytes;           // AST არენიდან გაცემული ბაიტები
+    size_t arena_reserved;        // არენის ბლოკებისთვის აღებული ბაიტები
+    size_t code_bytes;            // გენერირებული C კოდის ზომა
+    const char* json_path;        // JSON ანგარიშის ფაილი (NULL — არ იწერება)
+} CompileStats;
+
+/** @brief სტატისტიკის ინიციალიზაცია; მთლიანი დრო ამ მომენტიდან ითვლება. */
+void init_compile_stats(CompileStats* stats, const char* json_path);
+
+/** @brief აბრუნებს მიმდინარე ანაბეჭდს (ნულებს, თუ stats == NULL). */
+StatsMark stats_mark(const CompileStats* stats);
+
+/** @brief `start`-იდან გასულ დროს ამატებს ეტაპს (stats == NULL — არაფერს აკეთებს). */
+void stats_record(CompileStats* stats, StatsPhase phase, StatsMark start);
+
+/** @brief ბეჭდავს ანგარიშს ადამიანისთვის წასაკითხი ფორმით. */
+void print_compile_stats(const CompileStats* stats, FILE* out);
+
+/**
+ * @brief წერს ანგარიშს JSON ფორმატში stats->json_path-ში.
+ * @return bool false, თუ ფაილის ჩაწერა ვერ მოხერხდა (შეტყობინება დაბეჭდილია).
+ */
+bool write_compile_stats_json(const CompileStats* stats);
+
+#endif // STATS_H
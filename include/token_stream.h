@@ -0,0 +1,92 @@
+/**
+ * @file token_stream.h
+ * @author გიორგი მაღრაძე (magradze.giorgi@gmail.com)
+ * @brief წინასწარ დასკანერებული ტოკენების ნაკადის დეკლარაციები.
+ * @version 0.2
+ *
+ * მთელი საწყისი კოდი ერთ გავლაში იშლება ტოკენებად, რომლებიც ინახება
+ * ცალკეულ მასივებში (struct-of-arrays): ტიპები, წანაცვლებები და სიგრძეები.
+ * ხაზების ნომრები არ ინახება თითოეულ ტოკენზე — ისინი გამოითვლება
+ * ხაზების ცხრილიდან, რომელიც პირველივე მოთხოვნისას იგება.
+ */
+#ifndef TOKEN_STREAM_H
+#define TOKEN_STREAM_H
+
+#include <stdint.h>
+#include "lexer.h"
+
+/** @brief შეცდომის ტოკენის შეტყობინება (შეცდომები იშვიათია, ამიტომ ცალკე ინახება). */
+typedef struct {
+    int index;             // შეცდომის ტოკენის ინდექსი ნაკადში
+    const char* message;   // ლექსერის შეტყობინება
+} TokenStreamError;
+
+/**
+ * @brief ტოკენების ნაკადი struct-of-arrays განლაგებით.
+ */
+typedef struct {
+    const char* source;        // საწყისი კოდი, რომელშიც offsets მიუთითებს
+    uint32_t source_length;    // საწყისი კოდის სიგრძე ბაიტებში
+    uint8_t* types;            // TokenType თითოეული ტოკენისთვის
+    uint32_t* offsets;         // ტოკენის დასაწყისი source-ის მიმართ
+    uint32_t* lengths;         // ტოკენის სიგრძე ბაიტებში
+    int count;                 // ტოკენების რაოდენობა (EOF-ის ჩათვლით)
+    int capacity;              // მასივების ტევადობა
+    TokenStreamError* errors;  // შეცდომის ტოკენების შეტყობინებები
+    int error_count;
+    int error_capacity;
+    uint32_t* line_starts;     // ხაზების დასაწყისები (NULL, სანამ არ დაგვჭირდება)
+    int line_count;
+    int line_hint;             // ბოლოს ნაპოვნი ხაზი — თანმიმდევრული ძებნის დასაჩქარებლად
+} TokenStream;
+
+/**
+ * @brief ერთ გავლაში ასკანერებს მთელ საწყის კოდს ტოკენების ნაკადში.
+ * @param stream ნაკადის ობიექტის მისამართი.
+ * @param source დასამუშავებელი საწყისი კოდი.
+ * @param length კოდის სიგრძე ბაიტებში.
+ */
+void lex_all(TokenStream* stream, const char* source, size_t length);
+
+/**
+ * @brief ინკრემენტული სკანირების შედეგი: ნაკადის [0, first) ნაწილი
+ * უცვლელია, [first, new_end) ხელახლა დასკანერდა, ხოლო new_end-დან მოყოლებული
+ * ტოკენები ძველი ნაკადის old_end-დან მოყოლებული ტოკენებია (წანაცვლებით).
+ */
+typedef struct {
+    int first;      // პირველი ხელახლა დასკანერებული ტოკენი
+    int old_end;    // ძველ ნაკადში პირველი ხელახლა გამოყენებული ტოკენი
+    int new_end;    // იგივე ტოკენი ახალ ნაკადში
+} TokenStreamEdit;
+
+/**
+ * @brief ანახლებს ნაკადს ტექსტის ცვლილების შემდეგ: ძველი ტექსტის
+ * [edit_start, old_edit_end) ნაწილი ახალ ტექსტში [edit_start, new_edit_end)-ით
+ * შეიცვალა. სკანირება იწყება ცვლილებამდე ბოლო შეწევის გარეშე ხაზიდან და
+ * ჩერდება, როგორც კი ცვლილების შემდეგ ისეთ ხაზს მიაღწევს, რომელიც ძველ
+ * ნაკადშიც ასევე იწყებოდა — დანარჩენი ტოკენები მხოლოდ წაინაცვლებს.
+ * @param source ახალი ტექსტი (ნაკადი მასზე მიუთითებს; ძველი აღარ გამოიყენება).
+ * @param edit აქ ჩაიწერება შეცვლილი ტოკენების შუალედი.
+ */
+void relex_token_stream(TokenStream* stream, const char* source, size_t length, uint32_t edit_start,
+                        uint32_t old_edit_end, uint32_t new_edit_end, TokenStreamEdit* edit);
+
+/**
+ * @brief აბრუნებს ნაკადის `index`-ე ტოკენს ჩვეულებრივი Token სტრუქტურის სახით.
+ * ინდექსი ნაკადის ბოლოს მიღმა აბრუნებს ბოლო (EOF) ტოკენს.
+ */
+Token token_stream_get(TokenStream* stream, int index);
+
+/** @brief აბრუნებს `index`-ე ტოკენის ხაზის ნომერს (1-დან). */
+int token_stream_line(TokenStream* stream, int index);
+
+/**
+ * @brief აბრუნებს `line`-ე ხაზის ტექსტს (ხაზის გადატანის გარეშე) დიაგნოსტიკისთვის.
+ * @param length აქ ჩაიწერება ხაზის სიგრძე ბაიტებში.
+ */
+const char* token_stream_line_text(TokenStream* stream, int line, int* length);
+
+/** @brief ათავისუფლებს ნაკადის მასივებს. */
+void free_token_stream(TokenStream* stream);
+
+#endif // TOKEN_STREAM_H
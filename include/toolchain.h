@@ -0,0 +1,93 @@
+/**
+ * @file toolchain.h
+ * @author გიორგი მაღრაძე (magradze.giorgi@gmail.com)
+ * @brief გენერირებული C კოდის კომპილაციის (C კომპილატორის გამოძახების) დეკლარაციები.
+ * @version 0.5
+ *
+ * ოპტიმიზაციის პროფილები:
+ *   debug   — `-O0 -g`, ყველაზე სწრაფი კომპილაცია;
+ *   release — `-O2 -march=native -ffp-contract=off -fopenmp-simd -DMS_OPENMP_SIMD`:
+ *             `ყოველი`-ს `#pragma omp simd` ციკლები ვექტორიზდება (MS_OPENMP_SIMD
+ *             გენერირებულ კოდს ეუბნება, რომ ეს პრაგმა მოქმედებს), FMA-ში
+ *             შერწყმა კი გამორთულია, რომ ათწილადი შედეგი debug-ისას ბიტ-ბიტ დაემთხვეს;
+ *   lto     — release + `-flto`;
+ *   pgo     — ორეტაპიანი აწყობა: ინსტრუმენტირებული ბინარი ეშვება სავარჯიშო
+ *             შესასვლელზე, შემდეგ კოდი შეგროვებული პროფილით ხელახლა კომპილირდება.
+ */
+#ifndef TOOLCHAIN_H
+#define TOOLCHAIN_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "ast.h"
+#include "stats.h"
+
+/** @brief გენერირებული კოდის ოპტიმიზაციის პროფილი. */
+typedef enum {
+    BUILD_PROFILE_DEBUG,
+    BUILD_PROFILE_RELEASE,
+    BUILD_PROFILE_LTO,
+    BUILD_PROFILE_PGO,
+    BUILD_PROFILE_COUNT
+} BuildProfile;
+
+/** @brief C კომპილაციის პარამეტრები. */
+typedef struct {
+    const char* compiler;        // C კომპილატორის ბრძანება (მაგ. "gcc" ან "ccache cc")
+    BuildProfile profile;        // ოპტიმიზაციის პროფილი
+    bool use_pipe;               // კოდის გადაცემა pipe-ით (`-x c -`), ფაილის გარეშე
+    const char* work_dir;        // შუალედური ფაილების დირექტორია (იხ. create_work_dir)
+    const char* training_input;  // PGO-ს სავარჯიშო გაშვების stdin (NULL — /dev/null)
+    CompileStats* stats;         // კოდის გენერაციისა და C კომპილაციის დრო (NULL — არ იზომება)
+} ToolchainOptions;
+
+/** @brief runtime-ის (runtime.h და libmanuscript_rt.a) ბილიკები. */
+typedef struct {
+    char include_dir[4096];
+    char library[4096];
+} RuntimePaths;
+
+/**
+ * @brief პოულობს runtime-ს: $MANUSCRIPT_HOME ან შესრულებადი ფაილის
+ * (`<root>/build/manuscript`) ძირი.
+ * @return bool false, თუ ბიბლიოთეკა ვერ მოიძებნა (შეტყობინება დაბეჭდილია).
+ */
+bool locate_runtime(RuntimePaths* paths);
+
+/** @brief აბრუნებს ნაგულისხმევ C კომპილატორს: $CC ან gcc. */
+const char* default_c_compiler(void);
+
+/** @brief არჩევს პროფილის სახელს ("debug", "release", "lto", "pgo"). */
+bool parse_build_profile(const char* name, BuildProfile* profile);
+
+/** @brief აბრუნებს პროფილის სახელს. */
+const char* build_profile_name(BuildProfile profile);
+
+/** @brief აბრუნებს პროფილის საბოლოო კომპილაციის პარამეტრებს. */
+const char* build_profile_flags(BuildProfile profile);
+
+/**
+ * @brief წერს ტექსტს ერთმაგ ბრჭყალებში shell-ისთვის (თავად ბრჭყალი '\'' სახით).
+ * @return bool false, თუ შედეგი ბუფერში არ ეტევა.
+ */
+bool shell_quote(char* dest, size_t size, const char* text);
+
+/**
+ * @brief ქმნის კომპილაციის პირად დროებით დირექტორიას (`$TMPDIR/manuscript.XXXXXX`),
+ * რომ ერთდროულად გაშვებულმა კომპილაციებმა ერთმანეთის ფაილები არ გადაწერონ.
+ * @return bool false შეცდომისას (შეტყობინება დაბეჭდილია).
+ */
+bool create_work_dir(char* dir, size_t size);
+
+/** @brief შლის დროებით დირექტორიას შიგთავსთან ერთად. */
+void remove_work_dir(const char* dir);
+
+/**
+ * @brief აგენერირებს C კოდს და აკომპილირებს მას შესრულებად ფაილად.
+ * @param ast ოპტიმიზირებული პროგრამა.
+ * @param output შესრულებადი ფაილის ბილიკი.
+ * @return bool false კომპილაციის შეცდომისას (შეტყობინება დაბეჭდილია).
+ */
+bool build_c_program(AstNode* ast, const ToolchainOptions* options, const char* output);
+
+#endif // TOOLCHAIN_H
@@ -0,0 +1,59 @@
+/**
+ * @file type_infer.h
+ * @author გიორგი მაღრაძე (magradze.giorgi@gmail.com)
+ * @brief სტატიკური ტიპების გამოყვანის დეკლარაციები.
+ * @version 0.7
+ *
+ * ენაში ყველა რიცხვი სემანტიკურად double-ია. გამოყვანა ადგენს, რომელი
+ * გამოსახულებებია დამტკიცებულად მთელი (TYPE_INT), რათა C ბექენდმა ისინი
+ * int64_t-ით გამოთვალოს და `.000000`-ის გარეშე დაბეჭდოს. ამისთვის
+ * თითოეულ მთელ ცვლადს მნიშვნელობების შუალედი ახლავს: ოპერაცია მთელი
+ * რჩება მხოლოდ მაშინ, როცა შედეგის შუალედი [-2^53, 2^53]-შია და -0.0
+ * ვერ მიიღება, ასე რომ ნებისმიერი ბექენდი ბიტ-ბიტ იგივე შედეგს იძლევა.
+ * გამონაკლისია `+` და `-`: თუ შუალედი ზღვარს სცდება (მაგ. ციკლში
+ * განუსაზღვრელად მზარდი ცვლადი), კვანძი მაინც მთელია, ოღონდ `wide`.
+ * C ბექენდი მას ms_add_int/ms_sub_int-ით ითვლის: ±2^53-ის მიღმა შედეგი
+ * double-ზე გადადის (double-ის შეკრების შედეგს მრგვალდება) და ისე
+ * იბეჭდება, ამიტომ გამოსავალი ისევ double-ის გამოთვლას ემთხვევა.
+ * ±2^63-ის მიღმა მნიშვნელობა int64_t-ში აღარ ეტევა და გაშვების შეცდომაა.
+ * ლოგიკური ლიტერალები TYPE_BOOL-ია, სტრიქონები და მათი `+` — TYPE_STRING; არარა და ყველა ოპერაცია არარიცხვით
+ * ოპერანდზე — TYPE_VALUE, რომლის ტიპი მხოლოდ გაშვებისას მოწმდება.
+ * შედარებები, `და`, `ან` და `არ` ყოველთვის TYPE_BOOL-ია.
+ *
+ * ცვლადის ტიპი მისი ყველა მინიჭების გაერთიანებაა (მაგ. მთელი და ათწილადი —
+ * TYPE_NUMBER, რიცხვი და სტრიქონი — TYPE_VALUE), შუალედი კი ნაკადის მიხედვით
+ * ითვლება: `თუ`/`სანამ` პირობა შტოში მას ავიწროებს, ციკლის თავში კი ის
+ * ფართოვდება, სანამ ანალიზი არ დასტაბილურდება. `ყოველი ი ში ა..ბ` ციკლის
+ * ცვლადი მთელია, თუ ორივე საზღვარი მთელია, და მისი შუალედი [ა, ბ - 1]-ია.
+ *
+ * ფუნქციები პროცედურათაშორისად ანალიზდება: პარამეტრის ტიპი და შესვლის
+ * შუალედი ყველა გამოძახების არგუმენტების გაერთიანებაა, დაბრუნების ტიპი —
+ * ყველა `დაბრუნე`-სი (ბოლომდე მიღწევადი სხეული `არარა`-ს აბრუნებს). ასე
+ * რეკურსიული `ფიბ(ნ - 1)`-ის ნ მთელი პარამეტრი რჩება. გამოძახებების გარეშე
+ * დარჩენილი პარამეტრი TYPE_VALUE-ა.
+ */
+#ifndef TYPE_INFER_H
+#define TYPE_INFER_H
+
+#include "ast.h"
+
+/** @brief უდიდესი მთელი, რომელიც double-ში ზუსტად წარმოიდგინება (2^53). */
+#define TYPE_INT_LIMIT 9007199254740992LL
+
+/** @brief მასივის ელემენტების უდიდესი რაოდენობა (runtime.h-ის MS_ARRAY_MAX_LENGTH). */
+#define TYPE_ARRAY_MAX_LENGTH (1LL << 40)
+
+/**
+ * @brief ამოწმებს სახელებს და ავსებს პროგრამის ყველა გამოსახულების
+ * value_type ველს. უნდა შესრულდეს ოპტიმიზაციამდე, რომ დაკეცილმა მუდმივებმა
+ * საწყისი გამოსახულების ტიპი შეინარჩუნონ (მაგ. `4 / 2` რჩება TYPE_NUMBER).
+ * @return bool false, თუ ცვლადი ან ფუნქცია გამოუცხადებელია, ხელახლა ცხადდება,
+ * `ყოველი`-ს ცვლადს ენიჭება, გამოძახების არგუმენტები პარამეტრებს არ ემთხვევა, `დაბრუნე` ფუნქციის გარეთაა
+ * ან `პარალელური ყოველი`-ს იტერაციები დამოუკიდებელი არ არის (შეტყობინება დაბეჭდილია).
+ */
+bool infer_types(AstNode* program, AstContext* ctx);
+
+/** @brief აბრუნებს ტიპის სახელს დიაგნოსტიკისთვის. */
+const char* value_type_name(ValueType type);
+
+#endif // TYPE_INFER_H
@@ -0,0 +1,73 @@
+/**
+ * @file vm.h
+ * @author გიორგი მაღრაძე (magradze.giorgi@gmail.com)
+ * @brief ბაიტკოდისა და ვირტუალური მანქანის (VM) დეკლარაციები.
+ * @version 0.1
+ *
+ * `--run` რეჟიმში AST კომპილირდება კომპაქტურ რეგისტრულ ბაიტკოდში და
+ * სრულდება იმავე პროცესში, C კომპილატორის გამოძახების გარეშე.
+ * ყოველი ცვლადი საკუთარ რეგისტრშია (რეგისტრის ნომერი = სიმბოლოს id),
+ * დროებითი მნიშვნელობები კი ცვლადების შემდეგ რეგისტრებს იკავებს.
+ */
+#ifndef VM_H
+#define VM_H
+
+#include <stdint.h>
+#include "ast.h"
+
+/** @brief ბაიტკოდის ოპერაციები. */
+typedef enum {
+    OP_LOADK,    // R[a] = K[b | c << 16]
+    OP_MOVE,     // R[a] = R[b]
+    OP_ADD,      // R[a] = R[b] + R[c]
+    OP_SUB,      // R[a] = R[b] - R[c]
+    OP_MUL,      // R[a] = R[b] * R[c]
+    OP_DIV,      // R[a] = R[b] / R[c]
+    OP_NEG,      // R[a] = -R[b]
+    OP_PRINT,    // დაბეჭდე R[a] ("%f")
+    OP_PRINT_INT,// დაბეჭდე R[a] მთელ რიცხვად (TYPE_INT გამოსახულებები)
+    OP_HALT,     // შესრულების დასრულება
+    OP_COUNT
+} OpCode;
+
+/** @brief ერთი ინსტრუქცია (8 ბაიტი): ოპერაცია და სამი 16-ბიტიანი ოპერანდი. */
+typedef struct {
+    uint8_t op;
+    uint16_t a;
+    uint16_t b;
+    uint16_t c;
+} Instruction;
+
+/** @brief კომპილირებული პროგრამა: ინსტრუქციები და მუდმივების ცხრილი. */
+typedef struct {
+    Instruction* code;
+    int count;
+    int capacity;
+    double* constants;
+    int constant_count;
+    int constant_capacity;
+    int register_count;    // საჭირო რეგისტრების რაოდენობა
+} Chunk;
+
+/**
+ * @brief აკომპილირებს პროგრამის AST-ს ბაიტკოდში.
+ * @param program NODE_PROGRAM კვანძი.
+ * @param ctx AST კონტექსტი (რეგისტრების რაოდენობა სიმბოლოებიდან გამოითვლება).
+ * @param chunk შესავსები ბაიტკოდის ობიექტი.
+ * @return bool false, თუ პროგრამა შეიცავს შეცდომას (შეტყობინება დაბეჭდილია).
+ */
+bool compile_bytecode(AstNode* program, AstContext* ctx, Chunk* chunk);
+
+/** @brief ბეჭდავს ბაიტკოდს ადამიანისთვის წაკითხვადი სახით. */
+void disassemble_chunk(Chunk* chunk);
+
+/** @brief ათავისუფლებს ბაიტკოდის მასივებს. */
+void free_chunk(Chunk* chunk);
+
+/**
+ * @brief ასრულებს ბაიტკოდს ვირტუალურ მანქანაში.
+ * @return int გამოსვლის კოდი (0 წარმატებისას).
+ */
+int run_bytecode(Chunk* chunk);
+
+#endif // VM_H
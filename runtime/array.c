@@ -0,0 +1,378 @@
+/**
+ * @file array.c
+ * @author გიორგი მაღრაძე (magradze.giorgi@gmail.com)
+ * @brief რიცხვითი მასივების იმპლემენტაცია: შექმნა, ინდექსირება და ელემენტური ოპერაციები.
+ * @version 0.4
+ *
+ * მთელი მასივი int64_t-ებს ინახავს, სანამ ყველა ელემენტი ±2^53-შია და
+ * ზუსტად გამოისახება double-ით; სხვა მნიშვნელობის ჩაწერა მას ადგილზე
+ * ნამდვილ მასივად გადააკეთებს. მთელი `+`, `-`, `*` და უარყოფა მთელ მასივს
+ * აბრუნებს, თუ ყველა შედეგი ზღვარშია და არცერთი -0.0 არ არის (`0 * -3`,
+ * `-0`); სხვაგვარად — და `/`-ზე ყოველთვის — ნამდვილს, ისევე როგორც
+ * სკალარული არითმეტიკა. შერეული ოპერანდები ბირთვებს
+ * MS_ARRAY_BLOCK ელემენტის ბლოკებად, double-ად გარდაქმნილი მიეწოდება.
+ * ms_sum_int/ms_min_int/ms_max_int იმავე რედუქციებს int64_t-ად აბრუნებს:
+ * კომპილატორი მათ იძახებს, როცა არგუმენტი სტატიკურად მთელი მასივია.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "runtime.h"
+#include "array_simd.h"
+
+// double-ად გარდაქმნის ბლოკი (სტეკზე, 4 KB) — L1 ქეშში ეტევა.
+#define MS_ARRAY_BLOCK 512
+#define MS_ARRAY_MIN_CAPACITY 8
+
+static void* allocate_data(size_t capacity) {
+    if (capacity == 0) return NULL;
+    if (capacity > SIZE_MAX / 16) {
+        fprintf(stderr, "FATAL: Memory allocation failed for array.\n");
+        exit(1);
+    }
+    void* data = aligned_alloc(MS_ARRAY_ALIGNMENT, ms_array_data_bytes(capacity));
+    if (data == NULL) {
+        fprintf(stderr, "FATAL: Memory allocation failed for array.\n");
+        exit(1);
+    }
+    return data;
+}
+
+/** @brief ახალი მასივი `length` ინიციალიზებელი ელემენტით (capacity == length). */
+static MsArray* allocate_array(MsArrayKind kind, size_t length) {
+    MsArray* array = ms_gc_alloc(sizeof(MsArray));
+    array->object.type = MS_OBJ_ARRAY;
+    array->object.flags = 0;
+    array->kind = kind;
+    array->length = length;
+    array->capacity = length;
+    array->data = allocate_data(length);
+    ms_gc_track_array(array);
+    return array;
+}
+
+/** @brief მთელ ელემენტებს ადგილზე double-ად გადააკეთებს (ზომა იგივეა — 8 ბაიტი). */
+static void convert_to_double(MsArray* array) {
+    // memcpy-ით, რომ ერთი მეხსიერების ორი ტიპით წაკითხვა-ჩაწერა ალიასინგის წესებს არ არღვევდეს.
+    char* bytes = array->data;
+    for (size_t i = 0; i < array->length; i++) {
+        int64_t item;
+        memcpy(&item, bytes + i * sizeof(item), sizeof(item));
+        double number = (double)item;
+        memcpy(bytes + i * sizeof(number), &number, sizeof(number));
+    }
+    array->kind = MS_ARRAY_DOUBLE;
+}
+
+/** @brief ამოწმებს, რომ მნიშვნელობა მასივია; `operation` შეცდომის შეტყობინებისთვისაა. */
+static MsArray* expect_array(MsValue value, const char* operation) {
+    if (ms_is_array(value)) return ms_as_array(value);
+    char message[256];
+    snprintf(message, sizeof(message), "'%s' მოითხოვს მასივს, მოცემულია '%s'.", operation, ms_type_name(value));
+    ms_type_error(message);
+}
+
+_Noreturn static void index_error(int64_t index, size_t length) {
+    char message[256];
+    snprintf(message, sizeof(message), "ინდექსი %lld მასივის საზღვრებს გარეთაა (სიგრძე %zu).",
+             (long long)index, length);
+    ms_type_error(message);
+}
+
+double ms_array_get_slow(MsValue value, int64_t index) {
+    if (!ms_is_array(value)) {
+        char message[256];
+        snprintf(message, sizeof(message), "ინდექსირება დაუშვებელია ტიპზე '%s'.", ms_type_name(value));
+        ms_type_error(message);
+    }
+    index_error(index, ms_as_array(value)->length);
+}
+
+void ms_array_set_slow(MsValue value, int64_t index, double element) {
+    MsArray* array = ms_as_array(value);
+    if (!ms_is_array(value) || (uint64_t)index >= array->length) ms_array_get_slow(value, index);
+    convert_to_double(array);
+    ((double*)array->data)[index] = element;
+}
+
+int64_t ms_index_slow(double number) {
+    char message[256];
+    if (number == number && number >= -9223372036854775808.0 && number < 9223372036854775808.0 &&
+        (double)(int64_t)number == number) {
+        return (int64_t)number;
+    }
+    // ±2^63-ს მიღმა მთელი რიცხვი ნებისმიერ საზღვარს სცდება.
+    if (number >= 9223372036854775808.0) return INT64_MAX;
+    if (number <= -9223372036854775808.0) return INT64_MIN;
+    snprintf(message, sizeof(message), "ინდექსი უნდა იყოს მთელი რიცხვი, მოცემულია %f.", number);
+    ms_type_error(message);
+}
+
+int64_t ms_index_value(MsValue value) {
+    if (ms_is_number(value)) return ms_index(ms_as_number(value));
+    char message[256];
+    snprintf(message, sizeof(message), "ინდექსი უნდა იყოს რიცხვი, მოცემულია '%s'.", ms_type_name(value));
+    ms_type_error(message);
+}
+
+double ms_element_value(MsValue value) {
+    if (ms_is_number(value)) return ms_as_number(value);
+    char message[256];
+    snprintf(message, sizeof(message), "მასივის ელემენტი უნდა იყოს რიცხვი, მოცემულია '%s'.", ms_type_name(value));
+    ms_type_error(message);
+}
+
+MsValue ms_array_from_int(size_t count, const int64_t* items) {
+    MsArray* array = allocate_array(MS_ARRAY_INT, count);
+    if (count > 0) memcpy(array->data, items, count * sizeof(int64_t));
+    return ms_object(&array->object);
+}
+
+MsValue ms_array_from_double(size_t count, const double* items) {
+    MsArray* array = allocate_array(MS_ARRAY_DOUBLE, count);
+    if (count > 0) memcpy(array->data, items, count * sizeof(double));
+    return ms_object(&array->object);
+}
+
+MsValue ms_array_new(int64_t length) {
+    if (length < 0) {
+        char message[256];
+        snprintf(message, sizeof(message), "მასივის ზომა უარყოფითია: %lld.", (long long)length);
+        ms_type_error(message);
+    }
+    if (length > MS_ARRAY_MAX_LENGTH) {
+        char message[256];
+        snprintf(message, sizeof(message), "მასივის ზომა ძალიან დიდია: %lld.", (long long)length);
+        ms_type_error(message);
+    }
+    MsArray* array = allocate_array(MS_ARRAY_INT, (size_t)length);
+    if (length > 0) memset(array->data, 0, (size_t)length * sizeof(int64_t));
+    return ms_object(&array->object);
+}
+
+MsValue ms_array_iterable(MsValue value) {
+    expect_array(value, "ყოველი");
+    return value;
+}
+
+int64_t ms_length(MsValue value) {
+    if (ms_is_string(value)) return (int64_t)ms_string_length(value);
+    return (int64_t)expect_array(value, "სიგრძე")->length;
+}
+
+MsValue ms_push(MsValue value, double element) {
+    MsArray* array = expect_array(value, "დაამატე");
+    if (array->length == (size_t)MS_ARRAY_MAX_LENGTH) ms_type_error("მასივის ზომა ძალიან დიდია.");
+    if (array->length == array->capacity) {
+        size_t old_capacity = array->capacity;
+        size_t capacity = old_capacity < MS_ARRAY_MIN_CAPACITY ? MS_ARRAY_MIN_CAPACITY : old_capacity * 2;
+        void* data = allocate_data(capacity);
+        if (array->length > 0) memcpy(data, array->data, array->length * sizeof(int64_t));
+        free(array->data);
+        array->data = data;
+        array->capacity = capacity;
+        ms_gc_array_resized(array, old_capacity);
+    }
+    array->length++;
+    ms_array_set(value, (int64_t)array->length - 1, element);
+    return MS_NONE;
+}
+
+/**
+ * @brief ელემენტების [start, start + count) ბლოკი double-ად: ნამდვილი
+ * მასივი პირდაპირ, მთელი — `buffer`-ში გარდაქმნით.
+ */
+static const double* double_block(const MsArray* array, size_t start, size_t count, double* buffer) {
+    if (array->kind == MS_ARRAY_DOUBLE) return (const double*)array->data + start;
+    const int64_t* items = (const int64_t*)array->data + start;
+    for (size_t i = 0; i < count; i++) buffer[i] = (double)items[i];
+    return buffer;
+}
+
+/** @brief მთელი მასივის ზუსტი ჯამი; false, თუ ის int64-ს გადაავსებს. */
+static bool int_sum(const MsArray* array, int64_t* total) {
+    const int64_t* items = array->data;
+    *total = 0;
+    for (size_t start = 0; start < array->length; start += MS_ARRAY_INT_SUM_BLOCK) {
+        size_t count = array->length - start < MS_ARRAY_INT_SUM_BLOCK ? array->length - start : MS_ARRAY_INT_SUM_BLOCK;
+        if (__builtin_add_overflow(*total, ms_array_kernels.sum_int(items + start, count), total)) return false;
+    }
+    return true;
+}
+
+double ms_sum(MsValue value) {
+    const MsArray* array = expect_array(value, "ჯამი");
+    if (array->kind == MS_ARRAY_DOUBLE) return ms_array_kernels.sum(array->data, array->length);
+    // მთელი ჯამი ზუსტია და ბოლოს ერთხელ მრგვალდება; int64-ის გადავსებისას ბლოკების double ჯამზე გადავდივართ.
+    int64_t total;
+    if (int_sum(array, &total)) return (double)total;
+    double sum = 0;
+    _Alignas(MS_ARRAY_ALIGNMENT) double buffer[MS_ARRAY_BLOCK];
+    for (size_t start = 0; start < array->length; start += MS_ARRAY_BLOCK) {
+        size_t count = array->length - start < MS_ARRAY_BLOCK ? array->length - start : MS_ARRAY_BLOCK;
+        sum += ms_array_kernels.sum(double_block(array, start, count, buffer), count);
+    }
+    return sum;
+}
+
+/** @brief მთელი მასივი; ათწილადი მასივი აქ მხოლოდ ტიპების გამოყვანის შეცდომით მოხვდება. */
+static const MsArray* expect_int_array(const MsArray* array) {
+    if (array->kind != MS_ARRAY_INT) ms_type_error("მთელი მასივის მოლოდინში მოცემულია ათწილადი მასივი.");
+    return array;
+}
+
+int64_t ms_sum_int(MsValue value) {
+    const MsArray* array = expect_int_array(expect_array(value, "ჯამი"));
+    int64_t total;
+    if (!int_sum(array, &total) || total < -9007199254740992LL || total > 9007199254740992LL) {
+        ms_type_error("მთელი მასივის 'ჯამი' ±2^53-ს სცდება.");
+    }
+    return total;
+}
+
+/** @brief არაცარიელი მასივი მინიმუმისთვის (`maximum` — მაქსიმუმისთვის). */
+static const MsArray* extremum_array(MsValue value, bool maximum) {
+    const MsArray* array = expect_array(value, maximum ? "მაქსიმუმი" : "მინიმუმი");
+    if (array->length == 0) {
+        ms_type_error(maximum ? "'მაქსიმუმი' ცარიელ მასივზე დაუშვებელია." : "'მინიმუმი' ცარიელ მასივზე დაუშვებელია.");
+    }
+    return array;
+}
+
+/** @brief მთელი მასივის მინიმუმი ან მაქსიმუმი ზუსტი შედარებით. */
+static int64_t int_extremum(const MsArray* array, bool maximum) {
+    const int64_t* items = array->data;
+    int64_t best = items[0];
+    for (size_t i = 1; i < array->length; i++) {
+        if (maximum ? items[i] > best : items[i] < best) best = items[i];
+    }
+    return best;
+}
+
+static double extremum(MsValue value, bool maximum) {
+    const MsArray* array = extremum_array(value, maximum);
+    if (array->kind == MS_ARRAY_DOUBLE) {
+        return maximum ? ms_array_kernels.max(array->data, array->length) : ms_array_kernels.min(array->data, array->length);
+    }
+    return (double)int_extremum(array, maximum);
+}
+
+double ms_min(MsValue value) {
+    return extremum(value, false);
+}
+
+double ms_max(MsValue value) {
+    return extremum(value, true);
+}
+
+int64_t ms_min_int(MsValue value) {
+    return int_extremum(expect_int_array(extremum_array(value, false)), false);
+}
+
+int64_t ms_max_int(MsValue value) {
+    return int_extremum(expect_int_array(extremum_array(value, true)), true);
+}
+
+_Noreturn static void length_error(const MsArray* left, const MsArray* right) {
+    char message[256];
+    snprintf(message, sizeof(message), "მასივების სიგრძეები არ ემთხვევა (%zu და %zu).", left->length, right->length);
+    ms_type_error(message);
+}
+
+double ms_dot(MsValue left, MsValue right) {
+    const MsArray* a = expect_array(left, "სკალარული");
+    const MsArray* b = expect_array(right, "სკალარული");
+    if (a->length != b->length) length_error(a, b);
+    if (a->kind == MS_ARRAY_DOUBLE && b->kind == MS_ARRAY_DOUBLE) return ms_array_kernels.dot(a->data, b->data, a->length);
+    double sum = 0;
+    _Alignas(MS_ARRAY_ALIGNMENT) double left_buffer[MS_ARRAY_BLOCK];
+    _Alignas(MS_ARRAY_ALIGNMENT) double right_buffer[MS_ARRAY_BLOCK];
+    for (size_t start = 0; start < a->length; start += MS_ARRAY_BLOCK) {
+        size_t count = a->length - start < MS_ARRAY_BLOCK ? a->length - start : MS_ARRAY_BLOCK;
+        sum += ms_array_kernels.dot(double_block(a, start, count, left_buffer),
+                                    double_block(b, start, count, right_buffer), count);
+    }
+    return sum;
+}
+
+static MsArrayOp array_op(char op) {
+    switch (op) {
+        case '+': return MS_ARRAY_ADD;
+        case '-': return MS_ARRAY_SUB;
+        case '*': return MS_ARRAY_MUL;
+        default: return MS_ARRAY_DIV;
+    }
+}
+
+/** @brief double შედეგი `out`-ში: მასივი და მასივი, ან მასივი და რიცხვი (`swap` — რიცხვი მარცხნივაა). */
+static void map_double(MsArrayOp op, double* out, const MsArray* left, const MsArray* right, double scalar,
+                       bool swap) {
+    if (left->kind == MS_ARRAY_DOUBLE && (right == NULL || right->kind == MS_ARRAY_DOUBLE)) {
+        if (right != NULL) ms_array_kernels.map(op, out, left->data, right->data, left->length);
+        else ms_array_kernels.map_scalar(op, out, left->data, scalar, swap, left->length);
+        return;
+    }
+    _Alignas(MS_ARRAY_ALIGNMENT) double left_buffer[MS_ARRAY_BLOCK];
+    _Alignas(MS_ARRAY_ALIGNMENT) double right_buffer[MS_ARRAY_BLOCK];
+    for (size_t start = 0; start < left->length; start += MS_ARRAY_BLOCK) {
+        size_t count = left->length - start < MS_ARRAY_BLOCK ? left->length - start : MS_ARRAY_BLOCK;
+        const double* a = double_block(left, start, count, left_buffer);
+        if (right != NULL) ms_array_kernels.map(op, out + start, a, double_block(right, start, count, right_buffer), count);
+        else ms_array_kernels.map_scalar(op, out + start, a, scalar, swap, count);
+    }
+}
+
+MsValue ms_array_binary(char op, MsValue left, MsValue right) {
+    bool swap = !ms_is_array(left);
+    const MsArray* array = ms_as_array(swap ? right : left);
+    const MsArray* other = NULL;
+    double scalar = 0;
+    if (ms_is_array(left) && ms_is_array(right)) {
+        other = ms_as_array(right);
+        if (array->length != other->length) length_error(array, other);
+    } else {
+        scalar = ms_as_number(swap ? left : right);
+    }
+
+    MsArrayOp operation = array_op(op);
+    MsArray* result;
+    if (operation != MS_ARRAY_DIV && array->kind == MS_ARRAY_INT &&
+        (other != NULL ? other->kind == MS_ARRAY_INT : ms_fits_int(scalar))) {
+        result = allocate_array(MS_ARRAY_INT, array->length);
+        bool exact = other != NULL
+            ? ms_array_kernels.map_int(operation, result->data, array->data, other->data, array->length)
+            : ms_array_kernels.map_int_scalar(operation, result->data, array->data, (int64_t)scalar, swap, array->length);
+        if (exact) return ms_object(&result->object);
+        // შედეგი ±2^53-ს გასცდა: იგივე ბუფერი double-ით ხელახლა ივსება.
+        result->kind = MS_ARRAY_DOUBLE;
+    } else {
+        result = allocate_array(MS_ARRAY_DOUBLE, array->length);
+    }
+    map_double(operation, result->data, array, other, scalar, swap);
+    return ms_object(&result->object);
+}
+
+MsValue ms_array_negate(MsValue value) {
+    const MsArray* array = ms_as_array(value);
+    if (array->kind == MS_ARRAY_INT) {
+        // |ელემენტი| <= 2^53, ამიტომ უარყოფა არ გადაივსება; მხოლოდ 0-ის უარყოფაა
+        // -0.0, რომელიც მთელ მასივში არ ეტევა — მაშინ შედეგი ნამდვილია.
+        const int64_t* items = array->data;
+        MsArray* result = allocate_array(MS_ARRAY_INT, array->length);
+        int64_t* out = result->data;
+        bool zero = false;
+        for (size_t i = 0; i < array->length; i++) {
+            out[i] = -items[i];
+            zero |= items[i] == 0;
+        }
+        if (!zero) return ms_object(&result->object);
+        result->kind = MS_ARRAY_DOUBLE;
+        double* values = result->data;
+        for (size_t i = 0; i < array->length; i++) values[i] = -(double)items[i];
+        return ms_object(&result->object);
+    }
+    MsArray* result = allocate_array(MS_ARRAY_DOUBLE, array->length);
+    double* out = result->data;
+    const double* items = array->data;
+    for (size_t i = 0; i < array->length; i++) out[i] = -items[i];
+    return ms_object(&result->object);
+}
@@ -0,0 +1,485 @@
+/**
+ * @file array_simd.c
+ * @author გიორგი მაღრაძე (magradze.giorgi@gmail.com)
+ * @brief მასივების ელემენტური ოპერაციების SIMD ბირთვების იმპლემენტაცია.
+ * @version 0.2
+ */
+#include <stdlib.h>
+#include <string.h>
+#include "array_simd.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define ARRAY_HAVE_X86 1
+#endif
+
+#define LANES 8
+#define INT_BIAS ((int64_t)1 << 53)
+
+// --- სკალარული ბირთვები (ყველა პლატფორმაზე და ვექტორული ბირთვების კუდისთვის) ---
+
+static void scalar_map(MsArrayOp op, double* out, const double* left, const double* right, size_t n) {
+    switch (op) {
+        case MS_ARRAY_ADD: for (size_t i = 0; i < n; i++) out[i] = left[i] + right[i]; break;
+        case MS_ARRAY_SUB: for (size_t i = 0; i < n; i++) out[i] = left[i] - right[i]; break;
+        case MS_ARRAY_MUL: for (size_t i = 0; i < n; i++) out[i] = left[i] * right[i]; break;
+        case MS_ARRAY_DIV: for (size_t i = 0; i < n; i++) out[i] = left[i] / right[i]; break;
+    }
+}
+
+static void scalar_map_scalar(MsArrayOp op, double* out, const double* left, double scalar, bool swap, size_t n) {
+    switch (op) {
+        case MS_ARRAY_ADD:
+            if (swap) for (size_t i = 0; i < n; i++) out[i] = scalar + left[i];
+            else for (size_t i = 0; i < n; i++) out[i] = left[i] + scalar;
+            break;
+        case MS_ARRAY_SUB:
+            if (swap) for (size_t i = 0; i < n; i++) out[i] = scalar - left[i];
+            else for (size_t i = 0; i < n; i++) out[i] = left[i] - scalar;
+            break;
+        case MS_ARRAY_MUL:
+            if (swap) for (size_t i = 0; i < n; i++) out[i] = scalar * left[i];
+            else for (size_t i = 0; i < n; i++) out[i] = left[i] * scalar;
+            break;
+        case MS_ARRAY_DIV:
+            if (swap) for (size_t i = 0; i < n; i++) out[i] = scalar / left[i];
+            else for (size_t i = 0; i < n; i++) out[i] = left[i] / scalar;
+            break;
+    }
+}
+
+/** @brief შედეგი ±2^53-ის გარეთაა: (r + 2^53) >> 54 ნულისგან განსხვავდება (2^53 თავადაც, რაც უსაფრთხოა). */
+static uint64_t int_out_of_range(int64_t result) {
+    return ((uint64_t)result + (uint64_t)INT_BIAS) >> 54;
+}
+
+/**
+ * @brief მთელი ნამრავლი (ms_mul_int-ის მსგავსად შემოწმებული): ნულისგან
+ * განსხვავდება, თუ int64 გადაივსო, შედეგი ±2^53-ს გასცდა ან double-ში -0.0
+ * იქნებოდა (ნული უარყოფით თანამამრავლთან).
+ */
+static uint64_t int_product(int64_t* out, int64_t left, int64_t right) {
+    if (__builtin_mul_overflow(left, right, out)) return 1;
+    return int_out_of_range(*out) | (uint64_t)(*out == 0 && (left < 0 || right < 0));
+}
+
+static bool scalar_map_int(MsArrayOp op, int64_t* out, const int64_t* left, const int64_t* right, size_t n) {
+    uint64_t flag = 0;
+    if (op == MS_ARRAY_ADD) {
+        for (size_t i = 0; i < n; i++) flag |= int_out_of_range(out[i] = left[i] + right[i]);
+    } else if (op == MS_ARRAY_MUL) {
+        for (size_t i = 0; i < n; i++) flag |= int_product(&out[i], left[i], right[i]);
+    } else {
+        for (size_t i = 0; i < n; i++) flag |= int_out_of_range(out[i] = left[i] - right[i]);
+    }
+    return flag == 0;
+}
+
+static bool scalar_map_int_scalar(MsArrayOp op, int64_t* out, const int64_t* left, int64_t scalar, bool swap, size_t n) {
+    uint64_t flag = 0;
+    if (op == MS_ARRAY_ADD) {
+        for (size_t i = 0; i < n; i++) flag |= int_out_of_range(out[i] = left[i] + scalar);
+    } else if (op == MS_ARRAY_MUL) {
+        for (size_t i = 0; i < n; i++) flag |= int_product(&out[i], left[i], scalar);
+    } else if (swap) {
+        for (size_t i = 0; i < n; i++) flag |= int_out_of_range(out[i] = scalar - left[i]);
+    } else {
+        for (size_t i = 0; i < n; i++) flag |= int_out_of_range(out[i] = left[i] - scalar);
+    }
+    return flag == 0;
+}
+
+/** @brief ზოლების გაერთიანება ფიქსირებული რიგით (ყველა ბირთვისთვის საერთო). */
+static double combine_sum(const double lanes[LANES]) {
+    return ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+}
+
+static double combine_min(const double lanes[LANES]) {
+    double m = lanes[0];
+    for (int j = 1; j < LANES; j++) m = lanes[j] < m ? lanes[j] : m;
+    return m;
+}
+
+static double combine_max(const double lanes[LANES]) {
+    double m = lanes[0];
+    for (int j = 1; j < LANES; j++) m = lanes[j] > m ? lanes[j] : m;
+    return m;
+}
+
+/** @brief ვექტორული ბირთვების კუდი: `start` LANES-ის ჯერადია, ამიტომ x[i] i % LANES ზოლში ხვდება. */
+static void sum_tail(double lanes[LANES], const double* x, size_t start, size_t n) {
+    for (size_t i = start; i < n; i++) lanes[i % LANES] += x[i];
+}
+
+static void dot_tail(double lanes[LANES], const double* x, const double* y, size_t start, size_t n) {
+    for (size_t i = start; i < n; i++) lanes[i % LANES] += x[i] * y[i];
+}
+
+static void min_tail(double lanes[LANES], const double* x, size_t start, size_t n) {
+    for (size_t i = start; i < n; i++) lanes[i % LANES] = x[i] < lanes[i % LANES] ? x[i] : lanes[i % LANES];
+}
+
+static void max_tail(double lanes[LANES], const double* x, size_t start, size_t n) {
+    for (size_t i = start; i < n; i++) lanes[i % LANES] = x[i] > lanes[i % LANES] ? x[i] : lanes[i % LANES];
+}
+
+static double scalar_sum(const double* x, size_t n) {
+    double lanes[LANES] = { 0 };
+    sum_tail(lanes, x, 0, n);
+    return combine_sum(lanes);
+}
+
+static double scalar_dot(const double* x, const double* y, size_t n) {
+    double lanes[LANES] = { 0 };
+    dot_tail(lanes, x, y, 0, n);
+    return combine_sum(lanes);
+}
+
+static double scalar_min(const double* x, size_t n) {
+    double lanes[LANES];
+    for (int j = 0; j < LANES; j++) lanes[j] = x[0];
+    min_tail(lanes, x, 0, n);
+    return combine_min(lanes);
+}
+
+static double scalar_max(const double* x, size_t n) {
+    double lanes[LANES];
+    for (int j = 0; j < LANES; j++) lanes[j] = x[0];
+    max_tail(lanes, x, 0, n);
+    return combine_max(lanes);
+}
+
+static int64_t scalar_sum_int(const int64_t* x, size_t n) {
+    int64_t sum = 0;
+    for (size_t i = 0; i < n; i++) sum += x[i];
+    return sum;
+}
+
+#ifdef ARRAY_HAVE_X86
+
+/**
+ * @brief აგებს ელემენტურ ბირთვებს მოცემული ვექტორული ინსტრუქციებით;
+ * ოპერანდების რიგი სკალარულ ბირთვებს ემთხვევა, კუდი კი სკალარულად მუშავდება.
+ */
+#define DEFINE_MAP_KERNELS(PREFIX, ATTR, VEC, WIDTH, LOAD, STORE, SET1, ADD, SUB, MUL, DIV)                   \
+    ATTR static void PREFIX##_map(MsArrayOp op, double* out, const double* left, const double* right,         \
+                                  size_t n) {                                                                  \
+        size_t i = 0;                                                                                          \
+        switch (op) {                                                                                          \
+            case MS_ARRAY_ADD:                                                                                 \
+                for (; i + WIDTH <= n; i += WIDTH) STORE(out + i, ADD(LOAD(left + i), LOAD(right + i)));       \
+                break;                                                                                         \
+            case MS_ARRAY_SUB:                                                                                 \
+                for (; i + WIDTH <= n; i += WIDTH) STORE(out + i, SUB(LOAD(left + i), LOAD(right + i)));       \
+                break;                                                                                         \
+            case MS_ARRAY_MUL:                                                                                 \
+                for (; i + WIDTH <= n; i += WIDTH) STORE(out + i, MUL(LOAD(left + i), LOAD(right + i)));       \
+                break;                                                                                         \
+            case MS_ARRAY_DIV:                                                                                 \
+                for (; i + WIDTH <= n; i += WIDTH) STORE(out + i, DIV(LOAD(left + i), LOAD(right + i)));       \
+                break;                                                                                         \
+        }                                                                                                      \
+        scalar_map(op, out + i, left + i, right + i, n - i);                                                   \
+    }                                                                                                          \
+    ATTR static void PREFIX##_map_scalar(MsArrayOp op, double* out, const double* left, double scalar,        \
+                                         bool swap, size_t n) {                                                \
+        VEC s = SET1(scalar);                                                                                  \
+        size_t i = 0;                                                                                          \
+        switch (op) {                                                                                          \
+            case MS_ARRAY_ADD:                                                                                 \
+                if (swap) for (; i + WIDTH <= n; i += WIDTH) STORE(out + i, ADD(s, LOAD(left + i)));           \
+                else for (; i + WIDTH <= n; i += WIDTH) STORE(out + i, ADD(LOAD(left + i), s));                \
+                break;                                                                                         \
+            case MS_ARRAY_SUB:                                                                                 \
+                if (swap) for (; i + WIDTH <= n; i += WIDTH) STORE(out + i, SUB(s, LOAD(left + i)));           \
+                else for (; i + WIDTH <= n; i += WIDTH) STORE(out + i, SUB(LOAD(left + i), s));                \
+                break;                                                                                         \
+            case MS_ARRAY_MUL:                                                                                 \
+                if (swap) for (; i + WIDTH <= n; i += WIDTH) STORE(out + i, MUL(s, LOAD(left + i)));           \
+                else for (; i + WIDTH <= n; i += WIDTH) STORE(out + i, MUL(LOAD(left + i), s));                \
+                break;                                                                                         \
+            case MS_ARRAY_DIV:                                                                                 \
+                if (swap) for (; i + WIDTH <= n; i += WIDTH) STORE(out + i, DIV(s, LOAD(left + i)));           \
+                else for (; i + WIDTH <= n; i += WIDTH) STORE(out + i, DIV(LOAD(left + i), s));                \
+                break;                                                                                         \
+        }                                                                                                      \
+        scalar_map_scalar(op, out + i, left + i, scalar, swap, n - i);                                         \
+    }
+
+// --- SSE2 ბირთვები (2 double ერთ რეგისტრში, 8 ზოლი ოთხ რეგისტრში) ---
+
+DEFINE_MAP_KERNELS(sse2, , __m128d, 2, _mm_loadu_pd, _mm_storeu_pd, _mm_set1_pd, _mm_add_pd, _mm_sub_pd,
+                   _mm_mul_pd, _mm_div_pd)
+
+static bool sse2_map_int(MsArrayOp op, int64_t* out, const int64_t* left, const int64_t* right, size_t n) {
+    // SSE2/AVX2-ს 64-ბიტიანი მთელი გამრავლება არ აქვს.
+    if (op == MS_ARRAY_MUL) return scalar_map_int(op, out, left, right, n);
+    __m128i bias = _mm_set1_epi64x(INT_BIAS);
+    __m128i flag = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128i a = _mm_loadu_si128((const __m128i*)(left + i));
+        __m128i b = _mm_loadu_si128((const __m128i*)(right + i));
+        __m128i r = op == MS_ARRAY_ADD ? _mm_add_epi64(a, b) : _mm_sub_epi64(a, b);
+        flag = _mm_or_si128(flag, _mm_srli_epi64(_mm_add_epi64(r, bias), 54));
+        _mm_storeu_si128((__m128i*)(out + i), r);
+    }
+    bool ok = _mm_movemask_epi8(_mm_cmpeq_epi8(flag, _mm_setzero_si128())) == 0xFFFF;
+    return scalar_map_int(op, out + i, left + i, right + i, n - i) && ok;
+}
+
+static bool sse2_map_int_scalar(MsArrayOp op, int64_t* out, const int64_t* left, int64_t scalar, bool swap, size_t n) {
+    if (op == MS_ARRAY_MUL) return scalar_map_int_scalar(op, out, left, scalar, swap, n);
+    __m128i bias = _mm_set1_epi64x(INT_BIAS);
+    __m128i s = _mm_set1_epi64x(scalar);
+    __m128i flag = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128i a = _mm_loadu_si128((const __m128i*)(left + i));
+        __m128i r = op == MS_ARRAY_ADD ? _mm_add_epi64(a, s) : swap ? _mm_sub_epi64(s, a) : _mm_sub_epi64(a, s);
+        flag = _mm_or_si128(flag, _mm_srli_epi64(_mm_add_epi64(r, bias), 54));
+        _mm_storeu_si128((__m128i*)(out + i), r);
+    }
+    bool ok = _mm_movemask_epi8(_mm_cmpeq_epi8(flag, _mm_setzero_si128())) == 0xFFFF;
+    return scalar_map_int_scalar(op, out + i, left + i, scalar, swap, n - i) && ok;
+}
+
+static void sse2_store_lanes(double lanes[LANES], __m128d a, __m128d b, __m128d c, __m128d d) {
+    _mm_storeu_pd(lanes, a);
+    _mm_storeu_pd(lanes + 2, b);
+    _mm_storeu_pd(lanes + 4, c);
+    _mm_storeu_pd(lanes + 6, d);
+}
+
+static double sse2_sum(const double* x, size_t n) {
+    __m128d a = _mm_setzero_pd(), b = a, c = a, d = a;
+    size_t i = 0;
+    for (; i + LANES <= n; i += LANES) {
+        a = _mm_add_pd(a, _mm_loadu_pd(x + i));
+        b = _mm_add_pd(b, _mm_loadu_pd(x + i + 2));
+        c = _mm_add_pd(c, _mm_loadu_pd(x + i + 4));
+        d = _mm_add_pd(d, _mm_loadu_pd(x + i + 6));
+    }
+    double lanes[LANES];
+    sse2_store_lanes(lanes, a, b, c, d);
+    sum_tail(lanes, x, i, n);
+    return combine_sum(lanes);
+}
+
+static double sse2_dot(const double* x, const double* y, size_t n) {
+    __m128d a = _mm_setzero_pd(), b = a, c = a, d = a;
+    size_t i = 0;
+    for (; i + LANES <= n; i += LANES) {
+        a = _mm_add_pd(a, _mm_mul_pd(_mm_loadu_pd(x + i), _mm_loadu_pd(y + i)));
+        b = _mm_add_pd(b, _mm_mul_pd(_mm_loadu_pd(x + i + 2), _mm_loadu_pd(y + i + 2)));
+        c = _mm_add_pd(c, _mm_mul_pd(_mm_loadu_pd(x + i + 4), _mm_loadu_pd(y + i + 4)));
+        d = _mm_add_pd(d, _mm_mul_pd(_mm_loadu_pd(x + i + 6), _mm_loadu_pd(y + i + 6)));
+    }
+    double lanes[LANES];
+    sse2_store_lanes(lanes, a, b, c, d);
+    dot_tail(lanes, x, y, i, n);
+    return combine_sum(lanes);
+}
+
+// _mm_min_pd(x, m) = x < m ? x : m — ზუსტად სკალარული ბირთვის წესი (NaN-ისა და ±0-ის ჩათვლით).
+static double sse2_min(const double* x, size_t n) {
+    __m128d a = _mm_set1_pd(x[0]), b = a, c = a, d = a;
+    size_t i = 0;
+    for (; i + LANES <= n; i += LANES) {
+        a = _mm_min_pd(_mm_loadu_pd(x + i), a);
+        b = _mm_min_pd(_mm_loadu_pd(x + i + 2), b);
+        c = _mm_min_pd(_mm_loadu_pd(x + i + 4), c);
+        d = _mm_min_pd(_mm_loadu_pd(x + i + 6), d);
+    }
+    double lanes[LANES];
+    sse2_store_lanes(lanes, a, b, c, d);
+    min_tail(lanes, x, i, n);
+    return combine_min(lanes);
+}
+
+static double sse2_max(const double* x, size_t n) {
+    __m128d a = _mm_set1_pd(x[0]), b = a, c = a, d = a;
+    size_t i = 0;
+    for (; i + LANES <= n; i += LANES) {
+        a = _mm_max_pd(_mm_loadu_pd(x + i), a);
+        b = _mm_max_pd(_mm_loadu_pd(x + i + 2), b);
+        c = _mm_max_pd(_mm_loadu_pd(x + i + 4), c);
+        d = _mm_max_pd(_mm_loadu_pd(x + i + 6), d);
+    }
+    double lanes[LANES];
+    sse2_store_lanes(lanes, a, b, c, d);
+    max_tail(lanes, x, i, n);
+    return combine_max(lanes);
+}
+
+static int64_t sse2_sum_int(const int64_t* x, size_t n) {
+    __m128i sum = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) sum = _mm_add_epi64(sum, _mm_loadu_si128((const __m128i*)(x + i)));
+    int64_t parts[2];
+    _mm_storeu_si128((__m128i*)parts, sum);
+    return parts[0] + parts[1] + scalar_sum_int(x + i, n - i);
+}
+
+// --- AVX2 ბირთვები (4 double ერთ რეგისტრში, 8 ზოლი ორ რეგისტრში) ---
+
+#define AVX2 __attribute__((target("avx2")))
+
+DEFINE_MAP_KERNELS(avx2, AVX2, __m256d, 4, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_set1_pd, _mm256_add_pd,
+                   _mm256_sub_pd, _mm256_mul_pd, _mm256_div_pd)
+
+AVX2 static bool avx2_flags_clear(__m256i flag) {
+    return _mm256_testz_si256(flag, flag) != 0;
+}
+
+AVX2 static bool avx2_map_int(MsArrayOp op, int64_t* out, const int64_t* left, const int64_t* right, size_t n) {
+    if (op == MS_ARRAY_MUL) return scalar_map_int(op, out, left, right, n);
+    __m256i bias = _mm256_set1_epi64x(INT_BIAS);
+    __m256i flag = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i a = _mm256_loadu_si256((const __m256i*)(left + i));
+        __m256i b = _mm256_loadu_si256((const __m256i*)(right + i));
+        __m256i r = op == MS_ARRAY_ADD ? _mm256_add_epi64(a, b) : _mm256_sub_epi64(a, b);
+        flag = _mm256_or_si256(flag, _mm256_srli_epi64(_mm256_add_epi64(r, bias), 54));
+        _mm256_storeu_si256((__m256i*)(out + i), r);
+    }
+    bool ok = avx2_flags_clear(flag);
+    return scalar_map_int(op, out + i, left + i, right + i, n - i) && ok;
+}
+
+AVX2 static bool avx2_map_int_scalar(MsArrayOp op, int64_t* out, const int64_t* left, int64_t scalar, bool swap,
+                                     size_t n) {
+    if (op == MS_ARRAY_MUL) return scalar_map_int_scalar(op, out, left, scalar, swap, n);
+    __m256i bias = _mm256_set1_epi64x(INT_BIAS);
+    __m256i s = _mm256_set1_epi64x(scalar);
+    __m256i flag = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i a = _mm256_loadu_si256((const __m256i*)(left + i));
+        __m256i r = op == MS_ARRAY_ADD ? _mm256_add_epi64(a, s) : swap ? _mm256_sub_epi64(s, a) : _mm256_sub_epi64(a, s);
+        flag = _mm256_or_si256(flag, _mm256_srli_epi64(_mm256_add_epi64(r, bias), 54));
+        _mm256_storeu_si256((__m256i*)(out + i), r);
+    }
+    bool ok = avx2_flags_clear(flag);
+    return scalar_map_int_scalar(op, out + i, left + i, scalar, swap, n - i) && ok;
+}
+
+AVX2 static double avx2_sum(const double* x, size_t n) {
+    __m256d low = _mm256_setzero_pd(), high = low;
+    size_t i = 0;
+    for (; i + LANES <= n; i += LANES) {
+        low = _mm256_add_pd(low, _mm256_loadu_pd(x + i));
+        high = _mm256_add_pd(high, _mm256_loadu_pd(x + i + 4));
+    }
+    double lanes[LANES];
+    _mm256_storeu_pd(lanes, low);
+    _mm256_storeu_pd(lanes + 4, high);
+    sum_tail(lanes, x, i, n);
+    return combine_sum(lanes);
+}
+
+AVX2 static double avx2_dot(const double* x, const double* y, size_t n) {
+    __m256d low = _mm256_setzero_pd(), high = low;
+    size_t i = 0;
+    for (; i + LANES <= n; i += LANES) {
+        low = _mm256_add_pd(low, _mm256_mul_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i)));
+        high = _mm256_add_pd(high, _mm256_mul_pd(_mm256_loadu_pd(x + i + 4), _mm256_loadu_pd(y + i + 4)));
+    }
+    double lanes[LANES];
+    _mm256_storeu_pd(lanes, low);
+    _mm256_storeu_pd(lanes + 4, high);
+    dot_tail(lanes, x, y, i, n);
+    return combine_sum(lanes);
+}
+
+AVX2 static double avx2_min(const double* x, size_t n) {
+    __m256d low = _mm256_set1_pd(x[0]), high = low;
+    size_t i = 0;
+    for (; i + LANES <= n; i += LANES) {
+        low = _mm256_min_pd(_mm256_loadu_pd(x + i), low);
+        high = _mm256_min_pd(_mm256_loadu_pd(x + i + 4), high);
+    }
+    double lanes[LANES];
+    _mm256_storeu_pd(lanes, low);
+    _mm256_storeu_pd(lanes + 4, high);
+    min_tail(lanes, x, i, n);
+    return combine_min(lanes);
+}
+
+AVX2 static double avx2_max(const double* x, size_t n) {
+    __m256d low = _mm256_set1_pd(x[0]), high = low;
+    size_t i = 0;
+    for (; i + LANES <= n; i += LANES) {
+        low = _mm256_max_pd(_mm256_loadu_pd(x + i), low);
+        high = _mm256_max_pd(_mm256_loadu_pd(x + i + 4), high);
+    }
+    double lanes[LANES];
+    _mm256_storeu_pd(lanes, low);
+    _mm256_storeu_pd(lanes + 4, high);
+    max_tail(lanes, x, i, n);
+    return combine_max(lanes);
+}
+
+AVX2 static int64_t avx2_sum_int(const int64_t* x, size_t n) {
+    __m256i sum = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) sum = _mm256_add_epi64(sum, _mm256_loadu_si256((const __m256i*)(x + i)));
+    int64_t parts[4];
+    _mm256_storeu_si256((__m256i*)parts, sum);
+    return parts[0] + parts[1] + parts[2] + parts[3] + scalar_sum_int(x + i, n - i);
+}
+
+#endif // ARRAY_HAVE_X86
+
+// --- ბირთვების არჩევა ---
+
+static const MsArrayKernels scalar_kernels = {
+    "scalar", scalar_map, scalar_map_scalar, scalar_map_int, scalar_map_int_scalar,
+    scalar_sum, scalar_dot, scalar_min, scalar_max, scalar_sum_int,
+};
+
+#ifdef ARRAY_HAVE_X86
+static const MsArrayKernels sse2_kernels = {
+    "sse2", sse2_map, sse2_map_scalar, sse2_map_int, sse2_map_int_scalar,
+    sse2_sum, sse2_dot, sse2_min, sse2_max, sse2_sum_int,
+};
+
+static const MsArrayKernels avx2_kernels = {
+    "avx2", avx2_map, avx2_map_scalar, avx2_map_int, avx2_map_int_scalar,
+    avx2_sum, avx2_dot, avx2_min, avx2_max, avx2_sum_int,
+};
+#endif
+
+MsArrayKernels ms_array_kernels = {
+    "scalar", scalar_map, scalar_map_scalar, scalar_map_int, scalar_map_int_scalar,
+    scalar_sum, scalar_dot, scalar_min, scalar_max, scalar_sum_int,
+};
+
+bool ms_select_array_kernels(const char* name) {
+    if (strcmp(name, "scalar") == 0) {
+        ms_array_kernels = scalar_kernels;
+        return true;
+    }
+#ifdef ARRAY_HAVE_X86
+    __builtin_cpu_init();
+    if (strcmp(name, "sse2") == 0 && __builtin_cpu_supports("sse2")) {
+        ms_array_kernels = sse2_kernels;
+        return true;
+    }
+    if (strcmp(name, "avx2") == 0 && __builtin_cpu_supports("avx2")) {
+        ms_array_kernels = avx2_kernels;
+        return true;
+    }
+#endif
+    return false;
+}
+
+/** @brief ირჩევს საუკეთესო ხელმისაწვდომ ბირთვებს პროგრამის გაშვებისას. */
+__attribute__((constructor)) static void init_array_kernels(void) {
+    const char* forced = getenv("MANUSCRIPT_SIMD");
+    if (forced && ms_select_array_kernels(forced)) return;
+    if (ms_select_array_kernels("avx2")) return;
+    if (ms_select_array_kernels("sse2")) return;
+    ms_select_array_kernels("scalar");
+}
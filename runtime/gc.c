@@ -0,0 +1,378 @@
+/**
+ * @file gc.c
+ * @author გიორგი მაღრაძე (magradze.giorgi@gmail.com)
+ * @brief runtime ობიექტების თაობებიანი შემგროვებელი (GC).
+ * @version 0.3
+ *
+ * ახალი ობიექტები ბაგში (nursery) bump-ით გამოიყოფა — ერთი შედარება და
+ * მიმატება malloc-ის ნაცვლად. ბაგის შევსებისას მცირე შეგროვება ცოცხალ
+ * ობიექტებს ფესვებიდან ძველ თაობაში აკოპირებს (Cheney-ს სტილით: ახლად
+ * გადატანილი ობიექტების სია თავადაა დასამუშავებელი რიგი) და ბაგს
+ * მთლიანად ათავისუფლებს. ძველი თაობა არ გადაადგილდება და ზღვარის
+ * გადაჭარბებისას mark-sweep-ით იწმინდება.
+ *
+ * ობიექტები შექმნის შემდეგ უცვლელია, ამიტომ ძველი ობიექტი ახალს ვერ
+ * მიუთითებს და ჩაწერის ბარიერი საჭირო არ არის. ორი გამონაკლისი:
+ * თოკის გაბრტყელება (ასლი ms_gc_alloc_tenured-ით ძველ თაობაში იქმნება) და
+ * ბაგის შევსების შემდეგ ძველ თაობაში გამოყოფილი ობიექტები, რომლებიც
+ * მომდევნო მცირე შეგროვებისას ფესვებად ითვლება. მასივები ცვალებადია,
+ * მაგრამ მხოლოდ რიცხვებს შეიცავს, ამიტომ ეს წესი მათზეც ვრცელდება.
+ *
+ * მასივის ბუფერი ჰიპის გარეთაა: ახალგაზრდა მასივები ცალკე სიაშია და მცირე
+ * შეგროვება გადაუტანელი მასივების ბუფერებს ათავისუფლებს; ძველისას
+ * sweep ათავისუფლებს. ბუფერების ზომა ბაგისა და ძველი თაობის ზღვრებში ითვლება.
+ *
+ * `MANUSCRIPT_GC_STATS=1` პროგრამის დასრულებისას stderr-ში ბეჭდავს
+ * სტატისტიკას; `MANUSCRIPT_GC_NURSERY` ბაგის ზომას ცვლის (მაგ. `256K`).
+ */
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "runtime.h"
+
+#define NURSERY_DEFAULT_SIZE ((size_t)4 << 20)
+#define MAJOR_THRESHOLD_MIN ((size_t)16 << 20)
+#define OBJECT_ALIGNMENT 16
+
+/** @brief შემგროვებლის მდგომარეობა (პროცესზე ერთი). */
+typedef struct {
+    char* nursery;             // ბაგის არე
+    size_t nursery_size;
+    size_t nursery_used;       // bump მაჩვენებელი
+    MsObject** old;            // ძველი თაობის ობიექტები
+    size_t old_count;
+    size_t old_capacity;
+    size_t old_bytes;
+    size_t scan_start;         // ამ ინდექსიდან ძველი ობიექტები ბოლო მცირე შეგროვების შემდეგ გაჩნდა
+    size_t major_threshold;    // ამ ზომის გადაჭარბებისას დიდი შეგროვება სრულდება
+    MsArray** young_arrays;    // ბაგის მასივები, რომელთა ბუფერი შეიძლება გასათავისუფლებელი გახდეს
+    size_t young_array_count;
+    size_t young_array_capacity;
+    size_t external_young;     // ბაგის მასივების ბუფერების ბაიტები
+    MsValue** roots;           // რეგისტრირებული ცვლადები
+    size_t root_count;
+    size_t root_capacity;
+    MsGcStats stats;
+    struct timespec started;
+    bool initialized;
+} Heap;
+
+static Heap heap;
+
+bool ms_gc_pending = false;
+int ms_gc_defer_depth = 0;
+
+static void out_of_memory(void) {
+    fprintf(stderr, "FATAL: Memory allocation failed for runtime heap.\n");
+    exit(1);
+}
+
+static double seconds_since(const struct timespec* start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)(now.tv_sec - start->tv_sec) + (double)(now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+/** @brief კითხულობს ზომას K/M/G სუფიქსით; 0 — თუ ჩანაწერი არასწორია. */
+static size_t parse_size(const char* text) {
+    char* end;
+    unsigned long long value = strtoull(text, &end, 10);
+    if (end == text) return 0;
+    switch (*end) {
+        case 'k': case 'K': value <<= 10; end++; break;
+        case 'm': case 'M': value <<= 20; end++; break;
+        case 'g': case 'G': value <<= 30; end++; break;
+        default: break;
+    }
+    return *end == '\0' ? (size_t)value : 0;
+}
+
+static void print_stats(void) {
+    MsGcStats stats;
+    ms_gc_stats(&stats);
+    double megabytes = (double)stats.allocated_bytes / (1024.0 * 1024.0);
+    double rate = stats.elapsed_seconds > 0 ? megabytes / stats.elapsed_seconds : 0.0;
+    fprintf(stderr, "--- GC სტატისტიკა ---\n");
+    fprintf(stderr, "  გამოყოფა: %llu ობიექტი, %.2f MB (%.1f MB/წმ)\n",
+            (unsigned long long)stats.allocations, megabytes, rate);
+    fprintf(stderr, "  შეგროვება: %llu მცირე, %llu დიდი\n",
+            (unsigned long long)stats.minor_collections, (unsigned long long)stats.major_collections);
+    fprintf(stderr, "  გადატანილი: %.2f MB, გათავისუფლებული: %.2f MB\n",
+            (double)stats.promoted_bytes / (1024.0 * 1024.0), (double)stats.freed_bytes / (1024.0 * 1024.0));
+    fprintf(stderr, "  პაუზა: ჯამში %.3f ms, მაქსიმუმი %.3f ms\n", stats.total_pause_ms, stats.max_pause_ms);
+    fprintf(stderr, "  პიკური ჰიპი: %.2f MB\n", (double)stats.peak_heap_bytes / (1024.0 * 1024.0));
+}
+
+static void init_heap(void) {
+    const char* size = getenv("MANUSCRIPT_GC_NURSERY");
+    heap.nursery_size = size ? parse_size(size) : 0;
+    if (heap.nursery_size < 4096) heap.nursery_size = NURSERY_DEFAULT_SIZE;
+    heap.nursery = malloc(heap.nursery_size);
+    if (heap.nursery == NULL) out_of_memory();
+    heap.major_threshold = MAJOR_THRESHOLD_MIN;
+    clock_gettime(CLOCK_MONOTONIC, &heap.started);
+    heap.initialized = true;
+
+    const char* stats = getenv("MANUSCRIPT_GC_STATS");
+    if (stats != NULL && stats[0] != '\0' && strcmp(stats, "0") != 0) atexit(print_stats);
+}
+
+static void update_peak(void) {
+    uint64_t used = (uint64_t)(heap.nursery_used + heap.external_young + heap.old_bytes);
+    if (used > heap.stats.peak_heap_bytes) heap.stats.peak_heap_bytes = used;
+}
+
+/** @brief ობიექტის სრული ზომა (სათაურით და ჩაშენებული ბაიტებით). */
+static size_t object_size(const MsObject* object) {
+    switch (object->type) {
+        case MS_OBJ_STRING: return sizeof(MsString) + ((const MsString*)object)->length + 1;
+        case MS_OBJ_ROPE: return sizeof(MsRope);
+        case MS_OBJ_ARRAY: return sizeof(MsArray);
+        default: return sizeof(MsObject);
+    }
+}
+
+/** @brief გამოყოფს ძველი თაობის ობიექტს და ამატებს მას სიაში. */
+static MsObject* allocate_old(size_t size) {
+    if (heap.old_count >= heap.old_capacity) {
+        heap.old_capacity = heap.old_capacity < 1024 ? 1024 : heap.old_capacity * 2;
+        MsObject** grown = realloc(heap.old, heap.old_capacity * sizeof(MsObject*));
+        if (grown == NULL) out_of_memory();
+        heap.old = grown;
+    }
+    MsObject* object = malloc(size);
+    if (object == NULL) out_of_memory();
+    heap.old[heap.old_count++] = object;
+    heap.old_bytes += size;
+    if (heap.old_bytes > heap.major_threshold) ms_gc_pending = true;
+    return object;
+}
+
+bool ms_gc_is_young(const MsObject* object) {
+    const char* address = (const char*)object;
+    return heap.nursery != NULL && address >= heap.nursery && address < heap.nursery + heap.nursery_size;
+}
+
+void* ms_gc_alloc(size_t size) {
+    if (!heap.initialized) init_heap();
+    heap.stats.allocations++;
+    heap.stats.allocated_bytes += size;
+
+    size_t aligned = (size + OBJECT_ALIGNMENT - 1) & ~(size_t)(OBJECT_ALIGNMENT - 1);
+    // დიდი ობიექტის კოპირება ძვირია, ამიტომ ის პირდაპირ ძველ თაობაში იქმნება.
+    if (aligned <= heap.nursery_size / 4) {
+        if (aligned <= heap.nursery_size - heap.nursery_used) {
+            void* object = heap.nursery + heap.nursery_used;
+            heap.nursery_used += aligned;
+            update_peak();
+            return object;
+        }
+        // შეგროვება მხოლოდ უსაფრთხო წერტილშია შესაძლებელი; მანამდე ძველ თაობაში ვაგრძელებთ.
+        ms_gc_pending = true;
+    }
+    void* object = allocate_old(size);
+    update_peak();
+    return object;
+}
+
+void* ms_gc_alloc_tenured(size_t size) {
+    if (!heap.initialized) init_heap();
+    heap.stats.allocations++;
+    heap.stats.allocated_bytes += size;
+    void* object = allocate_old(size);
+    update_peak();
+    return object;
+}
+
+/** @brief მასივის ბუფერის ბაიტები (ობიექტის სათაურის გარეშე). */
+static size_t array_bytes(const MsArray* array) {
+    return array->data != NULL ? ms_array_data_bytes(array->capacity) : 0;
+}
+
+/** @brief ბუფერის ზრდა: ბაგის მასივი ბაგის ზღვარს უახლოვდება, ძველი — დიდი შეგროვებისას. */
+static void account_array_bytes(const MsArray* array, size_t bytes) {
+    heap.stats.allocated_bytes += bytes;
+    if (ms_gc_is_young(&array->object)) {
+        heap.external_young += bytes;
+        if (heap.external_young > heap.nursery_size) ms_gc_pending = true;
+    } else {
+        heap.old_bytes += bytes;
+        if (heap.old_bytes > heap.major_threshold) ms_gc_pending = true;
+    }
+    update_peak();
+}
+
+void ms_gc_track_array(MsArray* array) {
+    if (ms_gc_is_young(&array->object)) {
+        if (heap.young_array_count >= heap.young_array_capacity) {
+            heap.young_array_capacity = heap.young_array_capacity < 64 ? 64 : heap.young_array_capacity * 2;
+            MsArray** grown = realloc(heap.young_arrays, heap.young_array_capacity * sizeof(MsArray*));
+            if (grown == NULL) out_of_memory();
+            heap.young_arrays = grown;
+        }
+        heap.young_arrays[heap.young_array_count++] = array;
+    }
+    account_array_bytes(array, array_bytes(array));
+}
+
+void ms_gc_array_resized(MsArray* array, size_t old_capacity) {
+    size_t old_size = old_capacity > 0 ? ms_array_data_bytes(old_capacity) : 0;
+    account_array_bytes(array, array_bytes(array) - old_size);
+}
+
+void ms_gc_add_root(MsValue* slot) {
+    if (heap.root_count >= heap.root_capacity) {
+        heap.root_capacity = heap.root_capacity < 64 ? 64 : heap.root_capacity * 2;
+        MsValue** grown = realloc(heap.roots, heap.root_capacity * sizeof(MsValue*));
+        if (grown == NULL) out_of_memory();
+        heap.roots = grown;
+    }
+    heap.roots[heap.root_count++] = slot;
+}
+
+size_t ms_gc_root_mark(void) {
+    return heap.root_count;
+}
+
+void ms_gc_release_roots(size_t mark) {
+    if (mark < heap.root_count) heap.root_count = mark;
+}
+
+// --- მცირე შეგროვება ---
+
+/** @brief გადააქვს ბაგის ობიექტი ძველ თაობაში (ერთხელ) და აბრუნებს ახალ მნიშვნელობას. */
+static MsValue evacuate(MsValue value) {
+    if (!ms_is_object(value)) return value;
+    MsObject* object = ms_as_object(value);
+    if (!ms_gc_is_young(object)) return value;
+    MsObject** forward = (MsObject**)(object + 1);
+    if (object->flags & MS_FLAG_FORWARDED) return ms_object(*forward);
+
+    size_t size = object_size(object);
+    MsObject* copy = allocate_old(size);
+    memcpy(copy, object, size);
+    if (copy->type == MS_OBJ_STRING) ((MsString*)copy)->chars = (const char*)((MsString*)copy + 1);
+    if (copy->type == MS_OBJ_ARRAY) {
+        // ბუფერი არ კოპირდება: მას ახლა ძველი ასლი ფლობს.
+        size_t external = array_bytes((MsArray*)copy);
+        heap.old_bytes += external;
+        heap.stats.promoted_bytes += external;
+    }
+    heap.stats.promoted_bytes += size;
+
+    object->flags |= MS_FLAG_FORWARDED;
+    *forward = copy;
+    return ms_object(copy);
+}
+
+static void evacuate_children(MsObject* object) {
+    if (object->type != MS_OBJ_ROPE) return;
+    MsRope* rope = (MsRope*)object;
+    rope->left = evacuate(rope->left);
+    rope->right = evacuate(rope->right);
+    rope->flat = evacuate(rope->flat);
+}
+
+static void minor_collection(void) {
+    for (size_t i = 0; i < heap.root_count; i++) *heap.roots[i] = evacuate(*heap.roots[i]);
+    // ბოლო შეგროვების შემდეგ გაჩენილი ძველი ობიექტები (გადატანილიც და პირდაპირ
+    // გამოყოფილიც) შეიძლება ბაგს მიუთითებდეს; სია ზრდასთან ერთად მუშავდება.
+    for (size_t i = heap.scan_start; i < heap.old_count; i++) evacuate_children(heap.old[i]);
+    heap.scan_start = heap.old_count;
+    // გადაუტანელი მასივი მკვდარია; გადატანილის სათაურში უკვე გადამისამართებაა.
+    for (size_t i = 0; i < heap.young_array_count; i++) {
+        MsArray* array = heap.young_arrays[i];
+        if (!(array->object.flags & MS_FLAG_FORWARDED)) free(array->data);
+    }
+    heap.young_array_count = 0;
+    heap.external_young = 0;
+    heap.nursery_used = 0;
+    heap.stats.minor_collections++;
+}
+
+// --- დიდი შეგროვება ---
+
+typedef struct {
+    MsObject** items;
+    size_t count;
+    size_t capacity;
+} MarkStack;
+
+static void mark_value(MarkStack* stack, MsValue value) {
+    if (!ms_is_object(value)) return;
+    MsObject* object = ms_as_object(value);
+    if (object->flags & (MS_FLAG_MARKED | MS_FLAG_STATIC)) return;
+    object->flags |= MS_FLAG_MARKED;
+    if (stack->count >= stack->capacity) {
+        stack->capacity = stack->capacity < 256 ? 256 : stack->capacity * 2;
+        MsObject** grown = realloc(stack->items, stack->capacity * sizeof(MsObject*));
+        if (grown == NULL) out_of_memory();
+        stack->items = grown;
+    }
+    stack->items[stack->count++] = object;
+}
+
+/** @brief მონიშნავს ფესვებიდან მიღწევად ობიექტებს და ათავისუფლებს დანარჩენს. */
+static void major_collection(void) {
+    MarkStack stack = { NULL, 0, 0 };
+    for (size_t i = 0; i < heap.root_count; i++) mark_value(&stack, *heap.roots[i]);
+    // თოკები ღრმა შეიძლება იყოს, ამიტომ მონიშვნა რეკურსიის ნაცვლად დასტით ხდება.
+    while (stack.count > 0) {
+        MsObject* object = stack.items[--stack.count];
+        if (object->type == MS_OBJ_ROPE) {
+            MsRope* rope = (MsRope*)object;
+            mark_value(&stack, rope->left);
+            mark_value(&stack, rope->right);
+            mark_value(&stack, rope->flat);
+        }
+    }
+    free(stack.items);
+
+    size_t live = 0;
+    for (size_t i = 0; i < heap.old_count; i++) {
+        MsObject* object = heap.old[i];
+        if (object->flags & MS_FLAG_MARKED) {
+            object->flags &= ~MS_FLAG_MARKED;
+            heap.old[live++] = object;
+        } else {
+            size_t size = object_size(object);
+            if (object->type == MS_OBJ_ARRAY) {
+                size += array_bytes((MsArray*)object);
+                free(((MsArray*)object)->data);
+            }
+            heap.old_bytes -= size;
+            heap.stats.freed_bytes += size;
+            free(object);
+        }
+    }
+    heap.old_count = live;
+    heap.scan_start = live;
+    heap.major_threshold = heap.old_bytes * 2 > MAJOR_THRESHOLD_MIN ? heap.old_bytes * 2 : MAJOR_THRESHOLD_MIN;
+    heap.stats.major_collections++;
+}
+
+void ms_gc_collect(void) {
+    if (!heap.initialized) {
+        ms_gc_pending = false;
+        return;
+    }
+
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    // მცირე შეგროვება ბაგს ცლის, ამიტომ დიდს მხოლოდ ძველი თაობა რჩება.
+    minor_collection();
+    if (heap.old_bytes > heap.major_threshold) major_collection();
+    // გადატანისას allocate_old-მა შეიძლება დროშა ხელახლა დააყენა.
+    ms_gc_pending = false;
+
+    double pause = seconds_since(&start) * 1000.0;
+    heap.stats.total_pause_ms += pause;
+    if (pause > heap.stats.max_pause_ms) heap.stats.max_pause_ms = pause;
+}
+
+void ms_gc_stats(MsGcStats* stats) {
+    *stats = heap.stats;
+    stats->elapsed_seconds = heap.initialized ? seconds_since(&heap.started) : 0.0;
+}
@@ -0,0 +1,342 @@
+/**
+ * @file parallel.c
+ * @author გიორგი მაღრაძე (magradze.giorgi@gmail.com)
+ * @brief `პარალელური ყოველი`-ს დამგეგმავი: ნაკადების აუზი სამუშაოს მოპარვით.
+ * @version 0.1
+ *
+ * დიაპაზონი ტოლ ნაჭრებად (chunk) იყოფა, ამოცანა კი ნაჭრების შუალედია
+ * [first, last), ერთ 64-ბიტიან სიტყვაში შეფუთული. ყოველ ნაკადს საკუთარი
+ * Chase-Lev დეკი აქვს: მფლობელი ამოცანას შუაზე ყოფს, ზედა ნახევარს დეკის
+ * ბოლოში დებს და ქვედასთან აგრძელებს, სანამ ერთი ნაჭერი არ დარჩება;
+ * უსაქმო ნაკადი შემთხვევითი მსხვერპლის დეკის თავიდან იპარავს — ყველაზე
+ * დიდ დარჩენილ ნახევარს. ორად გაყოფის გამო დეკის სიღრმე ნაჭრების
+ * რაოდენობის ლოგარითმს არ აღემატება, ამიტომ ბუფერი ფიქსირებულია.
+ * დეკის მეხსიერების რიგი მიჰყვება Lê et al., "Correct and Efficient
+ * Work-Stealing for Weak Memory Models" (PPoPP 2013).
+ *
+ * გამომძახებელი ნაკადი 0 ნომრის მუშაა; დანარჩენი ნაკადები პირველი
+ * პარალელური ციკლისას იქმნება და ციკლებს შორის პირობით ცვლადზე სძინავს.
+ * ms_parallel_for მხოლოდ მთავარი ნაკადიდან გამოიძახება: სხეულში ჩადგმულ
+ * `პარალელური ყოველი`-ს C ბექენდი ჩვეულებრივ ციკლად აგენერირებს.
+ * რედუქციები (მთელი ჯამი, მინიმუმი, მაქსიმუმი) ყოველი ნაკადის საკუთარ,
+ * ქეშის ხაზზე გასწორებულ შუალედურებში გროვდება და ბოლოს ნაკადების რიგით
+ * ერთიანდება; მთელ რიცხვებზე ეს ზუსტია, ამიტომ შედეგი განაწილებაზე არ
+ * არის დამოკიდებული. ნაკადების რაოდენობას `MANUSCRIPT_THREADS` ცვლის
+ * (ნაგულისხმევად — პროცესორების რაოდენობა).
+ */
+#define _POSIX_C_SOURCE 200809L
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "runtime.h"
+
+#define DEQUE_CAPACITY 64          // ორის ხარისხი; ორად გაყოფის სიღრმე <= log2(MAX_CHUNKS) + 1
+#define MAX_WORKERS 256
+#define CHUNKS_PER_WORKER 16       // დატვირთვის გასათანაბრებლად ნაკადზე რამდენიმე ნაჭერი მოდის
+#define MAX_CHUNKS ((int64_t)MAX_WORKERS * CHUNKS_PER_WORKER)
+#define CACHE_LINE 64
+#define PARTIALS_PER_LINE (CACHE_LINE / (int)sizeof(int64_t))
+#define STEAL_SPINS 64             // წარუმატებელი მოპარვების რაოდენობა sched_yield-მდე
+
+#define TASK_EMPTY UINT64_MAX
+#define TASK_ABORT (UINT64_MAX - 1)
+
+/** @brief ერთი მუშის Chase-Lev დეკი (მფლობელი — ბოლოდან, ქურდები — თავიდან). */
+typedef struct {
+    _Alignas(CACHE_LINE) _Atomic int64_t top;
+    _Alignas(CACHE_LINE) _Atomic int64_t bottom;
+    _Atomic uint64_t tasks[DEQUE_CAPACITY];
+} Deque;
+
+/** @brief აუზის მუშა. */
+typedef struct {
+    Deque deque;
+    int64_t* partials;         // რედუქციების შუალედურები (საკუთარ ქეშის ხაზებზე)
+    unsigned int seed;         // მსხვერპლის შემთხვევითი არჩევა
+    pthread_t thread;
+} Worker;
+
+/** @brief აუზი და მიმდინარე ციკლი (პროცესზე ერთი). */
+typedef struct {
+    Worker* workers;
+    int worker_count;          // 0 — რაოდენობა ჯერ არ წაკითხულა
+    bool started;              // დამხმარე ნაკადები შექმნილია
+    pthread_mutex_t lock;
+    pthread_cond_t wake;       // ახალი ციკლი ან გაჩერება
+    pthread_cond_t done;       // ყველა დამხმარე ნაკადმა ციკლი დატოვა
+    uint64_t generation;       // ციკლის ნომერი (lock-ით)
+    int busy;                  // ციკლში დარჩენილი დამხმარე ნაკადები (lock-ით)
+    bool shutdown;
+    // მიმდინარე ციკლი: იწერება generation-ის გაზრდამდე და ციკლში არ იცვლება.
+    MsParallelBody body;
+    const void* context;
+    int64_t start;
+    int64_t end;
+    int64_t chunk;             // ნაჭრის ზომა იტერაციებში
+    size_t partial_stride;     // მუშების შუალედურებს შორის მანძილი (ელემენტებში)
+    _Atomic int64_t remaining; // შეუსრულებელი ნაჭრები
+} Pool;
+
+static Pool pool = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .wake = PTHREAD_COND_INITIALIZER,
+    .done = PTHREAD_COND_INITIALIZER,
+};
+
+static inline uint64_t pack_task(int64_t first, int64_t last) {
+    return (uint64_t)first << 32 | (uint64_t)last;
+}
+
+// --- Chase-Lev დეკი ---
+
+static void deque_push(Deque* deque, uint64_t task) {
+    int64_t bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+    atomic_store_explicit(&deque->tasks[bottom & (DEQUE_CAPACITY - 1)], task, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+}
+
+static uint64_t deque_take(Deque* deque) {
+    int64_t bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed) - 1;
+    atomic_store_explicit(&deque->bottom, bottom, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+    if (top > bottom) {
+        atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+        return TASK_EMPTY;
+    }
+    uint64_t task = atomic_load_explicit(&deque->tasks[bottom & (DEQUE_CAPACITY - 1)], memory_order_relaxed);
+    if (top == bottom) {
+        // ბოლო ამოცანა: ქურდს top-ის CAS-ით ვეჯიბრებით.
+        if (!atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1, memory_order_seq_cst,
+                                                     memory_order_relaxed)) {
+            task = TASK_EMPTY;
+        }
+        atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+    }
+    return task;
+}
+
+static uint64_t deque_steal(Deque* deque) {
+    int64_t top = atomic_load_explicit(&deque->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t bottom = atomic_load_explicit(&deque->bottom, memory_order_acquire);
+    if (top >= bottom) return TASK_EMPTY;
+    uint64_t task = atomic_load_explicit(&deque->tasks[top & (DEQUE_CAPACITY - 1)], memory_order_relaxed);
+    if (!atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1, memory_order_seq_cst,
+                                                 memory_order_relaxed)) {
+        return TASK_ABORT;
+    }
+    return task;
+}
+
+// --- შესრულება ---
+
+/** @brief ცდილობს სხვა მუშის დეკიდან ამოცანის მოპარვას (შემთხვევითი მსხვერპლიდან დაწყებული). */
+static uint64_t steal_task(int index) {
+    Worker* self = &pool.workers[index];
+    self->seed = self->seed * 1103515245u + 12345u;
+    int first = (int)((self->seed >> 16) % (unsigned int)pool.worker_count);
+    for (int i = 0; i < pool.worker_count; i++) {
+        int victim = (first + i) % pool.worker_count;
+        if (victim == index) continue;
+        uint64_t task = deque_steal(&pool.workers[victim].deque);
+        if (task != TASK_EMPTY && task != TASK_ABORT) return task;
+    }
+    return TASK_EMPTY;
+}
+
+/** @brief ასრულებს ამოცანას: ზედა ნახევრებს დეკში დებს და პირველ ნაჭერს თავად ასრულებს. */
+static void run_task(Worker* self, uint64_t task) {
+    int64_t first = (int64_t)(task >> 32);
+    int64_t last = (int64_t)(task & UINT32_MAX);
+    while (last - first > 1) {
+        int64_t middle = first + (last - first) / 2;
+        deque_push(&self->deque, pack_task(middle, last));
+        last = middle;
+    }
+    int64_t start = pool.start + first * pool.chunk;
+    int64_t end = pool.end - start > pool.chunk ? start + pool.chunk : pool.end;
+    pool.body(start, end, pool.context, self->partials);
+    atomic_fetch_sub_explicit(&pool.remaining, 1, memory_order_acq_rel);
+}
+
+/** @brief მუშის მონაწილეობა მიმდინარე ციკლში, სანამ ყველა ნაჭერი არ შესრულდება. */
+static void run_loop(int index) {
+    Worker* self = &pool.workers[index];
+    int failures = 0;
+    while (atomic_load_explicit(&pool.remaining, memory_order_acquire) > 0) {
+        uint64_t task = deque_take(&self->deque);
+        if (task == TASK_EMPTY) task = steal_task(index);
+        if (task == TASK_EMPTY) {
+            if (++failures >= STEAL_SPINS) {
+                failures = 0;
+                sched_yield();
+            }
+            continue;
+        }
+        failures = 0;
+        run_task(self, task);
+    }
+}
+
+/** @brief დამხმარე ნაკადი: ელოდება ციკლს, მონაწილეობს და ისევ იძინებს. */
+static void* worker_main(void* argument) {
+    int index = (int)(intptr_t)argument;
+    uint64_t seen = 0;
+    pthread_mutex_lock(&pool.lock);
+    for (;;) {
+        while (pool.generation == seen && !pool.shutdown) pthread_cond_wait(&pool.wake, &pool.lock);
+        if (pool.shutdown) break;
+        seen = pool.generation;
+        pthread_mutex_unlock(&pool.lock);
+        run_loop(index);
+        pthread_mutex_lock(&pool.lock);
+        if (--pool.busy == 0) pthread_cond_signal(&pool.done);
+    }
+    pthread_mutex_unlock(&pool.lock);
+    return NULL;
+}
+
+// --- აუზი ---
+
+/** @brief კითხულობს ნაკადების რაოდენობას (MANUSCRIPT_THREADS, შემდეგ პროცესორები). */
+static int configured_workers(void) {
+    const char* threads = getenv("MANUSCRIPT_THREADS");
+    long count = threads != NULL && threads[0] != '\0' ? strtol(threads, NULL, 10) : sysconf(_SC_NPROCESSORS_ONLN);
+    if (count < 1) count = 1;
+    return count > MAX_WORKERS ? MAX_WORKERS : (int)count;
+}
+
+/** @brief ამზადებს მუშებს; დამხმარე ნაკადები მხოლოდ start_threads-ით იქმნება. */
+static void init_pool(int count) {
+    pool.worker_count = count;
+    pool.workers = aligned_alloc(CACHE_LINE, sizeof(Worker) * (size_t)count);
+    if (!pool.workers) {
+        fprintf(stderr, "FATAL: Memory allocation failed for parallel workers.\n");
+        exit(1);
+    }
+    memset(pool.workers, 0, sizeof(Worker) * (size_t)count);
+    for (int i = 0; i < count; i++) pool.workers[i].seed = 2654435761u * (unsigned int)(i + 1);
+    pool.started = false;
+    pool.shutdown = false;
+    pool.generation = 0;
+    pool.partial_stride = 0;
+}
+
+static void start_threads(void) {
+    for (int i = 1; i < pool.worker_count; i++) {
+        if (pthread_create(&pool.workers[i].thread, NULL, worker_main, (void*)(intptr_t)i) != 0) {
+            fprintf(stderr, "FATAL: Thread creation failed for parallel workers.\n");
+            exit(1);
+        }
+    }
+    pool.started = true;
+}
+
+/** @brief უზრუნველყოფს, რომ ყოველ მუშას `count` შუალედურისთვის ადგილი ჰქონდეს. */
+static void reserve_partials(int count) {
+    size_t stride = ((size_t)count + PARTIALS_PER_LINE - 1) / PARTIALS_PER_LINE * PARTIALS_PER_LINE;
+    if (stride <= pool.partial_stride) return;
+    for (int i = 0; i < pool.worker_count; i++) {
+        free(pool.workers[i].partials);
+        pool.workers[i].partials = aligned_alloc(CACHE_LINE, stride * sizeof(int64_t));
+        if (!pool.workers[i].partials) {
+            fprintf(stderr, "FATAL: Memory allocation failed for parallel reductions.\n");
+            exit(1);
+        }
+    }
+    pool.partial_stride = stride;
+}
+
+static int64_t reduction_identity(uint8_t reduction) {
+    switch (reduction) {
+        case MS_REDUCE_MIN: return INT64_MAX;
+        case MS_REDUCE_MAX: return INT64_MIN;
+        default: return 0;
+    }
+}
+
+static int64_t combine(uint8_t reduction, int64_t left, int64_t right) {
+    switch (reduction) {
+        case MS_REDUCE_MIN: return right < left ? right : left;
+        case MS_REDUCE_MAX: return right > left ? right : left;
+        default: return left + right;
+    }
+}
+
+int ms_parallel_workers(void) {
+    if (pool.worker_count == 0) init_pool(configured_workers());
+    return pool.worker_count;
+}
+
+void ms_parallel_set_workers(int count) {
+    if (pool.worker_count > 0) {
+        if (pool.started) {
+            pthread_mutex_lock(&pool.lock);
+            pool.shutdown = true;
+            pthread_cond_broadcast(&pool.wake);
+            pthread_mutex_unlock(&pool.lock);
+            for (int i = 1; i < pool.worker_count; i++) pthread_join(pool.workers[i].thread, NULL);
+        }
+        for (int i = 0; i < pool.worker_count; i++) free(pool.workers[i].partials);
+        free(pool.workers);
+        pool.workers = NULL;
+    }
+    init_pool(count < 1 ? 1 : count > MAX_WORKERS ? MAX_WORKERS : count);
+}
+
+void ms_parallel_for(int64_t start, int64_t end, MsParallelBody body, const void* context, int64_t* results,
+                     const uint8_t* reductions, int reduction_count) {
+    if (end <= start) return;
+    int workers = ms_parallel_workers();
+    reserve_partials(reduction_count);
+    for (int w = 0; w < workers; w++) {
+        for (int k = 0; k < reduction_count; k++) pool.workers[w].partials[k] = reduction_identity(reductions[k]);
+    }
+
+    // ნაჭრის ზომა ისეა შერჩეული, რომ ნაჭრები MAX_CHUNKS-ს (და 2^32-ს) არ აღემატებოდეს.
+    uint64_t iterations = (uint64_t)end - (uint64_t)start;
+    uint64_t target = (uint64_t)workers * CHUNKS_PER_WORKER;
+    uint64_t chunk = iterations / target + (iterations % target != 0);
+    int64_t chunks = (int64_t)(iterations / chunk + (iterations % chunk != 0));
+
+    if (workers == 1 || chunks == 1) {
+        int64_t* partials = pool.workers[0].partials;
+        body(start, end, context, partials);
+        for (int k = 0; k < reduction_count; k++) results[k] = combine(reductions[k], results[k], partials[k]);
+        return;
+    }
+
+    if (!pool.started) start_threads();
+    pool.body = body;
+    pool.context = context;
+    pool.start = start;
+    pool.end = end;
+    pool.chunk = (int64_t)chunk;
+    atomic_store_explicit(&pool.remaining, chunks, memory_order_relaxed);
+    deque_push(&pool.workers[0].deque, pack_task(0, chunks));
+
+    pthread_mutex_lock(&pool.lock);
+    pool.generation++;
+    pool.busy = workers - 1;
+    pthread_cond_broadcast(&pool.wake);
+    pthread_mutex_unlock(&pool.lock);
+
+    run_loop(0);
+
+    // დამხმარე ნაკადები ციკლს უნდა დატოვებდნენ, სანამ შუალედურებს წავიკითხავთ.
+    pthread_mutex_lock(&pool.lock);
+    while (pool.busy > 0) pthread_cond_wait(&pool.done, &pool.lock);
+    pthread_mutex_unlock(&pool.lock);
+
+    for (int w = 0; w < workers; w++) {
+        for (int k = 0; k < reduction_count; k++) {
+            results[k] = combine(reductions[k], results[k], pool.workers[w].partials[k]);
+        }
+    }
+}
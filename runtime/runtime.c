@@ -2,14 +2,248 @@
 * @file runtime.c
  * @author გიორგი მაღრაძე (magradze.giorgi@gmail.com)
  * @brief "მანუსკრიპტი" ენის დამხმარე (runtime) ფუნქციების იმპლემენტაცია.
- * @version 0.1
+ * @version 0.8
  * @date 2024-05-21
  *
  * @copyright Copyright (c) 2024
  * Website: https://magradze.dev
  * GitHub: https://github.com/magradze
  */
+#include <stdio.h>
+#include <stdlib.h>
 #include "runtime.h"
 
-// მომავალში აქ დაემატება `დაბეჭდე` ფუნქციის რეალური იმპლემენტაცია,
-// რომელიც გენერირებულ C კოდში იქნება გამოყენებული.
\ No newline at end of file
+// ამაზე მოკლე შეერთება პირდაპირ კოპირდება: პატარა თოკები მეხსიერებას უფრო მეტს ხარჯავს.
+#define ROPE_MIN_LENGTH 64
+
+const char* ms_type_name(MsValue value) {
+    if (ms_is_number(value)) return "რიცხვი";
+    if (ms_is_bool(value)) return "ლოგიკური";
+    if (ms_is_none(value)) return "არარა";
+    if (ms_is_string(value)) return "სტრიქონი";
+    if (ms_is_array(value)) return "მასივი";
+    return "ობიექტი";
+}
+
+/** @brief გამოყოფს ობიექტს შემგროვებლის ჰიპში (`tenured` — პირდაპირ ძველ თაობაში). */
+static void* allocate_object(size_t size, MsObjectType type, bool tenured) {
+    MsObject* object = tenured ? ms_gc_alloc_tenured(size) : ms_gc_alloc(size);
+    object->type = type;
+    object->flags = 0;
+    return object;
+}
+
+/** @brief ქმნის ბრტყელ სტრიქონს, რომლის ბაიტები ობიექტის ბოლოშია. */
+static MsString* allocate_string(size_t length, char** chars, bool tenured) {
+    MsString* string = allocate_object(sizeof(MsString) + length + 1, MS_OBJ_STRING, tenured);
+    *chars = (char*)(string + 1);
+    (*chars)[length] = '\0';
+    string->length = length;
+    string->chars = *chars;
+    return string;
+}
+
+MsValue ms_string_from(const char* chars, size_t length) {
+    if (ms_fits_small_string(chars, length)) return ms_small_string(chars, length);
+    char* data;
+    MsString* string = allocate_string(length, &data, false);
+    memcpy(data, chars, length);
+    return ms_string_value(string);
+}
+
+size_t ms_string_length(MsValue value) {
+    if (ms_is_small_string(value)) return ms_small_string_length(value);
+    MsObject* object = ms_as_object(value);
+    return object->type == MS_OBJ_ROPE ? ((MsRope*)object)->length : ((MsString*)object)->length;
+}
+
+static const char* string_chars(MsValue value, char small[MS_SMALL_STRING_MAX + 1]);
+
+/**
+ * @brief აკოპირებს სტრიქონის ბაიტებს `dest`-ში. თოკის ხე იტერაციულად
+ * ივლება (ციკლში აგებული თოკი მარცხნივ ღრმაა), ამიტომ სიღრმე სტეკს არ ავსებს.
+ */
+static void copy_string(MsValue value, char* dest) {
+    size_t capacity = 64, count = 0;
+    MsValue* stack = malloc(capacity * sizeof(MsValue));
+    if (stack == NULL) {
+        fprintf(stderr, "FATAL: Memory allocation failed for rope traversal.\n");
+        exit(1);
+    }
+    stack[count++] = value;
+    while (count > 0) {
+        MsValue item = stack[--count];
+        if (!ms_is_small_string(item) && ms_as_object(item)->type == MS_OBJ_ROPE &&
+            ((MsRope*)ms_as_object(item))->flat == MS_NONE) {
+            MsRope* rope = (MsRope*)ms_as_object(item);
+            if (count + 2 > capacity) {
+                capacity *= 2;
+                MsValue* grown = realloc(stack, capacity * sizeof(MsValue));
+                if (grown == NULL) {
+                    fprintf(stderr, "FATAL: Memory allocation failed for rope traversal.\n");
+                    exit(1);
+                }
+                stack = grown;
+            }
+            stack[count++] = rope->right;
+            stack[count++] = rope->left;
+            continue;
+        }
+        char small[MS_SMALL_STRING_MAX + 1];
+        size_t length = ms_string_length(item);
+        memcpy(dest, string_chars(item, small), length);
+        dest += length;
+    }
+    free(stack);
+}
+
+/**
+ * @brief აბრუნებს სტრიქონის უწყვეტ ბაიტებს. თოკი პირველ მოთხოვნაზე
+ * ერთხელ ბრტყელდება და ასლი ინახება; მოკლე სტრიქონი `small`-ში იშლება.
+ */
+static const char* string_chars(MsValue value, char small[MS_SMALL_STRING_MAX + 1]) {
+    if (ms_is_small_string(value)) {
+        size_t length = ms_small_string_length(value);
+        for (size_t i = 0; i < length; i++) small[i] = (char)((value >> (8 * i)) & 0xFF);
+        small[length] = '\0';
+        return small;
+    }
+    MsObject* object = ms_as_object(value);
+    if (object->type == MS_OBJ_STRING) return ((MsString*)object)->chars;
+
+    MsRope* rope = (MsRope*)object;
+    if (rope->flat == MS_NONE) {
+        // ძველი თოკის ასლიც ძველ თაობაშია, რომ ძველი → ახალი მაჩვენებელი არ გაჩნდეს.
+        char* flat;
+        MsString* string = allocate_string(rope->length, &flat, !ms_gc_is_young(object));
+        copy_string(ms_object(object), flat);
+        rope->flat = ms_string_value(string);
+    }
+    return ((MsString*)ms_as_object(rope->flat))->chars;
+}
+
+MsValue ms_concat(MsValue left, MsValue right) {
+    if (!ms_is_string(left) || !ms_is_string(right)) return ms_binary_slow('+', left, right);
+    size_t left_length = ms_string_length(left);
+    size_t right_length = ms_string_length(right);
+    if (left_length == 0) return right;
+    if (right_length == 0) return left;
+
+    size_t length = left_length + right_length;
+    if (length < ROPE_MIN_LENGTH) {
+        char left_small[MS_SMALL_STRING_MAX + 1], right_small[MS_SMALL_STRING_MAX + 1];
+        const char* left_chars = string_chars(left, left_small);
+        const char* right_chars = string_chars(right, right_small);
+        char buffer[ROPE_MIN_LENGTH];
+        memcpy(buffer, left_chars, left_length);
+        memcpy(buffer + left_length, right_chars, right_length);
+        return ms_string_from(buffer, length);
+    }
+
+    MsRope* rope = allocate_object(sizeof(MsRope), MS_OBJ_ROPE, false);
+    rope->length = length;
+    rope->left = left;
+    rope->right = right;
+    rope->flat = MS_NONE;
+    return ms_object(&rope->object);
+}
+
+bool ms_equals_slow(MsValue left, MsValue right) {
+    if (!ms_is_string(left) || !ms_is_string(right)) return false;
+    // მოკლე ფორმა კანონიკურია: მოკლე და გრძელი სტრიქონი ვერასოდეს დაემთხვევა.
+    if (ms_is_small_string(left) || ms_is_small_string(right)) return false;
+    size_t length = ms_string_length(left);
+    if (length != ms_string_length(right)) return false;
+    char left_small[MS_SMALL_STRING_MAX + 1], right_small[MS_SMALL_STRING_MAX + 1];
+    return memcmp(string_chars(left, left_small), string_chars(right, right_small), length) == 0;
+}
+
+_Noreturn void ms_type_error(const char* message) {
+    fflush(stdout);
+    fprintf(stderr, "გაშვების შეცდომა: %s\n", message);
+    exit(1);
+}
+
+MsValue ms_binary_slow(char op, MsValue left, MsValue right) {
+    if (op == '+' && ms_is_string(left) && ms_is_string(right)) return ms_concat(left, right);
+    if ((ms_is_array(left) && (ms_is_array(right) || ms_is_number(right))) ||
+        (ms_is_number(left) && ms_is_array(right))) {
+        return ms_array_binary(op, left, right);
+    }
+    char message[256];
+    snprintf(message, sizeof(message), "ოპერაცია '%c' დაუშვებელია ტიპებზე '%s' და '%s'.",
+             op, ms_type_name(left), ms_type_name(right));
+    ms_type_error(message);
+    return MS_NONE;
+}
+
+MsValue ms_negate_slow(MsValue value) {
+    if (ms_is_array(value)) return ms_array_negate(value);
+    char message[256];
+    snprintf(message, sizeof(message), "ერთმაგი '-' დაუშვებელია ტიპზე '%s'.", ms_type_name(value));
+    ms_type_error(message);
+    return MS_NONE;
+}
+
+double ms_range_bound_slow(MsValue value) {
+    char message[256];
+    snprintf(message, sizeof(message), "დიაპაზონის საზღვარი უნდა იყოს რიცხვი, მოცემულია '%s'.", ms_type_name(value));
+    ms_type_error(message);
+    return 0;
+}
+
+int ms_compare_slow(const char* op, MsValue left, MsValue right) {
+    if (ms_is_string(left) && ms_is_string(right)) {
+        size_t left_length = ms_string_length(left);
+        size_t right_length = ms_string_length(right);
+        char left_small[MS_SMALL_STRING_MAX + 1], right_small[MS_SMALL_STRING_MAX + 1];
+        int order = memcmp(string_chars(left, left_small), string_chars(right, right_small),
+                           left_length < right_length ? left_length : right_length);
+        if (order != 0) return order;
+        return left_length < right_length ? -1 : left_length > right_length;
+    }
+    char message[256];
+    snprintf(message, sizeof(message), "ოპერაცია '%s' დაუშვებელია ტიპებზე '%s' და '%s'.",
+             op, ms_type_name(left), ms_type_name(right));
+    ms_type_error(message);
+    return 0;
+}
+
+int64_t ms_promote_int(double value) {
+    // 2^63 double-ში ზუსტია; ნაკლები ყოველი მთელი double int64_t-ში ეტევა.
+    if (!(value > -9223372036854775808.0 && value < 9223372036854775808.0)) {
+        ms_type_error("მთელი რიცხვი ±2^63-ს სცდება.");
+    }
+    return (int64_t)value;
+}
+
+void ms_print_int(int64_t value) {
+    if (value >= -9007199254740992LL && value <= 9007199254740992LL) printf("%lld\n", (long long)value);
+    else printf("%f\n", (double)value);
+}
+
+void ms_print(MsValue value) {
+    if (ms_is_string(value)) {
+        char small[MS_SMALL_STRING_MAX + 1];
+        fwrite(string_chars(value, small), 1, ms_string_length(value), stdout);
+        putchar('\n');
+    } else if (ms_is_number(value)) {
+        printf("%f\n", ms_as_number(value));
+    } else if (ms_is_bool(value)) {
+        puts(ms_as_bool(value) ? "ჭეშმარიტი" : "მცდარი");
+    } else if (ms_is_none(value)) {
+        puts("არარა");
+    } else if (ms_is_array(value)) {
+        // მთელი მასივის ელემენტები მთელ რიცხვებად იბეჭდება, ნამდვილისა — რიცხვებივით.
+        const MsArray* array = ms_as_array(value);
+        putchar('[');
+        for (size_t i = 0; i < array->length; i++) {
+            if (i > 0) fputs(", ", stdout);
+            if (array->kind == MS_ARRAY_INT) printf("%lld", (long long)((const int64_t*)array->data)[i]);
+            else printf("%f", ((const double*)array->data)[i]);
+        }
+        puts("]");
+    } else {
+        printf("<ობიექტი %p>\n", (void*)ms_as_object(value));
+    }
+}
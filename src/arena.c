@@ -0,0 +1,77 @@
+/**
+ * @file arena.c
+ * @author გიორგი მაღრაძე (magradze.giorgi@gmail.com)
+ * @brief კომპილაციის არენის (bump allocator) იმპლემენტაცია.
+ * @version 0.1
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "arena.h"
+
+// პირველი ბლოკის ზომა და მაქსიმალური ზომა, რომლამდეც ბლოკები იზრდება.
+#define ARENA_FIRST_CHUNK_SIZE (64 * 1024)
+#define ARENA_MAX_CHUNK_SIZE (16 * 1024 * 1024)
+#define ARENA_ALIGNMENT 16
+
+/** @brief არენის ერთი ბლოკის სათაური. მონაცემები უშუალოდ სათაურის შემდეგ იწყება. */
+struct ArenaChunk {
+    ArenaChunk* next;
+    size_t size;
+    _Alignas(ARENA_ALIGNMENT) char data[];
+};
+
+/** @brief ამრგვალებს ზომას გასწორების ჯერადამდე. */
+static size_t align_up(size_t size) {
+    return (size + (ARENA_ALIGNMENT - 1)) & ~(size_t)(ARENA_ALIGNMENT - 1);
+}
+
+/** @brief გამოყოფს ახალ ბლოკს, რომელშიც მინიმუმ `min_size` ბაიტი ეტევა. */
+static void arena_grow(Arena* arena, size_t min_size) {
+    size_t size = arena->next_chunk_size;
+    while (size < min_size) size *= 2;
+
+    ArenaChunk* chunk = (ArenaChunk*)malloc(sizeof(ArenaChunk) + size);
+    if (!chunk) {
+        fprintf(stderr, "FATAL: Memory allocation failed for arena chunk.\n");
+        exit(1);
+    }
+    chunk->next = arena->head;
+    chunk->size = size;
+    arena->head = chunk;
+    arena->cursor = chunk->data;
+    arena->limit = chunk->data + size;
+    arena->bytes_reserved += size;
+
+    if (arena->next_chunk_size < ARENA_MAX_CHUNK_SIZE) arena->next_chunk_size *= 2;
+}
+
+void init_arena(Arena* arena) {
+    arena->head = NULL;
+    arena->cursor = NULL;
+    arena->limit = NULL;
+    arena->next_chunk_size = ARENA_FIRST_CHUNK_SIZE;
+    arena->bytes_allocated = 0;
+    arena->bytes_reserved = 0;
+}
+
+void* arena_alloc(Arena* arena, size_t size) {
+    size = align_up(size);
+    if (arena->cursor == NULL || (size_t)(arena->limit - arena->cursor) < size) {
+        arena_grow(arena, size);
+    }
+    void* result = arena->cursor;
+    arena->cursor += size;
+    arena->bytes_allocated += size;
+    return result;
+}
+
+void free_arena(Arena* arena) {
+    ArenaChunk* chunk = arena->head;
+    while (chunk) {
+        ArenaChunk* next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+    init_arena(arena);
+}
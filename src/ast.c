@@ -2,140 +2,538 @@
  * @file ast.c
  * @author გიორგი მაღრაძე (magradze.giorgi@gmail.com)
  * @brief აბსტრაქტული სინტაქსური ხის (AST) ფუნქციების იმპლემენტაცია.
- * @version 0.5
+ * @version 0.15
  */
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "ast.h"
 
+// კვანძი ყველა ტიპისთვის ერთნაირი ზომისაა, ამიტომ მისი სიმჭიდროვე პირდაპირ
+// აისახება არენის მოცულობასა და ქეშის გამოყენებაზე.
+_Static_assert(sizeof(AstNode) <= 32, "AstNode must stay compact");
+
+#define INITIAL_SYMBOL_CAPACITY 64
+
 /** @brief დამხმარე ფუნქცია ახალი AST კვანძის შესაქმნელად. */
-static AstNode* allocate_node(AstNodeType type) {
-    AstNode* node = (AstNode*)malloc(sizeof(AstNode));
-    if (!node) {
-        fprintf(stderr, "FATAL: Memory allocation failed for AST node.\n");
-        exit(1);
-    }
+static AstNode* allocate_node(AstContext* ctx, AstNodeType type) {
+    AstNode* node = (AstNode*)arena_alloc(&ctx->arena, sizeof(AstNode));
     node->type = type;
+    node->value_type = TYPE_UNKNOWN;
+    node->wide = false;
+    node->line = 0;
     return node;
 }
 
-AstNode* create_program_node() {
-    AstNode* node = allocate_node(NODE_PROGRAM);
-    node->as.program.count = 0;
-    node->as.program.capacity = 8;
-    node->as.program.statements = malloc(sizeof(AstNode*) * node->as.program.capacity);
-    if (!node->as.program.statements) {
-        fprintf(stderr, "FATAL: Memory allocation failed for program statements.\n");
+/** @brief FNV-1a ჰეში სახელის ბაიტებისთვის. */
+static unsigned int hash_chars(const char* chars, int length) {
+    unsigned int hash = 2166136261u;
+    for (int i = 0; i < length; i++) {
+        hash ^= (unsigned char)chars[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/** @brief ადიდებს სიმბოლოების ჰეშ-ცხრილს ორჯერ და გადაანაწილებს ჯაჭვებს. */
+static void grow_symbol_table(AstContext* ctx) {
+    int capacity = ctx->symbol_capacity == 0 ? INITIAL_SYMBOL_CAPACITY : ctx->symbol_capacity * 2;
+    Symbol** symbols = calloc((size_t)capacity, sizeof(Symbol*));
+    if (!symbols) {
+        fprintf(stderr, "FATAL: Memory allocation failed for symbol table.\n");
         exit(1);
     }
+    for (int i = 0; i < ctx->symbol_capacity; i++) {
+        Symbol* symbol = ctx->symbols[i];
+        while (symbol) {
+            Symbol* next = symbol->next;
+            int index = (int)(symbol->hash & (unsigned int)(capacity - 1));
+            symbol->next = symbols[index];
+            symbols[index] = symbol;
+            symbol = next;
+        }
+    }
+    free(ctx->symbols);
+    ctx->symbols = symbols;
+    ctx->symbol_capacity = capacity;
+}
+
+void init_ast_context(AstContext* ctx) {
+    init_arena(&ctx->arena);
+    ctx->symbols = NULL;
+    ctx->symbol_capacity = 0;
+    ctx->symbol_count = 0;
+}
+
+void free_ast_context(AstContext* ctx) {
+    free(ctx->symbols);
+    free_arena(&ctx->arena);
+    ctx->symbols = NULL;
+    ctx->symbol_capacity = 0;
+    ctx->symbol_count = 0;
+}
+
+Symbol* intern_symbol(AstContext* ctx, const char* chars, int length) {
+    if (ctx->symbol_count * 4 >= ctx->symbol_capacity * 3) grow_symbol_table(ctx);
+
+    unsigned int hash = hash_chars(chars, length);
+    int index = (int)(hash & (unsigned int)(ctx->symbol_capacity - 1));
+    for (Symbol* symbol = ctx->symbols[index]; symbol; symbol = symbol->next) {
+        if (symbol->hash == hash && symbol->length == length && memcmp(symbol->chars, chars, (size_t)length) == 0) {
+            return symbol;
+        }
+    }
+
+    // სახელს ვაკოპირებთ არენაში, რომ AST არ იყოს დამოკიდებული საწყისი კოდის ბუფერზე.
+    char* copy = arena_alloc(&ctx->arena, (size_t)length + 1);
+    memcpy(copy, chars, (size_t)length);
+    copy[length] = '\0';
+
+    Symbol* symbol = arena_alloc(&ctx->arena, sizeof(Symbol));
+    symbol->chars = copy;
+    symbol->length = length;
+    symbol->id = ctx->symbol_count++;
+    symbol->hash = hash;
+    symbol->next = ctx->symbols[index];
+    ctx->symbols[index] = symbol;
+    return symbol;
+}
+
+const char* operator_lexeme(TokenType op) {
+    switch (op) {
+        case TOKEN_PLUS: return "+";
+        case TOKEN_MINUS: return "-";
+        case TOKEN_STAR: return "*";
+        case TOKEN_SLASH: return "/";
+        case TOKEN_BANG: return "!";
+        case TOKEN_BANG_EQUAL: return "!=";
+        case TOKEN_EQUAL_EQUAL: return "==";
+        case TOKEN_GREATER: return ">";
+        case TOKEN_GREATER_EQUAL: return ">=";
+        case TOKEN_LESS: return "<";
+        case TOKEN_LESS_EQUAL: return "<=";
+        case TOKEN_და: return "და";
+        case TOKEN_ან: return "ან";
+        case TOKEN_არ: return "არ";
+        default: return "?";
+    }
+}
+
+/** @brief ქმნის განცხადებების სიის კვანძს (პროგრამა ან ბლოკი). */
+static AstNode* create_statement_list(AstContext* ctx, AstNodeType type) {
+    AstNode* node = allocate_node(ctx, type);
+    node->as.program.count = 0;
+    node->as.program.capacity = 8;
+    node->as.program.statements = arena_alloc(&ctx->arena, sizeof(AstNode*) * node->as.program.capacity);
     return node;
 }
 
-void add_statement_to_program(AstNode* program_node, AstNode* statement) {
-    if (program_node->type != NODE_PROGRAM) return;
-    ProgramNode* prog = &program_node->as.program;
+/** @brief ამატებს განცხადებას სიის ბოლოს. */
+static void append_statement(AstContext* ctx, ProgramNode* prog, AstNode* statement) {
     if (prog->count >= prog->capacity) {
+        // არენაში realloc არ გვაქვს: ვიღებთ ორჯერ დიდ მასივს და ვაკოპირებთ.
+        // ძველი მასივი არენაში რჩება, რაც ჯამში გეომეტრიული ზრდისას O(n)-ია.
+        AstNode** statements = arena_alloc(&ctx->arena, sizeof(AstNode*) * prog->capacity * 2);
+        memcpy(statements, prog->statements, sizeof(AstNode*) * prog->count);
+        prog->statements = statements;
         prog->capacity *= 2;
-        prog->statements = realloc(prog->statements, sizeof(AstNode*) * prog->capacity);
-        if (!prog->statements) {
-            fprintf(stderr, "FATAL: Memory reallocation failed for program statements.\n");
-            exit(1);
-        }
     }
     prog->statements[prog->count++] = statement;
 }
 
-AstNode* create_binary_op_node(AstNode* left, Token op, AstNode* right) {
-    AstNode* node = allocate_node(NODE_BINARY_OP);
+AstNode* create_program_node(AstContext* ctx) {
+    return create_statement_list(ctx, NODE_PROGRAM);
+}
+
+void add_statement_to_program(AstContext* ctx, AstNode* program_node, AstNode* statement) {
+    if (program_node->type != NODE_PROGRAM) return;
+    append_statement(ctx, &program_node->as.program, statement);
+}
+
+AstNode* create_block_node(AstContext* ctx) {
+    return create_statement_list(ctx, NODE_BLOCK);
+}
+
+void add_statement_to_block(AstContext* ctx, AstNode* block_node, AstNode* statement) {
+    if (block_node->type != NODE_BLOCK) return;
+    append_statement(ctx, &block_node->as.block, statement);
+}
+
+AstNode* create_binary_op_node(AstContext* ctx, AstNode* left, TokenType op, AstNode* right) {
+    AstNode* node = allocate_node(ctx, NODE_BINARY_OP);
     node->as.binary_op.left = left;
     node->as.binary_op.operator = op;
     node->as.binary_op.right = right;
     return node;
 }
 
-AstNode* create_number_node(double value) {
-    AstNode* node = allocate_node(NODE_NUMBER);
+AstNode* create_number_node(AstContext* ctx, double value) {
+    AstNode* node = allocate_node(ctx, NODE_NUMBER);
     node->as.number.value = value;
     return node;
 }
 
-AstNode* create_unary_op_node(Token op, AstNode* right) {
-    AstNode* node = allocate_node(NODE_UNARY_OP);
+AstNode* create_boolean_node(AstContext* ctx, bool value) {
+    AstNode* node = allocate_node(ctx, NODE_BOOLEAN);
+    node->as.boolean.value = value;
+    return node;
+}
+
+AstNode* create_none_node(AstContext* ctx) {
+    return allocate_node(ctx, NODE_NONE);
+}
+
+AstNode* create_string_node(AstContext* ctx, const char* chars, int length) {
+    char* copy = arena_alloc(&ctx->arena, (size_t)length + 1);
+    memcpy(copy, chars, (size_t)length);
+    copy[length] = '\0';
+    AstNode* node = allocate_node(ctx, NODE_STRING);
+    node->as.string.chars = copy;
+    node->as.string.length = length;
+    return node;
+}
+
+AstNode* create_unary_op_node(AstContext* ctx, TokenType op, AstNode* right) {
+    AstNode* node = allocate_node(ctx, NODE_UNARY_OP);
     node->as.unary_op.operator = op;
     node->as.unary_op.right = right;
     return node;
 }
 
-AstNode* create_print_stmt_node(AstNode* expression) {
-    AstNode* node = allocate_node(NODE_PRINT_STMT);
+AstNode* create_print_stmt_node(AstContext* ctx, AstNode* expression) {
+    AstNode* node = allocate_node(ctx, NODE_PRINT_STMT);
     node->as.print_stmt.expression = expression;
     return node;
 }
 
-AstNode* create_var_decl_node(Token name, AstNode* initializer) {
-    AstNode* node = allocate_node(NODE_VAR_DECL);
+AstNode* create_var_decl_node(AstContext* ctx, Symbol* name, AstNode* initializer) {
+    AstNode* node = allocate_node(ctx, NODE_VAR_DECL);
     node->as.var_decl.name = name;
     node->as.var_decl.initializer = initializer;
     return node;
 }
 
-AstNode* create_variable_node(Token name) {
-    AstNode* node = allocate_node(NODE_VARIABLE);
+AstNode* create_assign_node(AstContext* ctx, Symbol* name, AstNode* value) {
+    AstNode* node = allocate_node(ctx, NODE_ASSIGN);
+    node->as.assign.name = name;
+    node->as.assign.value = value;
+    return node;
+}
+
+AstNode* create_if_node(AstContext* ctx, AstNode* condition, AstNode* then_branch, AstNode* else_branch) {
+    AstNode* node = allocate_node(ctx, NODE_IF);
+    node->as.if_stmt.condition = condition;
+    node->as.if_stmt.then_branch = then_branch;
+    node->as.if_stmt.else_branch = else_branch;
+    return node;
+}
+
+AstNode* create_while_node(AstContext* ctx, AstNode* condition, AstNode* body) {
+    AstNode* node = allocate_node(ctx, NODE_WHILE);
+    node->as.while_stmt.condition = condition;
+    node->as.while_stmt.body = body;
+    return node;
+}
+
+AstNode* create_for_node(AstContext* ctx, Symbol* variable, AstNode* iterable, AstNode* body, bool parallel) {
+    AstNode* node = allocate_node(ctx, parallel ? NODE_PARALLEL_FOR : NODE_FOR);
+    node->as.for_stmt.variable = variable;
+    node->as.for_stmt.iterable = iterable;
+    node->as.for_stmt.body = body;
+    return node;
+}
+
+AstNode* create_range_node(AstContext* ctx, AstNode* start, AstNode* end) {
+    AstNode* node = allocate_node(ctx, NODE_RANGE);
+    node->as.range.start = start;
+    node->as.range.end = end;
+    return node;
+}
+
+AstNode* create_array_node(AstContext* ctx, AstNode** elements, int count) {
+    AstNode* node = allocate_node(ctx, NODE_ARRAY);
+    node->as.array.elements = elements;
+    node->as.array.count = count;
+    return node;
+}
+
+AstNode* create_index_node(AstContext* ctx, AstNode* array, AstNode* index) {
+    AstNode* node = allocate_node(ctx, NODE_INDEX);
+    node->as.index.array = array;
+    node->as.index.index = index;
+    return node;
+}
+
+AstNode* create_index_assign_node(AstContext* ctx, AstNode* array, AstNode* index, AstNode* value) {
+    AstNode* node = allocate_node(ctx, NODE_INDEX_ASSIGN);
+    node->as.index_assign.array = array;
+    node->as.index_assign.index = index;
+    node->as.index_assign.value = value;
+    return node;
+}
+
+AstNode* create_builtin_node(AstContext* ctx, BuiltinFunction function, AstNode** arguments, int count) {
+    AstNode* node = allocate_node(ctx, NODE_BUILTIN);
+    node->as.builtin.function = function;
+    node->as.builtin.arguments = arguments;
+    node->as.builtin.count = count;
+    return node;
+}
+
+/** @brief ჩაშენებული ფუნქციების სახელები და პარამეტრების რაოდენობა. */
+static const struct {
+    const char* name;
+    int arity;
+} builtins[BUILTIN_COUNT] = {
+    [BUILTIN_LENGTH] = { "სიგრძე", 1 },
+    [BUILTIN_ARRAY] = { "მასივი", 1 },
+    [BUILTIN_PUSH] = { "დაამატე", 2 },
+    [BUILTIN_SUM] = { "ჯამი", 1 },
+    [BUILTIN_MIN] = { "მინიმუმი", 1 },
+    [BUILTIN_MAX] = { "მაქსიმუმი", 1 },
+    [BUILTIN_DOT] = { "სკალარული", 2 },
+};
+
+int lookup_builtin(const char* chars, int length) {
+    for (int i = 0; i < BUILTIN_COUNT; i++) {
+        if ((int)strlen(builtins[i].name) == length && memcmp(builtins[i].name, chars, (size_t)length) == 0) return i;
+    }
+    return -1;
+}
+
+const char* builtin_name(BuiltinFunction function) {
+    return builtins[function].name;
+}
+
+int builtin_arity(BuiltinFunction function) {
+    return builtins[function].arity;
+}
+
+AstNode* create_function_node(AstContext* ctx, Symbol* name, AstNode* parameters, AstNode* body) {
+    AstNode* node = allocate_node(ctx, NODE_FUNCTION);
+    node->as.function.name = name;
+    node->as.function.parameters = parameters;
+    node->as.function.body = body;
+    return node;
+}
+
+AstNode* create_call_node(AstContext* ctx, Symbol* callee, AstNode** arguments, int count) {
+    AstNode* node = allocate_node(ctx, NODE_CALL);
+    node->as.call.callee = callee;
+    node->as.call.arguments = arguments;
+    node->as.call.count = count;
+    return node;
+}
+
+AstNode* create_return_node(AstContext* ctx, AstNode* value) {
+    AstNode* node = allocate_node(ctx, NODE_RETURN);
+    node->as.return_stmt.value = value;
+    return node;
+}
+
+AstNode* create_expression_stmt_node(AstContext* ctx, AstNode* expression) {
+    AstNode* node = allocate_node(ctx, NODE_EXPRESSION_STMT);
+    node->as.expression_stmt.expression = expression;
+    return node;
+}
+
+AstNode* create_variable_node(AstContext* ctx, Symbol* name) {
+    AstNode* node = allocate_node(ctx, NODE_VARIABLE);
     node->as.variable.name = name;
     return node;
 }
 
-void free_ast(AstNode* node) {
-    if (!node) return;
+int ast_child_count(const AstNode* node) {
+    if (node == NULL) return 0;
     switch (node->type) {
-        case NODE_PROGRAM:
-            for (int i = 0; i < node->as.program.count; i++) free_ast(node->as.program.statements[i]);
-            free(node->as.program.statements);
-            break;
-        case NODE_VAR_DECL: free_ast(node->as.var_decl.initializer); break;
-        case NODE_PRINT_STMT: free_ast(node->as.print_stmt.expression); break;
-        case NODE_BINARY_OP: free_ast(node->as.binary_op.left); free_ast(node->as.binary_op.right); break;
-        case NODE_UNARY_OP: free_ast(node->as.unary_op.right); break;
-        case NODE_VARIABLE: case NODE_NUMBER: break;
+        case NODE_PROGRAM: return node->as.program.count;
+        case NODE_BLOCK: return node->as.block.count;
+        case NODE_VAR_DECL:
+        case NODE_PRINT_STMT:
+        case NODE_ASSIGN:
+        case NODE_RETURN:
+        case NODE_EXPRESSION_STMT:
+        case NODE_UNARY_OP: return 1;
+        case NODE_BINARY_OP:
+        case NODE_FUNCTION:
+        case NODE_WHILE:
+        case NODE_FOR:
+        case NODE_PARALLEL_FOR:
+        case NODE_RANGE:
+        case NODE_INDEX: return 2;
+        case NODE_CALL: return node->as.call.count;
+        case NODE_ARRAY: return node->as.array.count;
+        case NODE_BUILTIN: return node->as.builtin.count;
+        case NODE_IF:
+        case NODE_INDEX_ASSIGN: return 3;
+        default: return 0;
     }
-    free(node);
 }
 
-/** @brief რეკურსიულად ბეჭდავს AST ხის თითოეულ კვანძს შეწევებით. */
-static void print_ast_recursive(AstNode* node, int indent) {
-    if (node == NULL) return;
-    for (int i = 0; i < indent; i++) printf("  ");
+AstNode* ast_child(const AstNode* node, int index) {
+    switch (node->type) {
+        case NODE_PROGRAM: return node->as.program.statements[index];
+        case NODE_VAR_DECL: return node->as.var_decl.initializer;
+        case NODE_PRINT_STMT: return node->as.print_stmt.expression;
+        case NODE_ASSIGN: return node->as.assign.value;
+        case NODE_BLOCK: return node->as.block.statements[index];
+        case NODE_IF:
+            if (index == 0) return node->as.if_stmt.condition;
+            return index == 1 ? node->as.if_stmt.then_branch : node->as.if_stmt.else_branch;
+        case NODE_WHILE: return index == 0 ? node->as.while_stmt.condition : node->as.while_stmt.body;
+        case NODE_FUNCTION: return index == 0 ? node->as.function.parameters : node->as.function.body;
+        case NODE_CALL: return node->as.call.arguments[index];
+        case NODE_RETURN: return node->as.return_stmt.value;
+        case NODE_EXPRESSION_STMT: return node->as.expression_stmt.expression;
+        case NODE_FOR:
+        case NODE_PARALLEL_FOR: return index == 0 ? node->as.for_stmt.iterable : node->as.for_stmt.body;
+        case NODE_RANGE: return index == 0 ? node->as.range.start : node->as.range.end;
+        case NODE_ARRAY: return node->as.array.elements[index];
+        case NODE_INDEX: return index == 0 ? node->as.index.array : node->as.index.index;
+        case NODE_INDEX_ASSIGN:
+            if (index == 0) return node->as.index_assign.array;
+            return index == 1 ? node->as.index_assign.index : node->as.index_assign.value;
+        case NODE_BUILTIN: return node->as.builtin.arguments[index];
+        case NODE_UNARY_OP: return node->as.unary_op.right;
+        case NODE_BINARY_OP: return index == 0 ? node->as.binary_op.left : node->as.binary_op.right;
+        default: return NULL;
+    }
+}
+
+void init_ast_stack(AstStack* stack) {
+    stack->frames = NULL;
+    stack->count = 0;
+    stack->capacity = 0;
+}
+
+void free_ast_stack(AstStack* stack) {
+    free(stack->frames);
+    init_ast_stack(stack);
+}
 
+void ast_stack_push(AstStack* stack, AstNode* node) {
+    if (stack->count >= stack->capacity) {
+        int capacity = stack->capacity < 64 ? 64 : stack->capacity * 2;
+        AstFrame* frames = realloc(stack->frames, sizeof(AstFrame) * (size_t)capacity);
+        if (!frames) {
+            fprintf(stderr, "FATAL: Memory allocation failed for AST traversal.\n");
+            exit(1);
+        }
+        stack->frames = frames;
+        stack->capacity = capacity;
+    }
+    stack->frames[stack->count].node = node;
+    stack->frames[stack->count].stage = 0;
+    stack->count++;
+}
+
+bool ast_stack_next_postorder(AstStack* stack, AstNode** node) {
+    while (stack->count > 0) {
+        AstFrame* frame = ast_stack_top(stack);
+        if (frame->stage < ast_child_count(frame->node)) {
+            AstNode* child = ast_child(frame->node, frame->stage++);
+            ast_stack_push(stack, child);
+            continue;
+        }
+        *node = frame->node;
+        stack->count--;
+        return true;
+    }
+    return false;
+}
+
+int ast_count_nodes(AstNode* root) {
+    int count = 0;
+    AstStack stack;
+    init_ast_stack(&stack);
+    ast_stack_push(&stack, root);
+    AstNode* node;
+    while (ast_stack_next_postorder(&stack, &node)) {
+        if (node != NULL) count++;
+    }
+    free_ast_stack(&stack);
+    return count;
+}
+
+/** @brief ბეჭდავს ერთ კვანძს (შვილების გარეშე) მოცემული შეწევით. */
+static void print_node(AstNode* node, int indent) {
+    for (int i = 0; i < indent; i++) printf("  ");
     switch (node->type) {
         case NODE_PROGRAM:
             printf("Program\n");
-            for (int i = 0; i < node->as.program.count; i++) {
-                print_ast_recursive(node->as.program.statements[i], indent + 1);
-            }
             break;
         case NODE_VAR_DECL:
-            printf("VarDecl(%.*s)\n", node->as.var_decl.name.length, node->as.var_decl.name.start);
-            print_ast_recursive(node->as.var_decl.initializer, indent + 1);
+            printf("VarDecl(%s)\n", node->as.var_decl.name->chars);
             break;
         case NODE_PRINT_STMT:
             printf("PrintStmt\n");
-            print_ast_recursive(node->as.print_stmt.expression, indent + 1);
             break;
         case NODE_BINARY_OP:
-            printf("BinaryOp(%.*s)\n", node->as.binary_op.operator.length, node->as.binary_op.operator.start);
-            print_ast_recursive(node->as.binary_op.left, indent + 1);
-            print_ast_recursive(node->as.binary_op.right, indent + 1);
+            printf("BinaryOp(%s)\n", operator_lexeme(node->as.binary_op.operator));
             break;
         case NODE_UNARY_OP:
-            printf("UnaryOp(%.*s)\n", node->as.unary_op.operator.length, node->as.unary_op.operator.start);
-            print_ast_recursive(node->as.unary_op.right, indent + 1);
+            printf("UnaryOp(%s)\n", operator_lexeme(node->as.unary_op.operator));
             break;
         case NODE_VARIABLE:
-            printf("Variable(%.*s)\n", node->as.variable.name.length, node->as.variable.name.start);
+            printf("Variable(%s)\n", node->as.variable.name->chars);
             break;
         case NODE_NUMBER:
             printf("Number(%.2f)\n", node->as.number.value);
             break;
+        case NODE_BOOLEAN:
+            printf("Boolean(%s)\n", node->as.boolean.value ? "ჭეშმარიტი" : "მცდარი");
+            break;
+        case NODE_NONE:
+            printf("None\n");
+            break;
+        case NODE_STRING:
+            printf("String(\"%.*s\")\n", node->as.string.length, node->as.string.chars);
+            break;
+        case NODE_ASSIGN:
+            printf("Assign(%s)\n", node->as.assign.name->chars);
+            break;
+        case NODE_BLOCK:
+            printf("Block\n");
+            break;
+        case NODE_IF:
+            printf("If\n");
+            break;
+        case NODE_WHILE:
+            printf("While\n");
+            break;
+        case NODE_FUNCTION:
+            printf("Function(%s)\n", node->as.function.name->chars);
+            break;
+        case NODE_CALL:
+            printf("Call(%s)\n", node->as.call.callee->chars);
+            break;
+        case NODE_RETURN:
+            printf("Return\n");
+            break;
+        case NODE_EXPRESSION_STMT:
+            printf("ExpressionStmt\n");
+            break;
+        case NODE_FOR:
+            printf("For(%s)\n", node->as.for_stmt.variable->chars);
+            break;
+        case NODE_PARALLEL_FOR:
+            printf("ParallelFor(%s)\n", node->as.for_stmt.variable->chars);
+            break;
+        case NODE_RANGE:
+            printf("Range\n");
+            break;
+        case NODE_ARRAY:
+            printf("Array(%d)\n", node->as.array.count);
+            break;
+        case NODE_INDEX:
+            printf("Index\n");
+            break;
+        case NODE_INDEX_ASSIGN:
+            printf("IndexAssign\n");
+            break;
+        case NODE_BUILTIN:
+            printf("Builtin(%s)\n", builtin_name((BuiltinFunction)node->as.builtin.function));
+            break;
         default:
             printf("Unknown Node\n");
             break;
@@ -144,6 +542,24 @@ static void print_ast_recursive(AstNode* node, int indent) {
 
 void print_ast(AstNode* node) {
     printf("--- Abstract Syntax Tree ---\n");
-    print_ast_recursive(node, 0);
+    // პრე-ორდერი: კვანძი იბეჭდება სტეკზე პირველად მოხვედრისას, შეწევა სტეკის სიღრმეა.
+    if (node != NULL) {
+        AstStack stack;
+        init_ast_stack(&stack);
+        ast_stack_push(&stack, node);
+        print_node(node, 0);
+        while (stack.count > 0) {
+            AstFrame* frame = ast_stack_top(&stack);
+            if (frame->stage >= ast_child_count(frame->node)) {
+                stack.count--;
+                continue;
+            }
+            AstNode* child = ast_child(frame->node, frame->stage++);
+            if (child == NULL) continue;
+            print_node(child, stack.count);
+            ast_stack_push(&stack, child);
+        }
+        free_ast_stack(&stack);
+    }
     printf("--------------------------\n");
-}
\ No newline at end of file
+}
@@ -0,0 +1,332 @@
+/**
+ * @file bytecode.c
+ * @author გიორგი მაღრაძე (magradze.giorgi@gmail.com)
+ * @brief AST-დან რეგისტრული ბაიტკოდის კომპილატორის იმპლემენტაცია.
+ * @version 0.8
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "vm.h"
+
+#define MAX_REGISTERS 65535
+
+/** @brief ბაიტკოდის კომპილაციის მდგომარეობა. */
+typedef struct {
+    Chunk* chunk;
+    AstContext* ctx;
+    bool* declared;        // declared[id] — გამოცხადებულია თუ არა ცვლადი
+    int next_temp;         // პირველი თავისუფალი დროებითი რეგისტრი
+    bool had_error;
+    int line;              // მიმდინარე ზედა დონის განცხადების ხაზი (0 — უცნობი)
+    AstStack walk;         // გამოსახულებების გავლის სტეკი
+    int* results;          // გავლილი ქვეხეების შედეგების რეგისტრები
+    int result_count;
+    int result_capacity;
+} BytecodeCompiler;
+
+/** @brief realloc-ის შეფუთვა, რომელიც შეცდომისას ასრულებს პროგრამას. */
+static void* grow_array(void* array, size_t new_size) {
+    void* result = realloc(array, new_size);
+    if (!result) {
+        fprintf(stderr, "FATAL: Memory allocation failed for bytecode.\n");
+        exit(1);
+    }
+    return result;
+}
+
+/**
+ * @brief ბეჭდავს კომპილაციის შეცდომას განცხადების ხაზით. მხოლოდ პირველი
+ * შეცდომა იბეჭდება: მხარდაუჭერელი კონსტრუქცია ერთხელ ცხადდება.
+ */
+static void compile_error(BytecodeCompiler* compiler, const char* message, Symbol* name) {
+    if (compiler->had_error) return;
+    if (compiler->line > 0) fprintf(stderr, "[Line %d] ", compiler->line);
+    if (name) fprintf(stderr, "შეცდომა: %s: '%s'\n", message, name->chars);
+    else fprintf(stderr, "შეცდომა: %s\n", message);
+    compiler->had_error = true;
+}
+
+/** @brief ამატებს ინსტრუქციას. */
+static void emit(BytecodeCompiler* compiler, OpCode op, int a, int b, int c) {
+    Chunk* chunk = compiler->chunk;
+    if (chunk->count >= chunk->capacity) {
+        chunk->capacity = chunk->capacity < 64 ? 64 : chunk->capacity * 2;
+        chunk->code = grow_array(chunk->code, sizeof(Instruction) * (size_t)chunk->capacity);
+    }
+    Instruction* instruction = &chunk->code[chunk->count++];
+    instruction->op = (uint8_t)op;
+    instruction->a = (uint16_t)a;
+    instruction->b = (uint16_t)b;
+    instruction->c = (uint16_t)c;
+}
+
+/** @brief ამატებს მუდმივას ცხრილში და აბრუნებს მის ინდექსს. */
+static int add_constant(BytecodeCompiler* compiler, double value) {
+    Chunk* chunk = compiler->chunk;
+    if (chunk->constant_count >= chunk->constant_capacity) {
+        chunk->constant_capacity = chunk->constant_capacity < 64 ? 64 : chunk->constant_capacity * 2;
+        chunk->constants = grow_array(chunk->constants, sizeof(double) * (size_t)chunk->constant_capacity);
+    }
+    chunk->constants[chunk->constant_count] = value;
+    return chunk->constant_count++;
+}
+
+/** @brief იკავებს დროებით რეგისტრს (სტეკის პრინციპით). */
+static int push_temp(BytecodeCompiler* compiler) {
+    int reg = compiler->next_temp++;
+    if (compiler->next_temp > compiler->chunk->register_count) {
+        compiler->chunk->register_count = compiler->next_temp;
+    }
+    if (compiler->next_temp > MAX_REGISTERS) {
+        compile_error(compiler, "გამოსახულება ძალიან რთულია ვირტუალური მანქანისთვის", NULL);
+        compiler->next_temp = compiler->ctx->symbol_count;
+    }
+    return reg;
+}
+
+/** @brief ათავისუფლებს ბოლოს დაკავებულ დროებით რეგისტრს. */
+static void pop_temp(BytecodeCompiler* compiler) {
+    compiler->next_temp--;
+}
+
+/** @brief ამატებს ქვეხის შედეგის რეგისტრს სტეკზე. */
+static void push_result(BytecodeCompiler* compiler, int reg) {
+    if (compiler->result_count >= compiler->result_capacity) {
+        compiler->result_capacity = compiler->result_capacity < 64 ? 64 : compiler->result_capacity * 2;
+        compiler->results = grow_array(compiler->results, sizeof(int) * (size_t)compiler->result_capacity);
+    }
+    compiler->results[compiler->result_count++] = reg;
+}
+
+/** @brief აბრუნებს ორობითი ოპერატორის ინსტრუქციას. */
+static OpCode binary_opcode(BytecodeCompiler* compiler, TokenType op) {
+    switch (op) {
+        case TOKEN_PLUS: return OP_ADD;
+        case TOKEN_MINUS: return OP_SUB;
+        case TOKEN_STAR: return OP_MUL;
+        case TOKEN_SLASH: return OP_DIV;
+        case TOKEN_EQUAL_EQUAL:
+        case TOKEN_BANG_EQUAL:
+        case TOKEN_LESS:
+        case TOKEN_LESS_EQUAL:
+        case TOKEN_GREATER:
+        case TOKEN_GREATER_EQUAL:
+        case TOKEN_და:
+        case TOKEN_ან:
+            compile_error(compiler, "ვირტუალურ მანქანას შედარება და ლოგიკური ოპერატორები არ აქვს მხარდაჭერილი", NULL);
+            return OP_ADD;
+        default:
+            compile_error(compiler, "უცნობი ოპერატორი", NULL);
+            return OP_ADD;
+    }
+}
+
+/**
+ * @brief აკომპილირებს ერთ კვანძს; მისი შვილების შედეგები სტეკის თავზეა.
+ * სტეკის ყოველ პოზიციას საკუთარი დროებითი რეგისტრი აქვს, რომელშიც
+ * კვანძის შედეგი იწერება (ცვლადი კი პირდაპირ თავის რეგისტრში რჩება).
+ */
+static void compile_node(BytecodeCompiler* compiler, AstNode* node) {
+    if (node == NULL) {
+        push_result(compiler, push_temp(compiler));
+        return;
+    }
+    switch (node->type) {
+        case NODE_NUMBER: {
+            int target = push_temp(compiler);
+            int index = add_constant(compiler, node->as.number.value);
+            emit(compiler, OP_LOADK, target, index & 0xFFFF, (index >> 16) & 0xFFFF);
+            push_result(compiler, target);
+            return;
+        }
+        case NODE_VARIABLE: {
+            Symbol* name = node->as.variable.name;
+            if (!compiler->declared[name->id]) {
+                compile_error(compiler, "ცვლადი არ არის გამოცხადებული", name);
+            }
+            push_temp(compiler);
+            push_result(compiler, name->id);
+            return;
+        }
+        case NODE_UNARY_OP: {
+            int right = compiler->results[compiler->result_count - 1];
+            int target = compiler->next_temp - 1;
+            if (node->as.unary_op.operator != TOKEN_MINUS) {
+                compile_error(compiler, "ვირტუალურ მანქანას შედარება და ლოგიკური ოპერატორები არ აქვს მხარდაჭერილი", NULL);
+            }
+            emit(compiler, OP_NEG, target, right, 0);
+            compiler->results[compiler->result_count - 1] = target;
+            return;
+        }
+        case NODE_BINARY_OP: {
+            int right = compiler->results[--compiler->result_count];
+            int left = compiler->results[compiler->result_count - 1];
+            pop_temp(compiler);
+            int target = compiler->next_temp - 1;
+            emit(compiler, binary_opcode(compiler, node->as.binary_op.operator), target, left, right);
+            compiler->results[compiler->result_count - 1] = target;
+            return;
+        }
+        case NODE_BOOLEAN:
+        case NODE_NONE:
+        case NODE_STRING:
+            // VM-ის რეგისტრები double-ია; დინამიური მნიშვნელობები მხოლოდ C ბექენდს აქვს.
+            compile_error(compiler, "ვირტუალურ მანქანას მხოლოდ რიცხვითი მნიშვნელობები აქვს მხარდაჭერილი", NULL);
+            break;
+        case NODE_CALL:
+            compile_error(compiler, "ვირტუალურ მანქანას ფუნქციები არ აქვს მხარდაჭერილი", NULL);
+            break;
+        case NODE_ARRAY:
+        case NODE_INDEX:
+        case NODE_BUILTIN:
+            compile_error(compiler, "ვირტუალურ მანქანას მასივები არ აქვს მხარდაჭერილი", NULL);
+            break;
+        default:
+            compile_error(compiler, "კვანძი არ არის გამოსახულება", NULL);
+            break;
+    }
+    push_result(compiler, push_temp(compiler));
+}
+
+/**
+ * @brief აკომპილირებს გამოსახულებას პოსტ-ორდერში, ცხადი სტეკით.
+ * @return int რეგისტრი, რომელშიც შედეგი აღმოჩნდა: დროებითი რეგისტრი
+ * (შედეგის შემდეგ ის უკვე თავისუფალია) ან ცვლადის რეგისტრი.
+ */
+static int compile_expression(BytecodeCompiler* compiler, AstNode* node) {
+    AstNode* current;
+    ast_stack_push(&compiler->walk, node);
+    while (ast_stack_next_postorder(&compiler->walk, &current)) compile_node(compiler, current);
+    pop_temp(compiler);
+    return compiler->results[--compiler->result_count];
+}
+
+/**
+ * @brief ცვლადის რეგისტრში წერს გამოსახულების მნიშვნელობას. ინსტრუქცია
+ * ოპერანდებს შედეგის ჩაწერამდე კითხულობს, ამიტომ `ა = ა + 1`-შიც ბოლო
+ * ინსტრუქცია პირდაპირ ცვლადში შეიძლება წერდეს.
+ */
+static void compile_store(BytecodeCompiler* compiler, Symbol* name, AstNode* value) {
+    Chunk* chunk = compiler->chunk;
+    int start = chunk->count;
+    int result = compile_expression(compiler, value);
+    if (result >= compiler->ctx->symbol_count && chunk->count > start && chunk->code[chunk->count - 1].a == result) {
+        // შედეგი დროებით რეგისტრში ბოლო ინსტრუქციამ ჩაწერა: ის პირდაპირ ცვლადში ჩაიწეროს.
+        chunk->code[chunk->count - 1].a = (uint16_t)name->id;
+    } else if (result != name->id) {
+        emit(compiler, OP_MOVE, name->id, result, 0);
+    }
+}
+
+/** @brief აკომპილირებს ერთ განცხადებას. */
+static void compile_statement(BytecodeCompiler* compiler, AstNode* node) {
+    if (node == NULL) return;
+    switch (node->type) {
+        case NODE_VAR_DECL: {
+            Symbol* name = node->as.var_decl.name;
+            if (compiler->declared[name->id]) {
+                compile_error(compiler, "ცვლადი უკვე გამოცხადებულია", name);
+            }
+            compile_store(compiler, name, node->as.var_decl.initializer);
+            compiler->declared[name->id] = true;
+            break;
+        }
+        case NODE_ASSIGN: {
+            Symbol* name = node->as.assign.name;
+            if (!compiler->declared[name->id]) {
+                compile_error(compiler, "ცვლადი არ არის გამოცხადებული", name);
+            }
+            compile_store(compiler, name, node->as.assign.value);
+            break;
+        }
+        case NODE_BLOCK:
+        case NODE_IF:
+        case NODE_WHILE:
+        case NODE_FOR:
+        case NODE_PARALLEL_FOR:
+            // ბაიტკოდი წრფივია: გადასვლის ინსტრუქციები მხოლოდ C ბექენდს აქვს.
+            compile_error(compiler, "ვირტუალურ მანქანას მართვის კონსტრუქციები (თუ, სანამ, ყოველი) არ აქვს მხარდაჭერილი", NULL);
+            break;
+        case NODE_FUNCTION:
+        case NODE_RETURN:
+        case NODE_EXPRESSION_STMT:
+            compile_error(compiler, "ვირტუალურ მანქანას ფუნქციები არ აქვს მხარდაჭერილი", NULL);
+            break;
+        case NODE_INDEX_ASSIGN:
+            compile_error(compiler, "ვირტუალურ მანქანას მასივები არ აქვს მხარდაჭერილი", NULL);
+            break;
+        case NODE_PRINT_STMT: {
+            int result = compile_expression(compiler, node->as.print_stmt.expression);
+            OpCode op = node->as.print_stmt.expression->value_type == TYPE_INT ? OP_PRINT_INT : OP_PRINT;
+            emit(compiler, op, result, 0, 0);
+            break;
+        }
+        default:
+            compile_error(compiler, "უცნობი განცხადება", NULL);
+            break;
+    }
+}
+
+bool compile_bytecode(AstNode* program, AstContext* ctx, Chunk* chunk) {
+    memset(chunk, 0, sizeof(*chunk));
+    if (ctx->symbol_count >= MAX_REGISTERS) {
+        fprintf(stderr, "შეცდომა: ძალიან ბევრი სახელი ვირტუალური მანქანისთვის.\n");
+        return false;
+    }
+
+    BytecodeCompiler compiler;
+    compiler.chunk = chunk;
+    compiler.ctx = ctx;
+    compiler.declared = calloc((size_t)ctx->symbol_count + 1, sizeof(bool));
+    compiler.next_temp = ctx->symbol_count;
+    compiler.had_error = false;
+    compiler.line = 0;
+    init_ast_stack(&compiler.walk);
+    compiler.results = NULL;
+    compiler.result_count = 0;
+    compiler.result_capacity = 0;
+    if (!compiler.declared) {
+        fprintf(stderr, "FATAL: Memory allocation failed for bytecode compiler.\n");
+        exit(1);
+    }
+    chunk->register_count = ctx->symbol_count;
+
+    if (program != NULL && program->type == NODE_PROGRAM) {
+        for (int i = 0; i < program->as.program.count && !compiler.had_error; i++) {
+            AstNode* statement = program->as.program.statements[i];
+            compiler.line = statement != NULL ? statement->line : 0;
+            compile_statement(&compiler, statement);
+        }
+    }
+    emit(&compiler, OP_HALT, 0, 0, 0);
+
+    free(compiler.declared);
+    free_ast_stack(&compiler.walk);
+    free(compiler.results);
+    return !compiler.had_error;
+}
+
+void disassemble_chunk(Chunk* chunk) {
+    static const char* names[OP_COUNT] = {
+        "LOADK", "MOVE", "ADD", "SUB", "MUL", "DIV", "NEG", "PRINT", "PRINTI", "HALT",
+    };
+    printf("--- ბაიტკოდი (%d რეგისტრი, %d მუდმივა) ---\n", chunk->register_count, chunk->constant_count);
+    for (int i = 0; i < chunk->count; i++) {
+        Instruction* in = &chunk->code[i];
+        printf("%04d  %-6s", i, names[in->op]);
+        switch ((OpCode)in->op) {
+            case OP_LOADK: printf(" r%d, k%d (%g)\n", in->a, in->b | (in->c << 16), chunk->constants[in->b | (in->c << 16)]); break;
+            case OP_MOVE: case OP_NEG: printf(" r%d, r%d\n", in->a, in->b); break;
+            case OP_ADD: case OP_SUB: case OP_MUL: case OP_DIV: printf(" r%d, r%d, r%d\n", in->a, in->b, in->c); break;
+            case OP_PRINT: case OP_PRINT_INT: printf(" r%d\n", in->a); break;
+            default: printf("\n"); break;
+        }
+    }
+}
+
+void free_chunk(Chunk* chunk) {
+    free(chunk->code);
+    free(chunk->constants);
+    memset(chunk, 0, sizeof(*chunk));
+}
@@ -0,0 +1,235 @@
+/**
+ * @file cache.c
+ * @author გიორგი მაღრაძე (magradze.giorgi@gmail.com)
+ * @brief კომპილაციის ქეშის იმპლემენტაცია.
+ * @version 0.1
+ */
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "cache.h"
+#include "sha256.h"
+
+// ამაზე ძველი დროებითი ფაილი ჩავარდნილი პროცესის ნარჩენად ითვლება.
+#define STALE_TEMP_SECONDS 3600
+
+/** @brief ერთი ჩანაწერი გამოსახლების დროს. */
+typedef struct {
+    char name[CACHE_KEY_SIZE];
+    uint64_t size;
+    struct timespec used;
+} CacheEntry;
+
+/** @brief ქმნის დირექტორიას და მის ყველა მშობელს (`mkdir -p`). */
+static bool make_directories(const char* path) {
+    char* copy = strdup(path);
+    if (!copy) return false;
+    for (char* p = copy + 1; *p; p++) {
+        if (*p != '/') continue;
+        *p = '\0';
+        if (mkdir(copy, 0755) != 0 && errno != EEXIST) {
+            free(copy);
+            return false;
+        }
+        *p = '/';
+    }
+    bool ok = mkdir(copy, 0755) == 0 || errno == EEXIST;
+    free(copy);
+    return ok;
+}
+
+/** @brief აბრუნებს ნაგულისხმევ დირექტორიას (malloc-ით გამოყოფილს). */
+static char* default_directory(void) {
+    const char* env = getenv("MANUSCRIPT_CACHE_DIR");
+    if (env && env[0]) return strdup(env);
+
+    const char* base = getenv("XDG_CACHE_HOME");
+    const char* suffix = "/manuscript";
+    if (!base || !base[0]) {
+        base = getenv("HOME");
+        suffix = "/.cache/manuscript";
+    }
+    if (!base || !base[0]) {
+        base = "/tmp";
+        suffix = "/manuscript-cache";
+    }
+    size_t length = strlen(base) + strlen(suffix) + 1;
+    char* directory = malloc(length);
+    if (directory) snprintf(directory, length, "%s%s", base, suffix);
+    return directory;
+}
+
+uint64_t parse_cache_size(const char* text) {
+    if (text == NULL) return 0;
+    char* end;
+    errno = 0;
+    unsigned long long value = strtoull(text, &end, 10);
+    if (errno != 0 || end == text) return 0;
+    switch (*end) {
+        case 'k': case 'K': value *= 1024ull; end++; break;
+        case 'm': case 'M': value *= 1024ull * 1024; end++; break;
+        case 'g': case 'G': value *= 1024ull * 1024 * 1024; end++; break;
+        default: break;
+    }
+    return *end == '\0' ? (uint64_t)value : 0;
+}
+
+bool init_compile_cache(CompileCache* cache, const char* directory, uint64_t max_bytes) {
+    cache->directory = directory ? strdup(directory) : default_directory();
+    if (max_bytes == 0) max_bytes = parse_cache_size(getenv("MANUSCRIPT_CACHE_SIZE"));
+    cache->max_bytes = max_bytes ? max_bytes : CACHE_DEFAULT_MAX_BYTES;
+    if (cache->directory == NULL) {
+        fprintf(stderr, "FATAL: Memory allocation failed for compile cache.\n");
+        exit(1);
+    }
+    if (!make_directories(cache->directory)) {
+        fprintf(stderr, "ქეშის დირექტორიის შექმნა ვერ მოხერხდა: %s: %s\n", cache->directory, strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+void free_compile_cache(CompileCache* cache) {
+    free(cache->directory);
+    cache->directory = NULL;
+}
+
+void compute_cache_key(char key[CACHE_KEY_SIZE], const char* source, size_t length, const char* config) {
+    Sha256 sha;
+    sha256_init(&sha);
+    // კონფიგურაცია NUL-ით გამოიყოფა წყაროსგან, რომ საზღვრის გადაწევამ
+    // სხვა გასაღებში არ გადაიყვანოს იგივე ბაიტები.
+    sha256_update(&sha, config, strlen(config) + 1);
+    sha256_update(&sha, source, length);
+
+    uint8_t digest[SHA256_DIGEST_SIZE];
+    sha256_final(&sha, digest);
+    static const char hex[] = "0123456789abcdef";
+    for (int i = 0; i < SHA256_DIGEST_SIZE; i++) {
+        key[i * 2] = hex[digest[i] >> 4];
+        key[i * 2 + 1] = hex[digest[i] & 15];
+    }
+    key[CACHE_KEY_SIZE - 1] = '\0';
+}
+
+/** @brief აწყობს ჩანაწერის სრულ ბილიკს. */
+static bool entry_path(CompileCache* cache, const char* name, char* path, size_t path_size) {
+    int written = snprintf(path, path_size, "%s/%s", cache->directory, name);
+    return written > 0 && (size_t)written < path_size;
+}
+
+bool cache_lookup(CompileCache* cache, const char* key, char* path, size_t path_size) {
+    if (!entry_path(cache, key, path, path_size)) return false;
+    if (access(path, X_OK) != 0) return false;
+    // LRU: გამოყენების დრო mtime-შია (atime ხშირად გამორთულია).
+    utimensat(AT_FDCWD, path, NULL, 0);
+    return true;
+}
+
+bool cache_temp_path(CompileCache* cache, char* path, size_t path_size) {
+    if (!entry_path(cache, "tmp.XXXXXX", path, path_size)) return false;
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        fprintf(stderr, "ქეშში დროებითი ფაილის შექმნა ვერ მოხერხდა: %s\n", strerror(errno));
+        return false;
+    }
+    close(fd);
+    return true;
+}
+
+static void evict_entries(CompileCache* cache, const char* keep);
+
+bool cache_store(CompileCache* cache, const char* key, const char* temp_path, char* path, size_t path_size) {
+    if (!entry_path(cache, key, path, path_size)) return false;
+    // rename() იმავე ფაილურ სისტემაზე ატომურია: პარალელურ პროცესებს შორის
+    // ბოლო იმარჯვებს, ორივე ვერსია კი იდენტურია.
+    if (rename(temp_path, path) != 0) {
+        fprintf(stderr, "ქეშში ჩაწერა ვერ მოხერხდა: %s\n", strerror(errno));
+        unlink(temp_path);
+        return false;
+    }
+    evict_entries(cache, key);
+    return true;
+}
+
+static bool is_key_name(const char* name) {
+    if (strlen(name) != CACHE_KEY_SIZE - 1) return false;
+    for (const char* p = name; *p; p++) {
+        if (!((*p >= '0' && *p <= '9') || (*p >= 'a' && *p <= 'f'))) return false;
+    }
+    return true;
+}
+
+static int compare_by_use(const void* a, const void* b) {
+    const CacheEntry* left = a;
+    const CacheEntry* right = b;
+    if (left->used.tv_sec != right->used.tv_sec) return left->used.tv_sec < right->used.tv_sec ? -1 : 1;
+    if (left->used.tv_nsec != right->used.tv_nsec) return left->used.tv_nsec < right->used.tv_nsec ? -1 : 1;
+    return 0;
+}
+
+/** @brief გამოსახლება; `keep` ჩანაწერი (ახლახან ჩაწერილი) არასოდეს იშლება. */
+static void evict_entries(CompileCache* cache, const char* keep) {
+    DIR* dir = opendir(cache->directory);
+    if (dir == NULL) return;
+    int dir_fd = dirfd(dir);
+
+    CacheEntry* entries = NULL;
+    size_t count = 0;
+    size_t capacity = 0;
+    uint64_t total = 0;
+    time_t now = time(NULL);
+
+    struct dirent* item;
+    while ((item = readdir(dir)) != NULL) {
+        struct stat info;
+        if (fstatat(dir_fd, item->d_name, &info, AT_SYMLINK_NOFOLLOW) != 0 || !S_ISREG(info.st_mode)) continue;
+        if (strncmp(item->d_name, "tmp.", 4) == 0) {
+            if (now - info.st_mtime > STALE_TEMP_SECONDS) unlinkat(dir_fd, item->d_name, 0);
+            continue;
+        }
+        if (!is_key_name(item->d_name)) continue;
+        if (keep != NULL && strcmp(item->d_name, keep) == 0) {
+            total += (uint64_t)info.st_size;
+            continue;
+        }
+
+        if (count >= capacity) {
+            capacity = capacity < 64 ? 64 : capacity * 2;
+            CacheEntry* grown = realloc(entries, capacity * sizeof(CacheEntry));
+            if (!grown) {
+                fprintf(stderr, "FATAL: Memory allocation failed for compile cache.\n");
+                exit(1);
+            }
+            entries = grown;
+        }
+        memcpy(entries[count].name, item->d_name, CACHE_KEY_SIZE);
+        entries[count].size = (uint64_t)info.st_size;
+        entries[count].used = info.st_mtim;
+        total += entries[count].size;
+        count++;
+    }
+
+    if (total > cache->max_bytes) {
+        qsort(entries, count, sizeof(CacheEntry), compare_by_use);
+        // სხვა პროცესმა შეიძლება იგივე ფაილი უკვე წაშალა — ENOENT უგულებელყოფილია.
+        for (size_t i = 0; i < count && total > cache->max_bytes; i++) {
+            unlinkat(dir_fd, entries[i].name, 0);
+            total -= entries[i].size;
+        }
+    }
+
+    free(entries);
+    closedir(dir);
+}
+
+void cache_evict(CompileCache* cache) {
+    evict_entries(cache, NULL);
+}
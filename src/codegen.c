@@ -2,76 +2,2316 @@
  * @file codegen.c
  * @author გიორგი მაღრაძე (magradze.giorgi@gmail.com)
  * @brief C კოდის გენერატორის იმპლემენტაცია.
- * @version 0.2
+ * @version 0.16
  */
+#include <math.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
 #include "codegen.h"
+#include "loop_analysis.h"
+#include "runtime.h"
 
-static void generate_expression(AstNode* node, FILE* outfile);
+/** @brief ერთი ინტერნირებული ლიტერალი გენერირებული კოდის `ms_literals` ცხრილში. */
+typedef struct {
+    const char* chars;
+    int length;
+} StringLiteral;
 
 /**
- * @brief გენერირებს კოდს ერთი განცხადებისთვის.
+ * @brief კომპილაციისას ინტერნირებული ლიტერალები: ერთნაირ ბაიტებს ცხრილის
+ * ერთი ჩანაწერი შეესაბამება, ამიტომ გაშვებისას მათი ტოლობა მაჩვენებლების
+ * შედარებაა. ძებნა ღია მისამართებით ხდება.
  */
-static void generate_statement(AstNode* node, FILE* outfile) {
-    if (node == NULL) return;
+typedef struct {
+    StringLiteral* literals;
+    int count;
+    int capacity;
+    int* slots;            // ინდექსი + 1; 0 — ცარიელი უჯრა
+    int slot_capacity;     // ორის ხარისხი
+} StringTable;
+
+/**
+ * @brief გენერირებული C გამოსახულების მაქსიმალური ჩადგმულობა. უფრო ღრმა
+ * ქვეხე ცალკე დროებით ცვლადში (`ms_tN`) გამოითვლება, რომ C კომპილატორმა
+ * (რომლის პარსერიც რეკურსიულია) ათიათასობით დონის ხე გაუძლოს.
+ */
+#define CODEGEN_MAX_NESTING 100
+
+/** @brief ფუნქცია, რომელიც გამოძახებებს არ შეიცავს და ამდენ კვანძზე პატარაა, MS_INLINE-ით გამოცხადდება. */
+#define CODEGEN_INLINE_MAX_NODES 40
+
+/** @brief ინდექსების ციკლის ბირთვის მასივების მაქსიმალური რაოდენობა (იხ. ArrayKernel). */
+#define CODEGEN_KERNEL_MAX_ARRAYS 8
+
+/** @brief declare_variables-ის ნიშნები: სიმბოლოს სახელით გამოცხადებული C ცვლადები. */
+#define DECLARED_VARIABLE 1    // v_სახელი
+#define DECLARED_ITERABLE 2    // ms_each_v_სახელი — მასივის `ყოველი`-ს მასივი
+
+/** @brief გენერაციის ამოცანის სახე: ტექსტი ან კვანძი მოცემულ C კონტექსტში. */
+typedef enum {
+    GEN_TEXT,
+    GEN_EXPRESSION,        // კვანძი საკუთარ ტიპში
+    GEN_DOUBLE,            // კვანძი double კონტექსტში
+    GEN_VALUE,             // კვანძი MsValue კონტექსტში
+    GEN_CONDITION,         // კვანძის ჭეშმარიტობა bool კონტექსტში
+    GEN_TEMP,              // დროებითი ცვლადის (ms_tN) სახელი
+    GEN_ELEMENT,           // კვანძი მასივის ელემენტად (double; არარიცხვი გაშვებისას შეცდომაა)
+    GEN_INDEX,             // კვანძი ინდექსად (int64_t; არამთელი გაშვებისას შეცდომაა)
+    GEN_COUNT,             // ათობითი მთელი რიცხვი (მასივის ლიტერალის სიგრძე)
+} GenMode;
+
+/** @brief გამოსახულების გენერაციის სტეკის ელემენტი. */
+typedef struct {
+    GenMode mode;
+    int depth;             // ჩადგმულობა მიმდინარე C გამოსახულებაში
+    union {
+        AstNode* node;
+        const char* text;  // სტატიკური (ან არენაში მცხოვრები) სტრიქონი
+        int temp;          // დროებითი ცვლადის ნომერი
+        int count;         // GEN_COUNT-ის რიცხვი
+    } as;
+} GenTask;
+
+/** @brief დროებით ცვლადში გატანილი ქვეხე. */
+typedef struct {
+    AstNode* node;         // NULL — ცვლადი მხოლოდ ცხადდება (მნიშვნელობას გამოსახულება ანიჭებს)
+    CodeBuffer code;       // `T ms_tN = ...;` დეკლარაცია
+} Spill;
+
+/**
+ * @brief `ყოველი ი ში ა..ბ` ციკლი, რომლის სხეული მხოლოდ `მ[ი] = ...`
+ * ჩანაწერებია და მასივებს მხოლოდ ციკლის ცვლადით ინდექსირებს (იხ. find_array_kernel).
+ */
+typedef struct {
+    Symbol* arrays[CODEGEN_KERNEL_MAX_ARRAYS];
+    bool stored[CODEGEN_KERNEL_MAX_ARRAYS];   // მასივში სხეული წერს
+    int data[CODEGEN_KERNEL_MAX_ARRAYS];      // ბუფერის restrict მაჩვენებლის ms_tN
+    int count;
+    bool guarded;          // ჩანაწერი მთელ მასივში ms_fits_int-ის შემოწმებას საჭიროებს
+    bool int_kind;         // გენერირდება MS_ARRAY_INT ვარიანტი
+} ArrayKernel;
+
+/** @brief გენერაციის მდგომარეობა. */
+typedef struct {
+    CodeBuffer* out;       // მიმდინარე განცხადების ბუფერი
+    StringTable strings;
+    GenTask* tasks;        // გამოსახულებების გენერაციის სტეკი
+    int task_count;
+    int task_capacity;
+    Spill* spills;         // მიმდინარე განცხადების დროებითი ცვლადები
+    int spill_count;
+    int spill_capacity;
+    int temp_count;        // გამოყენებული ms_tN სახელები
+    AstStack walk;         // ქვეხის გავლა (ცვლადების აწევა, ციკლის სხეულის შემოწმება)
+    AstNode** functions;   // functions[id] — ფუნქციის განსაზღვრა სახელით
+    int function_capacity;
+    AstNode* function;     // ფუნქცია, რომლის სხეულიც ახლა გენერირდება (NULL — main)
+    bool function_roots;   // მიმდინარე ფუნქცია ფესვებს არეგისტრირებს (ms_roots)
+    bool function_heap;    // მიმდინარე ფუნქციაში ჰიპის მნიშვნელობები ჩნდება
+    CodeBuffer parallel;   // `პარალელური ყოველი`-ს გამოტანილი სხეულები (ms_parallel_N)
+    int parallel_count;
+    bool in_parallel;      // გამოტანილი სხეული გენერირდება: ჩადგმული ციკლები თანმიმდევრულია
+    ArrayKernel* kernel;   // გენერირდება ბირთვის სხეული: `მ[ი]` ბუფერს პირდაპირ კითხულობს (NULL — არა)
+    // მიმდინარე განცხადების გამოსახულება (იხ. begin_expression):
+    AstNode* root;         // ზედა კვანძი; მისი გამოძახება შეგროვებას არ გადადებს
+    bool defer_calls;      // ჩადგმული გამოძახებები შეგროვებას გადადებს
+    bool sequence_calls;   // ორი ან მეტი გამოძახებაა: მათი თანმიმდევრობა ცხადად დგინდება
+    AstNode** call_slots;  // კვანძები, რომელთა ქვეხე გამოძახებას შეიცავს (ღია მისამართები)
+    int call_slot_capacity;
+    bool* flags;           // გავლის დამხმარე სტეკი
+    int flag_count;
+    int flag_capacity;
+} CodeGenerator;
+
+static void generate_in_mode(AstNode* node, CodeGenerator* gen, GenMode mode);
+static void generate_expression(AstNode* node, CodeGenerator* gen);
+static void generate_double(AstNode* node, CodeGenerator* gen);
+static void begin_expression(CodeGenerator* gen, AstNode* root);
+static bool has_heap_node(AstNode* root, CodeGenerator* gen);
+
+void init_code_buffer(CodeBuffer* buffer) {
+    buffer->data = NULL;
+    buffer->length = 0;
+    buffer->capacity = 0;
+}
+
+void free_code_buffer(CodeBuffer* buffer) {
+    free(buffer->data);
+    init_code_buffer(buffer);
+}
+
+/** @brief უზრუნველყოფს, რომ ბუფერში კიდევ `extra` ბაიტი (და დამასრულებელი NUL) ჩაეტიოს. */
+static void reserve(CodeBuffer* buffer, size_t extra) {
+    size_t needed = buffer->length + extra + 1;
+    if (needed <= buffer->capacity) return;
+    size_t capacity = buffer->capacity < 4096 ? 4096 : buffer->capacity;
+    while (capacity < needed) capacity *= 2;
+    char* data = realloc(buffer->data, capacity);
+    if (!data) {
+        fprintf(stderr, "FATAL: Memory allocation failed for code buffer.\n");
+        exit(1);
+    }
+    buffer->data = data;
+    buffer->capacity = capacity;
+}
+
+/** @brief ამატებს `length` ბაიტს. */
+static void emit_chars(CodeBuffer* buffer, const char* chars, size_t length) {
+    reserve(buffer, length);
+    memcpy(buffer->data + buffer->length, chars, length);
+    buffer->length += length;
+    buffer->data[buffer->length] = '\0';
+}
+
+/** @brief ამატებს NUL-ით დასრულებულ სტრიქონს. */
+static void emit(CodeBuffer* buffer, const char* text) {
+    emit_chars(buffer, text, strlen(text));
+}
+
+/** @brief ამატებს printf-ის სტილის ფორმატირებულ ტექსტს პირდაპირ ბუფერში. */
+static void emit_format(CodeBuffer* buffer, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    va_list copy;
+    va_copy(copy, args);
+    int needed = vsnprintf(NULL, 0, format, copy);
+    va_end(copy);
+    if (needed > 0) {
+        reserve(buffer, (size_t)needed);
+        vsnprintf(buffer->data + buffer->length, (size_t)needed + 1, format, args);
+        buffer->length += (size_t)needed;
+    }
+    va_end(args);
+}
+
+/**
+ * @brief წერს რიცხვს C ლიტერალად, რომელიც ზუსტად იმავე double-ს იძლევა.
+ * ოპტიმიზატორის მიერ დაკეცილი მნიშვნელობები (მაგ. 1/3) სიზუსტეს არ უნდა
+ * კარგავდეს, ამიტომ ვირჩევთ უმოკლეს ჩანაწერს, რომელიც strtod-ით უკან
+ * იმავე მნიშვნელობად იკითხება. უარყოფითი რიცხვები ფრჩხილებშია, რომ
+ * ერთმაგ მინუსთან `--` არ შეიქმნას.
+ */
+static void generate_number(double value, CodeBuffer* out) {
+    if (isnan(value)) {
+        emit(out, signbit(value) ? "(-NAN)" : "NAN");
+        return;
+    }
+    if (isinf(value)) {
+        emit(out, value < 0 ? "(-INFINITY)" : "INFINITY");
+        return;
+    }
+    char buffer[32];
+    for (int precision = 15; precision <= 17; precision++) {
+        snprintf(buffer, sizeof(buffer), "%.*g", precision, value);
+        if (strtod(buffer, NULL) == value) break;
+    }
+    // "5" C-ში მთელი რიცხვია; double ლიტერალისთვის ".0" ემატება.
+    const char* suffix = strpbrk(buffer, ".eni") ? "" : ".0";
+    if (signbit(value)) emit_format(out, "(%s%s)", buffer, suffix);
+    else emit_format(out, "%s%s", buffer, suffix);
+}
+
+/** @brief წერს მთელ ლიტერალს int64_t კონტექსტისთვის (LL სუფიქსით, რომ int-ად არ გადაივსოს). */
+static void generate_integer(double value, CodeBuffer* out) {
+    long long integer = (long long)value;
+    if (integer < 0) emit_format(out, "(%lldLL)", integer);
+    else emit_format(out, "%lldLL", integer);
+}
+
+static unsigned int hash_bytes(const char* chars, int length) {
+    unsigned int hash = 2166136261u;
+    for (int i = 0; i < length; i++) {
+        hash ^= (uint8_t)chars[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static void free_string_table(StringTable* table) {
+    free(table->literals);
+    free(table->slots);
+}
+
+static void grow_string_slots(StringTable* table) {
+    int capacity = table->slot_capacity == 0 ? 64 : table->slot_capacity * 2;
+    int* slots = calloc((size_t)capacity, sizeof(int));
+    if (!slots) {
+        fprintf(stderr, "FATAL: Memory allocation failed for string table.\n");
+        exit(1);
+    }
+    for (int i = 0; i < table->count; i++) {
+        StringLiteral* literal = &table->literals[i];
+        unsigned int slot = hash_bytes(literal->chars, literal->length) & (unsigned int)(capacity - 1);
+        while (slots[slot] != 0) slot = (slot + 1) & (unsigned int)(capacity - 1);
+        slots[slot] = i + 1;
+    }
+    free(table->slots);
+    table->slots = slots;
+    table->slot_capacity = capacity;
+}
+
+/** @brief აბრუნებს ლიტერალის ინდექსს ცხრილში (საჭიროებისას ამატებს). */
+static int intern_literal(StringTable* table, const char* chars, int length) {
+    if ((table->count + 1) * 2 > table->slot_capacity) grow_string_slots(table);
+    unsigned int mask = (unsigned int)(table->slot_capacity - 1);
+    unsigned int slot = hash_bytes(chars, length) & mask;
+    while (table->slots[slot] != 0) {
+        StringLiteral* literal = &table->literals[table->slots[slot] - 1];
+        if (literal->length == length && memcmp(literal->chars, chars, (size_t)length) == 0) {
+            return table->slots[slot] - 1;
+        }
+        slot = (slot + 1) & mask;
+    }
+    if (table->count >= table->capacity) {
+        table->capacity = table->capacity < 16 ? 16 : table->capacity * 2;
+        StringLiteral* literals = realloc(table->literals, (size_t)table->capacity * sizeof(StringLiteral));
+        if (!literals) {
+            fprintf(stderr, "FATAL: Memory allocation failed for string table.\n");
+            exit(1);
+        }
+        table->literals = literals;
+    }
+    table->literals[table->count].chars = chars;
+    table->literals[table->count].length = length;
+    table->slots[slot] = ++table->count;
+    return table->count - 1;
+}
+
+/**
+ * @brief წერს ბაიტებს C სტრიქონულ ლიტერალად. UTF-8 ბაიტები უცვლელად
+ * გადის; მმართველი სიმბოლოები სამნიშნა რვაობითი კოდით იწერება, რომ
+ * მომდევნო ციფრმა ის არ გააგრძელოს.
+ */
+static void generate_c_string(const char* chars, int length, CodeBuffer* out) {
+    emit(out, "\"");
+    for (int i = 0; i < length; i++) {
+        unsigned char c = (unsigned char)chars[i];
+        if (c == '"' || c == '\\') emit_format(out, "\\%c", c);
+        else if (c < 0x20 || c == 0x7F) emit_format(out, "\\%03o", c);
+        else emit_chars(out, &chars[i], 1);
+    }
+    emit(out, "\"");
+}
+
+/**
+ * @brief წერს სტრიქონულ ლიტერალს MsValue-დ: მოკლე სტრიქონი პირდაპირ
+ * სიტყვად (გამოყოფის გარეშე), გრძელი — ინტერნირებული ცხრილის ჩანაწერად.
+ */
+static void generate_string(AstNode* node, CodeGenerator* gen) {
+    const char* chars = node->as.string.chars;
+    int length = node->as.string.length;
+    if (ms_fits_small_string(chars, (size_t)length)) {
+        emit_format(gen->out, "((MsValue)0x%016llxULL)", (unsigned long long)ms_small_string(chars, (size_t)length));
+        return;
+    }
+    emit_format(gen->out, "ms_string_value(&ms_literals[%d])", intern_literal(&gen->strings, chars, length));
+}
+
+/** @brief ტიპი, რომლის მნიშვნელობა შეიძლება ჰიპ-ობიექტი იყოს (GC-ს ფესვი). */
+static bool is_heap_type(ValueType type) {
+    return type == TYPE_STRING || type == TYPE_VALUE || type == TYPE_ARRAY;
+}
+
+static bool is_int(AstNode* node) {
+    return node != NULL && node->value_type == TYPE_INT;
+}
+
+static bool is_numeric(AstNode* node) {
+    return node->value_type != TYPE_BOOL && !is_heap_type((ValueType)node->value_type);
+}
+
+/** @brief გამოსახულების ტიპის C ტიპი. */
+static const char* c_type_name(ValueType type) {
+    switch (type) {
+        case TYPE_INT: return "int64_t";
+        case TYPE_BOOL: return "bool";
+        case TYPE_STRING:
+        case TYPE_VALUE:
+        case TYPE_ARRAY: return "MsValue";
+        default: return "double";
+    }
+}
+
+/**
+ * @brief წერს ცვლადის სახელს `v_` პრეფიქსით, რომ მომხმარებლის სახელი
+ * runtime-ის (ms_*) ან C-ის სახელებს არ დაეჯახოს.
+ */
+static void generate_name(Symbol* name, CodeBuffer* out) {
+    emit(out, "v_");
+    emit_chars(out, name->chars, (size_t)name->length);
+}
+
+/** @brief მასივის `ყოველი` ციკლის მასივის ცვლადი: `ms_each_v_ე` (ე — ციკლის ცვლადი). */
+static void generate_iterable_name(Symbol* variable, CodeBuffer* out) {
+    emit(out, "ms_each_");
+    generate_name(variable, out);
+}
+
+/** @brief ჭეშმარიტია `ყოველი ე ში მასივი:` ციკლისთვის (დიაპაზონის ნაცვლად). */
+static bool is_array_for(const AstNode* node) {
+    return (node->type == NODE_FOR || node->type == NODE_PARALLEL_FOR) &&
+           node->as.for_stmt.iterable->type != NODE_RANGE;
+}
+
+/**
+ * @brief ცვლადის მნიშვნელობის გენერაციის კონტექსტი: ცვლადი ყველა მინიჭების
+ * გაერთიანებულ ტიპს ინახავს, ამიტომ მთელი მნიშვნელობა ათწილად ცვლადში
+ * double-ად, ხოლო ნებისმიერი — დინამიურ ცვლადში MsValue-დ იწერება.
+ */
+static GenMode variable_mode(ValueType type) {
+    switch (type) {
+        case TYPE_INT:
+        case TYPE_BOOL: return GEN_EXPRESSION;
+        case TYPE_STRING:
+        case TYPE_VALUE:
+        case TYPE_ARRAY: return GEN_VALUE;
+        default: return GEN_DOUBLE;
+    }
+}
+
+/**
+ * @brief გენერირებს კოდს მარტივი განცხადებისთვის (დეკლარაცია, მინიჭება,
+ * ბეჭდვა, გამოსახულება-განცხადება). ხაზები შეწევის გარეშე იწერება; მას emit_lines ამატებს.
+ */
+static void generate_simple_statement(AstNode* node, CodeGenerator* gen) {
+    CodeBuffer* out = gen->out;
     switch (node->type) {
         case NODE_VAR_DECL:
-            fprintf(outfile, "double %.*s = ", node->as.var_decl.name.length, node->as.var_decl.name.start);
-            generate_expression(node->as.var_decl.initializer, outfile);
-            fprintf(outfile, ";\n");
+        case NODE_ASSIGN: {
+            // ცვლადი main-ის თავშია გამოცხადებული, აქ მხოლოდ მნიშვნელობა ენიჭება.
+            bool is_decl = node->type == NODE_VAR_DECL;
+            Symbol* name = is_decl ? node->as.var_decl.name : node->as.assign.name;
+            AstNode* value = is_decl ? node->as.var_decl.initializer : node->as.assign.value;
+            begin_expression(gen, value);
+            generate_name(name, out);
+            emit(out, " = ");
+            generate_in_mode(value, gen, variable_mode((ValueType)node->value_type));
+            emit(out, ";\n");
+            if (is_heap_type((ValueType)node->value_type)) emit(out, "ms_gc_safepoint();\n");
+            break;
+        }
+        case NODE_PRINT_STMT: {
+            AstNode* expression = node->as.print_stmt.expression;
+            begin_expression(gen, expression);
+            switch (expression->value_type) {
+                case TYPE_INT:
+                    // ფართო მთელი ±2^53-ის მიღმა double-ზე გადასულია და ისე იბეჭდება.
+                    emit(out, expression->wide ? "ms_print_int(" : "printf(\"%\" PRId64 \"\\n\", ");
+                    generate_expression(expression, gen);
+                    emit(out, ");\n");
+                    break;
+                case TYPE_BOOL:
+                    emit(out, "puts(");
+                    generate_expression(expression, gen);
+                    emit(out, " ? \"ჭეშმარიტი\" : \"მცდარი\");\n");
+                    break;
+                case TYPE_STRING:
+                case TYPE_VALUE:
+                case TYPE_ARRAY:
+                    // დროებითი მნიშვნელობა ბეჭდვის შემდეგ ცოცხალი აღარაა, ამიტომ უსაფრთხო წერტილი მის მერეა.
+                    emit(out, "ms_print(");
+                    generate_expression(expression, gen);
+                    emit(out, ");\nms_gc_safepoint();\n");
+                    break;
+                default:
+                    emit(out, "printf(\"%f\\n\", ");
+                    generate_double(expression, gen);
+                    emit(out, ");\n");
+                    break;
+            }
             break;
-        case NODE_PRINT_STMT:
-            fprintf(outfile, "printf(\"%%f\\n\", ");
-            generate_expression(node->as.print_stmt.expression, outfile);
-            fprintf(outfile, ");\n");
+        }
+        case NODE_EXPRESSION_STMT: {
+            AstNode* expression = node->as.expression_stmt.expression;
+            begin_expression(gen, expression);
+            bool call = expression->type == NODE_CALL || expression->type == NODE_BUILTIN;
+            emit(out, call ? "" : "(void)(");
+            generate_expression(expression, gen);
+            emit(out, call ? ";\n" : ");\n");
+            if (is_heap_type((ValueType)expression->value_type)) emit(out, "ms_gc_safepoint();\n");
+            break;
+        }
+        case NODE_INDEX_ASSIGN: {
+            AstNode* array = node->as.index_assign.array;
+            begin_expression(gen, node);
+            generate_expression(node, gen);
+            emit(out, ";\n");
+            // ჩანაწერი თავად არაფერს გამოყოფს; უსაფრთხო წერტილი მხოლოდ დროებითი ობიექტების შემდეგაა საჭირო.
+            if (array->type != NODE_VARIABLE || has_heap_node(node->as.index_assign.index, gen) ||
+                has_heap_node(node->as.index_assign.value, gen)) {
+                emit(out, "ms_gc_safepoint();\n");
+            }
             break;
+        }
         default:
             fprintf(stderr, "CodeGen Error: Unknown statement type for generation.\n");
             break;
     }
 }
 
+/** @brief დებს ამოცანას სტეკზე. */
+static void push_task(CodeGenerator* gen, GenMode mode, AstNode* node, const char* text, int depth) {
+    if (gen->task_count >= gen->task_capacity) {
+        gen->task_capacity = gen->task_capacity < 64 ? 64 : gen->task_capacity * 2;
+        GenTask* tasks = realloc(gen->tasks, sizeof(GenTask) * (size_t)gen->task_capacity);
+        if (!tasks) {
+            fprintf(stderr, "FATAL: Memory allocation failed for code generator.\n");
+            exit(1);
+        }
+        gen->tasks = tasks;
+    }
+    GenTask* task = &gen->tasks[gen->task_count++];
+    task->mode = mode;
+    task->depth = depth;
+    if (mode == GEN_TEXT) task->as.text = text;
+    else task->as.node = node;
+}
+
+// ამოცანები სტეკზე უკუღმა ლაგდება: ბოლოს ჩადებული პირველი გენერირდება.
+static void push_text(CodeGenerator* gen, const char* text) {
+    push_task(gen, GEN_TEXT, NULL, text, 0);
+}
+
+static void push_node(CodeGenerator* gen, GenMode mode, AstNode* node, int depth) {
+    push_task(gen, mode, node, NULL, depth);
+}
+
+/** @brief ამატებს დროებით ცვლადს განცხადების წინ; `node` NULL-ია, თუ მას მნიშვნელობა გამოსახულებაში ენიჭება. */
+static int add_spill(CodeGenerator* gen, AstNode* node, const char* type) {
+    if (gen->spill_count >= gen->spill_capacity) {
+        gen->spill_capacity = gen->spill_capacity < 8 ? 8 : gen->spill_capacity * 2;
+        Spill* spills = realloc(gen->spills, sizeof(Spill) * (size_t)gen->spill_capacity);
+        if (!spills) {
+            fprintf(stderr, "FATAL: Memory allocation failed for code generator.\n");
+            exit(1);
+        }
+        gen->spills = spills;
+    }
+    Spill* spill = &gen->spills[gen->spill_count++];
+    spill->node = node;
+    init_code_buffer(&spill->code);
+    emit_format(&spill->code, node != NULL ? "%s ms_t%d = " : "%s ms_t%d", type, gen->temp_count);
+    return gen->temp_count++;
+}
+
+/**
+ * @brief გადააქვს ქვეხე დროებით ცვლადში და წერს მის სახელს. დეკლარაცია
+ * განცხადების წინ იწერება, ამიტომ ქვეხე დანარჩენ გამოსახულებაზე ადრე
+ * გამოითვლება; ოპერაციები გვერდითი ეფექტების გარეშეა და შემგროვებელი
+ * მხოლოდ განცხადებებს შორის მუშაობს, ასე რომ შედეგი არ იცვლება. ერთადერთი
+ * გამონაკლისი გატანილ ქვეხეში მოხვედრილი ფუნქციის გამოძახებაა: ის
+ * განცხადების დანარჩენ გამოძახებებზე ადრე სრულდება.
+ */
+static void spill_expression(AstNode* node, CodeGenerator* gen) {
+    emit_format(gen->out, "ms_t%d", add_spill(gen, node, c_type_name((ValueType)node->value_type)));
+}
+
+/** @brief C ტიპი, რომელშიც კვანძი მოცემულ კონტექსტში გენერირდება. */
+static const char* mode_type_name(GenMode mode, AstNode* node) {
+    switch (mode) {
+        case GEN_DOUBLE: return "double";
+        case GEN_VALUE: return "MsValue";
+        case GEN_CONDITION: return "bool";
+        case GEN_ELEMENT: return "double";
+        case GEN_INDEX: return "int64_t";
+        default: return c_type_name((ValueType)node->value_type);
+    }
+}
+
+static void push_temp(CodeGenerator* gen, int temp) {
+    push_task(gen, GEN_TEMP, NULL, NULL, 0);
+    gen->tasks[gen->task_count - 1].as.temp = temp;
+}
+
+static void push_count(CodeGenerator* gen, int count) {
+    push_task(gen, GEN_COUNT, NULL, NULL, 0);
+    gen->tasks[gen->task_count - 1].as.count = count;
+}
+
+static unsigned int hash_node(const AstNode* node) {
+    uintptr_t bits = (uintptr_t)node;
+    return (unsigned int)((bits >> 4) ^ (bits >> 20)) * 2654435761u;
+}
+
+/**
+ * @brief ჭეშმარიტია, თუ კვანძის ქვეხე გამოძახებას ან მასივის შიგთავსის
+ * წაკითხვას შეიცავს (მხოლოდ მაშინ ითვლება, როცა მათი რიგი მნიშვნელოვანია).
+ */
+static bool contains_call(CodeGenerator* gen, const AstNode* node) {
+    if (!gen->sequence_calls || node == NULL) return false;
+    unsigned int mask = (unsigned int)gen->call_slot_capacity - 1;
+    for (unsigned int slot = hash_node(node) & mask; gen->call_slots[slot] != NULL; slot = (slot + 1) & mask) {
+        if (gen->call_slots[slot] == node) return true;
+    }
+    return false;
+}
+
+static void mark_call_node(CodeGenerator* gen, AstNode* node, int* marked) {
+    if ((*marked + 1) * 2 > gen->call_slot_capacity) {
+        AstNode** old = gen->call_slots;
+        int old_capacity = gen->call_slot_capacity;
+        gen->call_slot_capacity = old_capacity < 64 ? 64 : old_capacity * 2;
+        gen->call_slots = calloc((size_t)gen->call_slot_capacity, sizeof(AstNode*));
+        if (!gen->call_slots) {
+            fprintf(stderr, "FATAL: Memory allocation failed for code generator.\n");
+            exit(1);
+        }
+        for (int i = 0; i < old_capacity; i++) {
+            if (old[i] != NULL) {
+                int rehashed = 0;
+                mark_call_node(gen, old[i], &rehashed);
+            }
+        }
+        free(old);
+    }
+    unsigned int mask = (unsigned int)gen->call_slot_capacity - 1;
+    unsigned int slot = hash_node(node) & mask;
+    while (gen->call_slots[slot] != NULL) slot = (slot + 1) & mask;
+    gen->call_slots[slot] = node;
+    (*marked)++;
+}
+
+static void push_flag(CodeGenerator* gen, bool flag) {
+    if (gen->flag_count >= gen->flag_capacity) {
+        gen->flag_capacity = gen->flag_capacity < 64 ? 64 : gen->flag_capacity * 2;
+        bool* flags = realloc(gen->flags, sizeof(bool) * (size_t)gen->flag_capacity);
+        if (!flags) {
+            fprintf(stderr, "FATAL: Memory allocation failed for code generator.\n");
+            exit(1);
+        }
+        gen->flags = flags;
+    }
+    gen->flags[gen->flag_count++] = flag;
+}
+
+/**
+ * @brief ჭეშმარიტია კვანძისთვის, რომელიც მასივის შიგთავსს კითხულობს ან ცვლის
+ * (ინდექსი, ჩაშენებული ფუნქცია, ელემენტური არითმეტიკა): გამოძახებამ იმავე
+ * მასივის შეცვლა შეიძლება, ამიტომ მათი რიგი გამოძახებებთან ცხადად დგინდება.
+ */
+static bool touches_array(const AstNode* node) {
+    switch (node->type) {
+        case NODE_INDEX:
+        case NODE_BUILTIN: return true;
+        case NODE_UNARY_OP:
+        case NODE_BINARY_OP: return node->value_type == TYPE_ARRAY || node->value_type == TYPE_VALUE;
+        default: return false;
+    }
+}
+
+/**
+ * @brief ამზადებს განცხადების გამოსახულების გენერაციას. C-ში ოპერანდებისა და
+ * არგუმენტების გამოთვლის რიგი განუსაზღვრელია, ამიტომ ორი ან მეტი გამოძახებისას
+ * (ან გამოძახებისა და მასივის წაკითხვისას) აღინიშნება ქვეხეები, რომლებიც მათ
+ * შეიცავს: ისინი დროებით ცვლადებში მარცხნიდან მარჯვნივ გამოითვლება. თუ გამოსახულებაში (ფესვის გარდა) ჰიპის
+ * მნიშვნელობაა, ჩადგმული გამოძახება შეგროვებას გადადებს — გამომძახებლის
+ * დროებით მნიშვნელობებს ფესვები არ აქვს.
+ */
+static void begin_expression(CodeGenerator* gen, AstNode* root) {
+    gen->root = root;
+    gen->defer_calls = false;
+    gen->sequence_calls = false;
+    int calls = 0;
+    int touches = 0;
+    AstNode* node;
+    ast_stack_push(&gen->walk, root);
+    while (ast_stack_next_postorder(&gen->walk, &node)) {
+        if (node == NULL) continue;
+        if (node->type == NODE_CALL) calls++;
+        else if (touches_array(node)) touches++;
+        if (node != root && is_heap_type((ValueType)node->value_type)) gen->defer_calls = true;
+    }
+    if (calls == 0 || calls + touches < 2) return;
+
+    if (gen->call_slot_capacity > 0) memset(gen->call_slots, 0, sizeof(AstNode*) * (size_t)gen->call_slot_capacity);
+    int marked = 0;
+    gen->flag_count = 0;
+    ast_stack_push(&gen->walk, root);
+    while (ast_stack_next_postorder(&gen->walk, &node)) {
+        bool flag = node != NULL && (node->type == NODE_CALL || touches_array(node));
+        for (int i = ast_child_count(node); i > 0; i--) flag = gen->flags[--gen->flag_count] || flag;
+        if (flag) mark_call_node(gen, node, &marked);
+        push_flag(gen, flag);
+    }
+    gen->sequence_calls = true;
+}
+
+/** @brief აბრუნებს ფუნქციის განსაზღვრას სახელით (NULL — უცნობი). */
+static AstNode* find_function(CodeGenerator* gen, Symbol* name) {
+    return name->id < gen->function_capacity ? gen->functions[name->id] : NULL;
+}
+
+/** @brief გადადებული გამოძახების თავი დაბრუნების ტიპის მიხედვით. */
+static const char* resume_prefix(ValueType type) {
+    switch (type) {
+        case TYPE_INT: return "(ms_gc_defer_depth++, ms_gc_resume_int(";
+        case TYPE_BOOL: return "(ms_gc_defer_depth++, ms_gc_resume_bool(";
+        case TYPE_STRING:
+        case TYPE_VALUE:
+        case TYPE_ARRAY: return "(ms_gc_defer_depth++, ms_gc_resume_value(";
+        default: return "(ms_gc_defer_depth++, ms_gc_resume_number(";
+    }
+}
+
+/**
+ * @brief ელემენტების სია C-ის `a, b, ...` ჩანაწერისთვის (გამოძახების
+ * არგუმენტები, ჩაშენებული ფუნქციის არგუმენტები, მასივის ლიტერალი).
+ */
+typedef struct {
+    AstNode** items;
+    int count;
+    AstNode** parameters;  // გამოძახების პარამეტრები: ელემენტის რეჟიმი მათი ტიპიდან
+    const GenMode* modes;  // სხვა შემთხვევაში ელემენტების რეჟიმები (NULL — ყველასთვის `mode`)
+    GenMode mode;
+    int last;              // ბოლო ელემენტი, რომელიც გამოძახებას შეიცავს (-1 — არცერთი)
+    int base;              // პირველი წინასწარი გამოთვლის დროებითი ცვლადი
+    int sequenced;         // წინასწარ გამოთვლილი ელემენტების რაოდენობა
+} ItemList;
+
+static GenMode item_mode(const ItemList* list, int i) {
+    if (list->parameters != NULL) return variable_mode((ValueType)list->parameters[i]->value_type);
+    return list->modes != NULL ? list->modes[i] : list->mode;
+}
+
+/**
+ * @brief ამზადებს სიის გენერაციას. თუ რამდენიმე ელემენტი შეიცავს
+ * გამოძახებას, ბოლოს გარდა ყველა მათგანი ჯერ დროებით ცვლადში გამოითვლება
+ * (კომა ოპერატორით), რომ გვერდითი ეფექტები მარცხნიდან მარჯვნივ მოხდეს;
+ * მაშინ მთელი ჩანაწერი ფრჩხილებში ექცევა.
+ */
+static void begin_items(CodeGenerator* gen, ItemList* list) {
+    list->last = -1;
+    for (int i = 0; i < list->count; i++) {
+        if (contains_call(gen, list->items[i])) list->last = i;
+    }
+    list->base = gen->temp_count;
+    list->sequenced = 0;
+    for (int i = 0; i < list->last; i++) {
+        if (!contains_call(gen, list->items[i])) continue;
+        add_spill(gen, NULL, mode_type_name(item_mode(list, i), list->items[i]));
+        list->sequenced++;
+    }
+    if (list->sequenced > 0) {
+        emit(gen->out, "(");
+        push_text(gen, ")");
+    }
+}
+
+/** @brief დებს სტეკზე ელემენტებს მძიმეებით; წინასწარ გამოთვლილის ნაცვლად — მის დროებით ცვლადს. */
+static void push_items(CodeGenerator* gen, const ItemList* list, int depth) {
+    int temp = list->base + list->sequenced;
+    for (int i = list->count - 1; i >= 0; i--) {
+        if (i < list->last && contains_call(gen, list->items[i])) push_temp(gen, --temp);
+        else push_node(gen, item_mode(list, i), list->items[i], depth + 1);
+        if (i > 0) push_text(gen, ", ");
+    }
+}
+
+/** @brief დებს სტეკზე წინასწარ გამოთვლებს `ms_tN = ელემენტი, ` (ისინი სიის თავამდე გენერირდება). */
+static void push_sequenced_items(CodeGenerator* gen, const ItemList* list, int depth) {
+    int temp = list->base + list->sequenced;
+    for (int i = list->last - 1; i >= 0; i--) {
+        if (!contains_call(gen, list->items[i])) continue;
+        push_text(gen, ", ");
+        push_node(gen, item_mode(list, i), list->items[i], depth + 1);
+        push_text(gen, " = ");
+        push_temp(gen, --temp);
+    }
+}
+
+/** @brief გენერირებს გამოძახებას `f_სახელი(...)`; არგუმენტი პარამეტრის C ტიპში იწერება. */
+static void expand_call(AstNode* node, CodeGenerator* gen, int depth) {
+    AstNode* function = find_function(gen, node->as.call.callee);
+    if (function == NULL) {
+        fprintf(stderr, "CodeGen Error: Unknown function '%s'.\n", node->as.call.callee->chars);
+        return;
+    }
+    ItemList list = { node->as.call.arguments, node->as.call.count, function->as.function.parameters->as.block.statements,
+                      NULL, GEN_EXPRESSION, 0, 0, 0 };
+    begin_items(gen, &list);
+    bool deferred = gen->defer_calls && node != gen->root;
+    if (deferred) push_text(gen, "))");
+    push_text(gen, ")");
+    push_items(gen, &list, depth);
+    push_text(gen, "(");
+    push_text(gen, node->as.call.callee->chars);
+    push_text(gen, "f_");
+    if (deferred) push_text(gen, resume_prefix((ValueType)function->value_type));
+    push_sequenced_items(gen, &list, depth);
+}
+
+/**
+ * @brief ჩაშენებული ფუნქციის runtime გამოძახება და არგუმენტების რეჟიმები.
+ * int_call — ვარიანტი, რომელიც int64_t-ს აბრუნებს, როცა კვანძი TYPE_INT-ია
+ * (ტიპების გამოყვანამ არგუმენტი მთელ მასივად იცნო).
+ */
+static const struct {
+    const char* call;
+    const char* int_call;
+    GenMode modes[2];
+} builtin_calls[BUILTIN_COUNT] = {
+    [BUILTIN_LENGTH] = { "ms_length(", NULL, { GEN_VALUE } },
+    [BUILTIN_ARRAY] = { "ms_array_new(", NULL, { GEN_INDEX } },
+    [BUILTIN_PUSH] = { "ms_push(", NULL, { GEN_VALUE, GEN_ELEMENT } },
+    [BUILTIN_SUM] = { "ms_sum(", "ms_sum_int(", { GEN_VALUE } },
+    [BUILTIN_MIN] = { "ms_min(", "ms_min_int(", { GEN_VALUE } },
+    [BUILTIN_MAX] = { "ms_max(", "ms_max_int(", { GEN_VALUE } },
+    [BUILTIN_DOT] = { "ms_dot(", NULL, { GEN_VALUE, GEN_VALUE } },
+};
+
+/** @brief `ა[ი] = x`-ის ოპერანდების რეჟიმები: ms_array_set(ა, ი, x). */
+static const GenMode index_assign_modes[3] = { GEN_VALUE, GEN_INDEX, GEN_ELEMENT };
+
+/**
+ * @brief გენერირებს მასივის ლიტერალს: ყველა ელემენტი ზუსტი (არაფართო) მთელია —
+ * int64_t ცხრილიდან (ms_array_from_int), სხვა შემთხვევაში — double ცხრილიდან.
+ */
+static void expand_array(AstNode* node, CodeGenerator* gen, int depth) {
+    int count = node->as.array.count;
+    if (count == 0) {
+        emit(gen->out, "ms_array_from_int(0, NULL)");
+        return;
+    }
+    bool integers = true;
+    for (int i = 0; i < count; i++) {
+        if (!is_int(node->as.array.elements[i]) || node->as.array.elements[i]->wide) integers = false;
+    }
+    ItemList list = { node->as.array.elements, count, NULL, NULL, integers ? GEN_EXPRESSION : GEN_ELEMENT, 0, 0, 0 };
+    begin_items(gen, &list);
+    push_text(gen, "})");
+    push_items(gen, &list, depth);
+    push_text(gen, integers ? ", (const int64_t[]){" : ", (const double[]){");
+    push_count(gen, count);
+    push_text(gen, integers ? "ms_array_from_int(" : "ms_array_from_double(");
+    push_sequenced_items(gen, &list, depth);
+}
+
+/** @brief გენერირებს ჩაშენებული ფუნქციის ან `ა[ი] = x`-ის runtime გამოძახებას. */
+static void expand_runtime_call(const char* call, ItemList* list, CodeGenerator* gen, int depth) {
+    begin_items(gen, list);
+    push_text(gen, ")");
+    push_items(gen, list, depth);
+    push_text(gen, call);
+    push_sequenced_items(gen, list, depth);
+}
+
+/** @brief გენერირებს მასივის ელემენტს: რიცხვი double-ად, დინამიური მნიშვნელობა — შემოწმებით. */
+static void expand_element(AstNode* node, CodeGenerator* gen, int depth) {
+    if (is_numeric(node)) {
+        push_node(gen, GEN_DOUBLE, node, depth);
+        return;
+    }
+    emit(gen->out, "ms_element_value(");
+    push_text(gen, ")");
+    push_node(gen, GEN_VALUE, node, depth + 1);
+}
+
+/** @brief გენერირებს ინდექსს: მთელი — უცვლელად, ნამდვილი და დინამიური — მთელობის შემოწმებით. */
+static void expand_index(AstNode* node, CodeGenerator* gen, int depth) {
+    if (is_int(node)) {
+        push_node(gen, GEN_EXPRESSION, node, depth);
+    } else if (is_numeric(node)) {
+        emit(gen->out, "ms_index(");
+        push_text(gen, ")");
+        push_node(gen, GEN_DOUBLE, node, depth + 1);
+    } else {
+        emit(gen->out, "ms_index_value(");
+        push_text(gen, ")");
+        push_node(gen, GEN_VALUE, node, depth + 1);
+    }
+}
+
+/**
+ * @brief გენერირებს გამოსახულებას double კონტექსტისთვის: მთელი
+ * გამოსახულება (double)-ით გარდაიქმნება, რაც |x| <= 2^53-ისთვის ზუსტია.
+ */
+static void expand_double(AstNode* node, CodeGenerator* gen, int depth) {
+    if (!is_int(node)) {
+        push_node(gen, GEN_EXPRESSION, node, depth);
+        return;
+    }
+    if (node->type == NODE_NUMBER) {
+        generate_number(node->as.number.value, gen->out);
+        return;
+    }
+    emit(gen->out, "((double)");
+    push_text(gen, ")");
+    push_node(gen, GEN_EXPRESSION, node, depth + 1);
+}
+
+/**
+ * @brief გენერირებს გამოსახულებას MsValue კონტექსტისთვის: სტატიკურად
+ * ცნობილი ტიპის მნიშვნელობა აქ იფუთება.
+ */
+static void expand_value(AstNode* node, CodeGenerator* gen, int depth) {
+    CodeBuffer* out = gen->out;
+    switch (node->value_type) {
+        case TYPE_STRING:
+        case TYPE_VALUE:
+        case TYPE_ARRAY:
+            push_node(gen, GEN_EXPRESSION, node, depth);
+            break;
+        case TYPE_BOOL:
+            if (node->type == NODE_BOOLEAN) {
+                emit(out, node->as.boolean.value ? "MS_TRUE" : "MS_FALSE");
+                break;
+            }
+            emit(out, "ms_bool(");
+            push_text(gen, ")");
+            push_node(gen, GEN_EXPRESSION, node, depth + 1);
+            break;
+        default:
+            emit(out, "ms_number(");
+            push_text(gen, ")");
+            push_node(gen, GEN_DOUBLE, node, depth + 1);
+            break;
+    }
+}
+
+/**
+ * @brief გენერირებს გამოსახულების ჭეშმარიტობას bool-ად: ლოგიკური
+ * გამოსახულება უცვლელად, რიცხვი — ნულთან შედარებით, დინამიური
+ * მნიშვნელობა — ms_truthy-ით.
+ */
+static void expand_condition(AstNode* node, CodeGenerator* gen, int depth) {
+    CodeBuffer* out = gen->out;
+    switch (node->value_type) {
+        case TYPE_BOOL:
+            push_node(gen, GEN_EXPRESSION, node, depth);
+            break;
+        case TYPE_INT:
+            emit(out, "(");
+            push_text(gen, " != 0)");
+            push_node(gen, GEN_EXPRESSION, node, depth + 1);
+            break;
+        case TYPE_STRING:
+        case TYPE_VALUE:
+        case TYPE_ARRAY:
+            emit(out, "ms_truthy(");
+            push_text(gen, ")");
+            push_node(gen, GEN_EXPRESSION, node, depth + 1);
+            break;
+        default:
+            emit(out, "(");
+            push_text(gen, " != 0.0)");
+            push_node(gen, GEN_DOUBLE, node, depth + 1);
+            break;
+    }
+}
+
+/** @brief აბრუნებს runtime-ის ფუნქციას MsValue ოპერანდებზე ორობითი ოპერაციისთვის. */
+static const char* value_operation(TokenType op) {
+    switch (op) {
+        case TOKEN_PLUS: return "ms_add(";
+        case TOKEN_MINUS: return "ms_sub(";
+        case TOKEN_STAR: return "ms_mul(";
+        default: return "ms_div(";
+    }
+}
+
+/** @brief აბრუნებს ოპერატორს ჰარებით (" + "), რომ ის ერთ ამოცანად ჩაიდოს. */
+static const char* spaced_operator(TokenType op) {
+    switch (op) {
+        case TOKEN_PLUS: return " + ";
+        case TOKEN_MINUS: return " - ";
+        case TOKEN_STAR: return " * ";
+        case TOKEN_SLASH: return " / ";
+        case TOKEN_EQUAL_EQUAL: return " == ";
+        case TOKEN_BANG_EQUAL: return " != ";
+        case TOKEN_LESS: return " < ";
+        case TOKEN_LESS_EQUAL: return " <= ";
+        case TOKEN_GREATER: return " > ";
+        case TOKEN_GREATER_EQUAL: return " >= ";
+        default: return " ? ";
+    }
+}
+
+/** @brief აბრუნებს runtime-ის ფუნქციას MsValue ოპერანდების რიგის შედარებისთვის. */
+static const char* value_comparison(TokenType op) {
+    switch (op) {
+        case TOKEN_LESS: return "ms_less(";
+        case TOKEN_LESS_EQUAL: return "ms_less_equal(";
+        case TOKEN_GREATER: return "ms_greater(";
+        default: return "ms_greater_equal(";
+    }
+}
+
+static bool is_comparison(TokenType op) {
+    return op == TOKEN_EQUAL_EQUAL || op == TOKEN_BANG_EQUAL || op == TOKEN_LESS || op == TOKEN_LESS_EQUAL ||
+           op == TOKEN_GREATER || op == TOKEN_GREATER_EQUAL;
+}
+
+/**
+ * @brief დებს სტეკზე `prefix left separator right suffix` თანმიმდევრობას;
+ * prefix პირდაპირ იწერება.
+ */
+static void expand_pair(CodeGenerator* gen, const char* prefix, GenMode left_mode, AstNode* left, const char* separator,
+                        GenMode right_mode, AstNode* right, const char* suffix, int depth) {
+    // ორივე ოპერანდში გამოძახებაა: მარცხენა ჯერ დროებით ცვლადში გამოითვლება.
+    // `&&`/`||` (GEN_CONDITION ოპერანდები) თანმიმდევრობას თავად ადგენს.
+    if (left_mode != GEN_CONDITION && contains_call(gen, left) && contains_call(gen, right)) {
+        int temp = add_spill(gen, NULL, mode_type_name(left_mode, left));
+        emit_format(gen->out, "(ms_t%d = ", temp);
+        push_text(gen, ")");
+        push_text(gen, suffix);
+        push_node(gen, right_mode, right, depth + 1);
+        push_text(gen, separator);
+        push_temp(gen, temp);
+        push_text(gen, prefix);
+        push_text(gen, ", ");
+        push_node(gen, left_mode, left, depth + 1);
+        return;
+    }
+    emit(gen->out, prefix);
+    push_text(gen, suffix);
+    push_node(gen, right_mode, right, depth + 1);
+    push_text(gen, separator);
+    push_node(gen, left_mode, left, depth + 1);
+}
+
+/**
+ * @brief გენერირებს ორობით ოპერაციას, რომლის შედეგი double-ია. მთელ
+ * ოპერანდებზე `+` და `-` ყოველთვის მთელია (იხ. type_infer.h), ამიტომ აქ
+ * მხოლოდ `*` და `/` მოდის. მთელი `*` ms_mul_int-ით სრულდება, რომელიც
+ * გადავსებისას double-ზე გადადის.
+ */
+static void expand_double_binary(AstNode* node, CodeGenerator* gen, int depth) {
+    AstNode* left = node->as.binary_op.left;
+    AstNode* right = node->as.binary_op.right;
+    TokenType op = node->as.binary_op.operator;
+    if (is_int(left) && is_int(right) && op == TOKEN_STAR) {
+        expand_pair(gen, "ms_mul_int(", GEN_EXPRESSION, left, ", ", GEN_EXPRESSION, right, ")", depth);
+        return;
+    }
+    expand_pair(gen, "(", GEN_DOUBLE, left, spaced_operator(op), GEN_DOUBLE, right, ")", depth);
+}
+
+/**
+ * @brief გენერირებს შედარებას. სტატიკურად რიცხვითი ოპერანდები C-ის
+ * ოპერატორით დარდება (ორივე მთელი — int64_t-ში, სხვა შემთხვევაში
+ * double-ში), ორი ლოგიკური მნიშვნელობის ტოლობა — bool-ებით, დანარჩენი —
+ * runtime-ის ms_equals-ით და ms_less-ის ოჯახით.
+ */
+static void expand_comparison(AstNode* node, CodeGenerator* gen, int depth) {
+    AstNode* left = node->as.binary_op.left;
+    AstNode* right = node->as.binary_op.right;
+    TokenType op = node->as.binary_op.operator;
+    bool equality = op == TOKEN_EQUAL_EQUAL || op == TOKEN_BANG_EQUAL;
+    if (is_int(left) && is_int(right)) {
+        expand_pair(gen, "(", GEN_EXPRESSION, left, spaced_operator(op), GEN_EXPRESSION, right, ")", depth);
+    } else if (is_numeric(left) && is_numeric(right)) {
+        expand_pair(gen, "(", GEN_DOUBLE, left, spaced_operator(op), GEN_DOUBLE, right, ")", depth);
+    } else if (equality && left->value_type == TYPE_BOOL && right->value_type == TYPE_BOOL) {
+        expand_pair(gen, "(", GEN_EXPRESSION, left, spaced_operator(op), GEN_EXPRESSION, right, ")", depth);
+    } else if (op == TOKEN_EQUAL_EQUAL) {
+        expand_pair(gen, "ms_equals(", GEN_VALUE, left, ", ", GEN_VALUE, right, ")", depth);
+    } else if (op == TOKEN_BANG_EQUAL) {
+        expand_pair(gen, "(!ms_equals(", GEN_VALUE, left, ", ", GEN_VALUE, right, "))", depth);
+    } else {
+        expand_pair(gen, value_comparison(op), GEN_VALUE, left, ", ", GEN_VALUE, right, ")", depth);
+    }
+}
+
+/** @brief მასივის ცვლადის ნომერი ბირთვში; -1 — არ არის. */
+static int kernel_slot(const ArrayKernel* kernel, const Symbol* name) {
+    for (int i = 0; i < kernel->count; i++) {
+        if (kernel->arrays[i] == name) return i;
+    }
+    return -1;
+}
+
+/** @brief ბირთვის `მ[ი]`: ელემენტი ბუფერიდან (მთელი მასივისას double-ად). */
+static void generate_kernel_element(AstNode* node, CodeGenerator* gen) {
+    int slot = kernel_slot(gen->kernel, node->as.index.array->as.variable.name);
+    emit_format(gen->out, gen->kernel->int_kind ? "((double)ms_t%d[" : "ms_t%d[", gen->kernel->data[slot]);
+    generate_name(node->as.index.index->as.variable.name, gen->out);
+    emit(gen->out, gen->kernel->int_kind ? "])" : "]");
+}
+
 /**
- * @brief გენერირებს კოდს გამოსახულებისთვის.
+ * @brief გენერირებს კოდს გამოსახულებისთვის მისივე ტიპში
+ * (TYPE_INT — int64_t, TYPE_BOOL — bool, TYPE_VALUE — MsValue, დანარჩენი — double).
+ * ოპერანდები სტეკზე ლაგდება და მოგვიანებით გენერირდება.
  */
-static void generate_expression(AstNode* node, FILE* outfile) {
+static void expand_expression(AstNode* node, CodeGenerator* gen, int depth) {
+    CodeBuffer* out = gen->out;
     if (node == NULL) return;
+    if (depth >= CODEGEN_MAX_NESTING &&
+        (node->type == NODE_UNARY_OP || node->type == NODE_BINARY_OP || node->type == NODE_CALL ||
+         node->type == NODE_INDEX || node->type == NODE_BUILTIN || node->type == NODE_ARRAY)) {
+        spill_expression(node, gen);
+        return;
+    }
     switch (node->type) {
         case NODE_NUMBER:
-            fprintf(outfile, "%f", node->as.number.value);
+            if (is_int(node)) generate_integer(node->as.number.value, out);
+            else generate_number(node->as.number.value, out);
+            break;
+        case NODE_BOOLEAN:
+            emit(out, node->as.boolean.value ? "true" : "false");
+            break;
+        case NODE_NONE:
+            emit(out, "MS_NONE");
+            break;
+        case NODE_STRING:
+            generate_string(node, gen);
             break;
         case NODE_VARIABLE:
-            fprintf(outfile, "%.*s", node->as.variable.name.length, node->as.variable.name.start);
+            generate_name(node->as.variable.name, out);
             break;
         case NODE_UNARY_OP:
-            fprintf(outfile, "(%.*s", node->as.unary_op.operator.length, node->as.unary_op.operator.start);
-            generate_expression(node->as.unary_op.right, outfile);
-            fprintf(outfile, ")");
+            if (node->as.unary_op.operator == TOKEN_არ) {
+                emit(out, "(!");
+                push_text(gen, ")");
+                push_node(gen, GEN_CONDITION, node->as.unary_op.right, depth + 1);
+                break;
+            }
+            if (node->value_type == TYPE_VALUE || node->value_type == TYPE_ARRAY) {
+                emit(out, "ms_neg(");
+                push_text(gen, ")");
+                push_node(gen, GEN_VALUE, node->as.unary_op.right, depth + 1);
+                break;
+            }
+            emit(out, "(");
+            emit(out, operator_lexeme(node->as.unary_op.operator));
+            push_text(gen, ")");
+            push_node(gen, is_int(node) ? GEN_EXPRESSION : GEN_DOUBLE, node->as.unary_op.right, depth + 1);
+            break;
+        case NODE_BINARY_OP: {
+            AstNode* left = node->as.binary_op.left;
+            AstNode* right = node->as.binary_op.right;
+            TokenType op = node->as.binary_op.operator;
+            if (op == TOKEN_და || op == TOKEN_ან) {
+                // C-ის && და || მოკლე ჩართვას ინარჩუნებს: მარჯვენა ოპერანდი საჭიროებისას გამოითვლება.
+                expand_pair(gen, "(", GEN_CONDITION, left, op == TOKEN_და ? " && " : " || ", GEN_CONDITION, right, ")",
+                            depth);
+                break;
+            }
+            if (is_comparison(op)) {
+                expand_comparison(node, gen, depth);
+                break;
+            }
+            if (node->value_type == TYPE_STRING) {
+                // ორივე ოპერანდი სტატიკურად სტრიქონია: რიცხვის შემოწმება საჭირო არ არის.
+                expand_pair(gen, "ms_concat(", GEN_EXPRESSION, left, ", ", GEN_EXPRESSION, right, ")", depth);
+                break;
+            }
+            if (node->value_type == TYPE_VALUE || node->value_type == TYPE_ARRAY) {
+                // მასივზე ms_add და სხვ. ელემენტურ ოპერაციას (array.c) ასრულებს.
+                expand_pair(gen, value_operation(node->as.binary_op.operator), GEN_VALUE, left, ", ", GEN_VALUE, right, ")", depth);
+                break;
+            }
+            if (!is_int(node)) {
+                expand_double_binary(node, gen, depth);
+                break;
+            }
+            if (node->wide) {
+                // შუალედი ±2^53-ს სცდება: გადავსებისას შედეგი double-ზე გადადის.
+                expand_pair(gen, op == TOKEN_PLUS ? "ms_add_int(" : "ms_sub_int(", GEN_EXPRESSION, left, ", ",
+                            GEN_EXPRESSION, right, ")", depth);
+                break;
+            }
+            // მთელი შედეგი: ტიპების გამოყვანამ დაამტკიცა, რომ გადავსება შეუძლებელია.
+            expand_pair(gen, "(", GEN_EXPRESSION, left, spaced_operator(node->as.binary_op.operator), GEN_EXPRESSION,
+                        right, ")", depth);
+            break;
+        }
+        case NODE_CALL:
+            expand_call(node, gen, depth);
+            break;
+        case NODE_ARRAY:
+            expand_array(node, gen, depth);
             break;
-        case NODE_BINARY_OP:
-            fprintf(outfile, "(");
-            generate_expression(node->as.binary_op.left, outfile);
-            fprintf(outfile, " %.*s ", node->as.binary_op.operator.length, node->as.binary_op.operator.start);
-            generate_expression(node->as.binary_op.right, outfile);
-            fprintf(outfile, ")");
+        case NODE_INDEX:
+            if (gen->kernel != NULL) {
+                generate_kernel_element(node, gen);
+                break;
+            }
+            expand_pair(gen, "ms_array_get(", GEN_VALUE, node->as.index.array, ", ", GEN_INDEX, node->as.index.index, ")",
+                        depth);
             break;
+        case NODE_BUILTIN: {
+            int function = node->as.builtin.function;
+            ItemList list = { node->as.builtin.arguments, node->as.builtin.count, NULL,
+                              builtin_calls[function].modes, GEN_VALUE, 0, 0, 0 };
+            bool integer = node->value_type == TYPE_INT && builtin_calls[function].int_call != NULL;
+            expand_runtime_call(integer ? builtin_calls[function].int_call : builtin_calls[function].call, &list, gen,
+                                depth);
+            break;
+        }
+        case NODE_INDEX_ASSIGN: {
+            AstNode* operands[3] = { node->as.index_assign.array, node->as.index_assign.index, node->as.index_assign.value };
+            ItemList list = { operands, 3, NULL, index_assign_modes, GEN_VALUE, 0, 0, 0 };
+            expand_runtime_call("ms_array_set(", &list, gen, depth);
+            break;
+        }
         default:
             fprintf(stderr, "CodeGen Error: Node is not a valid expression.\n");
             break;
     }
 }
 
-void generate_code(AstNode* node, FILE* outfile) {
-    fprintf(outfile, "#include <stdio.h>\n\n");
-    fprintf(outfile, "int main() {\n");
+/** @brief გენერირებს გამოსახულებას მოცემულ კონტექსტში; ხე ცხადი სტეკით გაივლება. */
+static void generate_in_mode(AstNode* node, CodeGenerator* gen, GenMode mode) {
+    int base = gen->task_count;
+    push_node(gen, mode, node, 0);
+    while (gen->task_count > base) {
+        GenTask task = gen->tasks[--gen->task_count];
+        switch (task.mode) {
+            case GEN_TEXT: emit(gen->out, task.as.text); break;
+            case GEN_DOUBLE: expand_double(task.as.node, gen, task.depth); break;
+            case GEN_VALUE: expand_value(task.as.node, gen, task.depth); break;
+            case GEN_CONDITION: expand_condition(task.as.node, gen, task.depth); break;
+            case GEN_TEMP: emit_format(gen->out, "ms_t%d", task.as.temp); break;
+            case GEN_COUNT: emit_format(gen->out, "%d", task.as.count); break;
+            case GEN_ELEMENT: expand_element(task.as.node, gen, task.depth); break;
+            case GEN_INDEX: expand_index(task.as.node, gen, task.depth); break;
+            default: expand_expression(task.as.node, gen, task.depth); break;
+        }
+    }
+}
+
+static void generate_expression(AstNode* node, CodeGenerator* gen) {
+    generate_in_mode(node, gen, GEN_EXPRESSION);
+}
+
+static void generate_double(AstNode* node, CodeGenerator* gen) {
+    generate_in_mode(node, gen, GEN_DOUBLE);
+}
+
+static void emit_indent(CodeBuffer* out, int indent) {
+    for (int i = 0; i < indent; i++) emit(out, "    ");
+}
+
+/** @brief გადააქვს `lines`-ის ყოველი ხაზი `out`-ში `indent` დონის შეწევით. */
+static void emit_lines(CodeBuffer* out, const CodeBuffer* lines, int indent) {
+    size_t start = 0;
+    for (size_t i = 0; i < lines->length; i++) {
+        if (lines->data[i] != '\n') continue;
+        emit_indent(out, indent);
+        emit_chars(out, lines->data + start, i + 1 - start);
+        start = i + 1;
+    }
+}
+
+/**
+ * @brief წერს მიმდინარე განცხადების დროებით ცვლადებს `body`-ში უკუღმა
+ * თანმიმდევრობით: ყოველი მათგანი მხოლოდ მოგვიანებით შექმნილ დროებითებს
+ * იყენებს. `და`/`ან`-ის გატანილი ოპერანდი ამიტომ წინასწარ გამოითვლება;
+ * ეს შესამჩნევია მხოლოდ ასზე მეტი დონის სიღრმეზე მდებარე ოპერანდის
+ * გაშვების შეცდომისას.
+ */
+static void emit_spills(CodeGenerator* gen, CodeBuffer* body, int indent) {
+    for (int i = 0; i < gen->spill_count; i++) {
+        // ბუფერი ლოკალურია: დეკლარაციის გენერაციამ spills მასივი შეიძლება გაადიდოს.
+        CodeBuffer code = gen->spills[i].code;
+        gen->out = &code;
+        if (gen->spills[i].node != NULL) generate_expression(gen->spills[i].node, gen);
+        emit(&code, ";\n");
+        gen->spills[i].code = code;
+    }
+    for (int i = gen->spill_count - 1; i >= 0; i--) {
+        emit_lines(body, &gen->spills[i].code, indent);
+        free_code_buffer(&gen->spills[i].code);
+    }
+    gen->spill_count = 0;
+}
+
+/** @brief გენერირებს პირობას `condition`-ში; მისი დროებითი ცვლადები gen->spills-ში რჩება. */
+static void generate_condition(AstNode* node, CodeGenerator* gen, CodeBuffer* condition) {
+    init_code_buffer(condition);
+    gen->out = condition;
+    begin_expression(gen, node);
+    generate_in_mode(node, gen, GEN_CONDITION);
+}
+
+/** @brief ჭეშმარიტია, თუ ქვეხეში ჰიპის მნიშვნელობის მქონე კვანძია. */
+static bool has_heap_node(AstNode* root, CodeGenerator* gen) {
+    AstNode* node;
+    bool found = false;
+    ast_stack_push(&gen->walk, root);
+    while (ast_stack_next_postorder(&gen->walk, &node)) {
+        if (node != NULL && is_heap_type((ValueType)node->value_type)) found = true;
+    }
+    return found;
+}
+
+static void generate_statement(AstNode* node, CodeGenerator* gen, CodeBuffer* body, int indent);
+static void declare_variables(AstNode* root, CodeGenerator* gen, CodeBuffer* body);
+
+/**
+ * @brief გენერირებს `თუ` ჯაჭვს `if`/`else if`/`else`-ად. `სხვა_თუ`-ს
+ * პირობას დროებითი ცვლადები თუ სჭირდება, ისინი `else` ბლოკში იწერება და
+ * ჯაჭვი იქ ჩადგმული `if`-ით გრძელდება.
+ */
+static void generate_if(AstNode* node, CodeGenerator* gen, CodeBuffer* body, int indent) {
+    int level = indent;
+    AstNode* link = node;
+    for (bool first = true; link != NULL && link->type == NODE_IF; first = false) {
+        CodeBuffer condition;
+        generate_condition(link->as.if_stmt.condition, gen, &condition);
+        if (first || gen->spill_count > 0) {
+            if (!first) {
+                emit_indent(body, level);
+                emit(body, "} else {\n");
+                level++;
+            }
+            emit_spills(gen, body, level);
+            emit_indent(body, level);
+            emit(body, "if (");
+        } else {
+            emit_indent(body, level);
+            emit(body, "} else if (");
+        }
+        emit_chars(body, condition.data ? condition.data : "", condition.length);
+        emit(body, ") {\n");
+        free_code_buffer(&condition);
+        generate_statement(link->as.if_stmt.then_branch, gen, body, level + 1);
+        link = link->as.if_stmt.else_branch;
+    }
+    if (link != NULL) {
+        emit_indent(body, level);
+        emit(body, "} else {\n");
+        generate_statement(link, gen, body, level + 1);
+    }
+    for (; level >= indent; level--) {
+        emit_indent(body, level);
+        emit(body, "}\n");
+    }
+}
+
+/**
+ * @brief გენერირებს `სანამ` ციკლს. პირობა, რომელსაც დროებითი ცვლადები
+ * სჭირდება, ყოველ იტერაციაზე ციკლის შიგნით გამოითვლება. თუ ციკლში ჰიპის
+ * მნიშვნელობები ჩნდება, იტერაციის დასაწყისი უსაფრთხო წერტილია, რომ
+ * მხოლოდ პირობაში გამოყოფილი ობიექტებიც შეგროვდეს.
+ */
+static void generate_while(AstNode* node, CodeGenerator* gen, CodeBuffer* body, int indent) {
+    CodeBuffer condition;
+    generate_condition(node->as.while_stmt.condition, gen, &condition);
+    const char* text = condition.data ? condition.data : "";
+    if (gen->spill_count == 0) {
+        emit_indent(body, indent);
+        emit_format(body, "while (%s) {\n", text);
+        if (has_heap_node(node, gen)) {
+            emit_indent(body, indent + 1);
+            emit(body, "ms_gc_safepoint();\n");
+        }
+    } else {
+        emit_indent(body, indent);
+        emit(body, "for (;;) {\n");
+        if (has_heap_node(node, gen)) {
+            emit_indent(body, indent + 1);
+            emit(body, "ms_gc_safepoint();\n");
+        }
+        emit_spills(gen, body, indent + 1);
+        emit_indent(body, indent + 1);
+        emit_format(body, "if (!(%s)) break;\n", text);
+    }
+    free_code_buffer(&condition);
+    generate_statement(node->as.while_stmt.body, gen, body, indent + 1);
+    emit_indent(body, indent);
+    emit(body, "}\n");
+}
+
+/**
+ * @brief ამოწმებს, შეიძლება თუ არა მთელი (ან მასივის) `ყოველი` ციკლის იტერაციების
+ * ერთდროულად (SIMD ზოლებში) შესრულება (იხ. analyze_loop), და `clauses`-ში
+ * წერს `#pragma omp simd`-ის რედუქციისა და კერძო ცვლადების პუნქტებს.
+ */
+static bool vectorizable_loop(AstNode* node, CodeGenerator* gen, CodeBuffer* clauses) {
+    if (!is_array_for(node) && node->value_type != TYPE_INT) return false;
+    LoopAnalysis analysis;
+    bool vectorizable = analyze_loop(node, &gen->walk, false, &analysis);
+    if (vectorizable) {
+        for (int i = 0; i < analysis.count; i++) {
+            if (analysis.variables[i].role == LOOP_VARIABLE_REDUCTION) {
+                emit_format(clauses, " reduction(%s:", analysis.variables[i].operation);
+                generate_name(analysis.variables[i].name, clauses);
+                emit(clauses, ")");
+            }
+        }
+        bool first = true;
+        for (int i = 0; i < analysis.count; i++) {
+            if (analysis.variables[i].role != LOOP_VARIABLE_PRIVATE) continue;
+            emit(clauses, first ? " private(" : ", ");
+            generate_name(analysis.variables[i].name, clauses);
+            first = false;
+        }
+        if (!first) emit(clauses, ")");
+    }
+    free_loop_analysis(&analysis);
+    return vectorizable;
+}
+
+/**
+ * @brief გენერირებს `ყოველი` საზღვარს `lines`-ში ციკლის ცვლადის C ტიპში;
+ * არარიცხვითი საზღვარი გაშვებისას მოწმდება (ms_range_bound).
+ */
+static void generate_range_bound(AstNode* bound, ValueType type, CodeGenerator* gen, CodeBuffer* lines) {
+    gen->out = lines;
+    begin_expression(gen, bound);
+    if (type == TYPE_INT) {
+        generate_expression(bound, gen);
+    } else if (bound->value_type == TYPE_BOOL || is_heap_type((ValueType)bound->value_type)) {
+        emit(lines, "ms_range_bound(");
+        generate_in_mode(bound, gen, GEN_VALUE);
+        emit(lines, ")");
+    } else {
+        generate_double(bound, gen);
+    }
+}
+
+/**
+ * @brief გენერირებს `ყოველი` ციკლის საზღვრებს `start_text`-სა და `end_text`-ში.
+ * საზღვრები ერთხელ, მარცხნიდან მარჯვნივ გამოითვლება: ბოლო (თუ ის
+ * ლიტერალი არ არის) დროებით ცვლადში ინახება, რომ სხეულმა ის ვერ შეცვალოს;
+ * გამოძახების შემცველი საწყისი მასზე ადრე.
+ */
+static void generate_range_bounds(AstNode* node, CodeGenerator* gen, CodeBuffer* body, int indent,
+                                  CodeBuffer* start_text, CodeBuffer* end_text) {
+    AstNode* start = node->as.for_stmt.iterable->as.range.start;
+    AstNode* end = node->as.for_stmt.iterable->as.range.end;
+    ValueType type = node->value_type == TYPE_INT ? TYPE_INT : TYPE_NUMBER;
+    const char* c_type = c_type_name(type);
+    bool hoist_end = end->type != NODE_NUMBER;
+    bool hoist_start = hoist_end && start->type != NODE_NUMBER && start->type != NODE_VARIABLE;
+    init_code_buffer(start_text);
+    init_code_buffer(end_text);
+
+    if (hoist_start) emit_format(start_text, "%s ms_t%d = ", c_type, gen->temp_count);
+    int start_temp = hoist_start ? gen->temp_count++ : -1;
+    generate_range_bound(start, type, gen, start_text);
+    if (hoist_start) {
+        emit(start_text, ";\n");
+        emit_spills(gen, body, indent);
+        emit_lines(body, start_text, indent);
+        free_code_buffer(start_text);
+        init_code_buffer(start_text);
+        emit_format(start_text, "ms_t%d", start_temp);
+    } else {
+        emit_spills(gen, body, indent);
+    }
+
+    if (hoist_end) emit_format(end_text, "%s ms_t%d = ", c_type, gen->temp_count);
+    int end_temp = hoist_end ? gen->temp_count++ : -1;
+    generate_range_bound(end, type, gen, end_text);
+    if (hoist_end) {
+        emit(end_text, ";\n");
+        emit_spills(gen, body, indent);
+        emit_lines(body, end_text, indent);
+        free_code_buffer(end_text);
+        init_code_buffer(end_text);
+        emit_format(end_text, "ms_t%d", end_temp);
+    } else {
+        emit_spills(gen, body, indent);
+    }
+}
+
+/**
+ * @brief წერს მთვლელიან C `for`-ს `start`-იდან `end`-მდე და მის სხეულს.
+ * ციკლის ცვლადი `for`-ის საკუთარი ცვლადია (int64_t ან double).
+ * ვექტორიზებადი სხეულის წინ `#pragma omp simd` იწერება რედუქციისა და
+ * კერძო ცვლადების პუნქტებით.
+ */
+static void emit_for_loop(AstNode* node, const char* start, const char* end, CodeGenerator* gen, CodeBuffer* body,
+                          int indent) {
+    ValueType type = node->value_type == TYPE_INT ? TYPE_INT : TYPE_NUMBER;
+    CodeBuffer clauses;
+    init_code_buffer(&clauses);
+    if (vectorizable_loop(node, gen, &clauses)) {
+        emit_indent(body, indent);
+        emit_format(body, "#pragma omp simd%s\n", clauses.data ? clauses.data : "");
+    }
+    free_code_buffer(&clauses);
+
+    emit_indent(body, indent);
+    emit_format(body, "for (%s ", c_type_name(type));
+    generate_name(node->as.for_stmt.variable, body);
+    emit_format(body, " = %s; ", start);
+    generate_name(node->as.for_stmt.variable, body);
+    emit_format(body, " < %s; ", end);
+    generate_name(node->as.for_stmt.variable, body);
+    emit(body, type == TYPE_INT ? "++) {\n" : " += 1.0) {\n");
+    if (has_heap_node(node->as.for_stmt.body, gen)) {
+        emit_indent(body, indent + 1);
+        emit(body, "ms_gc_safepoint();\n");
+    }
+    generate_statement(node->as.for_stmt.body, gen, body, indent + 1);
+    emit_indent(body, indent);
+    emit(body, "}\n");
+}
+
+/** @brief ჭეშმარიტია, თუ სხეული მასივებს ვერ შეცვლის და შეგროვებას ვერ გამოიწვევს (ჰიპის მნიშვნელობისა და გამოძახების გარეშე). */
+static bool keeps_arrays(AstNode* root, CodeGenerator* gen) {
+    AstNode* node;
+    bool keeps = true;
+    ast_stack_push(&gen->walk, root);
+    while (ast_stack_next_postorder(&gen->walk, &node)) {
+        if (node != NULL && (node->type == NODE_CALL || is_heap_type((ValueType)node->value_type))) keeps = false;
+    }
+    return keeps;
+}
+
+/**
+ * @brief წერს მასივის `ყოველი`-ს ციკლს, რომელიც ელემენტებს `data` ბუფერიდან
+ * (`element` — int64_t ან double) პირდაპირ კითხულობს. ბუფერი restrict
+ * ლოკალურშია: სხეული მას არ წერს. დამოუკიდებელ იტერაციებს `#pragma omp simd`
+ * ეწერება, ხოლო როცა ის არ მოქმედებს (MS_OPENMP_SIMD-ის გარეშე) —
+ * `#pragma GCC ivdep`; GCC ორივეს ერთ ციკლზე არ იღებს.
+ */
+static void emit_array_loop(AstNode* node, const char* element, const char* length, CodeGenerator* gen,
+                            CodeBuffer* body, int indent) {
+    int data = gen->temp_count++;
+    int index = gen->temp_count++;
+    emit_indent(body, indent);
+    emit_format(body, "const %s* restrict ms_t%d = ms_as_array(", element, data);
+    generate_iterable_name(node->as.for_stmt.variable, body);
+    emit(body, ")->data;\n");
+    CodeBuffer clauses;
+    init_code_buffer(&clauses);
+    if (vectorizable_loop(node, gen, &clauses)) {
+        emit(body, "#ifdef MS_OPENMP_SIMD\n");
+        emit_indent(body, indent);
+        emit_format(body, "#pragma omp simd%s\n", clauses.data ? clauses.data : "");
+        emit(body, "#else\n");
+        emit_indent(body, indent);
+        emit(body, "#pragma GCC ivdep\n");
+        emit(body, "#endif\n");
+    }
+    free_code_buffer(&clauses);
+    emit_indent(body, indent);
+    emit_format(body, "for (int64_t ms_t%d = 0; ms_t%d < %s; ms_t%d++) {\n", index, index, length, index);
+    emit_indent(body, indent + 1);
+    emit_format(body, "%s ", c_type_name(node->value_type == TYPE_INT ? TYPE_INT : TYPE_NUMBER));
+    generate_name(node->as.for_stmt.variable, body);
+    emit_format(body, " = ms_t%d[ms_t%d];\n", data, index);
+    generate_statement(node->as.for_stmt.body, gen, body, indent + 1);
+    emit_indent(body, indent);
+    emit(body, "}\n");
+}
+
+/**
+ * @brief გენერირებს `ყოველი ე ში მასივი:` ციკლს. მასივი ერთხელ გამოითვლება
+ * ფესვიან ms_each_ ცვლადში (სხეულის შეგროვებამ ის შეიძლება გადაიტანოს),
+ * სიგრძე კი ციკლამდე იკითხება: სხეულში დამატებული ელემენტები ციკლში აღარ
+ * შედის. თუ სხეული მასივებს ვერ შეცვლის (keeps_arrays), ციკლი ელემენტების
+ * ბუფერს პირდაპირ გადის — თითო შტო მასივის თითო სახისთვის (მთელი ციკლის
+ * ცვლადისას მასივი ყოველთვის მთელია); სხვა შემთხვევაში ელემენტი ყოველ
+ * იტერაციაზე ms_array_get-ით იკითხება.
+ */
+static void generate_array_for(AstNode* node, CodeGenerator* gen, CodeBuffer* body, int indent) {
+    Symbol* variable = node->as.for_stmt.variable;
+    AstNode* iterable = node->as.for_stmt.iterable;
+    CodeBuffer lines;
+    init_code_buffer(&lines);
+    gen->out = &lines;
+    begin_expression(gen, iterable);
+    generate_iterable_name(variable, &lines);
+    emit(&lines, " = ms_array_iterable(");
+    generate_in_mode(iterable, gen, GEN_VALUE);
+    emit(&lines, ");\n");
+    emit_spills(gen, body, indent);
+    emit_lines(body, &lines, indent);
+    free_code_buffer(&lines);
+
+    char length[32];
+    snprintf(length, sizeof(length), "ms_t%d", gen->temp_count++);
+    emit_indent(body, indent);
+    emit_format(body, "int64_t %s = ms_length(", length);
+    generate_iterable_name(variable, body);
+    emit(body, ");\n");
+
+    if (keeps_arrays(node->as.for_stmt.body, gen)) {
+        if (node->value_type == TYPE_INT) {
+            emit_array_loop(node, "int64_t", length, gen, body, indent);
+            return;
+        }
+        emit_indent(body, indent);
+        emit(body, "if (ms_as_array(");
+        generate_iterable_name(variable, body);
+        emit(body, ")->kind == MS_ARRAY_INT) {\n");
+        emit_array_loop(node, "int64_t", length, gen, body, indent + 1);
+        emit_indent(body, indent);
+        emit(body, "} else {\n");
+        emit_array_loop(node, "double", length, gen, body, indent + 1);
+        emit_indent(body, indent);
+        emit(body, "}\n");
+        return;
+    }
+
+    int index = gen->temp_count++;
+    emit_indent(body, indent);
+    emit_format(body, "for (int64_t ms_t%d = 0; ms_t%d < %s; ms_t%d++) {\n", index, index, length, index);
+    if (has_heap_node(node->as.for_stmt.body, gen)) {
+        emit_indent(body, indent + 1);
+        emit(body, "ms_gc_safepoint();\n");
+    }
+    emit_indent(body, indent + 1);
+    if (node->value_type == TYPE_INT) {
+        emit(body, "int64_t ");
+        generate_name(variable, body);
+        emit(body, " = (int64_t)ms_array_get(");
+    } else {
+        emit(body, "double ");
+        generate_name(variable, body);
+        emit(body, " = ms_array_get(");
+    }
+    generate_iterable_name(variable, body);
+    emit_format(body, ", ms_t%d);\n", index);
+    generate_statement(node->as.for_stmt.body, gen, body, indent + 1);
+    emit_indent(body, indent);
+    emit(body, "}\n");
+}
+
+/**
+ * @brief ამატებს ბირთვს `მ[ი]`-ის მასივს; ჭეშმარიტია, თუ მასივი ცვლადია და
+ * ინდექსი ციკლის ცვლადია.
+ */
+static bool add_kernel_access(ArrayKernel* kernel, AstNode* array, AstNode* index, Symbol* variable, bool store) {
+    if (array->type != NODE_VARIABLE || (array->value_type != TYPE_ARRAY && array->value_type != TYPE_VALUE)) return false;
+    if (index->type != NODE_VARIABLE || index->as.variable.name != variable) return false;
+    int slot = kernel_slot(kernel, array->as.variable.name);
+    if (slot < 0) {
+        if (kernel->count == CODEGEN_KERNEL_MAX_ARRAYS) return false;
+        slot = kernel->count++;
+        kernel->arrays[slot] = array->as.variable.name;
+        kernel->stored[slot] = false;
+    }
+    kernel->stored[slot] = kernel->stored[slot] || store;
+    return true;
+}
+
+/**
+ * @brief ჭეშმარიტია მთელი `ყოველი ი ში ა..ბ` ციკლისთვის, რომლის სხეული
+ * მხოლოდ `მ[ი] = გამოსახულება` ჩანაწერებია: გამოსახულებები რიცხვითია
+ * (გამოძახებების და გამოყოფის გარეშე), ხოლო ყველა მასივი ცვლადია და
+ * მხოლოდ ციკლის ცვლადით ინდექსირდება. ასეთი სხეული ობიექტებს არ ქმნის და
+ * არც მასივის ცვლადებს ცვლის, ამიტომ ბუფერები ციკლამდე ერთხელ იკითხება.
+ */
+static bool find_array_kernel(AstNode* node, CodeGenerator* gen, ArrayKernel* kernel) {
+    AstNode* body = node->as.for_stmt.body;
+    Symbol* variable = node->as.for_stmt.variable;
+    kernel->count = 0;
+    kernel->guarded = false;
+    kernel->int_kind = false;
+    if (node->type != NODE_FOR || node->value_type != TYPE_INT || body == NULL || body->type != NODE_BLOCK ||
+        body->as.block.count == 0) {
+        return false;
+    }
+    bool eligible = true;
+    for (int i = 0; i < body->as.block.count && eligible; i++) {
+        AstNode* statement = body->as.block.statements[i];
+        if (statement->type != NODE_INDEX_ASSIGN) return false;
+        AstNode* value = statement->as.index_assign.value;
+        if (!is_numeric(value) || !add_kernel_access(kernel, statement->as.index_assign.array,
+                                                     statement->as.index_assign.index, variable, true)) {
+            return false;
+        }
+        // ±2^53-ს მიღმა ან ათწილადი მნიშვნელობა მთელ მასივს ათწილადად აქცევს (ms_array_set_slow).
+        if (value->value_type != TYPE_INT || value->wide) kernel->guarded = true;
+        AstNode* current;
+        ast_stack_push(&gen->walk, value);
+        while (ast_stack_next_postorder(&gen->walk, &current)) {
+            if (!eligible || current == NULL) continue;
+            switch (current->type) {
+                case NODE_NUMBER:
+                case NODE_UNARY_OP:
+                case NODE_BINARY_OP:
+                    eligible = is_numeric(current);
+                    break;
+                case NODE_VARIABLE:
+                    // მასივის ცვლადი მხოლოდ `მ[ი]`-შია: სხვაგან მშობლის ტიპი არარიცხვითი იქნებოდა.
+                    eligible = is_numeric(current) || current->value_type == TYPE_ARRAY ||
+                               current->value_type == TYPE_VALUE;
+                    break;
+                case NODE_INDEX:
+                    eligible = add_kernel_access(kernel, current->as.index.array, current->as.index.index, variable, false);
+                    break;
+                default:
+                    eligible = false;
+                    break;
+            }
+        }
+    }
+    return eligible;
+}
+
+/** @brief წერს ბირთვის `მ[ი] = x` ჩანაწერს; მთელ მასივში ათწილადი x ms_fits_int-ით მოწმდება. */
+static void emit_kernel_store(AstNode* statement, CodeGenerator* gen, CodeBuffer* body, int indent) {
+    ArrayKernel* kernel = gen->kernel;
+    AstNode* value = statement->as.index_assign.value;
+    int data = kernel->data[kernel_slot(kernel, statement->as.index_assign.array->as.variable.name)];
+    Symbol* index = statement->as.index_assign.index->as.variable.name;
+    CodeBuffer lines;
+    init_code_buffer(&lines);
+    gen->out = &lines;
+    begin_expression(gen, value);
+    if (kernel->int_kind && kernel->guarded) {
+        int temp = gen->temp_count++;
+        emit_format(&lines, "double ms_t%d = ", temp);
+        generate_double(value, gen);
+        emit_format(&lines, ";\nif (!ms_fits_int(ms_t%d)) break;\nms_t%d[", temp, data);
+        generate_name(index, &lines);
+        emit_format(&lines, "] = (int64_t)ms_t%d;\n", temp);
+    } else {
+        emit_format(&lines, "ms_t%d[", data);
+        generate_name(index, &lines);
+        emit(&lines, "] = ");
+        if (kernel->int_kind) generate_expression(value, gen);
+        else generate_double(value, gen);
+        emit(&lines, ";\n");
+    }
+    emit_spills(gen, body, indent);
+    emit_lines(body, &lines, indent);
+    free_code_buffer(&lines);
+}
+
+/**
+ * @brief წერს ბირთვის ერთ ვარიანტს (ყველა მასივი `int_kind`-ის მიხედვით
+ * MS_ARRAY_INT ან MS_ARRAY_DOUBLE): პირობა ამოწმებს მასივების სახეს,
+ * საზღვრებს და იმას, რომ ჩასაწერი მასივი სხვა ცვლადის მასივს არ ემთხვევა;
+ * ბუფერები restrict ლოკალურებშია, ციკლს კი `#pragma omp simd` ან
+ * `#pragma GCC ivdep` ეწერება (იტერაცია მხოლოდ საკუთარ ელემენტებს ეხება).
+ * შემოწმებული ჩანაწერის ვარიანტი (guarded) ms_fits_int-ის დარღვევისას
+ * წყდება და `resume` შეწყვეტის ინდექსზე რჩება.
+ */
+static void emit_kernel_variant(AstNode* node, bool int_kind, bool first, const char* resume, const char* end,
+                                CodeGenerator* gen, CodeBuffer* body, int indent) {
+    ArrayKernel* kernel = gen->kernel;
+    const char* element = int_kind ? "int64_t" : "double";
+    kernel->int_kind = int_kind;
+    bool guarded = int_kind && kernel->guarded;
+    emit_indent(body, indent);
+    emit(body, first ? "if (" : "} else if (");
+    for (int i = 0; i < kernel->count; i++) {
+        emit(body, i > 0 ? " && ms_array_spans(" : "ms_array_spans(");
+        generate_name(kernel->arrays[i], body);
+        emit_format(body, ", %s, %s, %s)", int_kind ? "MS_ARRAY_INT" : "MS_ARRAY_DOUBLE", resume, end);
+    }
+    for (int i = 0; i < kernel->count; i++) {
+        for (int j = i + 1; j < kernel->count; j++) {
+            if (!kernel->stored[i] && !kernel->stored[j]) continue;
+            emit(body, " && ms_as_array(");
+            generate_name(kernel->arrays[i], body);
+            emit(body, ") != ms_as_array(");
+            generate_name(kernel->arrays[j], body);
+            emit(body, ")");
+        }
+    }
+    emit(body, ") {\n");
+    for (int i = 0; i < kernel->count; i++) {
+        kernel->data[i] = gen->temp_count++;
+        emit_indent(body, indent + 1);
+        emit_format(body, "%s%s* restrict ms_t%d = ms_as_array(", kernel->stored[i] ? "" : "const ", element,
+                    kernel->data[i]);
+        generate_name(kernel->arrays[i], body);
+        emit(body, ")->data;\n");
+    }
+    Symbol* variable = node->as.for_stmt.variable;
+    if (guarded) {
+        emit_indent(body, indent + 1);
+        emit_format(body, "for (; %s < %s; %s++) {\n", resume, end, resume);
+        emit_indent(body, indent + 2);
+        emit(body, "int64_t ");
+        generate_name(variable, body);
+        emit_format(body, " = %s;\n", resume);
+    } else {
+        emit(body, "#ifdef MS_OPENMP_SIMD\n");
+        emit_indent(body, indent + 1);
+        emit(body, "#pragma omp simd\n");
+        emit(body, "#else\n");
+        emit_indent(body, indent + 1);
+        emit(body, "#pragma GCC ivdep\n");
+        emit(body, "#endif\n");
+        emit_indent(body, indent + 1);
+        emit(body, "for (int64_t ");
+        generate_name(variable, body);
+        emit_format(body, " = %s; ", resume);
+        generate_name(variable, body);
+        emit_format(body, " < %s; ", end);
+        generate_name(variable, body);
+        emit(body, "++) {\n");
+    }
+    AstNode* block = node->as.for_stmt.body;
+    for (int i = 0; i < block->as.block.count; i++) emit_kernel_store(block->as.block.statements[i], gen, body, indent + 2);
+    emit_indent(body, indent + 1);
+    emit(body, "}\n");
+    if (!guarded) {
+        emit_indent(body, indent + 1);
+        emit_format(body, "%s = %s;\n", resume, end);
+    }
+}
+
+/**
+ * @brief წერს ინდექსების ციკლს ბირთვით (find_array_kernel): ციკლამდე ერთი
+ * უსაფრთხო წერტილი, შემდეგ ათწილადი და მთელი მასივების ვარიანტები. მთელი
+ * ვარიანტი შემოწმებული ჩანაწერით მხოლოდ ერთჩანაწერიან სხეულს ეწერება, რომ
+ * შეწყვეტილი იტერაცია ხელახლა უსაფრთხოდ შესრულდეს. დარჩენილ იტერაციებს
+ * (სხვა სახის ან საზღვრებს გარეთ მასივი, ალიასი, შეწყვეტა) ჩვეულებრივი
+ * ციკლი `resume`-დან ასრულებს, რომელიც შეცდომებსაც იმავე იტერაციაზე აჩენს.
+ */
+static void emit_index_kernel(AstNode* node, ArrayKernel* kernel, const char* start, const char* end,
+                              CodeGenerator* gen, CodeBuffer* body, int indent) {
+    char resume[32];
+    snprintf(resume, sizeof(resume), "ms_t%d", gen->temp_count++);
+    emit_indent(body, indent);
+    emit_format(body, "int64_t %s = %s;\n", resume, start);
+    emit_indent(body, indent);
+    emit(body, "ms_gc_safepoint();\n");
+    gen->kernel = kernel;
+    emit_kernel_variant(node, false, true, resume, end, gen, body, indent);
+    if (!kernel->guarded || node->as.for_stmt.body->as.block.count == 1) {
+        emit_kernel_variant(node, true, false, resume, end, gen, body, indent);
+    }
+    gen->kernel = NULL;
+    emit_indent(body, indent);
+    emit(body, "}\n");
+    emit_for_loop(node, resume, end, gen, body, indent);
+}
+
+/**
+ * @brief გენერირებს `ყოველი ი ში ა..ბ` ციკლს მთვლელიან C `for`-ად; მასივების
+ * ინდექსების ციკლი ბირთვით (emit_index_kernel).
+ */
+static void generate_for(AstNode* node, CodeGenerator* gen, CodeBuffer* body, int indent) {
+    if (is_array_for(node)) {
+        generate_array_for(node, gen, body, indent);
+        return;
+    }
+    CodeBuffer start_text, end_text;
+    generate_range_bounds(node, gen, body, indent, &start_text, &end_text);
+    ArrayKernel kernel;
+    if (find_array_kernel(node, gen, &kernel)) {
+        emit_index_kernel(node, &kernel, start_text.data, end_text.data, gen, body, indent);
+    } else {
+        emit_for_loop(node, start_text.data, end_text.data, gen, body, indent);
+    }
+    free_code_buffer(&start_text);
+    free_code_buffer(&end_text);
+}
+
+static const char* reduction_name(const char* operation) {
+    if (strcmp(operation, "min") == 0) return "MS_REDUCE_MIN";
+    if (strcmp(operation, "max") == 0) return "MS_REDUCE_MAX";
+    return "MS_REDUCE_SUM";
+}
+
+/** @brief ჭეშმარიტია გარე ცვლადისთვის, რომელსაც სხეული მხოლოდ კითხულობს (ციკლის ცვლადის გარდა). */
+static bool is_capture(const LoopVariable* variable, const AstNode* node) {
+    return variable->role == LOOP_VARIABLE_NONE && variable->reads > 0 && variable->name != node->as.for_stmt.variable;
+}
+
+/**
+ * @brief გენერირებს `პარალელური ყოველი`-ს. სხეული `ms_parallel_N` ფუნქციად
+ * გამოიტანება, რომელიც [ms_start, ms_end) ნაჭერს ასრულებს: წაკითხული გარე
+ * ცვლადები `ms_parallel_N_context` სტრუქტურით გადაეცემა და ლოკალურებში
+ * იტვირთება, რედუქციები ნაკადის შუალედურებს (ms_partials) აგრძელებს,
+ * სხეულის ცვლადები კი ფუნქციის ლოკალურებია. ციკლის ადგილზე
+ * ms_parallel_for-ის გამოძახება რჩება, რომელიც რედუქციების შედეგს
+ * ცვლადებში აბრუნებს. გამოტანილი სხეულის შიგნით ჩადგმული პარალელური
+ * ციკლი ჩვეულებრივ `for`-ად გენერირდება.
+ */
+static void generate_parallel_for(AstNode* node, CodeGenerator* gen, CodeBuffer* body, int indent) {
+    LoopAnalysis analysis;
+    bool parallel = !gen->in_parallel && !is_array_for(node) && node->value_type == TYPE_INT;
+    if (parallel && !analyze_loop(node, &gen->walk, true, &analysis)) {
+        free_loop_analysis(&analysis);
+        parallel = false;
+    }
+    if (!parallel) {
+        generate_for(node, gen, body, indent);
+        return;
+    }
+    int id = gen->parallel_count++;
+    int captures = 0;
+    int reductions = 0;
+    for (int i = 0; i < analysis.count; i++) {
+        if (is_capture(&analysis.variables[i], node)) captures++;
+        if (analysis.variables[i].role == LOOP_VARIABLE_REDUCTION) reductions++;
+    }
+
+    CodeBuffer* out = &gen->parallel;
+    if (captures > 0) {
+        emit(out, "typedef struct {\n");
+        for (int i = 0; i < analysis.count; i++) {
+            if (!is_capture(&analysis.variables[i], node)) continue;
+            emit_format(out, "    %s ", c_type_name(analysis.variables[i].type));
+            generate_name(analysis.variables[i].name, out);
+            emit(out, ";\n");
+        }
+        emit_format(out, "} ms_parallel_%d_context;\n\n", id);
+    }
+    emit_format(out, "static void ms_parallel_%d(int64_t ms_start, int64_t ms_end, const void* ms_context, "
+                     "int64_t* ms_partials) {\n", id);
+    if (captures > 0) emit_format(out, "    const ms_parallel_%d_context* ms_c = ms_context;\n", id);
+    else emit(out, "    (void)ms_context;\n");
+    if (reductions == 0) emit(out, "    (void)ms_partials;\n");
+    for (int i = 0, k = 0; i < analysis.count; i++) {
+        LoopVariable* variable = &analysis.variables[i];
+        if (is_capture(variable, node)) {
+            emit_format(out, "    %s ", c_type_name(variable->type));
+            generate_name(variable->name, out);
+            emit(out, " = ms_c->");
+            generate_name(variable->name, out);
+            emit(out, ";\n");
+        } else if (variable->role == LOOP_VARIABLE_REDUCTION) {
+            emit(out, "    int64_t ");
+            generate_name(variable->name, out);
+            emit_format(out, " = ms_partials[%d];\n", k++);
+        }
+    }
+    declare_variables(node->as.for_stmt.body, gen, out);
+    gen->in_parallel = true;
+    emit_for_loop(node, "ms_start", "ms_end", gen, out, 1);
+    gen->in_parallel = false;
+    for (int i = 0, k = 0; i < analysis.count; i++) {
+        if (analysis.variables[i].role != LOOP_VARIABLE_REDUCTION) continue;
+        emit_format(out, "    ms_partials[%d] = ", k++);
+        generate_name(analysis.variables[i].name, out);
+        emit(out, ";\n");
+    }
+    emit(out, "}\n\n");
+
+    CodeBuffer start_text, end_text;
+    generate_range_bounds(node, gen, body, indent, &start_text, &end_text);
+    emit_indent(body, indent);
+    emit(body, "{\n");
+    if (captures > 0) {
+        emit_indent(body, indent + 1);
+        emit_format(body, "ms_parallel_%d_context ms_c%d = { ", id, id);
+        bool first = true;
+        for (int i = 0; i < analysis.count; i++) {
+            if (!is_capture(&analysis.variables[i], node)) continue;
+            if (!first) emit(body, ", ");
+            generate_name(analysis.variables[i].name, body);
+            first = false;
+        }
+        emit(body, " };\n");
+    }
+    if (reductions > 0) {
+        CodeBuffer values, operations;
+        init_code_buffer(&values);
+        init_code_buffer(&operations);
+        for (int i = 0; i < analysis.count; i++) {
+            if (analysis.variables[i].role != LOOP_VARIABLE_REDUCTION) continue;
+            bool first = values.length == 0;
+            emit(&values, first ? "" : ", ");
+            generate_name(analysis.variables[i].name, &values);
+            emit_format(&operations, "%s%s", first ? "" : ", ", reduction_name(analysis.variables[i].operation));
+        }
+        emit_indent(body, indent + 1);
+        emit_format(body, "int64_t ms_r%d[] = { %s };\n", id, values.data);
+        emit_indent(body, indent + 1);
+        emit_format(body, "static const uint8_t ms_o%d[] = { %s };\n", id, operations.data);
+        free_code_buffer(&values);
+        free_code_buffer(&operations);
+    }
+    emit_indent(body, indent + 1);
+    emit_format(body, "ms_parallel_for(%s, %s, ms_parallel_%d, ", start_text.data, end_text.data, id);
+    if (captures > 0) emit_format(body, "&ms_c%d, ", id);
+    else emit(body, "NULL, ");
+    if (reductions > 0) emit_format(body, "ms_r%d, ms_o%d, %d);\n", id, id, reductions);
+    else emit(body, "NULL, NULL, 0);\n");
+    for (int i = 0, k = 0; i < analysis.count; i++) {
+        if (analysis.variables[i].role != LOOP_VARIABLE_REDUCTION) continue;
+        emit_indent(body, indent + 1);
+        generate_name(analysis.variables[i].name, body);
+        emit_format(body, " = ms_r%d[%d];\n", id, k++);
+    }
+    emit_indent(body, indent);
+    emit(body, "}\n");
+    free_code_buffer(&start_text);
+    free_code_buffer(&end_text);
+    free_loop_analysis(&analysis);
+}
+
+/** @brief C ტიპის ნულოვანი მნიშვნელობა (ცვლადების ინიციალიზაცია, `არარა` დაბრუნება). */
+static const char* zero_value(ValueType type) {
+    switch (type) {
+        case TYPE_INT: return "0";
+        case TYPE_BOOL: return "false";
+        case TYPE_STRING:
+        case TYPE_VALUE:
+        case TYPE_ARRAY: return "MS_NONE";
+        default: return "0.0";
+    }
+}
+
+/**
+ * @brief გენერირებს `დაბრუნე`-ს. ფესვების მქონე ფუნქციაში შედეგი ჯერ
+ * გამოითვლება (გამოძახებამ შეიძლება შეგროვება გამოიწვიოს), შემდეგ
+ * ფუნქციის ფესვები იხსნება.
+ */
+static void emit_return(AstNode* value, CodeGenerator* gen, CodeBuffer* body, int indent) {
+    ValueType type = (ValueType)gen->function->value_type;
+    CodeBuffer lines;
+    init_code_buffer(&lines);
+    gen->out = &lines;
+    if (gen->function_roots) emit_format(&lines, "{\n    %s ms_result = ", c_type_name(type));
+    else emit(&lines, "return ");
+    if (value != NULL) {
+        begin_expression(gen, value);
+        generate_in_mode(value, gen, variable_mode(type));
+    } else {
+        emit(&lines, zero_value(type));
+    }
+    if (gen->function_roots) emit(&lines, ";\n    ms_gc_release_roots(ms_roots);\n    return ms_result;\n}\n");
+    else emit(&lines, ";\n");
+    emit_spills(gen, body, indent);
+    emit_lines(body, &lines, indent);
+    free_code_buffer(&lines);
+}
+
+/**
+ * @brief `დაბრუნე ფ(...)` მიმდინარე ფუნქციაში — კუდის გამოძახება ციკლად:
+ * არგუმენტები მარცხნიდან მარჯვნივ გამოითვლება, პარამეტრებს ენიჭება და
+ * შესრულება ფუნქციის თავზე (`ms_tail`) ბრუნდება. C სტეკი არ იზრდება,
+ * ფესვები კი უკვე რეგისტრირებულია.
+ */
+static void generate_tail_call(AstNode* call, CodeGenerator* gen, CodeBuffer* body, int indent) {
+    AstNode** parameters = gen->function->as.function.parameters->as.block.statements;
+    AstNode** arguments = call->as.call.arguments;
+    int count = call->as.call.count;
+    int* temps = malloc(sizeof(int) * ((size_t)count + 1));
+    if (!temps) {
+        fprintf(stderr, "FATAL: Memory allocation failed for code generator.\n");
+        exit(1);
+    }
+    CodeBuffer lines;
+    for (int i = 0; i < count; i++) {
+        Symbol* parameter = parameters[i]->as.variable.name;
+        temps[i] = -1;
+        // უცვლელი პარამეტრი (`ფ(ა, ბ - 1)`-ის ა) არ გადაიწერება.
+        if (arguments[i] != NULL && arguments[i]->type == NODE_VARIABLE && arguments[i]->as.variable.name == parameter) {
+            continue;
+        }
+        // ერთი პარამეტრი პირდაპირ ენიჭება; რამდენიმე — დროებითების გავლით, რადგან
+        // შემდეგი არგუმენტი შეიძლება ძველ მნიშვნელობას კითხულობდეს.
+        ValueType type = (ValueType)parameters[i]->value_type;
+        init_code_buffer(&lines);
+        gen->out = &lines;
+        begin_expression(gen, call);
+        if (count == 1) {
+            generate_name(parameter, &lines);
+            emit(&lines, " = ");
+        } else {
+            temps[i] = gen->temp_count++;
+            emit_format(&lines, "%s ms_t%d = ", c_type_name(type), temps[i]);
+        }
+        generate_in_mode(arguments[i], gen, variable_mode(type));
+        emit(&lines, ";\n");
+        emit_spills(gen, body, indent);
+        emit_lines(body, &lines, indent);
+        free_code_buffer(&lines);
+    }
+    for (int i = 0; i < count; i++) {
+        if (temps[i] < 0) continue;
+        emit_indent(body, indent);
+        generate_name(parameters[i]->as.variable.name, body);
+        emit_format(body, " = ms_t%d;\n", temps[i]);
+    }
+    free(temps);
+    if (gen->function_heap) {
+        emit_indent(body, indent);
+        emit(body, "ms_gc_safepoint();\n");
+    }
+    emit_indent(body, indent);
+    emit(body, "goto ms_tail;\n");
+}
+
+/** @brief ჭეშმარიტია, თუ `დაბრუნე` მიმდინარე ფუნქციის კუდის გამოძახებაა. */
+static bool is_tail_call(AstNode* node, const AstNode* function) {
+    AstNode* value = node->as.return_stmt.value;
+    return value != NULL && value->type == NODE_CALL && value->as.call.callee == function->as.function.name;
+}
+
+/** @brief გენერირებს განცხადებას `body`-ში `indent` დონის შეწევით. */
+static void generate_statement(AstNode* node, CodeGenerator* gen, CodeBuffer* body, int indent) {
+    if (node == NULL) return;
+    switch (node->type) {
+        case NODE_FUNCTION:
+            // ფუნქციები main-ის გარეთ, generate_function-ით გენერირდება.
+            break;
+        case NODE_RETURN:
+            if (is_tail_call(node, gen->function)) generate_tail_call(node->as.return_stmt.value, gen, body, indent);
+            else emit_return(node->as.return_stmt.value, gen, body, indent);
+            break;
+        case NODE_BLOCK:
+            for (int i = 0; i < node->as.block.count; i++) {
+                generate_statement(node->as.block.statements[i], gen, body, indent);
+            }
+            break;
+        case NODE_IF:
+            generate_if(node, gen, body, indent);
+            break;
+        case NODE_WHILE:
+            generate_while(node, gen, body, indent);
+            break;
+        case NODE_FOR:
+            generate_for(node, gen, body, indent);
+            break;
+        case NODE_PARALLEL_FOR:
+            generate_parallel_for(node, gen, body, indent);
+            break;
+        default: {
+            CodeBuffer lines;
+            init_code_buffer(&lines);
+            gen->out = &lines;
+            generate_simple_statement(node, gen);
+            emit_spills(gen, body, indent);
+            emit_lines(body, &lines, indent);
+            free_code_buffer(&lines);
+            break;
+        }
+    }
+}
+
+/**
+ * @brief აცხადებს ქვეხის ყველა ცვლადს ფუნქციის (ან main-ის) თავში, ნულოვანი
+ * მნიშვნელობით. ცვლადის C ტიპი მისი ყველა მინიჭების გაერთიანებული ტიპია
+ * (დეკლარაციის value_type), ამიტომ ბლოკში თუ ციკლში მინიჭებაც იმავე
+ * C ცვლადს ეხება; ჰიპის ცვლადი GC-ს ფესვად ერთხელ რეგისტრირდება.
+ * მასივის `ყოველი` ციკლის მასივიც ფესვიან ცვლადში ინახება (იხ. generate_array_for).
+ * ჩადგმული ფუნქციების ცვლადები მათ საკუთარ ფუნქციაში ცხადდება.
+ */
+static void declare_variables(AstNode* root, CodeGenerator* gen, CodeBuffer* body) {
+    uint8_t* declared = NULL;  // DECLARED_VARIABLE | DECLARED_ITERABLE სიმბოლოს მიხედვით
+    int capacity = 0;
+    // პრე-ორდერი შვილების უკუღმა ჩადებით: დეკლარაციები კოდის თანმიმდევრობით ჩნდება.
+    ast_stack_push(&gen->walk, root);
+    while (gen->walk.count > 0) {
+        AstNode* node = gen->walk.frames[--gen->walk.count].node;
+        if (node == NULL || node->type == NODE_FUNCTION) continue;
+        for (int i = ast_child_count(node) - 1; i >= 0; i--) ast_stack_push(&gen->walk, ast_child(node, i));
+        Symbol* name;
+        uint8_t flag;
+        if (node->type == NODE_VAR_DECL) {
+            name = node->as.var_decl.name;
+            flag = DECLARED_VARIABLE;
+        } else if (is_array_for(node)) {
+            name = node->as.for_stmt.variable;
+            flag = DECLARED_ITERABLE;
+        } else {
+            continue;
+        }
+        if (name->id >= capacity) {
+            int grown = capacity < 64 ? 64 : capacity;
+            while (grown <= name->id) grown *= 2;
+            uint8_t* resized = realloc(declared, sizeof(uint8_t) * (size_t)grown);
+            if (!resized) {
+                fprintf(stderr, "FATAL: Memory allocation failed for code generator.\n");
+                exit(1);
+            }
+            memset(resized + capacity, 0, sizeof(uint8_t) * (size_t)(grown - capacity));
+            declared = resized;
+            capacity = grown;
+        }
+        if (declared[name->id] & flag) continue;
+        declared[name->id] |= flag;
+
+        if (flag == DECLARED_ITERABLE) {
+            // ჩადგმული ციკლი იმავე სახელის ცვლადს ვერ გამოაცხადებს, ამიტომ ცვლადი ციკლის სახელით კმარა.
+            emit(body, "    MsValue ");
+            generate_iterable_name(name, body);
+            emit(body, " = MS_NONE;\n    ms_gc_add_root(&");
+            generate_iterable_name(name, body);
+            emit(body, ");\n");
+            continue;
+        }
+        ValueType type = (ValueType)node->value_type;
+        emit_format(body, "    %s ", c_type_name(type));
+        generate_name(name, body);
+        emit_format(body, " = %s;\n", zero_value(type));
+        if (is_heap_type(type)) {
+            // შემგროვებელი ცვლადს ფესვად ხედავს და ობიექტის გადატანისას ანახლებს.
+            emit(body, "    ms_gc_add_root(&");
+            generate_name(name, body);
+            emit(body, ");\n");
+        }
+    }
+    free(declared);
+}
+
+/** @brief ჭეშმარიტია, თუ განცხადების შემდეგ შესრულება აღარ გრძელდება (ყველა გზა `დაბრუნე`-თი სრულდება). */
+static bool always_returns(AstNode* node) {
+    if (node == NULL) return false;
+    switch (node->type) {
+        case NODE_RETURN: return true;
+        case NODE_BLOCK:
+            for (int i = 0; i < node->as.block.count; i++) {
+                if (always_returns(node->as.block.statements[i])) return true;
+            }
+            return false;
+        case NODE_IF:
+            for (; node != NULL && node->type == NODE_IF; node = node->as.if_stmt.else_branch) {
+                if (!always_returns(node->as.if_stmt.then_branch)) return false;
+            }
+            return always_returns(node);
+        default: return false;
+    }
+}
+
+/**
+ * @brief ჭეშმარიტია პატარა ფოთოლი ფუნქციისთვის (გამოძახებების გარეშე),
+ * რომელიც MS_INLINE-ით გამოძახების ადგილზე ჩაშენდება.
+ */
+static bool is_inline_function(AstNode* node, CodeGenerator* gen) {
+    int count = 0;
+    bool calls = false;
+    AstNode* current;
+    ast_stack_push(&gen->walk, node->as.function.body);
+    while (ast_stack_next_postorder(&gen->walk, &current)) {
+        if (current == NULL) continue;
+        count++;
+        if (current->type == NODE_CALL) calls = true;
+    }
+    return !calls && count <= CODEGEN_INLINE_MAX_NODES;
+}
+
+/** @brief წერს ფუნქციის სათაურს: `static T f_სახელი(T1 v_პ1, ...)`. */
+static void emit_function_signature(AstNode* node, CodeGenerator* gen, CodeBuffer* out) {
+    AstNode* parameters = node->as.function.parameters;
+    emit_format(out, "%s %s f_", is_inline_function(node, gen) ? "MS_INLINE" : "static",
+                c_type_name((ValueType)node->value_type));
+    emit_chars(out, node->as.function.name->chars, (size_t)node->as.function.name->length);
+    emit(out, "(");
+    for (int i = 0; i < parameters->as.block.count; i++) {
+        AstNode* parameter = parameters->as.block.statements[i];
+        emit_format(out, "%s%s ", i > 0 ? ", " : "", c_type_name((ValueType)parameter->value_type));
+        generate_name(parameter->as.variable.name, out);
+    }
+    emit(out, parameters->as.block.count == 0 ? "void)" : ")");
+}
+
+/**
+ * @brief გენერირებს ფუნქციას static C ფუნქციად. ჰიპის პარამეტრები და
+ * ლოკალურები ფესვებად რეგისტრირდება და ყოველ დაბრუნებაზე იხსნება;
+ * კუდის გამოძახებები `ms_tail` ჭდეზე გადადის.
+ */
+static void generate_function(AstNode* node, CodeGenerator* gen, CodeBuffer* out) {
+    AstNode* parameters = node->as.function.parameters;
+    AstNode* body = node->as.function.body;
+    bool tail = false;
+    bool roots = false;
+    AstNode* current;
+    ast_stack_push(&gen->walk, body);
+    while (ast_stack_next_postorder(&gen->walk, &current)) {
+        if (current == NULL) continue;
+        if (current->type == NODE_RETURN && is_tail_call(current, node)) tail = true;
+        if (current->type == NODE_VAR_DECL && is_heap_type((ValueType)current->value_type)) roots = true;
+        if (is_array_for(current)) roots = true;
+    }
+    for (int i = 0; i < parameters->as.block.count; i++) {
+        if (is_heap_type((ValueType)parameters->as.block.statements[i]->value_type)) roots = true;
+    }
+    gen->function = node;
+    gen->function_roots = roots;
+    gen->function_heap = roots || has_heap_node(body, gen);
+
+    emit_function_signature(node, gen, out);
+    emit(out, " {\n");
+    if (roots) {
+        emit(out, "    size_t ms_roots = ms_gc_root_mark();\n");
+        for (int i = 0; i < parameters->as.block.count; i++) {
+            AstNode* parameter = parameters->as.block.statements[i];
+            if (!is_heap_type((ValueType)parameter->value_type)) continue;
+            emit(out, "    ms_gc_add_root(&");
+            generate_name(parameter->as.variable.name, out);
+            emit(out, ");\n");
+        }
+    }
+    declare_variables(body, gen, out);
+    if (tail) emit(out, "ms_tail:;\n");
+    generate_statement(body, gen, out, 1);
+    if (!always_returns(body)) emit_return(NULL, gen, out, 1);
+    emit(out, "}\n\n");
+    gen->function = NULL;
+    gen->function_roots = false;
+    gen->function_heap = false;
+}
 
+void generate_code_to_buffer(AstNode* node, CodeBuffer* out) {
+    // სხეული და ფუნქციები ცალკე ბუფერებში გენერირდება, რომ ლიტერალების ცხრილი მათ წინ დაიწეროს.
+    CodeBuffer body, functions;
+    init_code_buffer(&body);
+    init_code_buffer(&functions);
+    CodeGenerator gen;
+    memset(&gen, 0, sizeof(gen));
+    init_ast_stack(&gen.walk);
+    init_code_buffer(&gen.parallel);
     if (node != NULL && node->type == NODE_PROGRAM) {
         ProgramNode* prog = &node->as.program;
         for (int i = 0; i < prog->count; i++) {
-            fprintf(outfile, "    ");
-            generate_statement(prog->statements[i], outfile);
+            AstNode* statement = prog->statements[i];
+            if (statement == NULL || statement->type != NODE_FUNCTION) continue;
+            if (statement->as.function.name->id >= gen.function_capacity) gen.function_capacity = statement->as.function.name->id + 1;
         }
+        gen.functions = calloc((size_t)gen.function_capacity + 1, sizeof(AstNode*));
+        if (!gen.functions) {
+            fprintf(stderr, "FATAL: Memory allocation failed for code generator.\n");
+            exit(1);
+        }
+        for (int i = 0; i < prog->count; i++) {
+            AstNode* statement = prog->statements[i];
+            if (statement == NULL || statement->type != NODE_FUNCTION) continue;
+            gen.functions[statement->as.function.name->id] = statement;
+            // პროტოტიპები: ფუნქციას შეუძლია მოგვიანებით განსაზღვრული ფუნქციის გამოძახება.
+            emit_function_signature(statement, &gen, &functions);
+            emit(&functions, ";\n");
+        }
+        if (functions.length > 0) emit(&functions, "\n");
+        for (int i = 0; i < prog->count; i++) {
+            AstNode* statement = prog->statements[i];
+            if (statement != NULL && statement->type == NODE_FUNCTION) generate_function(statement, &gen, &functions);
+        }
+        declare_variables(node, &gen, &body);
+        for (int i = 0; i < prog->count; i++) generate_statement(prog->statements[i], &gen, &body, 1);
+    }
+
+    emit(out, "#include <stdio.h>\n");
+    emit(out, "#include <stdint.h>\n");
+    emit(out, "#include <inttypes.h>\n");
+    emit(out, "#include <math.h>\n");
+    // MsValue, ms_mul_int და არითმეტიკის სწრაფი გზები; ნელი გზები libmanuscript_rt.a-შია.
+    emit(out, "#include \"runtime.h\"\n\n");
+    if (gen.strings.count > 0) {
+        emit(out, "static MsString ms_literals[] = {\n");
+        for (int i = 0; i < gen.strings.count; i++) {
+            StringLiteral* literal = &gen.strings.literals[i];
+            emit(out, "    MS_STRING_LITERAL(");
+            generate_c_string(literal->chars, literal->length, out);
+            emit_format(out, ", %d),\n", literal->length);
+        }
+        emit(out, "};\n\n");
     }
+    // პარალელური სხეულები ფუნქციებს არ იძახებს, ამიტომ პროტოტიპებამდე იწერება.
+    emit_chars(out, gen.parallel.data ? gen.parallel.data : "", gen.parallel.length);
+    emit_chars(out, functions.data ? functions.data : "", functions.length);
+    emit(out, "int main() {\n");
+    emit_chars(out, body.data ? body.data : "", body.length);
+    emit(out, "    return 0;\n");
+    emit(out, "}\n");
 
-    fprintf(outfile, "    return 0;\n");
-    fprintf(outfile, "}\n");
-}
\ No newline at end of file
+    free_string_table(&gen.strings);
+    free(gen.tasks);
+    free(gen.spills);
+    free(gen.functions);
+    free(gen.call_slots);
+    free(gen.flags);
+    free_ast_stack(&gen.walk);
+    free_code_buffer(&body);
+    free_code_buffer(&functions);
+    free_code_buffer(&gen.parallel);
+}
+
+bool generate_code(AstNode* node, FILE* outfile) {
+    CodeBuffer buffer;
+    init_code_buffer(&buffer);
+    generate_code_to_buffer(node, &buffer);
+    // მთელი პროგრამა ერთი ჩაწერით გადის ფაილში ან pipe-ში.
+    bool ok = fwrite(buffer.data, 1, buffer.length, outfile) == buffer.length;
+    free_code_buffer(&buffer);
+    return ok;
+}
@@ -0,0 +1,235 @@
+/**
+ * @file incremental.c
+ * @author გიორგი მაღრაძე (magradze.giorgi@gmail.com)
+ * @brief ინკრემენტული ლექსირებისა და პარსინგის იმპლემენტაცია.
+ * @version 0.3
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "incremental.h"
+#include "parser.h"
+
+// დოკუმენტი თავიდან იგება, როცა არენა ბოლო სრული პარსინგის შემდეგ ამდენჯერ
+// გაიზარდა (ძველი კვანძები და ყოველი კომპილაციის ოპტიმიზირებული ხეები).
+#define REBUILD_GROWTH_FACTOR 4
+#define REBUILD_MIN_BYTES ((size_t)1 << 20)
+
+/** @brief ადიდებს განცხადებების მასივს ორჯერ. */
+static void grow_statements(SourceDocument* document) {
+    int capacity = document->statement_capacity < 16 ? 16 : document->statement_capacity * 2;
+    DocumentStatement* statements = realloc(document->statements, sizeof(DocumentStatement) * (size_t)capacity);
+    if (statements == NULL) {
+        fprintf(stderr, "FATAL: Memory allocation failed for document statements.\n");
+        exit(1);
+    }
+    document->statements = statements;
+    document->statement_capacity = capacity;
+}
+
+/** @brief ამატებს განცხადებას დოკუმენტის სიის ბოლოს. */
+static void push_statement(SourceDocument* document, int first_token, AstNode* node, bool had_error) {
+    if (document->statement_count >= document->statement_capacity) grow_statements(document);
+    DocumentStatement* statement = &document->statements[document->statement_count++];
+    statement->first_token = first_token;
+    statement->node = node;
+    statement->had_error = had_error;
+}
+
+/** @brief აბრუნებს `from`-დან პირველ განცხადებას, რომლის პირველი ტოკენი >= `token` (ორობითი ძებნა). */
+static int first_statement_from(const SourceDocument* document, int from, int token) {
+    int low = from < document->statement_count ? from : document->statement_count;
+    int high = document->statement_count;
+    while (low < high) {
+        int mid = low + (high - low) / 2;
+        if (document->statements[mid].first_token < token) low = mid + 1;
+        else high = mid;
+    }
+    return low;
+}
+
+/**
+ * @brief არჩევს განცხადებებს `position`-დან (პარსერი იქ უკვე დგას) ფაილის
+ * ბოლომდე, ან სანამ პარსერი (`min_token`-ის შემდეგ) `tail`-ის რომელიმე
+ * განცხადების დასაწყისს არ მიაღწევს — იქიდან ძველი განცხადებები უცვლელია.
+ *
+ * განცხადების დასაწყისად იწერება პოზიცია მის წინ გამოტოვებულ შეცდომის
+ * ტოკენებამდე, ხოლო ბოლო advance-ის შეცდომები მას ეკუთვნის. ასე ნებისმიერი
+ * განცხადების თავიდან არჩევა init_parser_at-ით ზუსტად იმავე დიაგნოსტიკას იძლევა.
+ * @param shift tail-ის ტოკენების ინდექსების წანაცვლება ახალ ნაკადში.
+ * @return int tail-ის პირველი ხელახლა გამოსაყენებელი განცხადება (tail_count, თუ არცერთი).
+ */
+static int parse_statements(SourceDocument* document, Parser* parser, int position, const DocumentStatement* tail,
+                            int tail_count, int shift, int min_token) {
+    int reused = 0;
+    while (parser->current.type != TOKEN_EOF) {
+        if (position >= min_token) {
+            while (reused < tail_count && tail[reused].first_token + shift < position) reused++;
+            if (reused < tail_count && tail[reused].first_token + shift == position) return reused;
+        }
+        AstNode* node = parse_declaration(parser);
+        push_statement(document, position, node, parser->had_error);
+        parser->had_error = false;
+        position = parser_position(parser);
+    }
+    // მხოლოდ შეცდომის ტოკენები ფაილის ბოლოს: ისინიც განცხადებად ითვლება, რომ დოკუმენტი შეცდომიანი იყოს.
+    if (parser->had_error) push_statement(document, position, NULL, true);
+    return tail_count;
+}
+
+/** @brief ხელახლა ბეჭდავს უცვლელი, შეცდომიანი განცხადებების დიაგნოსტიკას. */
+static void report_statements(SourceDocument* document, int from, int to) {
+    for (int i = from; i < to; i++) {
+        if (!document->statements[i].had_error) continue;
+        Parser parser;
+        init_parser_at(&parser, &document->tokens, document->statements[i].first_token, &document->ast);
+        parser.max_depth = document->max_depth;
+        parse_declaration(&parser);
+    }
+}
+
+/** @brief ავსებს ProgramNode-ს დოკუმენტის განცხადებებით და აახლებს მათ ხაზებს. */
+static void rebuild_program(SourceDocument* document) {
+    document->program->as.program.count = 0;
+    document->had_error = false;
+    for (int i = 0; i < document->statement_count; i++) {
+        DocumentStatement* statement = &document->statements[i];
+        if (statement->node != NULL) {
+            // ხელახლა გამოყენებული განცხადება რედაქტირების შემდეგ სხვა ხაზზე შეიძლება იყოს.
+            statement->node->line = token_stream_get(&document->tokens, statement->first_token).line;
+            add_statement_to_program(&document->ast, document->program, statement->node);
+        }
+        if (statement->had_error) document->had_error = true;
+    }
+}
+
+/** @brief სრულად ასკანერებს და არჩევს document->text-ს. */
+static void parse_document(SourceDocument* document, DocumentStats* stats) {
+    init_ast_context(&document->ast);
+    lex_all(&document->tokens, document->text, document->length);
+    document->program = create_program_node(&document->ast);
+    document->statement_count = 0;
+
+    Parser parser;
+    init_parser_from_stream(&parser, &document->tokens, &document->ast);
+    parser.max_depth = document->max_depth;
+    parse_statements(document, &parser, 0, NULL, 0, 0, 0);
+    rebuild_program(document);
+    document->arena_baseline = document->ast.arena.bytes_allocated;
+
+    stats->tokens_relexed = document->tokens.count;
+    stats->token_count = document->tokens.count;
+    stats->statements_reparsed = document->statement_count;
+    stats->statement_count = document->statement_count;
+    stats->full_rebuild = true;
+}
+
+void init_document(SourceDocument* document, const char* text, size_t length, int max_depth, DocumentStats* stats) {
+    memset(document, 0, sizeof(*document));
+    document->max_depth = max_depth;
+    document->text = malloc(length + 1);
+    if (document->text == NULL) {
+        fprintf(stderr, "FATAL: Memory allocation failed for document text.\n");
+        exit(1);
+    }
+    memcpy(document->text, text, length);
+    document->length = length;
+    parse_document(document, stats);
+}
+
+void edit_document(SourceDocument* document, size_t start, size_t end, const char* replacement,
+                   size_t replacement_length, DocumentStats* stats) {
+    memset(stats, 0, sizeof(*stats));
+    if (end > document->length) end = document->length;
+    if (start > end) start = end;
+
+    size_t length = document->length - (end - start) + replacement_length;
+    char* text = malloc(length + 1);
+    if (text == NULL) {
+        fprintf(stderr, "FATAL: Memory allocation failed for document text.\n");
+        exit(1);
+    }
+    memcpy(text, document->text, start);
+    memcpy(text + start, replacement, replacement_length);
+    memcpy(text + start + replacement_length, document->text + end, document->length - end);
+
+    size_t limit = document->arena_baseline * REBUILD_GROWTH_FACTOR;
+    if (document->ast.arena.bytes_allocated > (limit > REBUILD_MIN_BYTES ? limit : REBUILD_MIN_BYTES)) {
+        free(document->text);
+        free_token_stream(&document->tokens);
+        free_ast_context(&document->ast);
+        document->text = text;
+        document->length = length;
+        parse_document(document, stats);
+        return;
+    }
+
+    // ძველი ტექსტი სკანირებისას ჯერ კიდევ საჭიროა: მისით მოწმდება, სად ემთხვევა ნაკადები.
+    TokenStreamEdit edit;
+    relex_token_stream(&document->tokens, text, length, (uint32_t)start, (uint32_t)end,
+                       (uint32_t)(start + replacement_length), &edit);
+    free(document->text);
+    document->text = text;
+    document->length = length;
+
+    // განცხადება უცვლელია, თუ მისი ტოკენებიც და მომდევნო ტოკენიც (პარსერის
+    // წინასწარ ნახული) ცვლილებამდეა. ბოლოს განცხადებას EOF მოსდევს, ის ყოველთვის ხელახლა ირჩევა.
+    int keep = first_statement_from(document, 1, edit.first) - 1;
+    if (keep < 0) keep = 0;
+    int first_token = keep < document->statement_count ? document->statements[keep].first_token : 0;
+
+    int tail_start = first_statement_from(document, keep, edit.old_end);
+    int tail_count = document->statement_count - tail_start;
+    DocumentStatement* tail = malloc(sizeof(DocumentStatement) * (size_t)(tail_count + 1));
+    if (tail == NULL) {
+        fprintf(stderr, "FATAL: Memory allocation failed for document statements.\n");
+        exit(1);
+    }
+    memcpy(tail, document->statements + tail_start, sizeof(DocumentStatement) * (size_t)tail_count);
+    int shift = edit.new_end - edit.old_end;
+
+    bool had_error = document->had_error;
+    if (had_error) report_statements(document, 0, keep);
+    document->statement_count = keep;
+    Parser parser;
+    init_parser_at(&parser, &document->tokens, first_token, &document->ast);
+    parser.max_depth = document->max_depth;
+    int reused = parse_statements(document, &parser, first_token, tail, tail_count, shift, edit.new_end);
+    stats->statements_reparsed = document->statement_count - keep;
+
+    int reused_start = document->statement_count;
+    int rest = tail_count - reused;
+    while (document->statement_capacity < document->statement_count + rest) grow_statements(document);
+    DocumentStatement* moved = document->statements + document->statement_count;
+    memcpy(moved, tail + reused, sizeof(DocumentStatement) * (size_t)rest);
+    if (shift != 0) {
+        for (int i = 0; i < rest; i++) moved[i].first_token += shift;
+    }
+    document->statement_count += rest;
+    free(tail);
+    if (had_error) report_statements(document, reused_start, document->statement_count);
+    rebuild_program(document);
+
+    stats->tokens_relexed = edit.new_end - edit.first;
+    stats->token_count = document->tokens.count;
+    stats->statement_count = document->statement_count;
+}
+
+void replace_document_text(SourceDocument* document, const char* text, size_t length, DocumentStats* stats) {
+    size_t shorter = length < document->length ? length : document->length;
+    size_t prefix = 0;
+    while (prefix < shorter && text[prefix] == document->text[prefix]) prefix++;
+    size_t suffix = 0;
+    while (suffix < shorter - prefix && text[length - 1 - suffix] == document->text[document->length - 1 - suffix]) {
+        suffix++;
+    }
+    edit_document(document, prefix, document->length - suffix, text + prefix, length - prefix - suffix, stats);
+}
+
+void free_document(SourceDocument* document) {
+    free(document->text);
+    free_token_stream(&document->tokens);
+    free_ast_context(&document->ast);
+    free(document->statements);
+    memset(document, 0, sizeof(*document));
+}
@@ -0,0 +1,385 @@
+/**
+ * @file jit_x64.c
+ * @author გიორგი მაღრაძე (magradze.giorgi@gmail.com)
+ * @brief x86-64 SSE2 მანქანური კოდის გენერატორის (JIT) იმპლემენტაცია.
+ * @version 0.9
+ *
+ * გენერირებული ფუნქციის სიგნატურაა `void entry(double* frame)` (System V ABI).
+ * ჩარჩოს მისამართი rbx-შია, გამოსახულების შედეგი — xmm0-ში, xmm1 დამხმარეა.
+ * რთული მარჯვენა ოპერანდის გამოთვლისას მარცხენა მნიშვნელობა მანქანის
+ * სტეკზე ინახება. ფუნქციების გამოძახება (დაბეჭდვა) მხოლოდ განცხადებების
+ * დონეზე ხდება, როცა სტეკი 16 ბაიტზეა გასწორებული.
+ */
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include "jit.h"
+
+#if defined(__x86_64__)
+
+#include <sys/mman.h>
+
+/** @brief მანქანური კოდის ბუფერი და კომპილაციის მდგომარეობა. */
+typedef struct {
+    uint8_t* bytes;
+    size_t count;
+    size_t capacity;
+    bool* declared;        // declared[id] — გამოცხადებულია თუ არა ცვლადი
+    bool had_error;
+    int line;              // მიმდინარე ზედა დონის განცხადების ხაზი (0 — უცნობი)
+    AstStack walk;         // გამოსახულებების გავლის სტეკი
+} Emitter;
+
+typedef void (*JitEntry)(double* frame);
+
+// SSE2 ოპერაციების კოდები (F2 0F xx პრეფიქსის შემდეგ).
+#define SSE_LOAD 0x10
+#define SSE_STORE 0x11
+#define SSE_ADD 0x58
+#define SSE_MUL 0x59
+#define SSE_SUB 0x5C
+#define SSE_DIV 0x5E
+
+/** @brief დაბეჭდვის დამხმარე ფუნქცია, რომელსაც გენერირებული კოდი იძახებს. */
+static void jit_print_number(double value) {
+    printf("%f\n", value);
+}
+
+/** @brief მთელი (TYPE_INT) გამოსახულების დაბეჭდვა; ±2^53-ის მიღმა — ათწილადივით (იხ. ms_print_int). */
+static void jit_print_integer(double value) {
+    if (value >= -9007199254740992.0 && value <= 9007199254740992.0) printf("%" PRId64 "\n", (int64_t)value);
+    else printf("%f\n", value);
+}
+
+static void emit_byte(Emitter* e, uint8_t byte) {
+    if (e->count >= e->capacity) {
+        e->capacity = e->capacity < 256 ? 256 : e->capacity * 2;
+        e->bytes = realloc(e->bytes, e->capacity);
+        if (!e->bytes) {
+            fprintf(stderr, "FATAL: Memory allocation failed for JIT buffer.\n");
+            exit(1);
+        }
+    }
+    e->bytes[e->count++] = byte;
+}
+
+static void emit_bytes(Emitter* e, const uint8_t* bytes, size_t count) {
+    for (size_t i = 0; i < count; i++) emit_byte(e, bytes[i]);
+}
+
+static void emit_u32(Emitter* e, uint32_t value) {
+    for (int i = 0; i < 4; i++) emit_byte(e, (uint8_t)(value >> (8 * i)));
+}
+
+static void emit_u64(Emitter* e, uint64_t value) {
+    for (int i = 0; i < 8; i++) emit_byte(e, (uint8_t)(value >> (8 * i)));
+}
+
+/** @brief movabs rax, imm64 */
+static void emit_mov_rax_imm64(Emitter* e, uint64_t value) {
+    emit_byte(e, 0x48);
+    emit_byte(e, 0xB8);
+    emit_u64(e, value);
+}
+
+/** @brief ტვირთავს double მუდმივას xmm0-ში ან xmm1-ში (rax-ის გავლით). */
+static void emit_load_constant(Emitter* e, int xmm, double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    emit_mov_rax_imm64(e, bits);
+    // movq xmmN, rax
+    const uint8_t movq[] = { 0x66, 0x48, 0x0F, 0x6E, (uint8_t)(0xC0 | (xmm << 3)) };
+    emit_bytes(e, movq, sizeof(movq));
+}
+
+/** @brief SSE2 ოპერაცია xmmN-სა და ჩარჩოს სლოტს შორის: op xmmN, [rbx + slot*8]. */
+static void emit_frame_op(Emitter* e, uint8_t op, int xmm, int slot) {
+    const uint8_t prefix[] = { 0xF2, 0x0F, op, (uint8_t)(0x80 | (xmm << 3) | 3) };
+    emit_bytes(e, prefix, sizeof(prefix));
+    emit_u32(e, (uint32_t)slot * 8u);
+}
+
+/** @brief SSE2 ოპერაცია რეგისტრებზე: op xmm0, xmm1. */
+static void emit_xmm_op(Emitter* e, uint8_t op) {
+    const uint8_t bytes[] = { 0xF2, 0x0F, op, 0xC1 };
+    emit_bytes(e, bytes, sizeof(bytes));
+}
+
+/**
+ * @brief ბეჭდავს კომპილაციის შეცდომას განცხადების ხაზით. მხოლოდ პირველი
+ * შეცდომა იბეჭდება: მხარდაუჭერელი კონსტრუქცია ერთხელ ცხადდება.
+ */
+static void jit_error(Emitter* e, const char* message, Symbol* name) {
+    if (e->had_error) return;
+    if (e->line > 0) fprintf(stderr, "[Line %d] ", e->line);
+    if (name) fprintf(stderr, "შეცდომა: %s: '%s'\n", message, name->chars);
+    else fprintf(stderr, "შეცდომა: %s\n", message);
+    e->had_error = true;
+}
+
+/** @brief აბრუნებს ოპერატორის SSE2 კოდს. */
+static uint8_t arithmetic_opcode(Emitter* e, TokenType op) {
+    switch (op) {
+        case TOKEN_PLUS: return SSE_ADD;
+        case TOKEN_MINUS: return SSE_SUB;
+        case TOKEN_STAR: return SSE_MUL;
+        case TOKEN_SLASH: return SSE_DIV;
+        default:
+            jit_error(e, "JIT-ს ეს ოპერატორი არ აქვს მხარდაჭერილი", NULL);
+            return SSE_ADD;
+    }
+}
+
+/** @brief ამოწმებს, რომ ცვლადი გამოცხადებულია გამოყენებამდე. */
+static void check_declared(Emitter* e, Symbol* name) {
+    if (!e->declared[name->id]) jit_error(e, "ცვლადი არ არის გამოცხადებული", name);
+}
+
+/** @brief ტვირთავს ფოთოლს (რიცხვი ან ცვლადი) xmm0-ში. */
+static void emit_leaf(Emitter* e, AstNode* node) {
+    switch (node->type) {
+        case NODE_NUMBER:
+            emit_load_constant(e, 0, node->as.number.value);
+            break;
+        case NODE_VARIABLE:
+            check_declared(e, node->as.variable.name);
+            emit_frame_op(e, SSE_LOAD, 0, node->as.variable.name->id);
+            break;
+        case NODE_BOOLEAN:
+        case NODE_NONE:
+        case NODE_STRING:
+            jit_error(e, "JIT-ს მხოლოდ რიცხვითი მნიშვნელობები აქვს მხარდაჭერილი", NULL);
+            break;
+        case NODE_CALL:
+            jit_error(e, "JIT-ს ფუნქციები არ აქვს მხარდაჭერილი", NULL);
+            break;
+        case NODE_ARRAY:
+        case NODE_INDEX:
+        case NODE_BUILTIN:
+            jit_error(e, "JIT-ს მასივები არ აქვს მხარდაჭერილი", NULL);
+            break;
+        default:
+            jit_error(e, "JIT-ს ეს გამოსახულება არ აქვს მხარდაჭერილი", NULL);
+            break;
+    }
+}
+
+/**
+ * @brief აგენერირებს ორობითი ოპერაციის კოდს, როცა მარცხენა ოპერანდი უკვე
+ * xmm0-შია. მარტივი მარჯვენა ოპერანდი პირდაპირ გამოიყენება და ფუნქცია
+ * true-ს აბრუნებს; რთულისთვის მარცხენა მნიშვნელობა სტეკზე ინახება და
+ * მარჯვენა ოპერანდი ცალკე უნდა გამოითვალოს (false).
+ */
+static bool emit_binary_left_done(Emitter* e, AstNode* node) {
+    AstNode* right = node->as.binary_op.right;
+    if (right && right->type == NODE_VARIABLE) {
+        // მარჯვენა ოპერანდი პირდაპირ ჩარჩოდან: op xmm0, [rbx + disp]
+        check_declared(e, right->as.variable.name);
+        emit_frame_op(e, arithmetic_opcode(e, node->as.binary_op.operator), 0, right->as.variable.name->id);
+        return true;
+    }
+    if (right && right->type == NODE_NUMBER) {
+        emit_load_constant(e, 1, right->as.number.value);
+        emit_xmm_op(e, arithmetic_opcode(e, node->as.binary_op.operator));
+        return true;
+    }
+    // sub rsp, 8; movsd [rsp], xmm0
+    const uint8_t spill[] = { 0x48, 0x83, 0xEC, 0x08, 0xF2, 0x0F, 0x11, 0x04, 0x24 };
+    emit_bytes(e, spill, sizeof(spill));
+    return false;
+}
+
+/**
+ * @brief აგენერირებს გამოსახულების კოდს; შედეგი xmm0-შია. ხე ცხადი
+ * სტეკით გაივლება; ჩარჩოს ეტაპი აჩვენებს, რომელი ოპერანდია უკვე გამოთვლილი.
+ */
+static void emit_expression(Emitter* e, AstNode* node) {
+    if (node == NULL) return;
+    AstStack* stack = &e->walk;
+    int base = stack->count;
+    ast_stack_push(stack, node);
+    while (stack->count > base) {
+        AstFrame* frame = ast_stack_top(stack);
+        AstNode* current = frame->node;
+        if (current->type == NODE_UNARY_OP) {
+            if (frame->stage++ == 0 && current->as.unary_op.right != NULL) {
+                ast_stack_push(stack, current->as.unary_op.right);
+                continue;
+            }
+            if (current->as.unary_op.operator != TOKEN_MINUS) {
+                jit_error(e, "JIT-ს ეს ოპერატორი არ აქვს მხარდაჭერილი", NULL);
+            }
+            // ნიშნის ბიტის შებრუნება: xorpd xmm0, xmm1 (xmm1 = -0.0)
+            emit_load_constant(e, 1, -0.0);
+            const uint8_t xorpd[] = { 0x66, 0x0F, 0x57, 0xC1 };
+            emit_bytes(e, xorpd, sizeof(xorpd));
+        } else if (current->type == NODE_BINARY_OP) {
+            int stage = frame->stage++;
+            if (stage == 0) {
+                if (current->as.binary_op.left != NULL) ast_stack_push(stack, current->as.binary_op.left);
+                continue;
+            }
+            if (stage == 1) {
+                if (!emit_binary_left_done(e, current)) {
+                    if (current->as.binary_op.right != NULL) ast_stack_push(stack, current->as.binary_op.right);
+                    continue;
+                }
+            } else {
+                // movapd xmm1, xmm0; movsd xmm0, [rsp]; add rsp, 8
+                const uint8_t reload[] = { 0x66, 0x0F, 0x28, 0xC8, 0xF2, 0x0F, 0x10, 0x04, 0x24, 0x48, 0x83, 0xC4, 0x08 };
+                emit_bytes(e, reload, sizeof(reload));
+                emit_xmm_op(e, arithmetic_opcode(e, current->as.binary_op.operator));
+            }
+        } else {
+            emit_leaf(e, current);
+        }
+        stack->count--;
+    }
+}
+
+/** @brief აგენერირებს ერთი განცხადების კოდს. */
+static void emit_statement(Emitter* e, AstNode* node) {
+    if (node == NULL) return;
+    switch (node->type) {
+        case NODE_VAR_DECL: {
+            Symbol* name = node->as.var_decl.name;
+            if (e->declared[name->id]) jit_error(e, "ცვლადი უკვე გამოცხადებულია", name);
+            emit_expression(e, node->as.var_decl.initializer);
+            emit_frame_op(e, SSE_STORE, 0, name->id);
+            e->declared[name->id] = true;
+            break;
+        }
+        case NODE_ASSIGN: {
+            Symbol* name = node->as.assign.name;
+            check_declared(e, name);
+            emit_expression(e, node->as.assign.value);
+            emit_frame_op(e, SSE_STORE, 0, name->id);
+            break;
+        }
+        case NODE_BLOCK:
+        case NODE_IF:
+        case NODE_WHILE:
+        case NODE_FOR:
+        case NODE_PARALLEL_FOR:
+            jit_error(e, "JIT-ს მართვის კონსტრუქციები (თუ, სანამ, ყოველი) არ აქვს მხარდაჭერილი", NULL);
+            break;
+        case NODE_FUNCTION:
+        case NODE_RETURN:
+        case NODE_EXPRESSION_STMT:
+            jit_error(e, "JIT-ს ფუნქციები არ აქვს მხარდაჭერილი", NULL);
+            break;
+        case NODE_INDEX_ASSIGN:
+            jit_error(e, "JIT-ს მასივები არ აქვს მხარდაჭერილი", NULL);
+            break;
+        case NODE_PRINT_STMT: {
+            emit_expression(e, node->as.print_stmt.expression);
+            // movabs rax, helper; call rax
+            void (*helper)(double) = node->as.print_stmt.expression->value_type == TYPE_INT
+                                         ? jit_print_integer : jit_print_number;
+            emit_mov_rax_imm64(e, (uint64_t)(uintptr_t)helper);
+            const uint8_t call[] = { 0xFF, 0xD0 };
+            emit_bytes(e, call, sizeof(call));
+            break;
+        }
+        default:
+            jit_error(e, "JIT-ს ეს განცხადება არ აქვს მხარდაჭერილი", NULL);
+            break;
+    }
+}
+
+bool jit_compile(AstNode* program, AstContext* ctx, JitProgram* jit) {
+    memset(jit, 0, sizeof(*jit));
+
+    Emitter e;
+    memset(&e, 0, sizeof(e));
+    e.declared = calloc((size_t)ctx->symbol_count + 1, sizeof(bool));
+    if (!e.declared) {
+        fprintf(stderr, "FATAL: Memory allocation failed for JIT compiler.\n");
+        exit(1);
+    }
+    init_ast_stack(&e.walk);
+
+    // push rbx; mov rbx, rdi
+    const uint8_t prologue[] = { 0x53, 0x48, 0x89, 0xFB };
+    emit_bytes(&e, prologue, sizeof(prologue));
+
+    if (program != NULL && program->type == NODE_PROGRAM) {
+        for (int i = 0; i < program->as.program.count && !e.had_error; i++) {
+            AstNode* statement = program->as.program.statements[i];
+            e.line = statement != NULL ? statement->line : 0;
+            emit_statement(&e, statement);
+        }
+    }
+
+    // pop rbx; ret
+    const uint8_t epilogue[] = { 0x5B, 0xC3 };
+    emit_bytes(&e, epilogue, sizeof(epilogue));
+
+    free(e.declared);
+    free_ast_stack(&e.walk);
+    if (e.had_error) {
+        free(e.bytes);
+        return false;
+    }
+
+    // W^X: ჯერ ვწერთ ჩასაწერ რეგიონში, შემდეგ ვცვლით მას შესრულებადად.
+    void* code = mmap(NULL, e.count, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (code == MAP_FAILED) {
+        perror("JIT: mmap");
+        free(e.bytes);
+        return false;
+    }
+    memcpy(code, e.bytes, e.count);
+    free(e.bytes);
+    if (mprotect(code, e.count, PROT_READ | PROT_EXEC) != 0) {
+        perror("JIT: mprotect");
+        munmap(code, e.count);
+        return false;
+    }
+
+    jit->code = code;
+    jit->size = e.count;
+    jit->frame_size = ctx->symbol_count;
+    return true;
+}
+
+int jit_run(JitProgram* jit) {
+    double* frame = calloc((size_t)jit->frame_size + 1, sizeof(double));
+    if (!frame) {
+        fprintf(stderr, "FATAL: Memory allocation failed for JIT frame.\n");
+        exit(1);
+    }
+    JitEntry entry = (JitEntry)jit->code;
+    entry(frame);
+    free(frame);
+    return 0;
+}
+
+void jit_free(JitProgram* jit) {
+    if (jit->code) munmap(jit->code, jit->size);
+    memset(jit, 0, sizeof(*jit));
+}
+
+#else // !__x86_64__
+
+bool jit_compile(AstNode* program, AstContext* ctx, JitProgram* jit) {
+    (void)program;
+    (void)ctx;
+    memset(jit, 0, sizeof(*jit));
+    fprintf(stderr, "შეცდომა: JIT ბექენდი მხოლოდ x86-64 პლატფორმაზეა ხელმისაწვდომი.\n");
+    return false;
+}
+
+int jit_run(JitProgram* jit) {
+    (void)jit;
+    return 1;
+}
+
+void jit_free(JitProgram* jit) {
+    memset(jit, 0, sizeof(*jit));
+}
+
+#endif // __x86_64__
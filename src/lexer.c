@@ -2,13 +2,14 @@
  * @file lexer.c
  * @author გიორგი მაღრაძე (magradze.giorgi@gmail.com)
  * @brief ლექსიკური ანალიზატორის (ლექსერის) იმპლემენტაცია.
- * @version 0.6
+ * @version 0.12
  * @date 2024-05-21
  */
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
 #include "lexer.h"
+#include "scan_simd.h"
 
 // --- დამხმარე ფუნქციები ---
 
@@ -16,7 +17,7 @@
  * @brief ამოწმებს, მივაღწიეთ თუ არა საწყისი კოდის ბოლოს.
  */
 static bool is_at_end(Lexer* lexer) {
-    return *lexer->current == '\0';
+    return lexer->current >= lexer->end;
 }
 
 /**
@@ -75,27 +76,27 @@ static bool match(Lexer* lexer, char expected) {
 
 /**
  * @brief აბრუნებს მიმდინარე სიმბოლოს პოზიციის გადატანის გარეშე.
+ * კოდის ბოლოს აბრუნებს ვირტუალურ '\0' მცველს (sentinel), ისე რომ ბუფერის
+ * მიღმა არაფერი იკითხება.
  */
 static char peek(Lexer* lexer) {
-    return *lexer->current;
+    return lexer->current < lexer->end ? *lexer->current : '\0';
+}
+
+/**
+ * @brief აბრუნებს მიმდინარის მომდევნო სიმბოლოს (ან '\0'-ს კოდის ბოლოს).
+ */
+static char peek_next(Lexer* lexer) {
+    return lexer->current + 1 < lexer->end ? lexer->current[1] : '\0';
 }
 
 /**
  * @brief გამოტოვებს ცარიელ ადგილებს (space, tab, carriage return).
  */
 static void skip_whitespace(Lexer* lexer) {
-    while (true) {
-        char c = peek(lexer);
-        switch (c) {
-            case ' ':
-            case '\r':
-            case '\t':
-                advance(lexer);
-                break;
-            default:
-                return;
-        }
-    }
+    char c = peek(lexer);
+    if (c != ' ' && c != '\r' && c != '\t') return;
+    lexer->current = scan_kernels.spaces(lexer->current + 1, lexer->end);
 }
 
 /**
@@ -117,7 +118,7 @@ static bool is_alpha(char c) {
  */
 static Token number(Lexer* lexer) {
     while (is_digit(peek(lexer))) advance(lexer);
-    if (peek(lexer) == '.' && is_digit(lexer->current[1])) {
+    if (peek(lexer) == '.' && is_digit(peek_next(lexer))) {
         advance(lexer);
         while (is_digit(peek(lexer))) advance(lexer);
     }
@@ -128,10 +129,7 @@ static Token number(Lexer* lexer) {
  * @brief სკანირებს სტრიქონულ ლიტერალს.
  */
 static Token string(Lexer* lexer) {
-    while (peek(lexer) != '"' && !is_at_end(lexer)) {
-        if (peek(lexer) == '\n') lexer->line++;
-        advance(lexer);
-    }
+    lexer->current = scan_kernels.string_body(lexer->current, lexer->end, &lexer->line);
 
     if (is_at_end(lexer)) return error_token(lexer, "დაუსრულებელი სტრიქონი.");
 
@@ -139,38 +137,109 @@ static Token string(Lexer* lexer) {
     return make_token(lexer, TOKEN_STRING);
 }
 
+// --- საკვანძო სიტყვები ---
+
+/** @brief საკვანძო სიტყვის ჩანაწერი სრულყოფილი ჰეშის ცხრილში. */
+typedef struct {
+    const char* text;     // UTF-8 ბაიტები
+    int length;           // სიგრძე ბაიტებში (0 ცარიელ უჯრაში)
+    TokenType type;
+} Keyword;
+
+// მაკროები და keyword_table გენერირებულია tools/keyword_hash.c-ით (`make keyword-hash`); ხელით არ შეცვალოთ.
+#define KEYWORD_MIN_LENGTH 6
+#define KEYWORD_MAX_LENGTH 30
+#define KEYWORD_TABLE_SIZE 32
+#define KEYWORD_HASH_LENGTH 2u
+#define KEYWORD_HASH_LAST 9u
+#define KEYWORD_HASH_FOURTH_LAST 7u
+
 /**
- * @brief განსაზღვრავს იდენტიფიკატორის ტიპს (საკვანძო სიტყვაა თუ უბრალო იდენტიფიკატორი).
+ * @brief სრულყოფილი ჰეში საკვანძო სიტყვებისთვის.
+ *
+ * ქართული ასოები UTF-8-ში სამბაიტიანია (E1 83 xx), ამიტომ განმასხვავებელია
+ * ყოველი ასოს ბოლო ბაიტი. ფორმულა იყენებს პირველი ასოს, ბოლო ასოს და ბოლოდან
+ * მეორე ასოს ბოლო ბაიტებს და სიგრძეს. მამრავლებს, ცხრილის ზომას და ცხრილს
+ * tools/keyword_hash.c არჩევს (`make keyword-hash`), check_keyword_table კი
+ * (`make test`, tests/lexer_test.c) ამოწმებს, რომ ყოველი საკვანძო სიტყვა საკუთარ უჯრაშია.
  */
-static TokenType identifier_type(Lexer* lexer) {
-    const char* str = lexer->start;
-    int len = lexer->current - lexer->start;
-
-    // შესწორებული და სწორი სიგრძეები ბაიტებში
-    if (len == 6 && strncmp(str, "თუ", 6) == 0) return TOKEN_თუ;
-    if (len == 12 && strncmp(str, "სხვა", 12) == 0) return TOKEN_სხვა;
-    if (len == 21 && strncmp(str, "ფუნქცია", 21) == 0) return TOKEN_ფუნქცია;
-    if (len == 18 && strncmp(str, "ცვლადი", 18) == 0) return TOKEN_ცვლადი;
-    if (len == 21 && strncmp(str, "დაბეჭდე", 21) == 0) return TOKEN_დაბეჭდე;
+static unsigned int keyword_hash(const unsigned char* str, int length) {
+    return (str[2] + KEYWORD_HASH_LENGTH * (unsigned int)length + KEYWORD_HASH_LAST * str[length - 1] +
+            KEYWORD_HASH_FOURTH_LAST * str[length - 4]) & (KEYWORD_TABLE_SIZE - 1);
+}
 
+static const Keyword keyword_table[KEYWORD_TABLE_SIZE] = {
+    [2]  = { "სანამ",      15, TOKEN_სანამ },
+    [3]  = { "სხვა_თუ",    19, TOKEN_სხვა_თუ },
+    [4]  = { "ში",         6,  TOKEN_ში },
+    [6]  = { "ფუნქცია",    21, TOKEN_ფუნქცია },
+    [8]  = { "ან",         6,  TOKEN_ან },
+    [9]  = { "ჭეშმარიტი",  27, TOKEN_ჭეშმარიტი },
+    [11] = { "ცვლადი",     18, TOKEN_ცვლადი },
+    [12] = { "არ",         6,  TOKEN_არ },
+    [18] = { "პარალელური", 30, TOKEN_პარალელური },
+    [20] = { "და",         6,  TOKEN_და },
+    [21] = { "დაბრუნე",    21, TOKEN_დაბრუნე },
+    [22] = { "დაბეჭდე",    21, TOKEN_დაბეჭდე },
+    [23] = { "მცდარი",     18, TOKEN_მცდარი },
+    [25] = { "ყოველი",     18, TOKEN_ყოველი },
+    [28] = { "სხვა",       12, TOKEN_სხვა },
+    [30] = { "არარა",      15, TOKEN_არარა },
+    [31] = { "თუ",         6,  TOKEN_თუ },
+};
+
+TokenType lookup_keyword(const char* str, int length) {
+    if (length < KEYWORD_MIN_LENGTH || length > KEYWORD_MAX_LENGTH) return TOKEN_IDENTIFIER;
+    const Keyword* keyword = &keyword_table[keyword_hash((const unsigned char*)str, length)];
+    if (keyword->length == length && memcmp(keyword->text, str, (size_t)length) == 0) {
+        return keyword->type;
+    }
     return TOKEN_IDENTIFIER;
 }
 
+bool check_keyword_table(void) {
+    size_t prefix = strlen("KEYWORD_");
+    bool ok = true;
+    int entries = 0;
+    for (int slot = 0; slot < KEYWORD_TABLE_SIZE; slot++) {
+        if (keyword_table[slot].length > 0) entries++;
+    }
+    for (int type = TOKEN_FIRST_KEYWORD; type <= TOKEN_LAST_KEYWORD; type++) {
+        const char* text = token_type_name((TokenType)type) + prefix;
+        if (lookup_keyword(text, (int)strlen(text)) != (TokenType)type) {
+            fprintf(stderr, "შეცდომა: საკვანძო სიტყვა '%s' ჰეშის ცხრილში არ ამოიცნობა; გაუშვით `make keyword-hash`.\n", text);
+            ok = false;
+        }
+    }
+    if (entries != TOKEN_LAST_KEYWORD - TOKEN_FIRST_KEYWORD + 1) {
+        fprintf(stderr, "შეცდომა: ჰეშის ცხრილში %d ჩანაწერია, საკვანძო სიტყვა კი %d.\n", entries,
+                TOKEN_LAST_KEYWORD - TOKEN_FIRST_KEYWORD + 1);
+        ok = false;
+    }
+    return ok;
+}
+
+/**
+ * @brief განსაზღვრავს იდენტიფიკატორის ტიპს (საკვანძო სიტყვაა თუ უბრალო იდენტიფიკატორი).
+ */
+static TokenType identifier_type(Lexer* lexer) {
+    return lookup_keyword(lexer->start, (int)(lexer->current - lexer->start));
+}
+
 /**
  * @brief სკანირებს იდენტიფიკატორს.
  */
 static Token identifier(Lexer* lexer) {
-    while (is_alpha(peek(lexer)) || is_digit(peek(lexer)) || (unsigned char)peek(lexer) > 127) {
-        advance(lexer);
-    }
+    lexer->current = scan_kernels.identifier(lexer->current, lexer->end);
     return make_token(lexer, identifier_type(lexer));
 }
 
 // --- მთავარი ფუნქციები ---
 
-void init_lexer(Lexer* lexer, const char* source) {
+void init_lexer(Lexer* lexer, const char* source, size_t length) {
     lexer->start = source;
     lexer->current = source;
+    lexer->end = source + length;
     lexer->line = 1;
     lexer->at_start_of_line = true;
     lexer->indent_level_count = 1;
@@ -187,9 +256,7 @@ Token scan_token(Lexer* lexer) {
 
         if (lexer->at_start_of_line) {
             if (peek(lexer) == '#' || peek(lexer) == '\n' || peek(lexer) == '\r') {
-                while (!is_at_end(lexer) && peek(lexer) != '\n') {
-                    advance(lexer);
-                }
+                lexer->current = scan_kernels.line_end(lexer->current, lexer->end);
                 if (!is_at_end(lexer)) {
                     advance(lexer);
                     lexer->line++;
@@ -246,6 +313,8 @@ Token scan_token(Lexer* lexer) {
     switch (c) {
         case '(': return make_token(lexer, TOKEN_LPAREN);
         case ')': return make_token(lexer, TOKEN_RPAREN);
+        case '[': return make_token(lexer, TOKEN_LBRACKET);
+        case ']': return make_token(lexer, TOKEN_RBRACKET);
         case ':': return make_token(lexer, TOKEN_COLON);
         case ',': return make_token(lexer, TOKEN_COMMA);
         case '.': return make_token(lexer, TOKEN_DOT);
@@ -265,4 +334,54 @@ Token scan_token(Lexer* lexer) {
     }
 
     return error_token(lexer, "გაუთვალისწინებელი სიმბოლო.");
-}
\ No newline at end of file
+}
+
+const char* token_type_name(TokenType type) {
+    switch (type) {
+        case TOKEN_LPAREN: return "LPAREN";
+        case TOKEN_RPAREN: return "RPAREN";
+        case TOKEN_LBRACKET: return "LBRACKET";
+        case TOKEN_RBRACKET: return "RBRACKET";
+        case TOKEN_COMMA: return "COMMA";
+        case TOKEN_DOT: return "DOT";
+        case TOKEN_MINUS: return "MINUS";
+        case TOKEN_PLUS: return "PLUS";
+        case TOKEN_SLASH: return "SLASH";
+        case TOKEN_STAR: return "STAR";
+        case TOKEN_COLON: return "COLON";
+        case TOKEN_BANG: return "BANG";
+        case TOKEN_BANG_EQUAL: return "BANG_EQUAL";
+        case TOKEN_EQUAL: return "EQUAL";
+        case TOKEN_EQUAL_EQUAL: return "EQUAL_EQUAL";
+        case TOKEN_GREATER: return "GREATER";
+        case TOKEN_GREATER_EQUAL: return "GREATER_EQUAL";
+        case TOKEN_LESS: return "LESS";
+        case TOKEN_LESS_EQUAL: return "LESS_EQUAL";
+        case TOKEN_IDENTIFIER: return "IDENTIFIER";
+        case TOKEN_STRING: return "STRING";
+        case TOKEN_NUMBER: return "NUMBER";
+        case TOKEN_თუ: return "KEYWORD_თუ";
+        case TOKEN_სხვა: return "KEYWORD_სხვა";
+        case TOKEN_სხვა_თუ: return "KEYWORD_სხვა_თუ";
+        case TOKEN_და: return "KEYWORD_და";
+        case TOKEN_ან: return "KEYWORD_ან";
+        case TOKEN_არ: return "KEYWORD_არ";
+        case TOKEN_ჭეშმარიტი: return "KEYWORD_ჭეშმარიტი";
+        case TOKEN_მცდარი: return "KEYWORD_მცდარი";
+        case TOKEN_არარა: return "KEYWORD_არარა";
+        case TOKEN_ფუნქცია: return "KEYWORD_ფუნქცია";
+        case TOKEN_დაბრუნე: return "KEYWORD_დაბრუნე";
+        case TOKEN_სანამ: return "KEYWORD_სანამ";
+        case TOKEN_ყოველი: return "KEYWORD_ყოველი";
+        case TOKEN_ში: return "KEYWORD_ში";
+        case TOKEN_ცვლადი: return "KEYWORD_ცვლადი";
+        case TOKEN_დაბეჭდე: return "KEYWORD_დაბეჭდე";
+        case TOKEN_პარალელური: return "KEYWORD_პარალელური";
+        case TOKEN_NEWLINE: return "NEWLINE";
+        case TOKEN_INDENT: return "INDENT";
+        case TOKEN_DEDENT: return "DEDENT";
+        case TOKEN_ERROR: return "ERROR";
+        case TOKEN_EOF: return "EOF";
+    }
+    return "UNKNOWN";
+}
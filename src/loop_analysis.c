@@ -0,0 +1,177 @@
+/**
+ * @file loop_analysis.c
+ * @author გიორგი მაღრაძე (magradze.giorgi@gmail.com)
+ * @brief `ყოველი` ციკლის იტერაციების დამოუკიდებლობის ანალიზის იმპლემენტაცია.
+ * @version 0.2
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "loop_analysis.h"
+
+/** @brief ზუსტი მთელი: ფართო (wide) მნიშვნელობის ჯამი მრგვალდება, ამიტომ ასოციაციური არ არის. */
+static bool is_int(const AstNode* node) {
+    return node != NULL && node->value_type == TYPE_INT && !node->wide;
+}
+
+/** @brief ჭეშმარიტია, თუ კვანძი `ცვლადი` წაკითხვაა. */
+static bool reads_variable(const AstNode* node, const Symbol* name) {
+    return node != NULL && node->type == NODE_VARIABLE && node->as.variable.name == name;
+}
+
+/**
+ * @brief ამოიცნობს მინიმუმის/მაქსიმუმის რედუქციას `თუ x > მ: მ = x`
+ * (`else` შტოს გარეშე, x — ცვლადი). აბრუნებს "min"/"max"-ს ან NULL-ს.
+ */
+static const char* extremum_reduction(AstNode* node, Symbol** target) {
+    if (node->as.if_stmt.else_branch != NULL) return NULL;
+    AstNode* then_branch = node->as.if_stmt.then_branch;
+    if (then_branch == NULL || then_branch->type != NODE_BLOCK || then_branch->as.block.count != 1) return NULL;
+    AstNode* assign = then_branch->as.block.statements[0];
+    AstNode* condition = node->as.if_stmt.condition;
+    if (assign == NULL || assign->type != NODE_ASSIGN || condition == NULL || condition->type != NODE_BINARY_OP) return NULL;
+    Symbol* name = assign->as.assign.name;
+    AstNode* value = assign->as.assign.value;
+    if (value == NULL || value->type != NODE_VARIABLE || value->as.variable.name == name) return NULL;
+    AstNode* left = condition->as.binary_op.left;
+    AstNode* right = condition->as.binary_op.right;
+    bool greater;
+    switch (condition->as.binary_op.operator) {
+        case TOKEN_GREATER:
+        case TOKEN_GREATER_EQUAL: greater = true; break;
+        case TOKEN_LESS:
+        case TOKEN_LESS_EQUAL: greater = false; break;
+        default: return NULL;
+    }
+    // `x > მ` და `მ < x` — მაქსიმუმი; `x < მ` და `მ > x` — მინიმუმი.
+    bool candidate_left = reads_variable(left, value->as.variable.name) && reads_variable(right, name);
+    if (!candidate_left && !(reads_variable(left, name) && reads_variable(right, value->as.variable.name))) return NULL;
+    if (!candidate_left) greater = !greater;
+    if (!is_int(right) || !is_int(left)) return NULL;
+    *target = name;
+    return greater ? "max" : "min";
+}
+
+/**
+ * @brief ამოიცნობს ჯამის რედუქციას `ს = ს + e`, `ს = e + ს`, `ს = ს - e`
+ * და მათ `+`/`-` ჯაჭვებს (`ს = ს + ი * 3 - 7`), სადაც ს დადებითი წევრია.
+ */
+static bool sum_reduction(AstNode* node) {
+    Symbol* name = node->as.assign.name;
+    if (!is_int(node->as.assign.value)) return false;
+    for (AstNode* term = node->as.assign.value; term->type == NODE_BINARY_OP; term = term->as.binary_op.left) {
+        TokenType op = term->as.binary_op.operator;
+        if (op != TOKEN_PLUS && op != TOKEN_MINUS) return false;
+        AstNode* left = term->as.binary_op.left;
+        AstNode* right = term->as.binary_op.right;
+        if (op == TOKEN_PLUS && reads_variable(right, name)) return is_int(right);
+        if (reads_variable(left, name)) return is_int(left);
+        if (!is_int(left)) return false;
+    }
+    return false;
+}
+
+static LoopVariable* loop_variable(LoopAnalysis* analysis, Symbol* name) {
+    for (int i = 0; i < analysis->count; i++) {
+        if (analysis->variables[i].name == name) return &analysis->variables[i];
+    }
+    if (analysis->count >= analysis->capacity) {
+        analysis->capacity = analysis->capacity < 8 ? 8 : analysis->capacity * 2;
+        LoopVariable* resized = realloc(analysis->variables, sizeof(LoopVariable) * (size_t)analysis->capacity);
+        if (!resized) {
+            fprintf(stderr, "FATAL: Memory allocation failed for loop analysis.\n");
+            exit(1);
+        }
+        analysis->variables = resized;
+    }
+    LoopVariable* variable = &analysis->variables[analysis->count++];
+    variable->name = name;
+    variable->role = LOOP_VARIABLE_NONE;
+    variable->operation = NULL;
+    variable->assignments = 0;
+    variable->reads = 0;
+    variable->type = TYPE_INT;
+    return variable;
+}
+
+bool analyze_loop(AstNode* node, AstStack* walk, bool nested_loops, LoopAnalysis* analysis) {
+    analysis->variables = NULL;
+    analysis->count = 0;
+    analysis->capacity = 0;
+    analysis->failure = NULL;
+    analysis->culprit = NULL;
+    AstNode* current;
+    ast_stack_push(walk, node->as.for_stmt.body);
+    while (ast_stack_next_postorder(walk, &current)) {
+        if (current == NULL || analysis->failure != NULL) continue;
+        ValueType type = (ValueType)current->value_type;
+        if (type == TYPE_STRING || type == TYPE_VALUE || type == TYPE_ARRAY) {
+            analysis->failure = "სტრიქონი, მასივი ან არარიცხვითი მნიშვნელობა";
+            continue;
+        }
+        switch (current->type) {
+            case NODE_CALL:
+                analysis->failure = "ფუნქციის გამოძახება";
+                break;
+            case NODE_PRINT_STMT:
+                analysis->failure = "ბეჭდვა";
+                break;
+            case NODE_RETURN:
+                analysis->failure = "'დაბრუნე'";
+                break;
+            case NODE_FUNCTION:
+                analysis->failure = "ფუნქციის განსაზღვრა";
+                break;
+            case NODE_WHILE:
+                if (!nested_loops) analysis->failure = "ჩადგმული ციკლი";
+                break;
+            case NODE_FOR:
+            case NODE_PARALLEL_FOR:
+                if (!nested_loops) analysis->failure = "ჩადგმული ციკლი";
+                else loop_variable(analysis, current->as.for_stmt.variable)->role = LOOP_VARIABLE_PRIVATE;
+                break;
+            case NODE_VARIABLE: {
+                LoopVariable* variable = loop_variable(analysis, current->as.variable.name);
+                variable->reads++;
+                variable->type = (ValueType)current->value_type;
+                break;
+            }
+            case NODE_VAR_DECL:
+                loop_variable(analysis, current->as.var_decl.name)->role = LOOP_VARIABLE_PRIVATE;
+                break;
+            case NODE_ASSIGN: {
+                LoopVariable* variable = loop_variable(analysis, current->as.assign.name);
+                variable->assignments++;
+                if (sum_reduction(current)) variable->operation = "+";
+                break;
+            }
+            case NODE_IF: {
+                Symbol* name;
+                const char* operation = extremum_reduction(current, &name);
+                if (operation != NULL) loop_variable(analysis, name)->operation = operation;
+                break;
+            }
+            default:
+                break;
+        }
+    }
+    // გავლა failure-ის შემდეგაც სრულდება, რომ სტეკი ცარიელი დარჩეს.
+    for (int i = 0; analysis->failure == NULL && i < analysis->count; i++) {
+        LoopVariable* variable = &analysis->variables[i];
+        if (variable->role == LOOP_VARIABLE_PRIVATE || variable->assignments == 0) continue;
+        // რედუქციის ცვლადი ზუსტად ერთხელ იკითხება — თავად რედუქციაში.
+        if (variable->operation == NULL || variable->assignments != 1 || variable->reads != 1) {
+            analysis->failure = "გარე ცვლადის ცვლილება რედუქციის გარეშე";
+            analysis->culprit = variable->name;
+        } else {
+            variable->role = LOOP_VARIABLE_REDUCTION;
+        }
+    }
+    return analysis->failure == NULL;
+}
+
+void free_loop_analysis(LoopAnalysis* analysis) {
+    free(analysis->variables);
+    analysis->variables = NULL;
+    analysis->count = 0;
+    analysis->capacity = 0;
+}
@@ -2,118 +2,743 @@
  * @file main.c
  * @author გიორგი მაღრაძე (magradze.giorgi@gmail.com)
  * @brief "მანუსკრიპტი" კომპილატორის მთავარი შესრულების წერტილი.
- * @version 0.5
+ * @version 0.12
  * @date 2024-05-21
  */
+#define _POSIX_C_SOURCE 200809L
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include "source.h"
 #include "lexer.h"
+#include "token_stream.h"
+#include "incremental.h"
 #include "parser.h"
+#include "type_infer.h"
+#include "optimizer.h"
 #include "codegen.h"
+#include "vm.h"
+#include "jit.h"
+#include "cache.h"
+#include "toolchain.h"
+#include "stats.h"
+
+#define MANUSCRIPT_VERSION "0.9.0"
+
+/**
+ * @brief ბრძანების ხაზის პარამეტრები.
+ */
+typedef struct {
+    const char** input_paths; // საწყისი .მს ფაილები (argv-ის ელემენტები)
+    int input_count;          // საწყისი ფაილების რაოდენობა
+    const char* output_dir;   // -o: პაკეტური კომპილაციის დირექტორია (პროგრამები არ ეშვება)
+    int jobs;                 // -j: ერთდროული კომპილაციები (ნაგულისხმევად ბირთვების რაოდენობა)
+    bool watch;               // --watch: ფაილის ცვლილებისას ინკრემენტული ხელახალი კომპილაცია
+    bool dump_tokens;         // --tokens: ტოკენების ნაკადის ბეჭდვა
+    bool dump_ast;            // --ast: ოპტიმიზირებული AST-ის ბეჭდვა
+    bool run_in_vm;           // --run: შესრულება ვირტუალურ მანქანაში, C კომპილატორის გარეშე
+    bool dump_bytecode;       // --bytecode: ბაიტკოდის ბეჭდვა --run რეჟიმში
+    bool run_jit;             // --jit: x86-64 მანქანურ კოდში კომპილაცია და შესრულება
+    bool no_optimize;         // --no-opt: AST-ის ოპტიმიზაციის გამორთვა
+    bool optimizer_stats;     // --opt-stats: ოპტიმიზაციის სტატისტიკის ბეჭდვა
+    bool pipe_to_cc;          // --pipe: C კოდი კომპილატორს pipe-ით გადაეცემა, ფაილის გარეშე
+    const char* cc;           // --cc: C კომპილატორი (ნაგულისხმევად $CC ან gcc)
+    BuildProfile profile;     // --profile: გენერირებული კოდის ოპტიმიზაციის პროფილი
+    const char* train_input;  // --train-input: PGO-ს სავარჯიშო გაშვების stdin
+    bool use_cache;           // --cache: კომპილირებული პროგრამების ქეში
+    const char* cache_dir;    // --cache-dir: ქეშის დირექტორია
+    uint64_t cache_size;      // --cache-size: ქეშის ზომის ლიმიტი ბაიტებში
+    bool gc_stats;            // --gc-stats: გენერირებული პროგრამის GC სტატისტიკა
+    int max_depth;            // --max-depth: გამოსახულების ჩადგმულობის ზღვარი
+    bool print_stats;         // --stats: ეტაპების სტატისტიკის ბეჭდვა
+    const char* stats_json;   // --stats-json: სტატისტიკის JSON ფაილი
+    CompileStats* stats;      // გაზომვების მიმღები (NULL, თუ სტატისტიკა გამორთულია)
+} Options;
 
 /**
  * @brief ბეჭდავს პროგრამის გამოყენების ინსტრუქციას.
  */
 void print_usage(const char* program_name) {
-    fprintf(stderr, "გამოყენება: %s <ფაილის_სახელი.მს>\n", program_name);
+    fprintf(stderr, "გამოყენება: %s [პარამეტრები] <ფაილის_სახელი.მს | ->\n", program_name);
+    fprintf(stderr, "           %s [პარამეტრები] -o <დირექტორია> <ფაილი.მს>...\n", program_name);
+    fprintf(stderr, "პარამეტრები:\n");
+    fprintf(stderr, "  --tokens    ტოკენების ნაკადის ბეჭდვა\n");
+    fprintf(stderr, "  --ast       ოპტიმიზირებული AST-ის ბეჭდვა\n");
+    fprintf(stderr, "  --run       შესრულება ვირტუალურ მანქანაში (C კომპილატორის გარეშე)\n");
+    fprintf(stderr, "  --bytecode  ბაიტკოდის ბეჭდვა (--run-თან ერთად)\n");
+    fprintf(stderr, "  --jit       x86-64 მანქანურ კოდში კომპილაცია და შესრულება\n");
+    fprintf(stderr, "  --no-opt    მუდმივების დაკეცვისა და გავრცელების გამორთვა\n");
+    fprintf(stderr, "  --opt-stats ოპტიმიზაციის სტატისტიკის ბეჭდვა (stderr-ზე)\n");
+    fprintf(stderr, "  --pipe      C კოდის გადაცემა კომპილატორისთვის pipe-ით (დროებითი C ფაილის გარეშე)\n");
+    fprintf(stderr, "  --cc <cmd>  C კომპილატორი (ნაგულისხმევად $CC, შემდეგ gcc)\n");
+    fprintf(stderr, "  --profile <debug|release|lto|pgo>  გენერირებული კოდის ოპტიმიზაცია (ნაგულისხმევად debug)\n");
+    fprintf(stderr, "  --train-input <file>  PGO-ს სავარჯიშო გაშვების სტანდარტული შესასვლელი\n");
+    fprintf(stderr, "  --cache     კომპილირებული პროგრამების ქეშის გამოყენება\n");
+    fprintf(stderr, "  --cache-dir <dir>   ქეშის დირექტორია (ნაგულისხმევად $MANUSCRIPT_CACHE_DIR ან ~/.cache/manuscript)\n");
+    fprintf(stderr, "  --cache-size <N[KMG]>  ქეშის ზომის ლიმიტი (ნაგულისხმევად $MANUSCRIPT_CACHE_SIZE ან 256M)\n");
+    fprintf(stderr, "  --gc-stats  პროგრამის დასრულებისას GC სტატისტიკის ბეჭდვა (stderr-ზე)\n");
+    fprintf(stderr, "  --stats     ეტაპების დროის, მოცულობისა და მეხსიერების სტატისტიკა (stderr-ზე)\n");
+    fprintf(stderr, "  --stats-json <file>  იგივე სტატისტიკა JSON ფაილში\n");
+    fprintf(stderr, "  --max-depth <N>  გამოსახულების ჩადგმულობის ზღვარი (ნაგულისხმევად %d)\n", PARSER_DEFAULT_MAX_DEPTH);
+    fprintf(stderr, "  --watch     ფაილის ყოველი ცვლილებისას ხელახლა კომპილაცია და გაშვება\n");
+    fprintf(stderr, "  -o <dir>    ყველა ფაილის კომპილაცია <dir>-ში გაშვების გარეშე (პაკეტური რეჟიმი)\n");
+    fprintf(stderr, "  -j <N>      პაკეტური რეჟიმის ერთდროული კომპილაციები (ნაგულისხმევად ბირთვების რაოდენობა)\n");
 }
 
 /**
- * @brief კითხულობს ფაილის სრულ შიგთავსს.
+ * @brief არჩევს ბრძანების ხაზის არგუმენტებს.
+ * @return bool false, თუ არგუმენტები არასწორია.
  */
-char* read_file_content(const char* filename) {
-    FILE* file = fopen(filename, "rb");
-    if (!file) {
-        perror("შეცდომა ფაილის გახსნისას");
-        return NULL;
+static bool parse_options(int argc, char* argv[], Options* options) {
+    memset(options, 0, sizeof(*options));
+    options->max_depth = PARSER_DEFAULT_MAX_DEPTH;
+    options->input_paths = malloc((size_t)argc * sizeof(const char*));
+    if (options->input_paths == NULL) {
+        fprintf(stderr, "FATAL: Memory allocation failed for options.\n");
+        exit(1);
     }
-
-    fseek(file, 0, SEEK_END);
-    long length = ftell(file);
-    fseek(file, 0, SEEK_SET);
-
-    char* buffer = (char*)malloc(length + 1);
-    if (!buffer) {
-        fprintf(stderr, "მეხსიერების გამოყოფის შეცდომა\n");
-        fclose(file);
-        return NULL;
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        if (strcmp(arg, "--tokens") == 0) {
+            options->dump_tokens = true;
+        } else if (strcmp(arg, "--ast") == 0) {
+            options->dump_ast = true;
+        } else if (strcmp(arg, "--stats") == 0) {
+            options->print_stats = true;
+        } else if (strcmp(arg, "--stats-json") == 0) {
+            if (i + 1 >= argc) {
+                fprintf(stderr, "--stats-json პარამეტრს ფაილი სჭირდება.\n");
+                return false;
+            }
+            options->stats_json = argv[++i];
+        } else if (strcmp(arg, "--run") == 0) {
+            options->run_in_vm = true;
+        } else if (strcmp(arg, "--bytecode") == 0) {
+            options->dump_bytecode = true;
+        } else if (strcmp(arg, "--jit") == 0) {
+            options->run_jit = true;
+        } else if (strcmp(arg, "--no-opt") == 0) {
+            options->no_optimize = true;
+        } else if (strcmp(arg, "--opt-stats") == 0) {
+            options->optimizer_stats = true;
+        } else if (strcmp(arg, "--gc-stats") == 0) {
+            options->gc_stats = true;
+        } else if (strcmp(arg, "--watch") == 0) {
+            options->watch = true;
+        } else if (strcmp(arg, "--pipe") == 0) {
+            options->pipe_to_cc = true;
+        } else if (strcmp(arg, "--cc") == 0) {
+            if (i + 1 >= argc) {
+                fprintf(stderr, "--cc პარამეტრს კომპილატორის სახელი სჭირდება.\n");
+                return false;
+            }
+            options->cc = argv[++i];
+        } else if (strcmp(arg, "--profile") == 0) {
+            if (i + 1 >= argc || !parse_build_profile(argv[i + 1], &options->profile)) {
+                fprintf(stderr, "--profile პარამეტრი უნდა იყოს debug, release, lto ან pgo.\n");
+                return false;
+            }
+            i++;
+        } else if (strcmp(arg, "--train-input") == 0) {
+            if (i + 1 >= argc) {
+                fprintf(stderr, "--train-input პარამეტრს ფაილი სჭირდება.\n");
+                return false;
+            }
+            options->train_input = argv[++i];
+        } else if (strcmp(arg, "--cache") == 0) {
+            options->use_cache = true;
+        } else if (strcmp(arg, "--cache-dir") == 0) {
+            if (i + 1 >= argc) {
+                fprintf(stderr, "--cache-dir პარამეტრს დირექტორია სჭირდება.\n");
+                return false;
+            }
+            options->cache_dir = argv[++i];
+            options->use_cache = true;
+        } else if (strcmp(arg, "--cache-size") == 0) {
+            options->cache_size = i + 1 < argc ? parse_cache_size(argv[++i]) : 0;
+            if (options->cache_size == 0) {
+                fprintf(stderr, "--cache-size პარამეტრს დადებითი ზომა სჭირდება (მაგ. 512M).\n");
+                return false;
+            }
+            options->use_cache = true;
+        } else if (strcmp(arg, "-o") == 0) {
+            if (i + 1 >= argc) {
+                fprintf(stderr, "-o პარამეტრს დირექტორია სჭირდება.\n");
+                return false;
+            }
+            options->output_dir = argv[++i];
+        } else if (strcmp(arg, "--max-depth") == 0) {
+            options->max_depth = i + 1 < argc ? atoi(argv[++i]) : 0;
+            if (options->max_depth <= 0) {
+                fprintf(stderr, "--max-depth პარამეტრს დადებითი რიცხვი სჭირდება.\n");
+                return false;
+            }
+        } else if (strcmp(arg, "-j") == 0) {
+            options->jobs = i + 1 < argc ? atoi(argv[++i]) : 0;
+            if (options->jobs <= 0) {
+                fprintf(stderr, "-j პარამეტრს დადებითი რიცხვი სჭირდება.\n");
+                return false;
+            }
+        } else if (arg[0] == '-' && arg[1] != '\0') {
+            fprintf(stderr, "უცნობი პარამეტრი: %s\n", arg);
+            return false;
+        } else {
+            options->input_paths[options->input_count++] = arg;
+        }
+    }
+    if (options->input_count == 0) return false;
+    if (options->input_count > 1 && options->output_dir == NULL) {
+        fprintf(stderr, "რამდენიმე ფაილის კომპილაციას -o დირექტორია სჭირდება.\n");
+        return false;
     }
+    if (options->output_dir != NULL && (options->run_in_vm || options->run_jit || options->use_cache)) {
+        fprintf(stderr, "--run, --jit და --cache პაკეტურ (-o) რეჟიმში არ გამოიყენება.\n");
+        return false;
+    }
+    if (options->watch && (options->output_dir != NULL || options->use_cache || strcmp(options->input_paths[0], "-") == 0)) {
+        fprintf(stderr, "--watch-ს ერთი ფაილი სჭირდება და -o-სთან და --cache-თან ერთად არ გამოიყენება.\n");
+        return false;
+    }
+    if ((options->print_stats || options->stats_json != NULL) && options->watch) {
+        fprintf(stderr, "--stats და --stats-json --watch რეჟიმში არ გამოიყენება.\n");
+        return false;
+    }
+    if (options->stats_json != NULL && options->output_dir != NULL) {
+        fprintf(stderr, "--stats-json პაკეტურ (-o) რეჟიმში არ გამოიყენება; გამოიყენეთ --stats.\n");
+        return false;
+    }
+    return true;
+}
 
-    if (fread(buffer, 1, (size_t)length, file) != (size_t)length) {
-        fprintf(stderr, "ფაილის წაკითხვის შეცდომა\n");
-        free(buffer);
-        fclose(file);
-        return NULL;
+/**
+ * @brief ბეჭდავს ტოკენების ნაკადს ხაზის ნომრებით.
+ */
+static void print_tokens(TokenStream* stream) {
+    printf("--- ლექსერის მიერ დაგენერირებული ტოკენები ---\n");
+    for (int i = 0; i < stream->count; i++) {
+        Token token = token_stream_get(stream, i);
+        printf("Line %-4d | %-20s | '%.*s'\n", token.line, token_type_name(token.type), token.length, token.start);
     }
+}
 
-    buffer[length] = '\0';
-    fclose(file);
-    return buffer;
+/**
+ * @brief აბრუნებს C კომპილატორის ბრძანებას: --cc, შემდეგ $CC, ბოლოს gcc.
+ */
+static const char* c_compiler(const Options* options) {
+    return options->cc != NULL ? options->cc : default_c_compiler();
 }
 
 /**
- * @brief აკომპილირებს და უშვებს გენერირებულ C კოდს.
+ * @brief უშვებს კომპილირებულ პროგრამას შედეგის ჩარჩოში.
  * @return int პროგრამის გამოსვლის კოდი. 0, თუ წარმატებით დასრულდა.
  */
-static int compile_and_run() {
-    int gcc_status = system("gcc build/output.c -o build/output_program");
-    if (gcc_status != 0) {
-        fprintf(stderr, "C კოდის კომპილაცია ვერ მოხერხდა.\n");
+static int run_program(const char* path, CompileStats* stats) {
+    char command[4096];
+    if (!shell_quote(command, sizeof(command), path)) {
+        fprintf(stderr, "პროგრამის ბილიკი ძალიან გრძელია: %s\n", path);
         return 1;
     }
 
     printf("\n--- პროგრამის შესრულების შედეგი ---\n");
-    int run_status = system("./build/output_program");
+    fflush(stdout);
+    StatsMark start = stats_mark(stats);
+    int run_status = system(command);
+    stats_record(stats, STATS_PHASE_RUN, start);
     printf("----------------------------------\n");
 
-    return run_status;
+    // system()-ის სტატუსი (მაგ. 256) პირდაპირ exit-ს ვერ გადაეცემა: 256 & 0xFF == 0.
+    return run_status == 0 ? 0 : 1;
 }
 
 /**
- * @brief პროგრამის მთავარი ფუნქცია.
+ * @brief აწყობს ქეშის გასაღების კონფიგურაციას: ყველაფერს წყაროს გარდა,
+ * რაც გენერირებულ ბინარზე მოქმედებს. აწყობის დრო მანუსკრიპტის ყოველ
+ * ახალ აწყობაზე ქეშს აუქმებს, რადგან კოდის გენერატორი შეიძლება შეიცვალა.
  */
-int main(int argc, char* argv[]) {
-    if (argc != 2) {
-        print_usage(argv[0]);
+static void format_cache_config(char* config, size_t size, const Options* options) {
+    // runtime ბინარში სტატიკურად ილინკება, ამიტომ მისი ცვლილება ქეშს აუქმებს.
+    RuntimePaths runtime;
+    struct stat info;
+    long long runtime_size = -1, runtime_mtime = -1;
+    if (locate_runtime(&runtime) && stat(runtime.library, &info) == 0) {
+        runtime_size = (long long)info.st_size;
+        runtime_mtime = (long long)info.st_mtim.tv_sec * 1000000000LL + info.st_mtim.tv_nsec;
+    }
+    snprintf(config, size, "manuscript %s (%s %s)\ncc=%s\nprofile=%s %s\noptimize=%d\nruntime=%lld:%lld\n",
+             MANUSCRIPT_VERSION, __DATE__, __TIME__, c_compiler(options), build_profile_name(options->profile),
+             build_profile_flags(options->profile), !options->no_optimize, runtime_size, runtime_mtime);
+}
+
+/** @brief ავსებს C ტულჩეინის პარამეტრებს; შუალედური ფაილები `work_dir`-ში იწერება. */
+static void init_toolchain_options(ToolchainOptions* toolchain, const Options* options, const char* work_dir) {
+    toolchain->compiler = c_compiler(options);
+    toolchain->profile = options->profile;
+    toolchain->use_pipe = options->pipe_to_cc;
+    toolchain->work_dir = work_dir;
+    toolchain->training_input = options->train_input;
+    toolchain->stats = options->stats;
+}
+
+/**
+ * @brief ასრულებს პროგრამას C ბექენდით: აგენერირებს C კოდს, აკომპილირებს და უშვებს.
+ * ყოველი კომპილაცია საკუთარ დროებით დირექტორიაში მიმდინარეობს. ქეშის
+ * გამოყენებისას ბინარი ჯერ დროებით ფაილში იწერება და შემდეგ ქეშში
+ * ატომურად თავსდება.
+ * @return int პროგრამის გამოსვლის კოდი. 0, თუ წარმატებით დასრულდა.
+ */
+static int run_with_c_backend(AstNode* ast, const Options* options, CompileCache* cache, const char* cache_key) {
+    char work_dir[4096], output[4096];
+    if (!create_work_dir(work_dir, sizeof(work_dir))) return 1;
+    bool ok = cache != NULL ? cache_temp_path(cache, output, sizeof(output))
+                            : snprintf(output, sizeof(output), "%s/program", work_dir) < (int)sizeof(output);
+
+    ToolchainOptions toolchain;
+    init_toolchain_options(&toolchain, options, work_dir);
+    if (ok && !build_c_program(ast, &toolchain, output)) {
+        fprintf(stderr, "C კოდის კომპილაცია ვერ მოხერხდა.\n");
+        if (cache != NULL) unlink(output);
+        ok = false;
+    }
+
+    if (ok && cache != NULL) {
+        char temp[sizeof(output)];
+        memcpy(temp, output, sizeof(output));
+        ok = cache_store(cache, cache_key, temp, output, sizeof(output));
+    }
+    int result = ok ? run_program(output, options->stats) : 1;
+    remove_work_dir(work_dir);
+    return result;
+}
+
+/**
+ * @brief ასრულებს პროგრამას იმავე პროცესში ბაიტკოდის ვირტუალური მანქანით.
+ */
+static int run_in_vm(AstNode* ast, AstContext* ast_context, const Options* options) {
+    Chunk chunk;
+    StatsMark start = stats_mark(options->stats);
+    bool compiled = compile_bytecode(ast, ast_context, &chunk);
+    stats_record(options->stats, STATS_PHASE_CODEGEN, start);
+    if (!compiled) {
+        free_chunk(&chunk);
         return 1;
     }
+    if (options->dump_bytecode) disassemble_chunk(&chunk);
+    start = stats_mark(options->stats);
+    int result = run_bytecode(&chunk);
+    stats_record(options->stats, STATS_PHASE_RUN, start);
+    free_chunk(&chunk);
+    return result;
+}
 
-    char* source_code = read_file_content(argv[1]);
-    if (!source_code) return 1;
+/**
+ * @brief აკომპილირებს პროგრამას x86-64 მანქანურ კოდში და ასრულებს იმავე პროცესში.
+ */
+static int run_jit(AstNode* ast, AstContext* ast_context, CompileStats* stats) {
+    JitProgram jit;
+    StatsMark start = stats_mark(stats);
+    bool compiled = jit_compile(ast, ast_context, &jit);
+    stats_record(stats, STATS_PHASE_CODEGEN, start);
+    if (!compiled) return 1;
+    start = stats_mark(stats);
+    int result = jit_run(&jit);
+    stats_record(stats, STATS_PHASE_RUN, start);
+    jit_free(&jit);
+    return result;
+}
 
-    Lexer lexer;
-    init_lexer(&lexer, source_code);
+/**
+ * @brief ტიპების გამოყვანა და ოპტიმიზაცია; ორივე ყველა ბექენდისთვის საერთოა.
+ * ტიპები ოპტიმიზაციამდე გამოიყვანება, რომ დაკეცილმა მუდმივებმა ისინი
+ * შეინარჩუნონ. საწყისი ხე არ იცვლება (value_type-ის გარდა).
+ * @return AstNode* ოპტიმიზირებული პროგრამა. NULL სახელების შეცდომისას.
+ */
+static AstNode* analyze_program(AstNode* ast, AstContext* ast_context, const Options* options) {
+    CompileStats* stats = options->stats;
+    StatsMark start = stats_mark(stats);
+    if (!infer_types(ast, ast_context)) {
+        fprintf(stderr, "სემანტიკური შეცდომების გამო კომპილაცია ჩაიშალა.\n");
+        return NULL;
+    }
+    if (!options->no_optimize) {
+        OptimizerStats optimizer_stats;
+        ast = optimize_program(ast, ast_context, &optimizer_stats);
+        stats_record(stats, STATS_PHASE_ANALYZE, start);
+        if (options->optimizer_stats) print_optimizer_stats(&optimizer_stats, stderr);
+        if (stats != NULL) {
+            stats->nodes = optimizer_stats.nodes_before;
+            stats->nodes_optimized = optimizer_stats.nodes_after;
+        }
+    } else if (stats != NULL) {
+        stats_record(stats, STATS_PHASE_ANALYZE, start);
+        stats->nodes = stats->nodes_optimized = ast_count_nodes(ast);
+    }
+    if (stats != NULL) {
+        stats->arena_bytes = ast_context->arena.bytes_allocated;
+        stats->arena_reserved = ast_context->arena.bytes_reserved;
+    }
+    return ast;
+}
+
+/** @brief ასრულებს პროგრამას არჩეული ბექენდით. */
+static int run_backend(AstNode* ast, AstContext* ast_context, const Options* options, CompileCache* cache,
+                       const char* cache_key) {
+    if (options->dump_ast) print_ast(ast);
+    if (options->run_jit) return run_jit(ast, ast_context, options->stats);
+    if (options->run_in_vm) return run_in_vm(ast, ast_context, options);
+    return run_with_c_backend(ast, options, cache, cache_key);
+}
+
+/**
+ * @brief საერთო წინა ნაწილი: ლექსირება, პარსინგი, ტიპების გამოყვანა და ოპტიმიზაცია.
+ * `tokens` ყოველთვის ივსება და გამომძახებელმა უნდა გაათავისუფლოს.
+ * @return AstNode* ოპტიმიზირებული პროგრამა. NULL სინტაქსური ან სემანტიკური შეცდომისას.
+ */
+static AstNode* analyze_source(const SourceFile* source, TokenStream* tokens, AstContext* ast_context,
+                               const Options* options) {
+    CompileStats* stats = options->stats;
+    // მთელ ფაილს ერთ გავლაში ვშლით ტოკენებად; პარსერი ნაკადს ინდექსით კითხულობს.
+    StatsMark start = stats_mark(stats);
+    lex_all(tokens, source->data, source->length);
+    stats_record(stats, STATS_PHASE_LEX, start);
+    if (stats != NULL) {
+        stats->source_bytes = source->length;
+        stats->tokens = tokens->count;
+        stats->token_bytes = (size_t)tokens->capacity * (sizeof(*tokens->types) + sizeof(*tokens->offsets) +
+                                                         sizeof(*tokens->lengths));
+    }
+    if (options->dump_tokens) print_tokens(tokens);
 
     Parser parser;
-    init_parser(&parser, &lexer);
+    init_parser_from_stream(&parser, tokens, ast_context);
+    parser.max_depth = options->max_depth;
 
+    start = stats_mark(stats);
     AstNode* ast = parse(&parser);
+    stats_record(stats, STATS_PHASE_PARSE, start);
 
     if (parser.had_error) {
         fprintf(stderr, "პარსინგის შეცდომების გამო კომპილაცია ჩაიშალა.\n");
-        free_ast(ast);
-        free(source_code);
+        return NULL;
+    }
+    return analyze_program(ast, ast_context, options);
+}
+
+/** @brief ბეჭდავს (--stats) და/ან ფაილში წერს (--stats-json) შეგროვებულ სტატისტიკას. */
+static void report_stats(const Options* options) {
+    if (options->stats == NULL) return;
+    fflush(stdout);
+    if (options->print_stats) print_compile_stats(options->stats, stderr);
+    if (options->stats_json != NULL) write_compile_stats_json(options->stats);
+}
+
+/**
+ * @brief აკომპილირებს ერთ ფაილს შესრულებად `output`-ად გაშვების გარეშე.
+ * @return int 0 წარმატებისას, 1 შეცდომისას (შეტყობინება დაბეჭდილია).
+ */
+static int compile_file(const char* input, const char* output, const Options* options) {
+    // პაკეტურ რეჟიმში ყოველი ფაილი საკუთარ პროცესშია, ამიტომ სტატისტიკაც ცალკეა.
+    if (options->stats != NULL) init_compile_stats(options->stats, NULL);
+    SourceFile source;
+    if (!load_source(&source, input)) return 1;
+
+    TokenStream tokens;
+    AstContext ast_context;
+    init_ast_context(&ast_context);
+    AstNode* ast = analyze_source(&source, &tokens, &ast_context, options);
+
+    bool ok = false;
+    char work_dir[4096];
+    if (ast != NULL && create_work_dir(work_dir, sizeof(work_dir))) {
+        ToolchainOptions toolchain;
+        init_toolchain_options(&toolchain, options, work_dir);
+        ok = build_c_program(ast, &toolchain, output);
+        remove_work_dir(work_dir);
+    }
+    report_stats(options);
+
+    free_ast_context(&ast_context);
+    free_token_stream(&tokens);
+    free_source(&source);
+    return ok ? 0 : 1;
+}
+
+/** @brief პაკეტური რეჟიმის მიმდინარე კომპილაცია (შვილობილი პროცესი). */
+typedef struct {
+    pid_t pid;     // პროცესის იდენტიფიკატორი (0 — თავისუფალი სლოტი)
+    int index;     // ფაილის ინდექსი options->input_paths-ში
+    FILE* log;     // პროცესის stdout/stderr, რომელიც დასრულებისას ერთიანად იბეჭდება
+} BatchJob;
+
+/**
+ * @brief წერს `<dir>/<სახელი გაფართოების გარეშე>`-ს `output`-ში.
+ * @return bool false, თუ ბილიკი ბუფერში არ ეტევა.
+ */
+static bool batch_output_path(char* output, size_t size, const char* dir, const char* input) {
+    const char* name = strrchr(input, '/');
+    name = name != NULL ? name + 1 : input;
+    const char* dot = strrchr(name, '.');
+    int length = dot != NULL && dot != name ? (int)(dot - name) : (int)strlen(name);
+    int written = snprintf(output, size, "%s/%.*s", dir, length, name);
+    return written > 0 && (size_t)written < size;
+}
+
+/**
+ * @brief ბეჭდავს დასრულებული კომპილაციის შეტყობინებებს; ყოველ ხაზს ფაილის
+ * სახელი ერთვის, რომ პარალელური კომპილაციების შეცდომები არ აირიოს.
+ * @return bool true, თუ კომპილაცია წარმატებით დასრულდა.
+ */
+static bool report_batch_job(BatchJob* job, int status, const Options* options, const char* output) {
+    const char* input = options->input_paths[job->index];
+    char* line = NULL;
+    size_t capacity = 0;
+    rewind(job->log);
+    while (getline(&line, &capacity, job->log) != -1) fprintf(stderr, "%s: %s", input, line);
+    free(line);
+    fclose(job->log);
+    job->pid = 0;
+
+    if (WIFEXITED(status) && WEXITSTATUS(status) == 0) {
+        printf("%s -> %s\n", input, output);
+        return true;
+    }
+    if (WIFSIGNALED(status)) {
+        fprintf(stderr, "%s: კომპილაცია შეწყდა სიგნალით %d.\n", input, WTERMSIG(status));
+    } else {
+        fprintf(stderr, "%s: კომპილაცია ვერ მოხერხდა.\n", input);
+    }
+    return false;
+}
+
+/**
+ * @brief პაკეტური კომპილაცია: ყოველი ფაილი ცალკე პროცესში კომპილირდება,
+ * ერთდროულად არაუმეტეს `jobs` ცალი. პროცესები ერთმანეთისგან იზოლირებულია —
+ * ერთის ავარია ან შეცდომა დანარჩენებზე არ მოქმედებს.
+ * @return int 0, თუ ყველა ფაილი აიწყო; 1 — თუ ერთი მაინც ჩაიშალა.
+ */
+static int compile_batch(const Options* options) {
+    if (mkdir(options->output_dir, 0755) != 0 && errno != EEXIST) {
+        fprintf(stderr, "დირექტორიის შექმნა ვერ მოხერხდა: %s: %s\n", options->output_dir, strerror(errno));
+        return 1;
+    }
+
+    int count = options->input_count;
+    char (*outputs)[4096] = malloc((size_t)count * sizeof(*outputs));
+    if (outputs == NULL) {
+        fprintf(stderr, "FATAL: Memory allocation failed for batch outputs.\n");
+        exit(1);
+    }
+    for (int i = 0; i < count; i++) {
+        const char* input = options->input_paths[i];
+        if (strcmp(input, "-") == 0 || !batch_output_path(outputs[i], sizeof(outputs[i]), options->output_dir, input)) {
+            fprintf(stderr, "%s: პაკეტურ რეჟიმში ფაილის სახელი აუცილებელია.\n", input);
+            free(outputs);
+            return 1;
+        }
+        for (int j = 0; j < i; j++) {
+            if (strcmp(outputs[i], outputs[j]) == 0) {
+                fprintf(stderr, "%s და %s ერთსა და იმავე ფაილში (%s) კომპილირდება.\n",
+                        options->input_paths[j], input, outputs[i]);
+                free(outputs);
+                return 1;
+            }
+        }
+    }
+
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    int jobs = options->jobs > 0 ? options->jobs : (cores > 0 ? (int)cores : 1);
+    if (jobs > count) jobs = count;
+    BatchJob* running = calloc((size_t)jobs, sizeof(BatchJob));
+    if (running == NULL) {
+        fprintf(stderr, "FATAL: Memory allocation failed for batch jobs.\n");
+        exit(1);
+    }
+
+    int next = 0, active = 0, failed = 0;
+    while (next < count || active > 0) {
+        for (int slot = 0; slot < jobs && next < count; slot++) {
+            if (running[slot].pid != 0) continue;
+            BatchJob* job = &running[slot];
+            job->index = next++;
+            job->log = tmpfile();
+            fflush(stdout);
+            fflush(stderr);
+            job->pid = job->log != NULL ? fork() : -1;
+            if (job->pid == 0) {
+                dup2(fileno(job->log), STDOUT_FILENO);
+                dup2(fileno(job->log), STDERR_FILENO);
+                int status = compile_file(options->input_paths[job->index], outputs[job->index], options);
+                fflush(stdout);
+                _exit(status);
+            }
+            if (job->pid < 0) {
+                fprintf(stderr, "%s: კომპილაციის პროცესის გაშვება ვერ მოხერხდა: %s\n",
+                        options->input_paths[job->index], strerror(errno));
+                if (job->log != NULL) fclose(job->log);
+                job->pid = 0;
+                failed++;
+                continue;
+            }
+            active++;
+        }
+        if (active == 0) continue;
+
+        int status;
+        pid_t pid = wait(&status);
+        if (pid < 0) {
+            if (errno == EINTR) continue;
+            perror("wait");
+            break;
+        }
+        for (int slot = 0; slot < jobs; slot++) {
+            if (running[slot].pid != pid) continue;
+            int index = running[slot].index;
+            if (!report_batch_job(&running[slot], status, options, outputs[index])) failed++;
+            active--;
+            break;
+        }
+    }
+
+    if (failed > 0) fprintf(stderr, "%d ფაილიდან %d ვერ აიწყო.\n", count, failed);
+    free(running);
+    free(outputs);
+    return failed > 0 ? 1 : 0;
+}
+
+/** @brief ადარებს ფაილის ზომასა და შეცვლის დროს; false — თუ ფაილი ვერ წავიკითხეთ. */
+static bool file_changed(const char* path, struct stat* last) {
+    struct stat info;
+    if (stat(path, &info) != 0) return false;
+    bool changed = info.st_size != last->st_size || info.st_mtim.tv_sec != last->st_mtim.tv_sec ||
+                   info.st_mtim.tv_nsec != last->st_mtim.tv_nsec;
+    *last = info;
+    return changed;
+}
+
+/** @brief აკომპილირებს და უშვებს დოკუმენტის მიმდინარე ხეს. */
+static int run_document(SourceDocument* document, const Options* options) {
+    if (document->had_error) {
+        fprintf(stderr, "პარსინგის შეცდომების გამო კომპილაცია ჩაიშალა.\n");
         return 1;
     }
+    AstNode* ast = analyze_program(document->program, &document->ast, options);
+    if (ast == NULL) return 1;
+    return run_backend(ast, &document->ast, options, NULL, NULL);
+}
 
-    print_ast(ast);
+/**
+ * @brief --watch რეჟიმი: ფაილის ყოველი ცვლილებისას ტექსტი ხელახლა
+ * იკითხება და დოკუმენტი ინკრემენტულად ახლდება — უცვლელი განცხადებების
+ * ტოკენები და კვანძები ხელახლა გამოიყენება. სრულდება Ctrl+C-ით.
+ */
+static int watch_file(const Options* options) {
+    const char* path = options->input_paths[0];
+    struct stat last;
+    SourceFile source;
+    if (stat(path, &last) != 0 || !load_source(&source, path)) {
+        fprintf(stderr, "ფაილის წაკითხვა ვერ მოხერხდა: %s\n", path);
+        return 1;
+    }
+    SourceDocument document;
+    DocumentStats stats;
+    init_document(&document, source.data, source.length, options->max_depth, &stats);
+    free_source(&source);
+
+    const struct timespec interval = { 0, 200 * 1000000L };
+    for (;;) {
+        fprintf(stderr, "--- %s: ხელახლა დასკანერდა %d/%d ტოკენი, ხელახლა გაირჩა %d/%d განცხადება%s ---\n", path,
+                stats.tokens_relexed, stats.token_count, stats.statements_reparsed, stats.statement_count,
+                stats.full_rebuild ? " (სრული)" : "");
+        run_document(&document, options);
+        fflush(stdout);
+
+        while (!file_changed(path, &last)) nanosleep(&interval, NULL);
+        if (!load_source(&source, path)) continue;
+        replace_document_text(&document, source.data, source.length, &stats);
+        free_source(&source);
+    }
+}
 
-    FILE* outfile = fopen("build/output.c", "w");
-    if (outfile == NULL) {
-        fprintf(stderr, "დროებითი C ფაილის შექმნა ვერ მოხერხდა.\n");
-        free_ast(ast);
-        free(source_code);
+/**
+ * @brief პროგრამის მთავარი ფუნქცია.
+ */
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parse_options(argc, argv, &options)) {
+        print_usage(argv[0]);
         return 1;
     }
 
-    generate_code(ast, outfile);
-    fclose(outfile);
+    // runtime სტატისტიკას გარემოს ცვლადით კითხულობს (ქეშირებული ბინარიც).
+    if (options.gc_stats) setenv("MANUSCRIPT_GC_STATS", "1", 1);
+
+    CompileStats stats;
+    if (options.print_stats || options.stats_json != NULL) {
+        init_compile_stats(&stats, options.stats_json);
+        options.stats = &stats;
+    }
+
+    if (options.output_dir != NULL) {
+        int result = compile_batch(&options);
+        free(options.input_paths);
+        return result;
+    }
+    if (options.watch) return watch_file(&options);
+
+    // ფაილი მეხსიერებაში აისახება; ტოკენები პირდაპირ ასახვაზე მიუთითებს.
+    SourceFile source;
+    if (!load_source(&source, options.input_paths[0])) return 1;
 
-    int result = compile_and_run();
+    // ქეშში მოხვედრისას ლექსერი, პარსერი, კოდის გენერატორი და C კომპილატორი
+    // საერთოდ არ ეშვება — პირდაპირ ქეშირებული ბინარი სრულდება.
+    CompileCache cache;
+    char cache_key[CACHE_KEY_SIZE];
+    bool use_cache = options.use_cache && !options.run_jit && !options.run_in_vm;
+    if (use_cache) {
+        if (!init_compile_cache(&cache, options.cache_dir, options.cache_size)) {
+            free_source(&source);
+            return 1;
+        }
+        char config[4096];
+        format_cache_config(config, sizeof(config), &options);
+        compute_cache_key(cache_key, source.data, source.length, config);
 
-    free_ast(ast);
-    free(source_code);
+        char cached[4096];
+        if (cache_lookup(&cache, cache_key, cached, sizeof(cached))) {
+            if (options.stats != NULL) options.stats->source_bytes = source.length;
+            int result = run_program(cached, options.stats);
+            report_stats(&options);
+            free_compile_cache(&cache);
+            free_source(&source);
+            return result;
+        }
+    }
+
+    TokenStream tokens;
+    AstContext ast_context;
+    init_ast_context(&ast_context);
+    AstNode* ast = analyze_source(&source, &tokens, &ast_context, &options);
+
+    if (ast == NULL) {
+        report_stats(&options);
+        if (use_cache) free_compile_cache(&cache);
+        free_ast_context(&ast_context);
+        free_token_stream(&tokens);
+        free_source(&source);
+        return 1;
+    }
+
+    int result = run_backend(ast, &ast_context, &options, use_cache ? &cache : NULL, cache_key);
+    report_stats(&options);
+
+    if (use_cache) free_compile_cache(&cache);
+    free_ast_context(&ast_context);
+    free_token_stream(&tokens);
+    free_source(&source);
 
     return result;
-}
\ No newline at end of file
+}
@@ -0,0 +1,568 @@
+/**
+ * @file optimizer.c
+ * @author გიორგი მაღრაძე (magradze.giorgi@gmail.com)
+ * @brief AST-ის ოპტიმიზატორის იმპლემენტაცია.
+ * @version 0.11
+ *
+ * ხე ერთხელ, ქვემოდან ზემოთ (ცხადი სტეკით, პოსტ-ორდერში) გაივლება: ყოველ
+ * კვანძზე ჯერ შვილები ოპტიმიზირდება, შემდეგ კი თანმიმდევრობით მოწმდება გავრცელება, დაკეცვა
+ * და გამარტივება. ასე გავრცელებული მუდმივა იმავე გავლაში იკეცება.
+ *
+ * გამარტივების წესები მხოლოდ ის იგივეობებია, რომლებიც IEEE-754-ში ზუსტია
+ * ყველა მნიშვნელობისთვის (−0.0, ∞ და NaN-ის ჩათვლით). მაგალითად, `x + 0`
+ * აქ არ მარტივდება, რადგან `-0.0 + 0.0` არის `+0.0`; სამაგიეროდ `x + (-0.0)`
+ * და `x - 0` ზუსტად `x`-ია.
+ *
+ * ახალი კვანძები საწყისის value_type-ს იღებენ, ამიტომ ოპტიმიზაცია
+ * გამოსავლის ფორმატს (მთელი თუ ათწილადი) არ ცვლის.
+ *
+ * მუდმივა მხოლოდ იმ ცვლადიდან ვრცელდება, რომელსაც პროგრამაში არსად
+ * ენიჭება ახალი მნიშვნელობა. მუდმივი პირობის `თუ` შტო და მცდარი
+ * პირობის `სანამ` ციკლი და ცარიელი მუდმივი დიაპაზონის `ყოველი` მთლიანად
+ * იშლება. ფუნქციის სხეული პროგრამის
+ * მუდმივებს ვერ ხედავს (ის მხოლოდ საკუთარ ცვლადებს ხედავს), ამიტომ
+ * სხეულის ოპტიმიზაციისას ცნობილი მუდმივების სია ცარიელია.
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "optimizer.h"
+
+/** @brief ოპტიმიზატორის მდგომარეობა. */
+typedef struct {
+    AstContext* ctx;
+    bool* is_constant;     // is_constant[id] — ცვლადის მნიშვნელობა ცნობილია კომპილაციისას
+    bool* assigned;        // assigned[id] — ცვლადს სადმე ახალი მნიშვნელობა ენიჭება
+    double* values;        // values[id] — ცვლადის მუდმივი მნიშვნელობა
+    OptimizerStats* stats;
+    AstStack walk;         // გამოსახულებების გავლის სტეკი
+    AstNode** results;     // გავლილი ქვეხეების ოპტიმიზირებული ვერსიები
+    int result_count;
+    int result_capacity;
+} Optimizer;
+
+static const char* pass_names[OPT_PASS_COUNT] = {
+    [OPT_PASS_PROPAGATE] = "მუდმივების გავრცელება",
+    [OPT_PASS_FOLD] = "მუდმივების დაკეცვა",
+    [OPT_PASS_SIMPLIFY] = "ალგებრული გამარტივება",
+};
+
+const char* optimizer_pass_name(OptimizerPass pass) {
+    return pass >= 0 && pass < OPT_PASS_COUNT ? pass_names[pass] : "?";
+}
+
+/** @brief ქმნის მუდმივას, რომელიც ჩანაცვლებული გამოსახულების ტიპს ინარჩუნებს. */
+static AstNode* typed_number(Optimizer* opt, double value, AstNode* original) {
+    AstNode* node = create_number_node(opt->ctx, value);
+    node->value_type = original->value_type;
+    node->wide = original->wide;
+    return node;
+}
+
+/** @brief ინარჩუნებს ტიპს ხელახლა აგებულ კვანძზე. */
+static AstNode* with_type(AstNode* node, AstNode* original) {
+    node->value_type = original->value_type;
+    node->wide = original->wide;
+    return node;
+}
+
+/** @brief იგივეობები მხოლოდ რიცხვით ტიპებზეა სწორი: MsValue ოპერაციამ შეიძლება ტიპის შეცდომა გამოიწვიოს. */
+static bool is_numeric(AstNode* node) {
+    return node->value_type == TYPE_INT || node->value_type == TYPE_NUMBER;
+}
+
+/** @brief ქმნის ორი სტრიქონული ლიტერალის შეერთების კვანძს. */
+static AstNode* concat_strings(Optimizer* opt, AstNode* left, AstNode* right) {
+    int length = left->as.string.length + right->as.string.length;
+    char* joined = malloc((size_t)length + 1);
+    if (!joined) {
+        fprintf(stderr, "FATAL: Memory allocation failed for optimizer.\n");
+        exit(1);
+    }
+    memcpy(joined, left->as.string.chars, (size_t)left->as.string.length);
+    memcpy(joined + left->as.string.length, right->as.string.chars, (size_t)right->as.string.length);
+    AstNode* node = create_string_node(opt->ctx, joined, length);
+    free(joined);
+    return node;
+}
+
+static bool is_number(AstNode* node, double value) {
+    return node->type == NODE_NUMBER && node->as.number.value == value &&
+           signbit(node->as.number.value) == signbit(value);
+}
+
+/** @brief ითვლის ორობით ოპერაციას ორ მუდმივაზე; false — თუ ოპერატორი უცნობია. */
+static bool fold_binary(TokenType op, double left, double right, double* result) {
+    switch (op) {
+        case TOKEN_PLUS: *result = left + right; return true;
+        case TOKEN_MINUS: *result = left - right; return true;
+        case TOKEN_STAR: *result = left * right; return true;
+        case TOKEN_SLASH: *result = left / right; return true;
+        default: return false;
+    }
+}
+
+/** @brief ადარებს ორ მუდმივას; false — თუ ოპერატორი შედარება არ არის. */
+static bool fold_comparison(TokenType op, double left, double right, bool* result) {
+    switch (op) {
+        case TOKEN_EQUAL_EQUAL: *result = left == right; return true;
+        case TOKEN_BANG_EQUAL: *result = left != right; return true;
+        case TOKEN_LESS: *result = left < right; return true;
+        case TOKEN_LESS_EQUAL: *result = left <= right; return true;
+        case TOKEN_GREATER: *result = left > right; return true;
+        case TOKEN_GREATER_EQUAL: *result = left >= right; return true;
+        default: return false;
+    }
+}
+
+/** @brief ლიტერალის ჭეშმარიტობა (runtime-ის ms_truthy-ის მსგავსად); false — თუ კვანძი ლიტერალი არ არის. */
+static bool constant_truth(AstNode* node, bool* truth) {
+    switch (node->type) {
+        case NODE_NUMBER: *truth = node->as.number.value != 0.0; return true;
+        case NODE_BOOLEAN: *truth = node->as.boolean.value; return true;
+        case NODE_NONE: *truth = false; return true;
+        case NODE_STRING: *truth = node->as.string.length > 0; return true;
+        default: return false;
+    }
+}
+
+/** @brief ქმნის ლოგიკურ მუდმივას, რომელიც ჩანაცვლებული გამოსახულების ტიპს ინარჩუნებს. */
+static AstNode* typed_boolean(Optimizer* opt, bool value, AstNode* original) {
+    return with_type(create_boolean_node(opt->ctx, value), original);
+}
+
+/**
+ * @brief ამარტივებს `და`/`ან`-ს, როცა მარცხენა ოპერანდი ლიტერალია: ის
+ * შედეგს ან წყვეტს (მარჯვენა მაშინ არც გამოითვლება), ან მარჯვენა ლოგიკური
+ * ოპერანდი თავადაა შედეგი.
+ * @return AstNode* გამარტივებული კვანძი ან NULL.
+ */
+static AstNode* simplify_logical(Optimizer* opt, AstNode* node, AstNode* left, AstNode* right) {
+    bool truth;
+    if (!constant_truth(left, &truth)) return NULL;
+    bool is_and = node->as.binary_op.operator == TOKEN_და;
+    if (truth != is_and) return typed_boolean(opt, truth, node);
+    return right->value_type == TYPE_BOOL ? right : NULL;
+}
+
+/**
+ * @brief ამარტივებს ორობით ოპერაციას, რომლის ერთ-ერთი ოპერანდი ნეიტრალური ელემენტია.
+ * @return AstNode* დარჩენილი ოპერანდი ან NULL, თუ იგივეობა არ მოიძებნა.
+ */
+static AstNode* simplify_binary(TokenType op, AstNode* left, AstNode* right) {
+    switch (op) {
+        case TOKEN_STAR:
+            if (is_number(right, 1.0)) return left;
+            if (is_number(left, 1.0)) return right;
+            return NULL;
+        case TOKEN_SLASH:
+            return is_number(right, 1.0) ? left : NULL;
+        case TOKEN_MINUS:
+            return is_number(right, 0.0) ? left : NULL;
+        case TOKEN_PLUS:
+            if (is_number(right, -0.0)) return left;
+            if (is_number(left, -0.0)) return right;
+            return NULL;
+        default:
+            return NULL;
+    }
+}
+
+/** @brief ამატებს ოპტიმიზირებულ ქვეხეს შედეგების სტეკზე. */
+static void push_result(Optimizer* opt, AstNode* node) {
+    if (opt->result_count >= opt->result_capacity) {
+        opt->result_capacity = opt->result_capacity < 64 ? 64 : opt->result_capacity * 2;
+        AstNode** results = realloc(opt->results, sizeof(AstNode*) * (size_t)opt->result_capacity);
+        if (!results) {
+            fprintf(stderr, "FATAL: Memory allocation failed for optimizer.\n");
+            exit(1);
+        }
+        opt->results = results;
+    }
+    opt->results[opt->result_count++] = node;
+}
+
+/**
+ * @brief იღებს შედეგების სტეკიდან სიის (არგუმენტები, ელემენტები) `count` ქვეხეს.
+ * @return AstNode** ახალი სია არენაში ან NULL, თუ არც ერთი ქვეხე არ შეცვლილა.
+ */
+static AstNode** pop_list(Optimizer* opt, AstNode** original, int count) {
+    opt->result_count -= count;
+    AstNode** items = &opt->results[opt->result_count];
+    bool changed = false;
+    for (int i = 0; i < count; i++) {
+        if (items[i] != original[i]) changed = true;
+    }
+    if (!changed) return NULL;
+    AstNode** copy = arena_alloc(&opt->ctx->arena, sizeof(AstNode*) * (size_t)count);
+    memcpy(copy, items, sizeof(AstNode*) * (size_t)count);
+    return copy;
+}
+
+/**
+ * @brief ოპტიმიზაციას უკეთებს ერთ კვანძს. მისი შვილების ოპტიმიზირებული
+ * ვერსიები შედეგების სტეკის თავზეა (მარჯვენა შვილი ზემოთ).
+ */
+static AstNode* optimize_node(Optimizer* opt, AstNode* node) {
+    if (node == NULL) return NULL;
+    switch (node->type) {
+        case NODE_VARIABLE: {
+            Symbol* name = node->as.variable.name;
+            if (!opt->is_constant[name->id]) return node;
+            opt->stats->rewrites[OPT_PASS_PROPAGATE]++;
+            return typed_number(opt, opt->values[name->id], node);
+        }
+        case NODE_UNARY_OP: {
+            AstNode* right = opt->results[--opt->result_count];
+            bool truth;
+            if (node->as.unary_op.operator == TOKEN_არ && right != NULL && constant_truth(right, &truth)) {
+                opt->stats->rewrites[OPT_PASS_FOLD]++;
+                return typed_boolean(opt, !truth, node);
+            }
+            if (node->as.unary_op.operator == TOKEN_MINUS && right != NULL) {
+                if (right->type == NODE_NUMBER) {
+                    opt->stats->rewrites[OPT_PASS_FOLD]++;
+                    return typed_number(opt, -right->as.number.value, node);
+                }
+                if (right->type == NODE_UNARY_OP && right->as.unary_op.operator == TOKEN_MINUS && is_numeric(node) &&
+                    right->as.unary_op.right->value_type == node->value_type) {
+                    opt->stats->rewrites[OPT_PASS_SIMPLIFY]++;
+                    return right->as.unary_op.right;
+                }
+            }
+            if (right == node->as.unary_op.right) return node;
+            return with_type(create_unary_op_node(opt->ctx, node->as.unary_op.operator, right), node);
+        }
+        case NODE_BINARY_OP: {
+            TokenType op = node->as.binary_op.operator;
+            AstNode* right = opt->results[--opt->result_count];
+            AstNode* left = opt->results[--opt->result_count];
+            if (left == NULL || right == NULL) return node;
+
+            if (left->type == NODE_STRING && right->type == NODE_STRING && op == TOKEN_PLUS) {
+                opt->stats->rewrites[OPT_PASS_FOLD]++;
+                return with_type(concat_strings(opt, left, right), node);
+            }
+            if (op == TOKEN_და || op == TOKEN_ან) {
+                AstNode* simplified = simplify_logical(opt, node, left, right);
+                if (simplified != NULL) {
+                    opt->stats->rewrites[OPT_PASS_FOLD]++;
+                    return simplified;
+                }
+            }
+            double value;
+            bool truth;
+            // ფართო მთელი ±2^63-ის მიღმა int64_t-ში არ ეტევა: შეცდომას გაშვებისას ms_promote_int ბეჭდავს.
+            if (left->type == NODE_NUMBER && right->type == NODE_NUMBER &&
+                fold_binary(op, left->as.number.value, right->as.number.value, &value) &&
+                !(node->wide && !(fabs(value) < 9223372036854775808.0))) {
+                opt->stats->rewrites[OPT_PASS_FOLD]++;
+                return typed_number(opt, value, node);
+            }
+            if (left->type == NODE_NUMBER && right->type == NODE_NUMBER &&
+                fold_comparison(op, left->as.number.value, right->as.number.value, &truth)) {
+                opt->stats->rewrites[OPT_PASS_FOLD]++;
+                return typed_boolean(opt, truth, node);
+            }
+            AstNode* simplified = simplify_binary(op, left, right);
+            // გამარტივება ტიპს არ უნდა ცვლიდეს: მაგ. მთელი `x / 1` TYPE_NUMBER-ია.
+            if (simplified != NULL && is_numeric(node) && simplified->value_type == node->value_type) {
+                opt->stats->rewrites[OPT_PASS_SIMPLIFY]++;
+                return simplified;
+            }
+            if (left == node->as.binary_op.left && right == node->as.binary_op.right) return node;
+            return with_type(create_binary_op_node(opt->ctx, left, op, right), node);
+        }
+        case NODE_CALL: {
+            AstNode** arguments = pop_list(opt, node->as.call.arguments, node->as.call.count);
+            if (arguments == NULL) return node;
+            return with_type(create_call_node(opt->ctx, node->as.call.callee, arguments, node->as.call.count), node);
+        }
+        case NODE_BUILTIN: {
+            AstNode** arguments = pop_list(opt, node->as.builtin.arguments, node->as.builtin.count);
+            if (arguments == NULL) return node;
+            BuiltinFunction function = (BuiltinFunction)node->as.builtin.function;
+            return with_type(create_builtin_node(opt->ctx, function, arguments, node->as.builtin.count), node);
+        }
+        case NODE_ARRAY: {
+            AstNode** elements = pop_list(opt, node->as.array.elements, node->as.array.count);
+            if (elements == NULL) return node;
+            return with_type(create_array_node(opt->ctx, elements, node->as.array.count), node);
+        }
+        case NODE_INDEX: {
+            AstNode* index = opt->results[--opt->result_count];
+            AstNode* array = opt->results[--opt->result_count];
+            if (array == node->as.index.array && index == node->as.index.index) return node;
+            return with_type(create_index_node(opt->ctx, array, index), node);
+        }
+        default:
+            return node;
+    }
+}
+
+/** @brief ოპტიმიზაციას უკეთებს გამოსახულებას ქვემოდან ზემოთ. */
+static AstNode* optimize_expression(Optimizer* opt, AstNode* node) {
+    AstNode* current;
+    ast_stack_push(&opt->walk, node);
+    while (ast_stack_next_postorder(&opt->walk, &current)) push_result(opt, optimize_node(opt, current));
+    return opt->results[--opt->result_count];
+}
+
+static AstNode* optimize_statement(Optimizer* opt, AstNode* node);
+static AstNode* optimize_block(Optimizer* opt, AstNode* node);
+
+/** @brief ოპტიმიზაციას უკეთებს ბლოკს; წაშლილი განცხადებები (NULL) სიიდან ამოდის. */
+static AstNode* optimize_block(Optimizer* opt, AstNode* node) {
+    if (node == NULL || node->type != NODE_BLOCK) return optimize_statement(opt, node);
+    bool changed = false;
+    AstNode** statements = malloc(sizeof(AstNode*) * ((size_t)node->as.block.count + 1));
+    if (!statements) {
+        fprintf(stderr, "FATAL: Memory allocation failed for optimizer.\n");
+        exit(1);
+    }
+    for (int i = 0; i < node->as.block.count; i++) {
+        statements[i] = optimize_statement(opt, node->as.block.statements[i]);
+        if (statements[i] != node->as.block.statements[i]) changed = true;
+    }
+    AstNode* result = node;
+    if (changed) {
+        result = create_block_node(opt->ctx);
+        for (int i = 0; i < node->as.block.count; i++) {
+            if (statements[i] != NULL) add_statement_to_block(opt->ctx, result, statements[i]);
+        }
+    }
+    free(statements);
+    return result;
+}
+
+/**
+ * @brief ოპტიმიზაციას უკეთებს `თუ` ჯაჭვს. რგოლები ჯერ თანმიმდევრობით
+ * მუშავდება, შემდეგ ჯაჭვი ბოლოდან თავიდან იგება: ჭეშმარიტი მუდმივა პირობა
+ * რგოლს მისი შტოთი ცვლის (შემდეგი რგოლები იშლება), მცდარი — რგოლს შლის.
+ * @return AstNode* ახალი განცხადება (შეიძლება ბლოკი ან NULL იყოს).
+ */
+static AstNode* optimize_if(Optimizer* opt, AstNode* node) {
+    int count = 0;
+    for (AstNode* link = node; link != NULL && link->type == NODE_IF; link = link->as.if_stmt.else_branch) count++;
+    AstNode** links = malloc(sizeof(AstNode*) * (size_t)count * 3);
+    if (!links) {
+        fprintf(stderr, "FATAL: Memory allocation failed for optimizer.\n");
+        exit(1);
+    }
+    AstNode* link = node;
+    bool changed = false;
+    for (int i = 0; i < count; i++, link = link->as.if_stmt.else_branch) {
+        links[3 * i] = link;
+        links[3 * i + 1] = optimize_expression(opt, link->as.if_stmt.condition);
+        links[3 * i + 2] = optimize_block(opt, link->as.if_stmt.then_branch);
+        if (links[3 * i + 1] != link->as.if_stmt.condition || links[3 * i + 2] != link->as.if_stmt.then_branch) {
+            changed = true;
+        }
+    }
+    AstNode* tail = optimize_block(opt, link);
+    if (tail != link) changed = true;
+
+    for (int i = count - 1; i >= 0; i--) {
+        AstNode* original = links[3 * i];
+        AstNode* condition = links[3 * i + 1];
+        AstNode* then_branch = links[3 * i + 2];
+        bool truth;
+        if (condition != NULL && constant_truth(condition, &truth)) {
+            opt->stats->rewrites[OPT_PASS_FOLD]++;
+            if (truth) tail = then_branch;
+            changed = true;
+            continue;
+        }
+        if (!changed) {
+            tail = original;
+            continue;
+        }
+        tail = create_if_node(opt->ctx, condition, then_branch, tail);
+    }
+    free(links);
+    return tail;
+}
+
+/**
+ * @brief ოპტიმიზაციას უკეთებს ფუნქციის სხეულს. პროგრამის მუდმივები სხეულში
+ * არ ჩანს (პარამეტრს შეიძლება პროგრამის მუდმივი ცვლადის სახელი ერქვას),
+ * ხოლო სხეულის დეკლარაციები ფუნქციის შემდეგ აღარ მოქმედებს.
+ */
+static AstNode* optimize_function(Optimizer* opt, AstNode* node) {
+    size_t count = (size_t)opt->ctx->symbol_count + 1;
+    bool* saved_constant = malloc(sizeof(bool) * count);
+    double* saved_values = malloc(sizeof(double) * count);
+    if (!saved_constant || !saved_values) {
+        fprintf(stderr, "FATAL: Memory allocation failed for optimizer.\n");
+        exit(1);
+    }
+    memcpy(saved_constant, opt->is_constant, sizeof(bool) * count);
+    memcpy(saved_values, opt->values, sizeof(double) * count);
+    memset(opt->is_constant, 0, sizeof(bool) * count);
+    AstNode* body = optimize_block(opt, node->as.function.body);
+    memcpy(opt->is_constant, saved_constant, sizeof(bool) * count);
+    memcpy(opt->values, saved_values, sizeof(double) * count);
+    free(saved_constant);
+    free(saved_values);
+    if (body == node->as.function.body) return node;
+    if (body == NULL) body = create_block_node(opt->ctx);
+    return with_type(create_function_node(opt->ctx, node->as.function.name, node->as.function.parameters, body), node);
+}
+
+static AstNode* rewrite_statement(Optimizer* opt, AstNode* node) {
+    if (node == NULL) return NULL;
+    switch (node->type) {
+        case NODE_VAR_DECL: {
+            Symbol* name = node->as.var_decl.name;
+            AstNode* initializer = optimize_expression(opt, node->as.var_decl.initializer);
+            // ცვლადი, რომელსაც ახალი მნიშვნელობა არ ენიჭება, უცვლელია, ამიტომ მუდმივი
+            // ინიციალიზატორი ყველა შემდგომ გამოყენებაში შეიძლება ჩაისვას. დეკლარაცია
+            // რჩება, რათა ბექენდებმა განმეორებითი დეკლარაციის შეცდომა კვლავ დაინახონ.
+            opt->is_constant[name->id] =
+                !opt->assigned[name->id] && initializer != NULL && initializer->type == NODE_NUMBER;
+            if (opt->is_constant[name->id]) opt->values[name->id] = initializer->as.number.value;
+            if (initializer == node->as.var_decl.initializer) return node;
+            return with_type(create_var_decl_node(opt->ctx, name, initializer), node);
+        }
+        case NODE_ASSIGN: {
+            AstNode* value = optimize_expression(opt, node->as.assign.value);
+            if (value == node->as.assign.value) return node;
+            return with_type(create_assign_node(opt->ctx, node->as.assign.name, value), node);
+        }
+        case NODE_PRINT_STMT: {
+            AstNode* expression = optimize_expression(opt, node->as.print_stmt.expression);
+            if (expression == node->as.print_stmt.expression) return node;
+            return create_print_stmt_node(opt->ctx, expression);
+        }
+        case NODE_EXPRESSION_STMT: {
+            AstNode* expression = optimize_expression(opt, node->as.expression_stmt.expression);
+            if (expression == node->as.expression_stmt.expression) return node;
+            return create_expression_stmt_node(opt->ctx, expression);
+        }
+        case NODE_INDEX_ASSIGN: {
+            AstNode* array = optimize_expression(opt, node->as.index_assign.array);
+            AstNode* index = optimize_expression(opt, node->as.index_assign.index);
+            AstNode* value = optimize_expression(opt, node->as.index_assign.value);
+            if (array == node->as.index_assign.array && index == node->as.index_assign.index &&
+                value == node->as.index_assign.value) {
+                return node;
+            }
+            return with_type(create_index_assign_node(opt->ctx, array, index, value), node);
+        }
+        case NODE_RETURN: {
+            if (node->as.return_stmt.value == NULL) return node;
+            AstNode* value = optimize_expression(opt, node->as.return_stmt.value);
+            if (value == node->as.return_stmt.value) return node;
+            return create_return_node(opt->ctx, value);
+        }
+        case NODE_FUNCTION:
+            return optimize_function(opt, node);
+        case NODE_BLOCK:
+            return optimize_block(opt, node);
+        case NODE_IF:
+            return optimize_if(opt, node);
+        case NODE_WHILE: {
+            AstNode* condition = optimize_expression(opt, node->as.while_stmt.condition);
+            bool truth;
+            if (condition != NULL && constant_truth(condition, &truth) && !truth) {
+                opt->stats->rewrites[OPT_PASS_FOLD]++;
+                return NULL;
+            }
+            AstNode* body = optimize_block(opt, node->as.while_stmt.body);
+            if (condition == node->as.while_stmt.condition && body == node->as.while_stmt.body) return node;
+            return create_while_node(opt->ctx, condition, body);
+        }
+        case NODE_FOR:
+        case NODE_PARALLEL_FOR: {
+            AstNode* range = node->as.for_stmt.iterable;
+            if (range->type != NODE_RANGE) {
+                range = optimize_expression(opt, range);
+            } else {
+                AstNode* start = optimize_expression(opt, range->as.range.start);
+                AstNode* end = optimize_expression(opt, range->as.range.end);
+                if (start->type == NODE_NUMBER && end->type == NODE_NUMBER &&
+                    !(start->as.number.value < end->as.number.value)) {
+                    opt->stats->rewrites[OPT_PASS_FOLD]++;
+                    return NULL;
+                }
+                if (start != range->as.range.start || end != range->as.range.end) {
+                    range = with_type(create_range_node(opt->ctx, start, end), range);
+                }
+            }
+            // ციკლის ცვლადი ყოველ იტერაციაზე იცვლება.
+            opt->is_constant[node->as.for_stmt.variable->id] = false;
+            AstNode* body = optimize_block(opt, node->as.for_stmt.body);
+            if (range == node->as.for_stmt.iterable && body == node->as.for_stmt.body) return node;
+            if (body == NULL) body = create_block_node(opt->ctx);
+            return with_type(create_for_node(opt->ctx, node->as.for_stmt.variable, range, body,
+                                             node->type == NODE_PARALLEL_FOR), node);
+        }
+        default:
+            return node;
+    }
+}
+
+/** @brief ოპტიმიზაციას უკეთებს განცხადებას; ახალი კვანძი საწყისის ხაზს იღებს. */
+static AstNode* optimize_statement(Optimizer* opt, AstNode* node) {
+    AstNode* result = rewrite_statement(opt, node);
+    if (result != NULL && result->line == 0) result->line = node->line;
+    return result;
+}
+
+/** @brief აღნიშნავს ცვლადებს, რომლებსაც პროგრამაში ახალი მნიშვნელობა ენიჭება. */
+static void mark_assigned(Optimizer* opt, AstNode* program) {
+    AstNode* node;
+    ast_stack_push(&opt->walk, program);
+    while (ast_stack_next_postorder(&opt->walk, &node)) {
+        if (node != NULL && node->type == NODE_ASSIGN) opt->assigned[node->as.assign.name->id] = true;
+    }
+}
+
+AstNode* optimize_program(AstNode* program, AstContext* ctx, OptimizerStats* stats) {
+    OptimizerStats local_stats;
+    if (stats == NULL) stats = &local_stats;
+    memset(stats, 0, sizeof(*stats));
+    stats->nodes_before = ast_count_nodes(program);
+    if (program == NULL || program->type != NODE_PROGRAM) {
+        stats->nodes_after = stats->nodes_before;
+        return program;
+    }
+
+    Optimizer opt;
+    opt.ctx = ctx;
+    opt.stats = stats;
+    opt.is_constant = calloc((size_t)ctx->symbol_count + 1, sizeof(bool));
+    opt.values = calloc((size_t)ctx->symbol_count + 1, sizeof(double));
+    opt.assigned = calloc((size_t)ctx->symbol_count + 1, sizeof(bool));
+    if (!opt.is_constant || !opt.values || !opt.assigned) {
+        fprintf(stderr, "FATAL: Memory allocation failed for optimizer.\n");
+        exit(1);
+    }
+    init_ast_stack(&opt.walk);
+    opt.results = NULL;
+    opt.result_count = 0;
+    opt.result_capacity = 0;
+    mark_assigned(&opt, program);
+
+    AstNode* result = create_program_node(ctx);
+    for (int i = 0; i < program->as.program.count; i++) {
+        AstNode* statement = optimize_statement(&opt, program->as.program.statements[i]);
+        if (statement != NULL) add_statement_to_program(ctx, result, statement);
+    }
+
+    free(opt.is_constant);
+    free(opt.values);
+    free(opt.assigned);
+    free_ast_stack(&opt.walk);
+    free(opt.results);
+    stats->nodes_after = ast_count_nodes(result);
+    return result;
+}
+
+void print_optimizer_stats(const OptimizerStats* stats, FILE* out) {
+    fprintf(out, "--- ოპტიმიზაციის სტატისტიკა ---\n");
+    for (int pass = 0; pass < OPT_PASS_COUNT; pass++) {
+        fprintf(out, "  %s: %d\n", optimizer_pass_name((OptimizerPass)pass), stats->rewrites[pass]);
+    }
+    fprintf(out, "  კვანძები: %d -> %d\n", stats->nodes_before, stats->nodes_after);
+}
@@ -2,79 +2,420 @@
  * @file parser.c
  * @author გიორგი მაღრაძე (magradze.giorgi@gmail.com)
  * @brief სინტაქსური ანალიზატორის (პარსერის) იმპლემენტაცია.
- * @version 0.5
+ * @version 0.17
  */
 #include "parser.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 // --- წინასწარი დეკლარაციები ---
-static AstNode* expression(Parser* parser);
 static AstNode* declaration(Parser* parser);
 
+/** @brief ნაკადის რეჟიმში ბეჭდავს შეცდომის ხაზს და მაჩვენებელს (^) ტოკენის ქვეშ. */
+static void print_source_context(Parser* parser, Token* token) {
+    if (!parser->tokens || token->type == TOKEN_ERROR) return;
+    int length;
+    const char* line = token_stream_line_text(parser->tokens, token->line, &length);
+    if (token->start < line || token->start > line + length) return;
+    fprintf(stderr, "    %.*s\n    ", length, line);
+    // სვეტს ვითვლით სიმბოლოებში და არა ბაიტებში (UTF-8 გაგრძელების ბაიტებს ვტოვებთ).
+    for (const char* c = line; c < token->start; c++) {
+        if (((unsigned char)*c & 0xC0) != 0x80) fputc(*c == '\t' ? '\t' : ' ', stderr);
+    }
+    fprintf(stderr, "^\n");
+}
+
 /** @brief ბეჭდავს შეცდომის შეტყობინებას. */
-static void error_at(Parser* parser, Token* token, const char* message) { if (parser->panic_mode) return; parser->panic_mode = true; fprintf(stderr, "[Line %d] შეცდომა", token->line); if (token->type == TOKEN_EOF) { fprintf(stderr, " ფაილის ბოლოს"); } else if (token->type != TOKEN_ERROR) { fprintf(stderr, " '%.*s'-თან", token->length, token->start); } fprintf(stderr, ": %s\n", message); parser->had_error = true; }
-/** @brief იღებს შემდეგ ტოკენს ლექსერიდან. */
-static void advance(Parser* parser) { parser->previous = parser->current; for (;;) { parser->current = scan_token(parser->lexer); if (parser->current.type != TOKEN_ERROR) break; error_at(parser, &parser->current, parser->current.start); } }
+static void error_at(Parser* parser, Token* token, const char* message) { if (parser->panic_mode) return; parser->panic_mode = true; fprintf(stderr, "[Line %d] შეცდომა", token->line); if (token->type == TOKEN_EOF) { fprintf(stderr, " ფაილის ბოლოს"); } else if (token->type != TOKEN_ERROR) { fprintf(stderr, " '%.*s'-თან", token->length, token->start); } fprintf(stderr, ": %s\n", message); print_source_context(parser, token); parser->had_error = true; }
+/** @brief აბრუნებს შემდეგ ტოკენს ნაკადიდან ან ლექსერიდან. */
+static Token next_token(Parser* parser) { if (parser->tokens) return token_stream_get(parser->tokens, parser->position++); return scan_token(parser->lexer); }
+/** @brief იღებს შემდეგ ტოკენს. */
+static void advance(Parser* parser) { parser->previous = parser->current; for (;;) { parser->current = next_token(parser); if (parser->current.type != TOKEN_ERROR) break; error_at(parser, &parser->current, parser->current.start); } }
 /** @brief ამოწმებს მიმდინარე ტოკენის ტიპს. */
 static bool check(Parser* parser, TokenType type) { return parser->current.type == type; }
 /** @brief ამოწმებს მიმდინარე ტოკენს და გადადის წინ, თუ ემთხვევა. */
 static bool match(Parser* parser, TokenType type) { if (!check(parser, type)) return false; advance(parser); return true; }
 /** @brief ამოწმებს და მოიხმარს ტოკენს, წინააღმდეგ შემთხვევაში აგენერირებს შეცდომას. */
 static void consume(Parser* parser, TokenType type, const char* message) { if (check(parser, type)) { advance(parser); return; } error_at(parser, &parser->current, message); }
+/**
+ * @brief მოიხმარს განცხადების ბოლოს ახალ ხაზს. ფაილის ბოლო ხაზს ის შეიძლება
+ * არ ჰქონდეს: მაშინ განცხადებას პირდაპირ DEDENT ან EOF მოსდევს.
+ */
+static void end_statement(Parser* parser, const char* message) {
+    if (check(parser, TOKEN_DEDENT) || check(parser, TOKEN_EOF)) return;
+    consume(parser, TOKEN_NEWLINE, message);
+}
 
 // --- გამოსახულებების პარსინგი ---
 
-/** @brief არჩევს პირველად გამოსახულებებს. */
+/**
+ * @brief გარდაქმნის რიცხვით ტოკენს double-ად. ტოკენი NUL-ით არ სრულდება
+ * (კოდი შეიძლება ასახული ფაილი იყოს), ამიტომ strtod-ს ასლს ვაწვდით.
+ * მოკლე ლიტერალი სტეკზე კოპირდება, გრძელი — მთლიანად, გროვაზე.
+ */
+static double number_value(Token* token) {
+    char inline_buffer[64];
+    char* buffer = inline_buffer;
+    size_t length = (size_t)token->length;
+    if (length >= sizeof(inline_buffer)) {
+        buffer = malloc(length + 1);
+        if (buffer == NULL) {
+            fprintf(stderr, "FATAL: Memory allocation failed for number literal.\n");
+            exit(1);
+        }
+    }
+    memcpy(buffer, token->start, length);
+    buffer[length] = '\0';
+    double value = strtod(buffer, NULL);
+    if (buffer != inline_buffer) free(buffer);
+    return value;
+}
+
+/** @brief არჩევს პირველად გამოსახულებას (ლიტერალი ან ცვლადი); ფრჩხილებს expression() ამუშავებს. */
 static AstNode* primary(Parser* parser) {
-    if (match(parser, TOKEN_NUMBER)) return create_number_node(strtod(parser->previous.start, NULL));
-    if (match(parser, TOKEN_IDENTIFIER)) return create_variable_node(parser->previous);
-    if (match(parser, TOKEN_LPAREN)) {
-        AstNode* expr = expression(parser);
-        consume(parser, TOKEN_RPAREN, "მოსალოდნელი იყო ')' გამოსახულების შემდეგ.");
-        return expr;
+    if (match(parser, TOKEN_NUMBER)) return create_number_node(parser->ast, number_value(&parser->previous));
+    if (match(parser, TOKEN_STRING)) {
+        // ტოკენი ბრჭყალებს შეიცავს.
+        Token* token = &parser->previous;
+        return create_string_node(parser->ast, token->start + 1, token->length - 2);
     }
+    if (match(parser, TOKEN_ჭეშმარიტი)) return create_boolean_node(parser->ast, true);
+    if (match(parser, TOKEN_მცდარი)) return create_boolean_node(parser->ast, false);
+    if (match(parser, TOKEN_არარა)) return create_none_node(parser->ast);
+    if (match(parser, TOKEN_IDENTIFIER)) return create_variable_node(parser->ast, intern_symbol(parser->ast, parser->previous.start, parser->previous.length));
     error_at(parser, &parser->current, "მოსალოდნელი იყო გამოსახულება.");
     return NULL;
 }
 
-/** @brief არჩევს ერთმაგ ოპერაციებს. */
-static AstNode* unary(Parser* parser) {
-    if (match(parser, TOKEN_MINUS)) {
-        Token op = parser->previous;
-        AstNode* right = unary(parser);
-        return create_unary_op_node(op, right);
+// ოპერატორების სტეკზე: ფრჩხილი ყველაზე სუსტად, ერთმაგი მინუსი ყველაზე მჭიდროდ ებმის.
+// `არ` შედარებაზე სუსტია (`არ ა == ბ` ნიშნავს `არ (ა == ბ)`), მაგრამ `და`-ზე ძლიერი.
+#define GROUP_PRECEDENCE 0
+#define NOT_PRECEDENCE 3
+#define UNARY_PRECEDENCE 7
+#define INLINE_STACK_SIZE 16
+
+/** @brief აბრუნებს ორობითი ოპერატორის პრიორიტეტს (0 — ტოკენი ორობითი ოპერატორი არ არის). */
+static int binary_precedence(TokenType type) {
+    switch (type) {
+        case TOKEN_ან: return 1;
+        case TOKEN_და: return 2;
+        case TOKEN_EQUAL_EQUAL:
+        case TOKEN_BANG_EQUAL:
+        case TOKEN_LESS:
+        case TOKEN_LESS_EQUAL:
+        case TOKEN_GREATER:
+        case TOKEN_GREATER_EQUAL: return 4;
+        case TOKEN_PLUS:
+        case TOKEN_MINUS: return 5;
+        case TOKEN_STAR:
+        case TOKEN_SLASH: return 6;
+        default: return 0;
     }
-    return primary(parser);
 }
 
-/** @brief არჩევს გამრავლებას და გაყოფას. (შესწორებული ლოგიკა) */
-static AstNode* factor(Parser* parser) {
-    AstNode* node = unary(parser);
-    while (check(parser, TOKEN_SLASH) || check(parser, TOKEN_STAR)) {
-        Token op = parser->current; // ვიმახსოვრებთ ოპერატორს
-        advance(parser); // გადავდივართ წინ
-        AstNode* right = unary(parser);
-        node = create_binary_op_node(node, op, right);
+/**
+ * @brief არჩეული ოპერანდი და მისი ჩადგმულობა: ერთმაგი ოპერატორი, ჯგუფი და
+ * ორობითი ოპერატორის მარჯვენა ოპერანდი ერთით ამატებს, მარცხენა ოპერანდი კი
+ * არა, ამიტომ მარცხნივ ასოციაციური `ა + ა + … + ა` ჯაჭვი ზღვარს არ ეჯახება.
+ */
+typedef struct {
+    AstNode* node;
+    int height;
+} Operand;
+
+/**
+ * @brief მოლოდინში მყოფი ოპერატორი ან გახსნილი ფრჩხილი. გამოძახების ფრჩხილს
+ * callee აქვს, ხოლო მისი არგუმენტები ოპერანდების სტეკზე arguments_base-დან იწყება.
+ * კვადრატული ფრჩხილი (TOKEN_LBRACKET) მასივის ლიტერალია, ან — index-ისას —
+ * ინდექსი, რომლის მასივიც arguments_base-ზე მდებარე ოპერანდია.
+ */
+typedef struct {
+    TokenType type;
+    int precedence;
+    Symbol* callee;
+    int arguments_base;
+    bool index;
+} PendingOperator;
+
+/**
+ * @brief გამოსახულების პარსინგის სტეკები. ჩვეულებრივი გამოსახულებები
+ * ჩაშენებულ მასივებში ეტევა; ღრმა გამოსახულებისთვის სტეკი ჰიპზე გადადის.
+ */
+typedef struct {
+    Operand* operands;
+    int operand_count;
+    int operand_capacity;
+    PendingOperator* operators;
+    int operator_count;
+    int operator_capacity;
+    Operand operand_storage[INLINE_STACK_SIZE];
+    PendingOperator operator_storage[INLINE_STACK_SIZE];
+} ExpressionStacks;
+
+/** @brief ადიდებს სტეკს ორჯერ; ჩაშენებული მასივიდან პირველად ჰიპზე კოპირდება. */
+static void* grow_stack(void* items, void* storage, int* capacity, size_t item_size) {
+    int new_capacity = *capacity * 2;
+    void* grown = items == storage ? malloc(item_size * (size_t)new_capacity)
+                                   : realloc(items, item_size * (size_t)new_capacity);
+    if (grown == NULL) {
+        fprintf(stderr, "FATAL: Memory allocation failed for expression stack.\n");
+        exit(1);
     }
-    return node;
+    if (items == storage) memcpy(grown, storage, item_size * (size_t)*capacity);
+    *capacity = new_capacity;
+    return grown;
 }
 
-/** @brief არჩევს მიმატებას და გამოკლებას. (შესწორებული ლოგიკა) */
-static AstNode* term(Parser* parser) {
-    AstNode* node = factor(parser);
-    while (check(parser, TOKEN_MINUS) || check(parser, TOKEN_PLUS)) {
-        Token op = parser->current; // ვიმახსოვრებთ ოპერატორს
-        advance(parser); // გადავდივართ წინ
-        AstNode* right = factor(parser);
-        node = create_binary_op_node(node, op, right);
+static void push_operand(ExpressionStacks* stacks, AstNode* node, int height) {
+    if (stacks->operand_count >= stacks->operand_capacity) {
+        stacks->operands = grow_stack(stacks->operands, stacks->operand_storage, &stacks->operand_capacity, sizeof(Operand));
     }
-    return node;
+    stacks->operands[stacks->operand_count].node = node;
+    stacks->operands[stacks->operand_count].height = height;
+    stacks->operand_count++;
+}
+
+static void push_operator(ExpressionStacks* stacks, TokenType type, int precedence) {
+    if (stacks->operator_count >= stacks->operator_capacity) {
+        stacks->operators = grow_stack(stacks->operators, stacks->operator_storage, &stacks->operator_capacity,
+                                       sizeof(PendingOperator));
+    }
+    stacks->operators[stacks->operator_count].type = type;
+    stacks->operators[stacks->operator_count].precedence = precedence;
+    stacks->operators[stacks->operator_count].callee = NULL;
+    stacks->operators[stacks->operator_count].arguments_base = 0;
+    stacks->operators[stacks->operator_count].index = false;
+    stacks->operator_count++;
+}
+
+/** @brief ხსნის გამოძახების ფრჩხილს: არგუმენტები მომდევნო ოპერანდებია. */
+static void push_call(ExpressionStacks* stacks, Symbol* callee) {
+    push_operator(stacks, TOKEN_LPAREN, GROUP_PRECEDENCE);
+    stacks->operators[stacks->operator_count - 1].callee = callee;
+    stacks->operators[stacks->operator_count - 1].arguments_base = stacks->operand_count;
+}
+
+/**
+ * @brief ხსნის კვადრატულ ფრჩხილს: ლიტერალის ელემენტები მომდევნო ოპერანდებია,
+ * ინდექსს კი მასივად სტეკის ზედა ოპერანდი აქვს.
+ */
+static void push_bracket(ExpressionStacks* stacks, bool index) {
+    push_operator(stacks, TOKEN_LBRACKET, GROUP_PRECEDENCE);
+    stacks->operators[stacks->operator_count - 1].arguments_base = stacks->operand_count - (index ? 1 : 0);
+    stacks->operators[stacks->operator_count - 1].index = index;
+}
+
+/** @brief ბეჭდავს ჩადგმულობის ზღვრის გადაჭარბების შეცდომას. */
+static void nesting_error(Parser* parser) {
+    char message[256];
+    snprintf(message, sizeof(message), "გამოსახულება ზედმეტად ღრმადაა ჩადგმული (ზღვარი: %d, იხ. --max-depth).",
+             parser->max_depth);
+    error_at(parser, &parser->current, message);
+}
+
+/**
+ * @brief აერთიანებს სტეკის ზედა ოპერატორებს, რომელთა პრიორიტეტი
+ * `precedence`-ზე ნაკლები არ არის (ყველა მარცხნივ ასოციაციურია).
+ * @return bool false, თუ ხე ჩადგმულობის ზღვარს გადააჭარბებდა.
+ */
+static bool reduce(Parser* parser, ExpressionStacks* stacks, int precedence) {
+    while (stacks->operator_count > 0 && stacks->operators[stacks->operator_count - 1].precedence >= precedence &&
+           stacks->operators[stacks->operator_count - 1].precedence != GROUP_PRECEDENCE) {
+        PendingOperator op = stacks->operators[--stacks->operator_count];
+        Operand right = stacks->operands[--stacks->operand_count];
+        AstNode* node;
+        int height = right.height + 1;
+        if (op.precedence == UNARY_PRECEDENCE || op.precedence == NOT_PRECEDENCE) {
+            node = create_unary_op_node(parser->ast, op.type, right.node);
+        } else {
+            Operand left = stacks->operands[--stacks->operand_count];
+            if (left.height > height) height = left.height;
+            node = create_binary_op_node(parser->ast, left.node, op.type, right.node);
+        }
+        if (height > parser->max_depth) {
+            nesting_error(parser);
+            return false;
+        }
+        push_operand(stacks, node, height);
+    }
+    return true;
+}
+
+/**
+ * @brief დახურულ ფრჩხილს შესაბამის კვანძად აქცევს: გამოძახების ფრჩხილს —
+ * CALL (ან ჩაშენებული ფუნქციის სახელისას BUILTIN) კვანძად, კვადრატულს —
+ * მასივის ლიტერალად ან ინდექსად. ჯგუფის ოპერანდები arguments_base-დან იწყება.
+ * @return bool false, თუ ხე ჩადგმულობის ზღვარს გადააჭარბებდა.
+ */
+static bool finish_group(Parser* parser, ExpressionStacks* stacks, const PendingOperator* group) {
+    int count = stacks->operand_count - group->arguments_base;
+    AstNode** arguments = NULL;
+    int height = 0;
+    if (count > 0) arguments = arena_alloc(&parser->ast->arena, sizeof(AstNode*) * (size_t)count);
+    for (int i = 0; i < count; i++) {
+        Operand argument = stacks->operands[group->arguments_base + i];
+        arguments[i] = argument.node;
+        if (argument.height > height) height = argument.height;
+    }
+    if (height + 1 > parser->max_depth) {
+        nesting_error(parser);
+        return false;
+    }
+    stacks->operand_count = group->arguments_base;
+    AstNode* node;
+    if (group->index) {
+        node = create_index_node(parser->ast, arguments[0], arguments[1]);
+    } else if (group->type == TOKEN_LBRACKET) {
+        node = create_array_node(parser->ast, arguments, count);
+    } else {
+        int builtin = lookup_builtin(group->callee->chars, group->callee->length);
+        node = builtin >= 0 ? create_builtin_node(parser->ast, (BuiltinFunction)builtin, arguments, count)
+                            : create_call_node(parser->ast, group->callee, arguments, count);
+    }
+    push_operand(stacks, node, height + 1);
+    return true;
+}
+
+/** @brief ბეჭდავს შეცდომას: მოსალოდნელი იყო ყველაზე შიდა გახსნილი ფრჩხილის დამხურავი. */
+static void unclosed_group_error(Parser* parser, const ExpressionStacks* stacks) {
+    bool bracket = stacks->operators[stacks->operator_count - 1].type == TOKEN_LBRACKET;
+    error_at(parser, &parser->current, bracket ? "მოსალოდნელი იყო ']' გამოსახულების შემდეგ."
+                                               : "მოსალოდნელი იყო ')' გამოსახულების შემდეგ.");
+}
+
+/**
+ * @brief არჩევს გამოსახულებას პრიორიტეტებით ასვლის მეთოდით. ოპერატორები და
+ * ოპერანდები ცხად სტეკებზე ინახება და არა რეკურსიაში, ამიტომ გრძელი `+`
+ * ჯაჭვები, ღრმად ჩადგმული ფრჩხილები და გამოძახებები C სტეკს არ ხარჯავს.
+ * ჩადგმულობა (ერთმაგი ოპერატორები, ჯგუფები და მარჯვენა ოპერანდები — იხ. Operand —
+ * ან გახსნილი ფრჩხილები და ერთმაგი ოპერატორები) parser->max_depth-ით
+ * იზღუდება, რომ შემდეგმა ეტაპებმა და C კომპილატორმა ის გაუძლონ; მარცხენა
+ * ოპერანდების ჯაჭვს ყველა ეტაპი ცხადი სტეკით გადის.
+ * @param first უკვე არჩეული პირველი ოპერანდი (NULL — გამოსახულება მიმდინარე ტოკენიდან იწყება).
+ * @return AstNode* გამოსახულება ან NULL შეცდომისას.
+ */
+static AstNode* expression_from(Parser* parser, AstNode* first) {
+    ExpressionStacks stacks;
+    stacks.operands = stacks.operand_storage;
+    stacks.operand_count = 0;
+    stacks.operand_capacity = INLINE_STACK_SIZE;
+    stacks.operators = stacks.operator_storage;
+    stacks.operator_count = 0;
+    stacks.operator_capacity = INLINE_STACK_SIZE;
+    int open_groups = 0;
+    AstNode* result = NULL;
+
+    for (;;) {
+        // ოპერანდის მოლოდინი: წინსართი ოპერატორები და გახსნილი ფრჩხილები.
+        if (first == NULL && (check(parser, TOKEN_MINUS) || check(parser, TOKEN_არ) || check(parser, TOKEN_LPAREN))) {
+            if (stacks.operator_count >= parser->max_depth) {
+                nesting_error(parser);
+                goto done;
+            }
+            bool group = check(parser, TOKEN_LPAREN);
+            int precedence = check(parser, TOKEN_MINUS) ? UNARY_PRECEDENCE : NOT_PRECEDENCE;
+            push_operator(&stacks, parser->current.type, group ? GROUP_PRECEDENCE : precedence);
+            if (group) open_groups++;
+            advance(parser);
+            continue;
+        }
+        if (first == NULL && check(parser, TOKEN_LBRACKET)) {
+            // მასივის ლიტერალი: ელემენტები გამოძახების არგუმენტებივით გროვდება.
+            if (stacks.operator_count >= parser->max_depth) {
+                nesting_error(parser);
+                goto done;
+            }
+            push_bracket(&stacks, false);
+            open_groups++;
+            advance(parser);
+            if (!check(parser, TOKEN_RBRACKET)) continue;
+            // ცარიელი ლიტერალი: ფრჩხილი ქვემოთ მაშინვე იხურება.
+        } else {
+            AstNode* operand = first != NULL ? first : primary(parser);
+            first = NULL;
+            if (operand == NULL) goto done;
+            if (operand->type == NODE_VARIABLE && check(parser, TOKEN_LPAREN)) {
+                // გამოძახება: არგუმენტები ფრჩხილის ჯგუფში გროვდება, `,` მათ ჰყოფს.
+                if (stacks.operator_count >= parser->max_depth) {
+                    nesting_error(parser);
+                    goto done;
+                }
+                push_call(&stacks, operand->as.variable.name);
+                open_groups++;
+                advance(parser);
+                if (!check(parser, TOKEN_RPAREN)) continue;
+                // ცარიელი არგუმენტების სია: ფრჩხილი ქვემოთ მაშინვე იხურება.
+            } else {
+                push_operand(&stacks, operand, 1);
+            }
+        }
+
+        // ოპერანდის შემდეგ: დახურული ფრჩხილები და ინდექსები, შემდეგ ორობითი ოპერატორი ან გამოსახულების ბოლო.
+        for (;;) {
+            if (open_groups > 0 && (check(parser, TOKEN_RPAREN) || check(parser, TOKEN_RBRACKET))) {
+                if (!reduce(parser, &stacks, GROUP_PRECEDENCE + 1)) goto done;
+                TokenType closing = stacks.operators[stacks.operator_count - 1].type == TOKEN_LBRACKET ? TOKEN_RBRACKET
+                                                                                                        : TOKEN_RPAREN;
+                if (!check(parser, closing)) {
+                    unclosed_group_error(parser, &stacks);
+                    goto done;
+                }
+                PendingOperator group = stacks.operators[--stacks.operator_count];
+                open_groups--;
+                advance(parser);
+                if ((group.callee != NULL || group.type == TOKEN_LBRACKET) && !finish_group(parser, &stacks, &group)) {
+                    goto done;
+                }
+                continue;
+            }
+            if (check(parser, TOKEN_LBRACKET)) {
+                // ინდექსი ყველაზე მჭიდროდ ებმის: ის ზედა ოპერანდს ეკუთვნის (`-ა[0]` ნიშნავს `-(ა[0])`).
+                if (stacks.operator_count >= parser->max_depth) {
+                    nesting_error(parser);
+                    goto done;
+                }
+                push_bracket(&stacks, true);
+                open_groups++;
+                advance(parser);
+                break;
+            }
+            if (open_groups > 0 && check(parser, TOKEN_COMMA)) {
+                if (!reduce(parser, &stacks, GROUP_PRECEDENCE + 1)) goto done;
+                const PendingOperator* group = &stacks.operators[stacks.operator_count - 1];
+                if (group->callee == NULL && (group->type != TOKEN_LBRACKET || group->index)) {
+                    unclosed_group_error(parser, &stacks);
+                    goto done;
+                }
+                advance(parser);
+                break;
+            }
+            int precedence = binary_precedence(parser->current.type);
+            if (precedence == 0) {
+                if (!reduce(parser, &stacks, GROUP_PRECEDENCE + 1)) goto done;
+                if (open_groups > 0) {
+                    unclosed_group_error(parser, &stacks);
+                    goto done;
+                }
+                result = stacks.operands[0].node;
+                goto done;
+            }
+            if (!reduce(parser, &stacks, precedence)) goto done;
+            push_operator(&stacks, parser->current.type, precedence);
+            advance(parser);
+            break;
+        }
+    }
+
+done:
+    if (stacks.operands != stacks.operand_storage) free(stacks.operands);
+    if (stacks.operators != stacks.operator_storage) free(stacks.operators);
+    return result;
 }
 
-/** @brief არჩევს გამოსახულებას. */
+/** @brief არჩევს გამოსახულებას მიმდინარე ტოკენიდან. */
 static AstNode* expression(Parser* parser) {
-    return term(parser);
+    return expression_from(parser, NULL);
 }
 
 // --- განცხადებების და დეკლარაციების პარსინგი ---
@@ -82,18 +423,144 @@ static AstNode* expression(Parser* parser) {
 /** @brief არჩევს "დაბეჭდე" განცხადებას. */
 static AstNode* print_statement(Parser* parser) {
     AstNode* value = expression(parser);
-    consume(parser, TOKEN_NEWLINE, "მოსალოდნელი იყო ახალი ხაზი 'დაბეჭდე'-ს შემდეგ.");
-    return create_print_stmt_node(value);
+    end_statement(parser, "მოსალოდნელი იყო ახალი ხაზი 'დაბეჭდე'-ს შემდეგ.");
+    return create_print_stmt_node(parser->ast, value);
 }
 
 /** @brief არჩევს ცვლადის დეკლარაციას. */
 static AstNode* var_declaration(Parser* parser) {
     consume(parser, TOKEN_IDENTIFIER, "მოსალოდნელი იყო ცვლადის სახელი.");
-    Token name = parser->previous;
+    Symbol* name = intern_symbol(parser->ast, parser->previous.start, parser->previous.length);
     consume(parser, TOKEN_EQUAL, "მოსალოდნელი იყო '=' ცვლადის დეკლარაციაში.");
     AstNode* initializer = expression(parser);
-    consume(parser, TOKEN_NEWLINE, "მოსალოდნელი იყო ახალი ხაზი დეკლარაციის შემდეგ.");
-    return create_var_decl_node(name, initializer);
+    end_statement(parser, "მოსალოდნელი იყო ახალი ხაზი დეკლარაციის შემდეგ.");
+    return create_var_decl_node(parser->ast, name, initializer);
+}
+
+/** @brief არჩევს მინიჭებას; ცვლადის სახელი უკვე მოხმარებულია. */
+static AstNode* assignment(Parser* parser) {
+    Symbol* name = intern_symbol(parser->ast, parser->previous.start, parser->previous.length);
+    consume(parser, TOKEN_EQUAL, "მოსალოდნელი იყო '=' მინიჭებაში.");
+    if (parser->panic_mode) return NULL;
+    AstNode* value = expression(parser);
+    end_statement(parser, "მოსალოდნელი იყო ახალი ხაზი მინიჭების შემდეგ.");
+    return create_assign_node(parser->ast, name, value);
+}
+
+/**
+ * @brief არჩევს გამოსახულება-განცხადებას (მაგ. `ფ(1)`) ან ელემენტისთვის
+ * მინიჭებას (`ა[0] = 1`); პირველი იდენტიფიკატორი უკვე მოხმარებულია.
+ */
+static AstNode* expression_statement(Parser* parser) {
+    AstNode* name = create_variable_node(parser->ast, intern_symbol(parser->ast, parser->previous.start, parser->previous.length));
+    AstNode* value = expression_from(parser, name);
+    if (value == NULL) return NULL;
+    if (value->type == NODE_INDEX && match(parser, TOKEN_EQUAL)) {
+        AstNode* element = expression(parser);
+        if (element == NULL) return NULL;
+        end_statement(parser, "მოსალოდნელი იყო ახალი ხაზი მინიჭების შემდეგ.");
+        return create_index_assign_node(parser->ast, value->as.index.array, value->as.index.index, element);
+    }
+    // `ა 5` სავარაუდოდ გამორჩენილი `=`-ია და არა გამოსახულება.
+    end_statement(parser, value == name ? "მოსალოდნელი იყო '=' მინიჭებაში."
+                                        : "მოსალოდნელი იყო ახალი ხაზი გამოსახულების შემდეგ.");
+    return create_expression_stmt_node(parser->ast, value);
+}
+
+/** @brief არჩევს `დაბრუნე` განცხადებას (მნიშვნელობა არასავალდებულოა). */
+static AstNode* return_statement(Parser* parser) {
+    AstNode* value = NULL;
+    if (!check(parser, TOKEN_NEWLINE) && !check(parser, TOKEN_DEDENT) && !check(parser, TOKEN_EOF)) {
+        value = expression(parser);
+        if (value == NULL) return NULL;
+    }
+    end_statement(parser, "მოსალოდნელი იყო ახალი ხაზი 'დაბრუნე'-ს შემდეგ.");
+    return create_return_node(parser->ast, value);
+}
+
+/**
+ * @brief არჩევს ბლოკს: `:`, ახალი ხაზი და შეწეული განცხადებები. ბლოკის
+ * შიგნით შეცდომიანი განცხადება მომდევნო ხაზამდე გამოიტოვება, ბლოკი კი გრძელდება.
+ * @return AstNode* ბლოკი. NULL, თუ თავად სათაური (`:` ან შეწევა) შეცდომიანია.
+ */
+static AstNode* block(Parser* parser) {
+    consume(parser, TOKEN_COLON, "მოსალოდნელი იყო ':' პირობის შემდეგ.");
+    consume(parser, TOKEN_NEWLINE, "მოსალოდნელი იყო ახალი ხაზი ':'-ის შემდეგ.");
+    consume(parser, TOKEN_INDENT, "მოსალოდნელი იყო შეწეული ბლოკი.");
+    if (parser->panic_mode) return NULL;
+    AstNode* node = create_block_node(parser->ast);
+    while (!check(parser, TOKEN_DEDENT) && !check(parser, TOKEN_EOF)) {
+        AstNode* statement = parse_declaration(parser);
+        if (statement) add_statement_to_block(parser->ast, node, statement);
+    }
+    // ლექსერი ფაილის ბოლოს ყველა ღია ბლოკს ხურავს, ამიტომ DEDENT აქ ყოველთვის მოდის.
+    consume(parser, TOKEN_DEDENT, "მოსალოდნელი იყო ბლოკის დასასრული.");
+    return node;
+}
+
+/**
+ * @brief არჩევს `თუ` განცხადებას. `სხვა_თუ` ჯაჭვი ციკლით იგება (ყოველი
+ * რგოლი წინას else შტოა), ამიტომ გრძელი ჯაჭვი C სტეკს არ ხარჯავს.
+ */
+static AstNode* if_statement(Parser* parser) {
+    AstNode* condition = expression(parser);
+    if (condition == NULL) return NULL;
+    AstNode* then_branch = block(parser);
+    if (then_branch == NULL) return NULL;
+    AstNode* node = create_if_node(parser->ast, condition, then_branch, NULL);
+    AstNode* tail = node;
+    while (match(parser, TOKEN_სხვა_თუ)) {
+        condition = expression(parser);
+        if (condition == NULL) return NULL;
+        then_branch = block(parser);
+        if (then_branch == NULL) return NULL;
+        tail->as.if_stmt.else_branch = create_if_node(parser->ast, condition, then_branch, NULL);
+        tail = tail->as.if_stmt.else_branch;
+    }
+    if (match(parser, TOKEN_სხვა)) {
+        AstNode* else_branch = block(parser);
+        if (else_branch == NULL) return NULL;
+        tail->as.if_stmt.else_branch = else_branch;
+    }
+    return node;
+}
+
+/** @brief არჩევს `სანამ` ციკლს. */
+static AstNode* while_statement(Parser* parser) {
+    AstNode* condition = expression(parser);
+    if (condition == NULL) return NULL;
+    AstNode* body = block(parser);
+    if (body == NULL) return NULL;
+    return create_while_node(parser->ast, condition, body);
+}
+
+/**
+ * @brief არჩევს `ყოველი ცვლადი ში საწყისი..ბოლო:` ციკლს და მასივის
+ * ელემენტებზე `ყოველი ცვლადი ში მასივი:` ციკლს (`parallel` — `პარალელური ყოველი`).
+ */
+static AstNode* for_statement(Parser* parser, bool parallel) {
+    consume(parser, TOKEN_IDENTIFIER, "მოსალოდნელი იყო ციკლის ცვლადის სახელი.");
+    if (parser->panic_mode) return NULL;
+    Symbol* variable = intern_symbol(parser->ast, parser->previous.start, parser->previous.length);
+    consume(parser, TOKEN_ში, "მოსალოდნელი იყო 'ში' ციკლის ცვლადის შემდეგ.");
+    if (parser->panic_mode) return NULL;
+    AstNode* iterable = expression(parser);
+    if (iterable == NULL) return NULL;
+    if (!check(parser, TOKEN_COLON)) {
+        consume(parser, TOKEN_DOT, "მოსალოდნელი იყო '..' დიაპაზონში ან ':' მასივის შემდეგ.");
+        consume(parser, TOKEN_DOT, "მოსალოდნელი იყო '..' დიაპაზონში.");
+        if (parser->panic_mode) return NULL;
+        AstNode* end = expression(parser);
+        if (end == NULL) return NULL;
+        if (!check(parser, TOKEN_COLON)) {
+            error_at(parser, &parser->current, "მოსალოდნელი იყო ':' დიაპაზონის შემდეგ.");
+            return NULL;
+        }
+        iterable = create_range_node(parser->ast, iterable, end);
+    }
+    AstNode* body = block(parser);
+    if (body == NULL) return NULL;
+    return create_for_node(parser->ast, variable, iterable, body, parallel);
 }
 
 /** @brief არჩევს განცხადებას. */
@@ -101,41 +568,146 @@ static AstNode* statement(Parser* parser) {
     if (match(parser, TOKEN_დაბეჭდე)) {
         return print_statement(parser);
     }
+    if (match(parser, TOKEN_თუ)) {
+        return if_statement(parser);
+    }
+    if (match(parser, TOKEN_სანამ)) {
+        return while_statement(parser);
+    }
+    if (match(parser, TOKEN_ყოველი)) {
+        return for_statement(parser, false);
+    }
+    if (match(parser, TOKEN_პარალელური)) {
+        consume(parser, TOKEN_ყოველი, "მოსალოდნელი იყო 'ყოველი' 'პარალელური'-ს შემდეგ.");
+        if (parser->panic_mode) return NULL;
+        return for_statement(parser, true);
+    }
+    if (match(parser, TOKEN_დაბრუნე)) {
+        return return_statement(parser);
+    }
+    if (match(parser, TOKEN_IDENTIFIER)) {
+        if (check(parser, TOKEN_EQUAL)) return assignment(parser);
+        return expression_statement(parser);
+    }
     error_at(parser, &parser->current, "უცნობი განცხადება.");
     return NULL;
 }
 
+/**
+ * @brief არჩევს ფუნქციის განსაზღვრას: `ფუნქცია სახელი(პ1, პ2):` და ბლოკი.
+ * სათაურის შეცდომისას ბლოკს synchronize მთლიანად გამოტოვებს.
+ */
+static AstNode* function_declaration(Parser* parser) {
+    consume(parser, TOKEN_IDENTIFIER, "მოსალოდნელი იყო ფუნქციის სახელი.");
+    if (parser->panic_mode) return NULL;
+    Symbol* name = intern_symbol(parser->ast, parser->previous.start, parser->previous.length);
+    consume(parser, TOKEN_LPAREN, "მოსალოდნელი იყო '(' ფუნქციის სახელის შემდეგ.");
+    if (parser->panic_mode) return NULL;
+    AstNode* parameters = create_block_node(parser->ast);
+    if (!check(parser, TOKEN_RPAREN)) {
+        do {
+            consume(parser, TOKEN_IDENTIFIER, "მოსალოდნელი იყო პარამეტრის სახელი.");
+            if (parser->panic_mode) return NULL;
+            Symbol* parameter = intern_symbol(parser->ast, parser->previous.start, parser->previous.length);
+            add_statement_to_block(parser->ast, parameters, create_variable_node(parser->ast, parameter));
+        } while (match(parser, TOKEN_COMMA));
+    }
+    consume(parser, TOKEN_RPAREN, "მოსალოდნელი იყო ')' პარამეტრების შემდეგ.");
+    if (parser->panic_mode) return NULL;
+    if (!check(parser, TOKEN_COLON)) {
+        error_at(parser, &parser->current, "მოსალოდნელი იყო ':' ფუნქციის სათაურის შემდეგ.");
+        return NULL;
+    }
+    AstNode* body = block(parser);
+    if (body == NULL) return NULL;
+    return create_function_node(parser->ast, name, parameters, body);
+}
+
 /** @brief არჩევს დეკლარაციას (უმაღლესი დონის კონსტრუქცია). */
 static AstNode* declaration(Parser* parser) {
     if (match(parser, TOKEN_ცვლადი)) {
         return var_declaration(parser);
     }
+    if (match(parser, TOKEN_ფუნქცია)) {
+        return function_declaration(parser);
+    }
     return statement(parser);
 }
 
 // --- მთავარი ფუნქციები ---
 
 /** @brief პარსერის ინიციალიზაცია. */
-void init_parser(Parser* parser, Lexer* lexer) {
+void init_parser(Parser* parser, Lexer* lexer, AstContext* ast) {
     parser->lexer = lexer;
+    parser->tokens = NULL;
+    parser->position = 0;
+    parser->ast = ast;
+    parser->max_depth = PARSER_DEFAULT_MAX_DEPTH;
     parser->had_error = false;
     parser->panic_mode = false;
     advance(parser);
 }
 
+/** @brief პარსერის ინიციალიზაცია წინასწარ დასკანერებული ნაკადით. */
+void init_parser_from_stream(Parser* parser, TokenStream* tokens, AstContext* ast) {
+    init_parser_at(parser, tokens, 0, ast);
+}
+
+/** @brief პარსერის ინიციალიზაცია ნაკადის `index`-ე ტოკენიდან. */
+void init_parser_at(Parser* parser, TokenStream* tokens, int index, AstContext* ast) {
+    parser->lexer = NULL;
+    parser->tokens = tokens;
+    parser->position = index;
+    parser->ast = ast;
+    parser->max_depth = PARSER_DEFAULT_MAX_DEPTH;
+    parser->had_error = false;
+    parser->panic_mode = false;
+    advance(parser);
+}
+
+/**
+ * @brief შეცდომის შემდეგ გამოტოვებს ტოკენებს მომდევნო ხაზამდე, ხოლო თუ
+ * ხაზს შეწეული ბლოკი მოსდევს — ამ ბლოკის ბოლომდეც, რომ შეცდომიანი სათაურის
+ * ბლოკი ცალკეულ შეცდომებად არ დაიშალოს. გარე ბლოკის DEDENT-ს არ მოიხმარს.
+ * ყოველთვის წინ მიიწევს: ხაზის დასაწყისში მომხდარი შეცდომა (მაგ. უცნობი
+ * განცხადება) სხვაგვარად იმავე ტოკენზე უსასრულოდ განმეორდებოდა.
+ */
+static void synchronize(Parser* parser) {
+    int depth = 0;
+    for (bool first = true; !check(parser, TOKEN_EOF); first = false) {
+        TokenType type = parser->current.type;
+        if (type == TOKEN_DEDENT && depth == 0 && !first) break;
+        advance(parser);
+        if (type == TOKEN_INDENT) depth++;
+        if (type == TOKEN_DEDENT && depth > 0) depth--;
+        if (depth == 0 && (type == TOKEN_NEWLINE || type == TOKEN_DEDENT) && !check(parser, TOKEN_INDENT)) break;
+    }
+    // დროშა ბოლოს სუფთავდება: გამოტოვებისას ნანახმა შეცდომის ტოკენმა შემდეგი
+    // განცხადების შეცდომა არ უნდა დაფაროს (ყოველი განცხადება ერთნაირ მდგომარეობაში იწყება).
+    parser->panic_mode = false;
+}
+
+AstNode* parse_declaration(Parser* parser) {
+    const char* start = parser->current.start;
+    int line = parser->current.line;
+    AstNode* decl = declaration(parser);
+    if (decl != NULL) decl->line = line;
+    if (parser->panic_mode) {
+        // განცხადებამ თავისი ხაზი უკვე დაასრულა (მაგ. შეცდომა ხაზის ბოლოს):
+        // გამოტოვება მომდევნო, სწორ ხაზს დაკარგავდა.
+        if (parser->current.start != start && parser->previous.type == TOKEN_NEWLINE) parser->panic_mode = false;
+        else synchronize(parser);
+    }
+    return decl;
+}
+
 /** @brief არჩევს პროგრამას, რომელიც შედგება მრავალი დეკლარაციისგან. */
 AstNode* parse(Parser* parser) {
-    AstNode* program = create_program_node();
+    AstNode* program = create_program_node(parser->ast);
     while (!check(parser, TOKEN_EOF)) {
-        AstNode* decl = declaration(parser);
+        AstNode* decl = parse_declaration(parser);
         if (decl) {
-            add_statement_to_program(program, decl);
-        }
-        if (parser->panic_mode) {
-             while(!check(parser, TOKEN_EOF) && parser->previous.type != TOKEN_NEWLINE) {
-                 advance(parser);
-             }
-             parser->panic_mode = false;
+            add_statement_to_program(parser->ast, program, decl);
         }
     }
     return program;
@@ -0,0 +1,230 @@
+/**
+ * @file scan_simd.c
+ * @author გიორგი მაღრაძე (magradze.giorgi@gmail.com)
+ * @brief ლექსერის SIMD სკანირების ბირთვების იმპლემენტაცია.
+ * @version 0.1
+ */
+#include <stdlib.h>
+#include <string.h>
+#include "scan_simd.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SCAN_HAVE_X86 1
+#endif
+
+// --- სკალარული ბირთვები (ყველა პლატფორმაზე და ვექტორული ბირთვების კუდისთვის) ---
+
+/** @brief არის თუ არა ბაიტი იდენტიფიკატორის ნაწილი. */
+static bool is_identifier_byte(unsigned char c) {
+    return c >= 0x80 || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+}
+
+static const char* scalar_identifier(const char* p, const char* end) {
+    while (p < end && is_identifier_byte((unsigned char)*p)) p++;
+    return p;
+}
+
+static const char* scalar_spaces(const char* p, const char* end) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) p++;
+    return p;
+}
+
+static const char* scalar_line_end(const char* p, const char* end) {
+    while (p < end && *p != '\n') p++;
+    return p;
+}
+
+static const char* scalar_string_body(const char* p, const char* end, int* newlines) {
+    while (p < end && *p != '"') {
+        if (*p == '\n') (*newlines)++;
+        p++;
+    }
+    return p;
+}
+
+#ifdef SCAN_HAVE_X86
+
+// --- SSE2 ბირთვები (16 ბაიტი ერთ ნაბიჯზე) ---
+
+/**
+ * @brief აბრუნებს 16-ბიტიან ნიღაბს: ბიტი 1, თუ შესაბამისი ბაიტი იდენტიფიკატორს ეკუთვნის.
+ * ბაიტები >= 0x80 ნიშნიანი შედარებისას უარყოფითია; ლათინური ასოები 0x20-ით
+ * OR-ის შემდეგ 'a'..'z' დიაპაზონში ხვდება.
+ */
+static unsigned int sse2_identifier_mask(__m128i bytes) {
+    __m128i high = _mm_cmplt_epi8(bytes, _mm_setzero_si128());
+    __m128i lower = _mm_or_si128(bytes, _mm_set1_epi8(0x20));
+    __m128i alpha = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+                                  _mm_cmplt_epi8(lower, _mm_set1_epi8('z' + 1)));
+    __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(bytes, _mm_set1_epi8('0' - 1)),
+                                  _mm_cmplt_epi8(bytes, _mm_set1_epi8('9' + 1)));
+    __m128i underscore = _mm_cmpeq_epi8(bytes, _mm_set1_epi8('_'));
+    __m128i all = _mm_or_si128(_mm_or_si128(high, alpha), _mm_or_si128(digit, underscore));
+    return (unsigned int)_mm_movemask_epi8(all);
+}
+
+static const char* sse2_identifier(const char* p, const char* end) {
+    while (end - p >= 16) {
+        unsigned int mask = sse2_identifier_mask(_mm_loadu_si128((const __m128i*)p));
+        if (mask != 0xFFFF) return p + __builtin_ctz(~mask);
+        p += 16;
+    }
+    return scalar_identifier(p, end);
+}
+
+static const char* sse2_spaces(const char* p, const char* end) {
+    while (end - p >= 16) {
+        __m128i bytes = _mm_loadu_si128((const __m128i*)p);
+        __m128i space = _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(' ')),
+                                     _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('\t')),
+                                                  _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\r'))));
+        unsigned int mask = (unsigned int)_mm_movemask_epi8(space);
+        if (mask != 0xFFFF) return p + __builtin_ctz(~mask);
+        p += 16;
+    }
+    return scalar_spaces(p, end);
+}
+
+static const char* sse2_line_end(const char* p, const char* end) {
+    while (end - p >= 16) {
+        __m128i bytes = _mm_loadu_si128((const __m128i*)p);
+        unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('\n')));
+        if (mask) return p + __builtin_ctz(mask);
+        p += 16;
+    }
+    return scalar_line_end(p, end);
+}
+
+static const char* sse2_string_body(const char* p, const char* end, int* newlines) {
+    while (end - p >= 16) {
+        __m128i bytes = _mm_loadu_si128((const __m128i*)p);
+        unsigned int quote = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('"')));
+        unsigned int newline = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('\n')));
+        if (quote) {
+            int offset = __builtin_ctz(quote);
+            *newlines += __builtin_popcount(newline & ((1u << offset) - 1));
+            return p + offset;
+        }
+        *newlines += __builtin_popcount(newline);
+        p += 16;
+    }
+    return scalar_string_body(p, end, newlines);
+}
+
+// --- AVX2 ბირთვები (32 ბაიტი ერთ ნაბიჯზე) ---
+
+#define AVX2 __attribute__((target("avx2")))
+
+AVX2 static unsigned int avx2_identifier_mask(__m256i bytes) {
+    __m256i high = _mm256_cmpgt_epi8(_mm256_setzero_si256(), bytes);
+    __m256i lower = _mm256_or_si256(bytes, _mm256_set1_epi8(0x20));
+    __m256i alpha = _mm256_and_si256(_mm256_cmpgt_epi8(lower, _mm256_set1_epi8('a' - 1)),
+                                     _mm256_cmpgt_epi8(_mm256_set1_epi8('z' + 1), lower));
+    __m256i digit = _mm256_and_si256(_mm256_cmpgt_epi8(bytes, _mm256_set1_epi8('0' - 1)),
+                                     _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), bytes));
+    __m256i underscore = _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('_'));
+    __m256i all = _mm256_or_si256(_mm256_or_si256(high, alpha), _mm256_or_si256(digit, underscore));
+    return (unsigned int)_mm256_movemask_epi8(all);
+}
+
+AVX2 static const char* avx2_identifier(const char* p, const char* end) {
+    while (end - p >= 32) {
+        unsigned int mask = avx2_identifier_mask(_mm256_loadu_si256((const __m256i*)p));
+        if (mask != 0xFFFFFFFFu) return p + __builtin_ctz(~mask);
+        p += 32;
+    }
+    return sse2_identifier(p, end);
+}
+
+AVX2 static const char* avx2_spaces(const char* p, const char* end) {
+    while (end - p >= 32) {
+        __m256i bytes = _mm256_loadu_si256((const __m256i*)p);
+        __m256i space = _mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(' ')),
+                                        _mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\t')),
+                                                        _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\r'))));
+        unsigned int mask = (unsigned int)_mm256_movemask_epi8(space);
+        if (mask != 0xFFFFFFFFu) return p + __builtin_ctz(~mask);
+        p += 32;
+    }
+    return sse2_spaces(p, end);
+}
+
+AVX2 static const char* avx2_line_end(const char* p, const char* end) {
+    while (end - p >= 32) {
+        __m256i bytes = _mm256_loadu_si256((const __m256i*)p);
+        unsigned int mask = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\n')));
+        if (mask) return p + __builtin_ctz(mask);
+        p += 32;
+    }
+    return sse2_line_end(p, end);
+}
+
+AVX2 static const char* avx2_string_body(const char* p, const char* end, int* newlines) {
+    while (end - p >= 32) {
+        __m256i bytes = _mm256_loadu_si256((const __m256i*)p);
+        unsigned int quote = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('"')));
+        unsigned int newline = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\n')));
+        if (quote) {
+            int offset = __builtin_ctz(quote);
+            *newlines += __builtin_popcount(newline & ((1u << offset) - 1));
+            return p + offset;
+        }
+        *newlines += __builtin_popcount(newline);
+        p += 32;
+    }
+    return sse2_string_body(p, end, newlines);
+}
+
+#endif // SCAN_HAVE_X86
+
+// --- ბირთვების არჩევა ---
+
+static const ScanKernels scalar_kernels = {
+    "scalar", scalar_identifier, scalar_spaces, scalar_line_end, scalar_string_body,
+};
+
+#ifdef SCAN_HAVE_X86
+static const ScanKernels sse2_kernels = {
+    "sse2", sse2_identifier, sse2_spaces, sse2_line_end, sse2_string_body,
+};
+
+static const ScanKernels avx2_kernels = {
+    "avx2", avx2_identifier, avx2_spaces, avx2_line_end, avx2_string_body,
+};
+#endif
+
+ScanKernels scan_kernels = {
+    "scalar", scalar_identifier, scalar_spaces, scalar_line_end, scalar_string_body,
+};
+
+bool select_scan_kernels(const char* name) {
+    if (strcmp(name, "scalar") == 0) {
+        scan_kernels = scalar_kernels;
+        return true;
+    }
+#ifdef SCAN_HAVE_X86
+    __builtin_cpu_init();
+    if (strcmp(name, "sse2") == 0 && __builtin_cpu_supports("sse2")) {
+        scan_kernels = sse2_kernels;
+        return true;
+    }
+    if (strcmp(name, "avx2") == 0 && __builtin_cpu_supports("avx2")) {
+        scan_kernels = avx2_kernels;
+        return true;
+    }
+#endif
+    return false;
+}
+
+/**
+ * @brief ირჩევს საუკეთესო ხელმისაწვდომ ბირთვებს პროგრამის გაშვებისას,
+ * ნაკადების შექმნამდე, ამიტომ შემდგომი წაკითხვები სინქრონიზაციას არ საჭიროებს.
+ */
+__attribute__((constructor)) static void init_scan_kernels(void) {
+    const char* forced = getenv("MANUSCRIPT_SIMD");
+    if (forced && select_scan_kernels(forced)) return;
+    if (select_scan_kernels("avx2")) return;
+    if (select_scan_kernels("sse2")) return;
+    select_scan_kernels("scalar");
+}
@@ -0,0 +1,122 @@
+/**
+ * @file source.c
+ * @author გიორგი მაღრაძე (magradze.giorgi@gmail.com)
+ * @brief საწყისი კოდის ფაილის ჩატვირთვის იმპლემენტაცია.
+ * @version 0.1
+ */
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "source.h"
+
+// ტოკენების ნაკადი წანაცვლებებს 32-ბიტიან რიცხვებში ინახავს.
+#define MAX_SOURCE_LENGTH ((size_t)UINT32_MAX)
+
+/** @brief კითხულობს ფაილის აღმწერს ბოლომდე ორჯერ მზარდ ბუფერში. */
+static bool read_stream(SourceFile* source, int fd, const char* path) {
+    size_t capacity = 64 * 1024;
+    size_t length = 0;
+    char* buffer = malloc(capacity);
+    if (!buffer) {
+        fprintf(stderr, "მეხსიერების გამოყოფის შეცდომა\n");
+        return false;
+    }
+
+    for (;;) {
+        if (length == capacity) {
+            if (capacity >= MAX_SOURCE_LENGTH) {
+                fprintf(stderr, "'%s': ფაილი ძალიან დიდია.\n", path);
+                free(buffer);
+                return false;
+            }
+            capacity *= 2;
+            char* grown = realloc(buffer, capacity);
+            if (!grown) {
+                fprintf(stderr, "მეხსიერების გამოყოფის შეცდომა\n");
+                free(buffer);
+                return false;
+            }
+            buffer = grown;
+        }
+        ssize_t count = read(fd, buffer + length, capacity - length);
+        if (count == 0) break;
+        if (count < 0) {
+            perror("ფაილის წაკითხვის შეცდომა");
+            free(buffer);
+            return false;
+        }
+        length += (size_t)count;
+    }
+
+    source->buffer = buffer;
+    source->data = buffer;
+    source->length = length;
+    return true;
+}
+
+bool load_source(SourceFile* source, const char* path) {
+    memset(source, 0, sizeof(*source));
+
+    if (strcmp(path, "-") == 0) return read_stream(source, STDIN_FILENO, "<stdin>");
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        perror("შეცდომა ფაილის გახსნისას");
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        perror("შეცდომა ფაილის გახსნისას");
+        close(fd);
+        return false;
+    }
+
+    // არხები, მოწყობილობები და ა.შ. ასახვას არ ექვემდებარება.
+    if (!S_ISREG(info.st_mode)) {
+        bool ok = read_stream(source, fd, path);
+        close(fd);
+        return ok;
+    }
+
+    size_t length = (size_t)info.st_size;
+    if (length > MAX_SOURCE_LENGTH) {
+        fprintf(stderr, "'%s': ფაილი ძალიან დიდია.\n", path);
+        close(fd);
+        return false;
+    }
+    if (length == 0) {
+        close(fd);
+        source->data = "";
+        return true;
+    }
+
+    // ასახვა მხოლოდ წასაკითხადაა და ფაილის ბოლოს NUL-ს არ საჭიროებს: ლექსერი
+    // საზღვარს სიგრძით ამოწმებს და ბოლოს მიღმა ბაიტებს არასდროს კითხულობს.
+    void* mapping = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping == MAP_FAILED) {
+        // ზოგიერთი ფაილური სისტემა ასახვას არ უჭერს მხარს — ვკითხულობთ ჩვეულებრივად.
+        bool ok = read_stream(source, fd, path);
+        close(fd);
+        return ok;
+    }
+    close(fd);
+    posix_madvise(mapping, length, POSIX_MADV_SEQUENTIAL);
+
+    source->mapping = mapping;
+    source->data = mapping;
+    source->length = length;
+    return true;
+}
+
+void free_source(SourceFile* source) {
+    if (source->mapping) munmap(source->mapping, source->length);
+    free(source->buffer);
+    memset(source, 0, sizeof(*source));
+}
@@ -0,0 +1,123 @@
+/**
+ * @file stats.c
+ * @author გიორგი მაღრაძე (magradze.giorgi@gmail.com)
+ * @brief კომპილაციის ეტაპების სტატისტიკის იმპლემენტაცია.
+ * @version 0.1
+ */
+#define _POSIX_C_SOURCE 200809L
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <sys/resource.h>
+#include "stats.h"
+
+static const char* phase_names[STATS_PHASE_COUNT] = {
+    [STATS_PHASE_LEX] = "lex",
+    [STATS_PHASE_PARSE] = "parse",
+    [STATS_PHASE_ANALYZE] = "analyze",
+    [STATS_PHASE_CODEGEN] = "codegen",
+    [STATS_PHASE_CC] = "cc",
+    [STATS_PHASE_RUN] = "run",
+};
+
+/** @brief rusage-ის მომხმარებლისა და სისტემის დროის ჯამი წამებში. */
+static double rusage_seconds(int who) {
+    struct rusage usage;
+    if (getrusage(who, &usage) != 0) return 0;
+    return (double)(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) +
+           (double)(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) * 1e-6;
+}
+
+/** @brief პიკური RSS ბაიტებში (Linux-ზე ru_maxrss კილობაიტებშია). */
+static long long peak_rss_bytes(int who) {
+    struct rusage usage;
+    if (getrusage(who, &usage) != 0) return 0;
+    return (long long)usage.ru_maxrss * 1024;
+}
+
+/** @brief მიმდინარე ანაბეჭდი: მონოტონური საათი და პროცესის + შვილების CPU დრო. */
+static StatsMark current_mark(void) {
+    struct timespec wall, cpu;
+    clock_gettime(CLOCK_MONOTONIC, &wall);
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &cpu);
+    StatsMark mark;
+    mark.wall = (double)wall.tv_sec + (double)wall.tv_nsec * 1e-9;
+    mark.cpu = (double)cpu.tv_sec + (double)cpu.tv_nsec * 1e-9 + rusage_seconds(RUSAGE_CHILDREN);
+    return mark;
+}
+
+void init_compile_stats(CompileStats* stats, const char* json_path) {
+    memset(stats, 0, sizeof(*stats));
+    stats->json_path = json_path;
+    stats->start = current_mark();
+}
+
+StatsMark stats_mark(const CompileStats* stats) {
+    if (stats == NULL) {
+        StatsMark none = { 0, 0 };
+        return none;
+    }
+    return current_mark();
+}
+
+void stats_record(CompileStats* stats, StatsPhase phase, StatsMark start) {
+    if (stats == NULL) return;
+    StatsMark now = current_mark();
+    PhaseTime* time = &stats->phases[phase];
+    time->wall += now.wall - start.wall;
+    time->cpu += now.cpu - start.cpu;
+    time->measured = true;
+}
+
+void print_compile_stats(const CompileStats* stats, FILE* out) {
+    StatsMark total = current_mark();
+    fprintf(out, "--- კომპილაციის სტატისტიკა ---\n");
+    fprintf(out, "ეტაპი     კედლის დრო       CPU დრო\n");
+    for (int phase = 0; phase < STATS_PHASE_COUNT; phase++) {
+        const PhaseTime* time = &stats->phases[phase];
+        if (!time->measured) continue;
+        fprintf(out, "%-8s %9.3f ms %9.3f ms\n", phase_names[phase], time->wall * 1e3, time->cpu * 1e3);
+    }
+    fprintf(out, "სულ      %9.3f ms %9.3f ms\n", (total.wall - stats->start.wall) * 1e3,
+            (total.cpu - stats->start.cpu) * 1e3);
+    fprintf(out, "საწყისი კოდი: %zu ბაიტი, %ld ტოკენი, %ld კვანძი (ოპტიმიზაციის შემდეგ %ld)\n",
+            stats->source_bytes, stats->tokens, stats->nodes, stats->nodes_optimized);
+    fprintf(out, "მეხსიერება: ტოკენები %zu ბაიტი, AST არენა %zu ბაიტი (დაკავებული %zu), C კოდი %zu ბაიტი\n",
+            stats->token_bytes, stats->arena_bytes, stats->arena_reserved, stats->code_bytes);
+    fprintf(out, "პიკური RSS: კომპილატორი %.1f MB, შვილობილი პროცესები %.1f MB\n",
+            (double)peak_rss_bytes(RUSAGE_SELF) / (1024 * 1024),
+            (double)peak_rss_bytes(RUSAGE_CHILDREN) / (1024 * 1024));
+}
+
+bool write_compile_stats_json(const CompileStats* stats) {
+    FILE* file = fopen(stats->json_path, "w");
+    if (file == NULL) {
+        fprintf(stderr, "სტატისტიკის ფაილის გახსნა ვერ მოხერხდა: %s: %s\n", stats->json_path, strerror(errno));
+        return false;
+    }
+    StatsMark total = current_mark();
+    fprintf(file, "{\n  \"phases\": {\n");
+    bool first = true;
+    for (int phase = 0; phase < STATS_PHASE_COUNT; phase++) {
+        const PhaseTime* time = &stats->phases[phase];
+        if (!time->measured) continue;
+        fprintf(file, "%s    \"%s\": { \"wall_seconds\": %.9f, \"cpu_seconds\": %.9f }", first ? "" : ",\n",
+                phase_names[phase], time->wall, time->cpu);
+        first = false;
+    }
+    fprintf(file, "%s  },\n", first ? "" : "\n");
+    fprintf(file, "  \"total\": { \"wall_seconds\": %.9f, \"cpu_seconds\": %.9f },\n",
+            total.wall - stats->start.wall, total.cpu - stats->start.cpu);
+    fprintf(file, "  \"source_bytes\": %zu,\n  \"tokens\": %ld,\n  \"nodes\": %ld,\n  \"nodes_optimized\": %ld,\n",
+            stats->source_bytes, stats->tokens, stats->nodes, stats->nodes_optimized);
+    fprintf(file, "  \"allocated_bytes\": { \"tokens\": %zu, \"arena\": %zu, \"arena_reserved\": %zu, \"code\": %zu },\n",
+            stats->token_bytes, stats->arena_bytes, stats->arena_reserved, stats->code_bytes);
+    fprintf(file, "  \"peak_rss_bytes\": { \"compiler\": %lld, \"children\": %lld }\n}\n",
+            peak_rss_bytes(RUSAGE_SELF), peak_rss_bytes(RUSAGE_CHILDREN));
+    if (fclose(file) != 0) {
+        fprintf(stderr, "სტატისტიკის ფაილის ჩაწერა ვერ მოხერხდა: %s\n", stats->json_path);
+        return false;
+    }
+    return true;
+}
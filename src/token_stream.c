@@ -0,0 +1,303 @@
+/**
+ * @file token_stream.c
+ * @author გიორგი მაღრაძე (magradze.giorgi@gmail.com)
+ * @brief წინასწარ დასკანერებული ტოკენების ნაკადის იმპლემენტაცია.
+ * @version 0.2
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "token_stream.h"
+
+/** @brief realloc-ის შეფუთვა, რომელიც შეცდომისას ასრულებს პროგრამას. */
+static void* grow_array(void* array, size_t new_size) {
+    void* result = realloc(array, new_size);
+    if (!result) {
+        fprintf(stderr, "FATAL: Memory allocation failed for token stream.\n");
+        exit(1);
+    }
+    return result;
+}
+
+/** @brief ადიდებს ნაკადის მასივებს ორჯერ. */
+static void grow_stream(TokenStream* stream) {
+    int capacity = stream->capacity < 64 ? 64 : stream->capacity * 2;
+    stream->types = grow_array(stream->types, sizeof(uint8_t) * (size_t)capacity);
+    stream->offsets = grow_array(stream->offsets, sizeof(uint32_t) * (size_t)capacity);
+    stream->lengths = grow_array(stream->lengths, sizeof(uint32_t) * (size_t)capacity);
+    stream->capacity = capacity;
+}
+
+/** @brief ინახავს შეცდომის ტოკენის შეტყობინებას. */
+static void add_error(TokenStream* stream, int index, const char* message) {
+    if (stream->error_count >= stream->error_capacity) {
+        stream->error_capacity = stream->error_capacity < 8 ? 8 : stream->error_capacity * 2;
+        stream->errors = grow_array(stream->errors, sizeof(TokenStreamError) * (size_t)stream->error_capacity);
+    }
+    stream->errors[stream->error_count].index = index;
+    stream->errors[stream->error_count].message = message;
+    stream->error_count++;
+}
+
+/** @brief აგებს ხაზების დასაწყისების ცხრილს (მხოლოდ პირველი მოთხოვნისას). */
+static void ensure_line_table(TokenStream* stream) {
+    if (stream->line_starts) return;
+
+    int capacity = 64;
+    stream->line_starts = grow_array(NULL, sizeof(uint32_t) * (size_t)capacity);
+    stream->line_starts[0] = 0;
+    stream->line_count = 1;
+
+    const char* cursor = stream->source;
+    const char* end = stream->source + stream->source_length;
+    while ((cursor = memchr(cursor, '\n', (size_t)(end - cursor))) != NULL) {
+        cursor++;
+        if (stream->line_count >= capacity) {
+            capacity *= 2;
+            stream->line_starts = grow_array(stream->line_starts, sizeof(uint32_t) * (size_t)capacity);
+        }
+        stream->line_starts[stream->line_count++] = (uint32_t)(cursor - stream->source);
+    }
+    stream->line_hint = 0;
+}
+
+/** @brief ამოწმებს, ეკუთვნის თუ არა წანაცვლება `line`-ე (0-დან) ხაზს. */
+static bool offset_on_line(TokenStream* stream, int line, uint32_t offset) {
+    if (line < 0 || line >= stream->line_count) return false;
+    if (stream->line_starts[line] > offset) return false;
+    return line + 1 == stream->line_count || stream->line_starts[line + 1] > offset;
+}
+
+/**
+ * @brief ამატებს ტოკენს ნაკადის ბოლოს. წანაცვლება `lexer`-ის საწყისი
+ * კოდის დასაწყისიდან ითვლება.
+ */
+static void push_token(TokenStream* stream, Token token, const Lexer* lexer, const char* source) {
+    if (stream->count >= stream->capacity) grow_stream(stream);
+
+    int index = stream->count++;
+    stream->types[index] = (uint8_t)token.type;
+    if (token.type == TOKEN_ERROR) {
+        // შეცდომის ტოკენის start შეტყობინებაზე მიუთითებს, ამიტომ პოზიციად
+        // ლექსერის მიმდინარე ადგილს ვინახავთ.
+        stream->offsets[index] = (uint32_t)(lexer->current - source);
+        stream->lengths[index] = 0;
+        add_error(stream, index, token.start);
+        return;
+    }
+    stream->offsets[index] = (uint32_t)(token.start - source);
+    stream->lengths[index] = (uint32_t)token.length;
+}
+
+void lex_all(TokenStream* stream, const char* source, size_t length) {
+    memset(stream, 0, sizeof(*stream));
+    stream->source = source;
+    stream->source_length = (uint32_t)length;
+
+    Lexer lexer;
+    init_lexer(&lexer, source, length);
+
+    for (;;) {
+        Token token = scan_token(&lexer);
+        push_token(stream, token, &lexer, source);
+        if (token.type == TOKEN_EOF) break;
+    }
+}
+
+/** @brief ტექსტიანი ტოკენი (არა INDENT/DEDENT/EOF/შეცდომა). */
+static bool is_real_token(TokenType type) {
+    return type != TOKEN_INDENT && type != TOKEN_DEDENT && type != TOKEN_EOF && type != TOKEN_ERROR;
+}
+
+/** @brief ამოწმებს, იწყება თუ არა `offset` ხაზის დასაწყისში (შეწევის გარეშე). */
+static bool at_line_start(const char* source, uint32_t offset) {
+    return offset == 0 || source[offset - 1] == '\n';
+}
+
+/** @brief აბრუნებს პირველი ტოკენის ინდექსს, რომლის წანაცვლება >= `offset`. */
+static int lower_bound(const TokenStream* stream, uint32_t offset) {
+    int low = 0;
+    int high = stream->count;
+    while (low < high) {
+        int mid = low + (high - low) / 2;
+        if (stream->offsets[mid] < offset) low = mid + 1;
+        else high = mid;
+    }
+    return low;
+}
+
+/**
+ * @brief პოულობს ხელახალი სკანირების დასაწყისს: `edit_start`-მდე ბოლო
+ * ტოკენს, რომელიც შეწევის გარეშე ხაზს იწყებს. ასეთ წერტილში ლექსერის
+ * მდგომარეობა (შეწევის დასტა) საწყისის ტოლია, ამიტომ ახალი ლექსერი იქიდან
+ * ისე აგრძელებს, თითქოს ფაილი თავიდან წაიკითხა. ტოკენი მკაცრად ცვლილებამდე
+ * უნდა იწყებოდეს: მის წინა DEDENT-ები იმაზეც არის დამოკიდებული, რომ მისი
+ * ხაზი ცარიელი არ არის.
+ */
+static int find_restart(const TokenStream* stream, uint32_t edit_start) {
+    int index = lower_bound(stream, edit_start) - 1;
+    for (; index > 0; index--) {
+        TokenType type = (TokenType)stream->types[index];
+        if (is_real_token(type) && at_line_start(stream->source, stream->offsets[index])) break;
+    }
+    return index < 0 ? 0 : index;
+}
+
+/**
+ * @brief ეძებს ძველ ნაკადში ტოკენს, რომლიდანაც ახალი სკანირება ძველს
+ * ემთხვევა: ორივე ნაკადში შეწევის გარეშე ხაზის პირველი ტოკენი, ცვლილების
+ * შემდეგ. -1 — თუ ასეთი არ არის.
+ */
+static int find_resync(const TokenStream* old, const TokenStream* fresh, int index, const char* source,
+                       uint32_t new_edit_end, int64_t delta) {
+    uint32_t offset = fresh->offsets[index];
+    TokenType type = (TokenType)fresh->types[index];
+    if (offset < new_edit_end || !is_real_token(type) || !at_line_start(source, offset)) return -1;
+
+    uint32_t old_offset = (uint32_t)((int64_t)offset - delta);
+    if (!at_line_start(old->source, old_offset)) return -1;
+    int match = lower_bound(old, old_offset);
+    // იმავე წანაცვლებაზე წინ შეიძლება DEDENT-ები იდგეს; ისინი ახალი სკანირებიდან მოდის.
+    while (match < old->count && old->offsets[match] == old_offset && !is_real_token((TokenType)old->types[match])) {
+        match++;
+    }
+    if (match >= old->count || old->offsets[match] != old_offset || old->types[match] != (uint8_t)type) return -1;
+    return match;
+}
+
+void relex_token_stream(TokenStream* stream, const char* source, size_t length, uint32_t edit_start,
+                        uint32_t old_edit_end, uint32_t new_edit_end, TokenStreamEdit* edit) {
+    int64_t delta = (int64_t)new_edit_end - (int64_t)old_edit_end;
+    int first = find_restart(stream, edit_start);
+    // ნულოვანი ტოკენი შეიძლება INDENT იყოს, ამიტომ მაშინ ფაილის დასაწყისიდან ვიწყებთ.
+    uint32_t restart = first > 0 ? stream->offsets[first] : 0;
+
+    Lexer lexer;
+    init_lexer(&lexer, source, length);
+    lexer.start = lexer.current = source + restart;
+
+    TokenStream fresh;
+    memset(&fresh, 0, sizeof(fresh));
+    int old_end = stream->count;
+    for (;;) {
+        Token token = scan_token(&lexer);
+        push_token(&fresh, token, &lexer, source);
+        if (token.type == TOKEN_EOF) break;
+        int match = find_resync(stream, &fresh, fresh.count - 1, source, new_edit_end, delta);
+        if (match >= 0) {
+            fresh.count--;
+            old_end = match;
+            break;
+        }
+    }
+
+    // ნაკადი: [0, first) უცვლელი + ახალი ტოკენები + [old_end, count) წანაცვლებული.
+    int tail = stream->count - old_end;
+    int new_end = first + fresh.count;
+    while (stream->capacity < new_end + tail) grow_stream(stream);
+    if (new_end != old_end) {
+        memmove(stream->types + new_end, stream->types + old_end, (size_t)tail * sizeof(uint8_t));
+        memmove(stream->offsets + new_end, stream->offsets + old_end, (size_t)tail * sizeof(uint32_t));
+        memmove(stream->lengths + new_end, stream->lengths + old_end, (size_t)tail * sizeof(uint32_t));
+    }
+    if (delta != 0) {
+        for (int i = new_end; i < new_end + tail; i++) stream->offsets[i] = (uint32_t)((int64_t)stream->offsets[i] + delta);
+    }
+    memcpy(stream->types + first, fresh.types, (size_t)fresh.count * sizeof(uint8_t));
+    memcpy(stream->offsets + first, fresh.offsets, (size_t)fresh.count * sizeof(uint32_t));
+    memcpy(stream->lengths + first, fresh.lengths, (size_t)fresh.count * sizeof(uint32_t));
+
+    // შეცდომების ინდექსები იგივე სამ ნაწილად იყოფა.
+    TokenStreamError* errors = stream->errors;
+    int error_count = stream->error_count;
+    stream->errors = NULL;
+    stream->error_count = stream->error_capacity = 0;
+    for (int i = 0; i < error_count && errors[i].index < first; i++) add_error(stream, errors[i].index, errors[i].message);
+    for (int i = 0; i < fresh.error_count; i++) add_error(stream, fresh.errors[i].index + first, fresh.errors[i].message);
+    for (int i = 0; i < error_count; i++) {
+        if (errors[i].index >= old_end) add_error(stream, errors[i].index - old_end + new_end, errors[i].message);
+    }
+    free(errors);
+    free_token_stream(&fresh);
+
+    stream->count = new_end + tail;
+    stream->source = source;
+    stream->source_length = (uint32_t)length;
+    free(stream->line_starts);
+    stream->line_starts = NULL;
+    stream->line_count = 0;
+
+    edit->first = first;
+    edit->old_end = old_end;
+    edit->new_end = new_end;
+}
+
+int token_stream_line(TokenStream* stream, int index) {
+    ensure_line_table(stream);
+    if (index >= stream->count) index = stream->count - 1;
+    uint32_t offset = stream->offsets[index];
+
+    // პარსერი ტოკენებს თანმიმდევრულად კითხულობს, ამიტომ ჯერ წინა პასუხს
+    // და მის მომდევნო ხაზს ვამოწმებთ, შემდეგ კი ორობით ძებნას ვიყენებთ.
+    int line = stream->line_hint;
+    if (!offset_on_line(stream, line, offset)) {
+        line++;
+        if (!offset_on_line(stream, line, offset)) {
+            int low = 0;
+            int high = stream->line_count - 1;
+            while (low < high) {
+                int mid = low + (high - low + 1) / 2;
+                if (stream->line_starts[mid] <= offset) low = mid;
+                else high = mid - 1;
+            }
+            line = low;
+        }
+    }
+    stream->line_hint = line;
+    return line + 1;
+}
+
+Token token_stream_get(TokenStream* stream, int index) {
+    if (index >= stream->count) index = stream->count - 1;
+
+    Token token;
+    token.type = (TokenType)stream->types[index];
+    token.line = token_stream_line(stream, index);
+    if (token.type == TOKEN_ERROR) {
+        int low = 0;
+        int high = stream->error_count - 1;
+        while (low < high) {
+            int mid = low + (high - low) / 2;
+            if (stream->errors[mid].index < index) low = mid + 1;
+            else high = mid;
+        }
+        token.start = stream->errors[low].message;
+        token.length = (int)strlen(token.start);
+        return token;
+    }
+    token.start = stream->source + stream->offsets[index];
+    token.length = (int)stream->lengths[index];
+    return token;
+}
+
+const char* token_stream_line_text(TokenStream* stream, int line, int* length) {
+    ensure_line_table(stream);
+    if (line < 1 || line > stream->line_count) {
+        *length = 0;
+        return stream->source + stream->source_length;
+    }
+    uint32_t start = stream->line_starts[line - 1];
+    uint32_t end = line < stream->line_count ? stream->line_starts[line] : stream->source_length;
+    while (end > start && (stream->source[end - 1] == '\n' || stream->source[end - 1] == '\r')) end--;
+    *length = (int)(end - start);
+    return stream->source + start;
+}
+
+void free_token_stream(TokenStream* stream) {
+    free(stream->types);
+    free(stream->offsets);
+    free(stream->lengths);
+    free(stream->errors);
+    free(stream->line_starts);
+    memset(stream, 0, sizeof(*stream));
+}
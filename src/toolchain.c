@@ -0,0 +1,286 @@
+/**
+ * @file toolchain.c
+ * @author გიორგი მაღრაძე (magradze.giorgi@gmail.com)
+ * @brief გენერირებული C კოდის კომპილაციის იმპლემენტაცია.
+ * @version 0.6
+ */
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "toolchain.h"
+#include "codegen.h"
+
+#define COMMAND_SIZE 8192
+#define PATH_SIZE 4096
+
+static const char* profile_names[BUILD_PROFILE_COUNT] = {
+    [BUILD_PROFILE_DEBUG] = "debug",
+    [BUILD_PROFILE_RELEASE] = "release",
+    [BUILD_PROFILE_LTO] = "lto",
+    [BUILD_PROFILE_PGO] = "pgo",
+};
+
+static const char* profile_flags[BUILD_PROFILE_COUNT] = {
+    [BUILD_PROFILE_DEBUG] = "-O0 -g",
+    [BUILD_PROFILE_RELEASE] = "-O2 -march=native -ffp-contract=off -fopenmp-simd -DMS_OPENMP_SIMD",
+    [BUILD_PROFILE_LTO] = "-O2 -march=native -ffp-contract=off -fopenmp-simd -DMS_OPENMP_SIMD -flto",
+    [BUILD_PROFILE_PGO] = "-O2 -march=native -ffp-contract=off -fopenmp-simd -DMS_OPENMP_SIMD",
+};
+
+const char* default_c_compiler(void) {
+    const char* env = getenv("CC");
+    return env != NULL && env[0] != '\0' ? env : "gcc";
+}
+
+bool parse_build_profile(const char* name, BuildProfile* profile) {
+    for (int i = 0; i < BUILD_PROFILE_COUNT; i++) {
+        if (strcmp(name, profile_names[i]) == 0) {
+            *profile = (BuildProfile)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+const char* build_profile_name(BuildProfile profile) {
+    return profile >= 0 && profile < BUILD_PROFILE_COUNT ? profile_names[profile] : "?";
+}
+
+const char* build_profile_flags(BuildProfile profile) {
+    return profile >= 0 && profile < BUILD_PROFILE_COUNT ? profile_flags[profile] : "";
+}
+
+bool shell_quote(char* dest, size_t size, const char* text) {
+    size_t length = 0;
+    if (size < 3) return false;
+    dest[length++] = '\'';
+    for (const char* p = text; *p; p++) {
+        const char* piece = *p == '\'' ? "'\\''" : NULL;
+        size_t piece_length = piece ? 4 : 1;
+        if (length + piece_length + 2 > size) return false;
+        if (piece) memcpy(dest + length, piece, piece_length);
+        else dest[length] = *p;
+        length += piece_length;
+    }
+    dest[length++] = '\'';
+    dest[length] = '\0';
+    return true;
+}
+
+/**
+ * @brief აწყობს და shell-ით ასრულებს ბრძანებას.
+ * @return bool true, თუ ბრძანება 0 კოდით დასრულდა.
+ */
+static bool run_command(const char* format, ...) {
+    char command[COMMAND_SIZE];
+    va_list args;
+    va_start(args, format);
+    int written = vsnprintf(command, sizeof(command), format, args);
+    va_end(args);
+    if (written < 0 || (size_t)written >= sizeof(command)) {
+        fprintf(stderr, "C კომპილატორის ბრძანება ძალიან გრძელია.\n");
+        return false;
+    }
+    fflush(stdout);
+    return system(command) == 0;
+}
+
+/** @brief აერთებს დირექტორიასა და ფაილის სახელს; false — თუ ბუფერში არ ეტევა. */
+static bool join_path(char* dest, size_t size, const char* dir, const char* name) {
+    int written = snprintf(dest, size, "%s/%s", dir, name);
+    return written > 0 && (size_t)written < size;
+}
+
+/** @brief ჭრის ბილიკის ბოლო კომპონენტს (`a/b/c` → `a/b`); false — თუ `/` არ არის. */
+static bool strip_last_component(char* path) {
+    char* slash = strrchr(path, '/');
+    if (slash == NULL) return false;
+    if (slash == path) slash[1] = '\0';
+    else *slash = '\0';
+    return true;
+}
+
+bool locate_runtime(RuntimePaths* paths) {
+    char root[PATH_SIZE];
+    const char* home = getenv("MANUSCRIPT_HOME");
+    if (home != NULL && home[0] != '\0') {
+        if (snprintf(root, sizeof(root), "%s", home) >= (int)sizeof(root)) return false;
+    } else {
+        // <root>/build/manuscript → <root>
+        ssize_t length = readlink("/proc/self/exe", root, sizeof(root) - 1);
+        if (length <= 0) return false;
+        root[length] = '\0';
+        if (!strip_last_component(root) || !strip_last_component(root)) return false;
+    }
+    if (!join_path(paths->include_dir, sizeof(paths->include_dir), root, "include") ||
+        !join_path(paths->library, sizeof(paths->library), root, "build/libmanuscript_rt.a")) {
+        return false;
+    }
+    if (access(paths->library, R_OK) != 0) {
+        fprintf(stderr, "runtime ბიბლიოთეკა ვერ მოიძებნა: %s (გაუშვით `make` ან მიუთითეთ MANUSCRIPT_HOME).\n",
+                paths->library);
+        return false;
+    }
+    return true;
+}
+
+/** @brief წერს ბუფერს ფაილში. */
+static bool write_file(const char* path, const CodeBuffer* code) {
+    FILE* file = fopen(path, "w");
+    if (file == NULL) {
+        fprintf(stderr, "დროებითი C ფაილის შექმნა ვერ მოხერხდა: %s\n", path);
+        return false;
+    }
+    bool written = fwrite(code->data, 1, code->length, file) == code->length;
+    if (fclose(file) != 0 || !written) {
+        fprintf(stderr, "დროებითი C ფაილის ჩაწერა ვერ მოხერხდა: %s\n", path);
+        return false;
+    }
+    return true;
+}
+
+bool create_work_dir(char* dir, size_t size) {
+    const char* base = getenv("TMPDIR");
+    if (base == NULL || base[0] == '\0') base = "/tmp";
+    if (!join_path(dir, size, base, "manuscript.XXXXXX") || mkdtemp(dir) == NULL) {
+        fprintf(stderr, "დროებითი დირექტორიის შექმნა ვერ მოხერხდა: %s: %s\n", base, strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+void remove_work_dir(const char* dir) {
+    char quoted[PATH_SIZE];
+    if (shell_quote(quoted, sizeof(quoted), dir)) run_command("rm -rf %s", quoted);
+}
+
+/**
+ * @brief აკომპილირებს კოდს pipe-ით: `<cc> <flags> -x c - -x none <runtime> -o <output>`.
+ * `-x none` აბრუნებს ენის ამოცნობას გაფართოებით, რომ ბიბლიოთეკა C-დ არ წაიკითხოს.
+ */
+static bool compile_via_pipe(const CodeBuffer* code, const char* compiler, const char* flags,
+                             const char* quoted_library, const char* quoted_output) {
+    char command[COMMAND_SIZE];
+    int written = snprintf(command, sizeof(command), "%s %s -x c - -x none %s -o %s",
+                           compiler, flags, quoted_library, quoted_output);
+    if (written < 0 || (size_t)written >= sizeof(command)) {
+        fprintf(stderr, "C კომპილატორის ბრძანება ძალიან გრძელია.\n");
+        return false;
+    }
+
+    fflush(stdout);
+    FILE* pipe = popen(command, "w");
+    if (pipe == NULL) {
+        perror("popen");
+        return false;
+    }
+    bool written_all = fwrite(code->data, 1, code->length, pipe) == code->length;
+    int status = pclose(pipe);
+    if (!written_all) fprintf(stderr, "C კოდის კომპილატორისთვის გადაცემა ვერ მოხერხდა.\n");
+    return written_all && status == 0;
+}
+
+/**
+ * @brief პროფილით მართული ორეტაპიანი აწყობა.
+ * GCC-ს .gcda ფაილები პირდაპირ -fprofile-use-ით იკითხება; Clang-ის .profraw
+ * ფაილები ჯერ llvm-profdata-თი ერთიანდება.
+ */
+static bool build_with_pgo(const CodeBuffer* code, const ToolchainOptions* options, const char* flags,
+                           const char* quoted_library, const char* quoted_output) {
+    char dir[PATH_SIZE];
+    if (!join_path(dir, sizeof(dir), options->work_dir, "pgo.XXXXXX") || mkdtemp(dir) == NULL) {
+        fprintf(stderr, "PGO დირექტორიის შექმნა ვერ მოხერხდა: %s\n", strerror(errno));
+        return false;
+    }
+
+    char source[PATH_SIZE], object[PATH_SIZE], instrumented[PATH_SIZE];
+    char q_dir[PATH_SIZE], q_source[PATH_SIZE], q_object[PATH_SIZE], q_instrumented[PATH_SIZE], q_input[PATH_SIZE];
+    const char* input = options->training_input ? options->training_input : "/dev/null";
+    bool ok = join_path(source, sizeof(source), dir, "program.c") &&
+              join_path(object, sizeof(object), dir, "program.o") &&
+              join_path(instrumented, sizeof(instrumented), dir, "instrumented") &&
+              shell_quote(q_dir, sizeof(q_dir), dir) && shell_quote(q_source, sizeof(q_source), source) &&
+              shell_quote(q_object, sizeof(q_object), object) &&
+              shell_quote(q_instrumented, sizeof(q_instrumented), instrumented) &&
+              shell_quote(q_input, sizeof(q_input), input);
+    if (!ok) fprintf(stderr, "PGO ბილიკი ძალიან გრძელია.\n");
+
+    const char* compiler = options->compiler;
+    bool clang = strstr(compiler, "clang") != NULL;
+
+    // 1. ინსტრუმენტირებული აწყობა. კომპილაცია და ლინკირება ცალკეა, რადგან GCC
+    //    პროფილის ფაილს ობიექტის სახელით არქმევს და ორივე ეტაპზე ის ერთი უნდა იყოს.
+    ok = ok && write_file(source, code) &&
+         run_command("%s %s -fprofile-generate=%s -c %s -o %s", compiler, flags, q_dir, q_source, q_object) &&
+         run_command("%s %s -fprofile-generate=%s %s %s -o %s", compiler, flags, q_dir, q_object, quoted_library,
+                     q_instrumented);
+    // 2. სავარჯიშო გაშვება; პროგრამის გამოსავალი არ გვჭირდება.
+    if (ok && !run_command("%s < %s > /dev/null", q_instrumented, q_input)) {
+        fprintf(stderr, "გაფრთხილება: სავარჯიშო გაშვება შეცდომით დასრულდა; პროფილი შეიძლება არასრული იყოს.\n");
+    }
+    // 3. ხელახალი კომპილაცია შეგროვებული პროფილით.
+    if (ok && clang) {
+        ok = run_command("llvm-profdata merge -output=%s/default.profdata %s", q_dir, q_dir) &&
+             run_command("%s %s -fprofile-use=%s/default.profdata -c %s -o %s", compiler, flags, q_dir, q_source, q_object);
+    } else if (ok) {
+        ok = run_command("%s %s -fprofile-use=%s -fprofile-correction -c %s -o %s",
+                         compiler, flags, q_dir, q_source, q_object);
+    }
+    ok = ok && run_command("%s %s %s %s -o %s", compiler, flags, q_object, quoted_library, quoted_output);
+
+    run_command("rm -rf %s", q_dir);
+    return ok;
+}
+
+bool build_c_program(AstNode* ast, const ToolchainOptions* options, const char* output) {
+    char quoted_output[PATH_SIZE];
+    if (!shell_quote(quoted_output, sizeof(quoted_output), output)) {
+        fprintf(stderr, "გამოსავალი ფაილის ბილიკი ძალიან გრძელია.\n");
+        return false;
+    }
+
+    // გენერირებული კოდი runtime.h-ს ჩართავს და libmanuscript_rt.a-სთან ილინკება.
+    RuntimePaths runtime;
+    char quoted_include[PATH_SIZE], quoted_library[PATH_SIZE], flags[COMMAND_SIZE];
+    if (!locate_runtime(&runtime)) return false;
+    if (!shell_quote(quoted_include, sizeof(quoted_include), runtime.include_dir) ||
+        !shell_quote(quoted_library, sizeof(quoted_library), runtime.library) ||
+        snprintf(flags, sizeof(flags), "%s -pthread -I%s", build_profile_flags(options->profile), quoted_include) >=
+            (int)sizeof(flags)) {
+        fprintf(stderr, "runtime-ის ბილიკი ძალიან გრძელია.\n");
+        return false;
+    }
+    if (mkdir(options->work_dir, 0755) != 0 && errno != EEXIST) {
+        fprintf(stderr, "დირექტორიის შექმნა ვერ მოხერხდა: %s: %s\n", options->work_dir, strerror(errno));
+        return false;
+    }
+
+    StatsMark start = stats_mark(options->stats);
+    CodeBuffer code;
+    init_code_buffer(&code);
+    generate_code_to_buffer(ast, &code);
+    stats_record(options->stats, STATS_PHASE_CODEGEN, start);
+    if (options->stats != NULL) options->stats->code_bytes = code.length;
+
+    start = stats_mark(options->stats);
+    bool ok;
+    if (options->profile == BUILD_PROFILE_PGO) {
+        ok = build_with_pgo(&code, options, flags, quoted_library, quoted_output);
+    } else if (options->use_pipe) {
+        ok = compile_via_pipe(&code, options->compiler, flags, quoted_library, quoted_output);
+    } else {
+        char source[PATH_SIZE], quoted_source[PATH_SIZE];
+        ok = join_path(source, sizeof(source), options->work_dir, "output.c") &&
+             shell_quote(quoted_source, sizeof(quoted_source), source) && write_file(source, &code) &&
+             run_command("%s %s %s %s -o %s", options->compiler, flags, quoted_source, quoted_library, quoted_output);
+    }
+    stats_record(options->stats, STATS_PHASE_CC, start);
+
+    free_code_buffer(&code);
+    return ok;
+}
@@ -0,0 +1,1351 @@
+/**
+ * @file type_infer.c
+ * @author გიორგი მაღრაძე (magradze.giorgi@gmail.com)
+ * @brief სტატიკური ტიპების გამოყვანის იმპლემენტაცია.
+ * @version 0.10
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <string.h>
+#include "loop_analysis.h"
+#include "type_infer.h"
+
+// პირობით შუალედების დავიწროებისას `და`/`ან` ჯაჭვის განხილული სიღრმე.
+#define NARROW_MAX_DEPTH 16
+
+// მთელი შუალედის საზღვარი, როცა მნიშვნელობამ შეიძლება ±2^53 გადალახოს
+// (ms_add_int-ით double-ზე გადასული). ორი ასეთი საზღვრის ჯამი int64-ს არ
+// გადაავსებს, ხოლო ±2^53-ის მიღმა ყველა შუალედი ერთნაირად "ფართოა".
+#define WIDE_INT_LIMIT ((int64_t)1 << 61)
+
+// `ყოველი`-ს გავლები, რომლებშიც აკუმულატორი იტერაციების რაოდენობით ფართოვდება;
+// შემდეგ (მაგ. საკუთარ თავზე დამოკიდებული ზრდისას) ჩვეულებრივი გაფართოება მოქმედებს.
+#define COUNTED_WIDEN_PASSES 4
+
+/** @brief მთელი მნიშვნელობების ჩაკეტილი შუალედი [low, high]. */
+typedef struct {
+    int64_t low;
+    int64_t high;
+} IntRange;
+
+/**
+ * @brief ფუნქციის ანალიზის მდგომარეობა. პარამეტრის ტიპი ყველა გამოძახების
+ * არგუმენტისა და სხეულში მინიჭებების გაერთიანებაა, დაბრუნების ტიპი — ყველა
+ * `დაბრუნე`-სი. ფუნქციის ლოკალურები ცალკე ინახება და სხეულის გავლისას
+ * types/ranges-ში ჩაინაცვლება, ამიტომ სხვა ფუნქციის ან პროგრამის ცვლადი
+ * იმავე სახელით მათ არ ერევა.
+ */
+typedef struct {
+    AstNode* node;
+    Symbol** locals;            // ჯერ პარამეტრები, შემდეგ სხეულის დეკლარაციები
+    int local_count;
+    int parameter_count;
+    uint8_t* local_types;       // ლოკალურების ტიპები გავლებს შორის
+    IntRange* parameter_ranges; // მთელი პარამეტრების შუალედი შესვლისას (არგუმენტების გაერთიანება)
+    uint8_t* saved_types;       // ჩანაცვლებული types/ranges სხეულის გავლისას
+    IntRange* saved_ranges;
+    ValueType return_type;      // TYPE_UNKNOWN — ჯერ არც ერთი `დაბრუნე` არ გავლილა
+    IntRange return_range;
+} FunctionInfo;
+
+/**
+ * @brief გამოყვანის მდგომარეობა. ცვლადის ტიპი ყველა მისი მინიჭების
+ * გაერთიანებაა (C ბექენდში ცვლადი ერთი ლოკალურია ერთი ტიპით), შუალედი კი
+ * პროგრამის მიმდინარე წერტილისაა: მინიჭება მას ცვლის, პირობა — ავიწროებს.
+ */
+typedef struct {
+    uint8_t* types;        // types[id] — ცვლადის ტიპი (TYPE_UNKNOWN — ჯერ არ მინიჭებია)
+    IntRange* ranges;      // ranges[id] — მთელი ცვლადის შუალედი მიმდინარე წერტილში
+    int symbol_count;
+    bool changed;          // გავლისას რომელიმე ცვლადის ტიპი გაფართოვდა
+    AstStack walk;         // გამოსახულებების გავლის სტეკი
+    IntRange* range_stack; // გავლილი ქვეხეების შუალედები
+    int range_count;
+    int range_capacity;
+    FunctionInfo* function_infos; // ფუნქციები პროგრამაში გამოჩენის მიხედვით
+    int function_count;
+    FunctionInfo** functions;     // functions[id] — ფუნქცია სახელით (NULL — არ არის)
+    FunctionInfo* current;        // ფუნქცია, რომლის სხეულიც ახლა გაივლება
+    bool unreachable;             // მიმდინარე წერტილამდე შესრულება ვერ მოდის (`დაბრუნე`-ს შემდეგ)
+    uint8_t* accumulators;        // accumulators[id] — მიმდინარე `ყოველი`-ს ACCUMULATOR_* (NULL — ციკლის გარეთ)
+    IntRange* growth;             // growth[id] — აკუმულატორის შუალედის ზრდა ერთ იტერაციაში (low — კლება)
+    uint8_t* array_kinds;         // array_kinds[id] — ARRAY_KIND_* ცვლადის ყველა მინიჭებიდან (ფუნქციებს შორის საერთო)
+    bool int_stores;              // პროგრამის ყველა `ა[ი] = x` და `დაამატე(ა, x)` მთელ x-ს წერს
+} TypeInferrer;
+
+/** @brief ცვლადს მინიჭებული მასივების სახე (array_kinds[id]). */
+enum {
+    ARRAY_KIND_NONE,       // ჯერ არ მინიჭებია
+    ARRAY_KIND_INT,        // მხოლოდ მთელი მასივები (is_int_array)
+    ARRAY_KIND_OTHER,      // სხვა მნიშვნელობა, ან პარამეტრი
+};
+
+/** @brief ცვლადის მინიჭებები `ყოველი`-ს სხეულში (accumulators[id]). */
+enum {
+    ACCUMULATOR_NONE,      // სხეულში არ ენიჭება
+    ACCUMULATOR_COUNTED,   // მხოლოდ `ს = ს ± e` ენიჭება, ყოველ იტერაციაში თითოჯერ მაინც
+    ACCUMULATOR_OTHER,     // სხვა მინიჭება ან მინიჭება ჩადგმულ ციკლში
+};
+
+const char* value_type_name(ValueType type) {
+    switch (type) {
+        case TYPE_INT: return "int";
+        case TYPE_NUMBER: return "number";
+        case TYPE_BOOL: return "bool";
+        case TYPE_STRING: return "string";
+        case TYPE_VALUE: return "value";
+        case TYPE_ARRAY: return "array";
+        default: return "unknown";
+    }
+}
+
+static bool is_numeric(ValueType type) {
+    return type == TYPE_INT || type == TYPE_NUMBER;
+}
+
+/** @brief არითმეტიკა მასივსა და მასივს ან რიცხვს შორის ელემენტებზე სრულდება და მასივს იძლევა. */
+static bool is_elementwise(ValueType left, ValueType right) {
+    return (left == TYPE_ARRAY && (right == TYPE_ARRAY || is_numeric(right))) ||
+           (right == TYPE_ARRAY && is_numeric(left));
+}
+
+/** @brief შედარების ან ლოგიკური ოპერატორი (შედეგი TYPE_BOOL-ია). */
+static bool is_boolean_operator(TokenType op) {
+    switch (op) {
+        case TOKEN_EQUAL_EQUAL:
+        case TOKEN_BANG_EQUAL:
+        case TOKEN_LESS:
+        case TOKEN_LESS_EQUAL:
+        case TOKEN_GREATER:
+        case TOKEN_GREATER_EQUAL:
+        case TOKEN_და:
+        case TOKEN_ან: return true;
+        default: return false;
+    }
+}
+
+static bool range_is_safe(IntRange range) {
+    return range.low >= -TYPE_INT_LIMIT && range.high <= TYPE_INT_LIMIT;
+}
+
+/** @brief ±2^53-ის მიღმა გასულ საზღვარს WIDE_INT_LIMIT-მდე წევს. */
+static IntRange clamp_wide(IntRange range) {
+    if (range.low < -TYPE_INT_LIMIT) range.low = -WIDE_INT_LIMIT;
+    if (range.high > TYPE_INT_LIMIT) range.high = WIDE_INT_LIMIT;
+    return range;
+}
+
+static bool range_contains_zero(IntRange range) {
+    return range.low <= 0 && range.high >= 0;
+}
+
+/** @brief ითვლის ნამრავლის შუალედს; false — თუ int64 გადაივსო. */
+static bool multiply_ranges(IntRange a, IntRange b, IntRange* result) {
+    int64_t products[4];
+    if (__builtin_mul_overflow(a.low, b.low, &products[0]) ||
+        __builtin_mul_overflow(a.low, b.high, &products[1]) ||
+        __builtin_mul_overflow(a.high, b.low, &products[2]) ||
+        __builtin_mul_overflow(a.high, b.high, &products[3])) {
+        return false;
+    }
+    result->low = result->high = products[0];
+    for (int i = 1; i < 4; i++) {
+        if (products[i] < result->low) result->low = products[i];
+        if (products[i] > result->high) result->high = products[i];
+    }
+    return true;
+}
+
+/**
+ * @brief ადგენს ორობითი ოპერაციის ტიპს მთელ ოპერანდებზე.
+ * ჯამი და სხვაობა ყოველთვის მთელია: თუ შედეგის შუალედი ±2^53-ს სცდება,
+ * კვანძი ფართოა (wide) და C ბექენდი მას ms_add_int/ms_sub_int-ით, გადავსების
+ * შემოწმებით ითვლის. ოპერანდები |x| <= WIDE_INT_LIMIT შუალედშია, ამიტომ
+ * შუალედების შეკრება int64-ს არ გადაავსებს; ნამრავლი მოწმდება ცალკე.
+ */
+static ValueType binary_int_type(TokenType op, IntRange left, IntRange right, IntRange* range) {
+    switch (op) {
+        case TOKEN_PLUS:
+            range->low = left.low + right.low;
+            range->high = left.high + right.high;
+            *range = clamp_wide(*range);
+            return TYPE_INT;
+        case TOKEN_MINUS:
+            range->low = left.low - right.high;
+            range->high = left.high - right.low;
+            *range = clamp_wide(*range);
+            return TYPE_INT;
+        case TOKEN_STAR:
+            if (!multiply_ranges(left, right, range)) return TYPE_NUMBER;
+            // 0 * უარყოფითი double-ში -0.0-ს იძლევა, int64-ში კი 0-ს.
+            if ((range_contains_zero(left) && right.low < 0) || (range_contains_zero(right) && left.low < 0)) {
+                return TYPE_NUMBER;
+            }
+            break;
+        default:
+            return TYPE_NUMBER;
+    }
+    return range_is_safe(*range) ? TYPE_INT : TYPE_NUMBER;
+}
+
+/** @brief ორი ტიპის გაერთიანება: ცვლადის ტიპი, რომელიც ორივე მნიშვნელობას იტევს. */
+static ValueType join_types(ValueType a, ValueType b) {
+    if (a == TYPE_UNKNOWN || a == b) return b;
+    if (b == TYPE_UNKNOWN) return a;
+    if (is_numeric(a) && is_numeric(b)) return TYPE_NUMBER;
+    return TYPE_VALUE;
+}
+
+/**
+ * @brief ციკლის თავის შუალედების გაფართოება (widening): საზღვარი, რომელიც
+ * იტერაციამ გაზარდა, მაშინვე ზღვრამდე (±2^53, ხოლო თუ მას უკვე სცდება —
+ * ±WIDE_INT_LIMIT) იწევს, ასე რომ ციკლის ანალიზი რამდენიმე იტერაციაში
+ * სრულდება. პირობა შემდეგ საზღვარს ისევ ავიწროებს.
+ * @return bool true, თუ რომელიმე საზღვარი შეიცვალა.
+ */
+static bool widen_ranges(IntRange* head, const IntRange* body, int count) {
+    bool changed = false;
+    for (int i = 0; i < count; i++) {
+        if (body[i].low < head[i].low) {
+            head[i].low = body[i].low < -TYPE_INT_LIMIT ? -WIDE_INT_LIMIT : -TYPE_INT_LIMIT;
+            changed = true;
+        }
+        if (body[i].high > head[i].high) {
+            head[i].high = body[i].high > TYPE_INT_LIMIT ? WIDE_INT_LIMIT : TYPE_INT_LIMIT;
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+/**
+ * @brief გამოძახების არგუმენტს პარამეტრის ტიპსა და შესვლის შუალედს უერთებს.
+ * მიმდინარე ფუნქციის (რეკურსიული გამოძახების) პარამეტრები types-შია ჩანაცვლებული.
+ */
+static void join_argument(TypeInferrer* inferrer, FunctionInfo* callee, int index, ValueType type, IntRange range) {
+    int id = callee->locals[index]->id;
+    uint8_t* slot = callee == inferrer->current ? &inferrer->types[id] : &callee->local_types[index];
+    ValueType old = (ValueType)*slot;
+    ValueType joined = join_types(old, type);
+    if (joined == TYPE_INT && type == TYPE_INT) {
+        if (old == TYPE_UNKNOWN) callee->parameter_ranges[index] = range;
+        else if (widen_ranges(&callee->parameter_ranges[index], &range, 1)) inferrer->changed = true;
+    }
+    if (joined != old) {
+        *slot = (uint8_t)joined;
+        inferrer->changed = true;
+    }
+}
+
+/** @brief ამატებს შუალედს გამოყვანის სტეკზე. */
+static void push_range(TypeInferrer* inferrer, IntRange range) {
+    if (inferrer->range_count >= inferrer->range_capacity) {
+        inferrer->range_capacity = inferrer->range_capacity < 64 ? 64 : inferrer->range_capacity * 2;
+        IntRange* stack = realloc(inferrer->range_stack, sizeof(IntRange) * (size_t)inferrer->range_capacity);
+        if (!stack) {
+            fprintf(stderr, "FATAL: Memory allocation failed for type inference.\n");
+            exit(1);
+        }
+        inferrer->range_stack = stack;
+    }
+    inferrer->range_stack[inferrer->range_count++] = range;
+}
+
+/**
+ * @brief ადგენს ერთი კვანძის ტიპს. შვილების ტიპები უკვე მათ value_type-შია,
+ * ხოლო მათი შუალედები სტეკის თავზეა (მარჯვენა შვილი ზემოთ); ისინი იხსნება
+ * და კვანძის შუალედი ემატება.
+ */
+/**
+ * @brief ჭეშმარიტია, თუ გამოსახულება ყოველთვის მთელ (MS_ARRAY_INT) მასივს
+ * იძლევა: მთელი ელემენტების ლიტერალი, `მასივი(n)` ან ცვლადი, რომელსაც მხოლოდ
+ * ასეთი მასივები ენიჭება. მასივი ცვალებადია და ალიასით სხვაგანაც ჩანს,
+ * ამიტომ ეს მხოლოდ მაშინ მოქმედებს, როცა პროგრამა მასივებში მხოლოდ მთელ
+ * რიცხვებს წერს (int_stores): სხვა ჩაწერა მასივს ადგილზე ათწილადად აქცევს.
+ */
+static bool is_int_array(const TypeInferrer* inferrer, const AstNode* node) {
+    if (node == NULL || !inferrer->int_stores) return false;
+    switch (node->type) {
+        case NODE_ARRAY:
+            for (int i = 0; i < node->as.array.count; i++) {
+                const AstNode* element = node->as.array.elements[i];
+                if (element == NULL || element->value_type != TYPE_INT || element->wide) return false;
+            }
+            return true;
+        case NODE_BUILTIN:
+            return node->as.builtin.function == BUILTIN_ARRAY;
+        case NODE_VARIABLE:
+            return node->value_type == TYPE_ARRAY && inferrer->array_kinds[node->as.variable.name->id] == ARRAY_KIND_INT;
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief აღნიშნავს მასივში არამთელი მნიშვნელობის ჩაწერას (`ა[ი] = x`,
+ * `დაამატე(ა, x)`). ფართო მთელი ±2^53-ს შეიძლება სცდებოდეს და მასივს ათწილადად აქცევს.
+ */
+static void note_array_store(TypeInferrer* inferrer, const AstNode* value) {
+    if (!inferrer->int_stores || (value != NULL && value->value_type == TYPE_INT && !value->wide)) return;
+    inferrer->int_stores = false;
+    inferrer->changed = true;
+}
+
+static void infer_node(TypeInferrer* inferrer, AstNode* node) {
+    IntRange range = { 0, 0 };
+    ValueType type = TYPE_NUMBER;
+    if (node == NULL) {
+        push_range(inferrer, range);
+        return;
+    }
+    switch (node->type) {
+        case NODE_NUMBER: {
+            double value = node->as.number.value;
+            bool in_range = value >= -(double)TYPE_INT_LIMIT && value <= (double)TYPE_INT_LIMIT;
+            if (in_range && value == (double)(int64_t)value && !(value == 0 && signbit(value))) {
+                type = TYPE_INT;
+                range.low = range.high = (int64_t)value;
+            }
+            break;
+        }
+        case NODE_BOOLEAN:
+            type = TYPE_BOOL;
+            break;
+        case NODE_NONE:
+            type = TYPE_VALUE;
+            break;
+        case NODE_STRING:
+            type = TYPE_STRING;
+            break;
+        case NODE_VARIABLE: {
+            // TYPE_UNKNOWN ჯერ გაუანალიზებელი ფუნქციის შედეგიდან მოდის და
+            // გამოსახულებაში ვრცელდება; მომდევნო გავლა მას დააზუსტებს.
+            int id = node->as.variable.name->id;
+            type = (ValueType)inferrer->types[id];
+            if (type == TYPE_INT) range = inferrer->ranges[id];
+            break;
+        }
+        case NODE_CALL: {
+            // არგუმენტების შუალედები სტეკზე თანმიმდევრობითაა.
+            int count = node->as.call.count;
+            inferrer->range_count -= count;
+            const IntRange* arguments = &inferrer->range_stack[inferrer->range_count];
+            FunctionInfo* callee = inferrer->functions[node->as.call.callee->id];
+            for (int i = 0; i < count; i++) {
+                AstNode* argument = node->as.call.arguments[i];
+                ValueType argument_type = argument ? (ValueType)argument->value_type : TYPE_NUMBER;
+                join_argument(inferrer, callee, i, argument_type, arguments[i]);
+            }
+            type = callee->return_type;
+            if (type == TYPE_INT) range = callee->return_range;
+            break;
+        }
+        case NODE_UNARY_OP: {
+            IntRange operand = inferrer->range_stack[--inferrer->range_count];
+            ValueType operand_type = node->as.unary_op.right ? (ValueType)node->as.unary_op.right->value_type : TYPE_NUMBER;
+            if (node->as.unary_op.operator == TOKEN_არ) {
+                type = TYPE_BOOL;
+                break;
+            }
+            if (operand_type == TYPE_UNKNOWN) {
+                type = TYPE_UNKNOWN;
+                break;
+            }
+            // არარიცხვითი ოპერანდის ტიპი მხოლოდ გაშვებისას მოწმდება.
+            if (operand_type == TYPE_ARRAY) type = TYPE_ARRAY;
+            else if (!is_numeric(operand_type)) type = TYPE_VALUE;
+            // -0 double-ში -0.0-ა, ამიტომ ნულის შემცველი შუალედი მთელი არ რჩება.
+            if (node->as.unary_op.operator == TOKEN_MINUS && operand_type == TYPE_INT && !range_contains_zero(operand)) {
+                type = TYPE_INT;
+                range.low = -operand.high;
+                range.high = -operand.low;
+            }
+            break;
+        }
+        case NODE_BINARY_OP: {
+            IntRange right = inferrer->range_stack[--inferrer->range_count];
+            IntRange left = inferrer->range_stack[--inferrer->range_count];
+            ValueType left_type = node->as.binary_op.left ? (ValueType)node->as.binary_op.left->value_type : TYPE_NUMBER;
+            ValueType right_type = node->as.binary_op.right ? (ValueType)node->as.binary_op.right->value_type : TYPE_NUMBER;
+            if (is_boolean_operator(node->as.binary_op.operator)) {
+                // შედარება და `და`/`ან` ყოველთვის ლოგიკურ მნიშვნელობას იძლევა.
+                type = TYPE_BOOL;
+            } else if (left_type == TYPE_UNKNOWN || right_type == TYPE_UNKNOWN) {
+                type = TYPE_UNKNOWN;
+            } else if (left_type == TYPE_INT && right_type == TYPE_INT) {
+                type = binary_int_type(node->as.binary_op.operator, left, right, &range);
+            } else if (left_type == TYPE_STRING && right_type == TYPE_STRING &&
+                       node->as.binary_op.operator == TOKEN_PLUS) {
+                type = TYPE_STRING;
+            } else if (is_elementwise(left_type, right_type)) {
+                type = TYPE_ARRAY;
+            } else if (!is_numeric(left_type) || !is_numeric(right_type)) {
+                type = TYPE_VALUE;
+            }
+            break;
+        }
+        case NODE_ARRAY:
+            // ელემენტები რიცხვებია; სხვა ტიპის ელემენტს გაშვებისას runtime უარყოფს.
+            inferrer->range_count -= node->as.array.count;
+            type = TYPE_ARRAY;
+            break;
+        case NODE_INDEX:
+            inferrer->range_count -= 2;
+            break;
+        case NODE_INDEX_ASSIGN:
+            inferrer->range_count -= 3;
+            note_array_store(inferrer, node->as.index_assign.value);
+            type = TYPE_VALUE;
+            break;
+        case NODE_BUILTIN:
+            inferrer->range_count -= node->as.builtin.count;
+            switch ((BuiltinFunction)node->as.builtin.function) {
+                case BUILTIN_LENGTH:
+                    type = TYPE_INT;
+                    range.high = TYPE_INT_LIMIT;
+                    break;
+                case BUILTIN_ARRAY: type = TYPE_ARRAY; break;
+                case BUILTIN_PUSH:
+                    note_array_store(inferrer, node->as.builtin.count > 1 ? node->as.builtin.arguments[1] : NULL);
+                    type = TYPE_VALUE;
+                    break;
+                case BUILTIN_SUM:
+                case BUILTIN_MIN:
+                case BUILTIN_MAX:
+                    // მთელი მასივის რედუქცია ზუსტი მთელია (ms_sum_int ±2^53-ს გაშვებისას ამოწმებს).
+                    if (node->as.builtin.count == 1 && is_int_array(inferrer, node->as.builtin.arguments[0])) {
+                        type = TYPE_INT;
+                        range.low = -TYPE_INT_LIMIT;
+                        range.high = TYPE_INT_LIMIT;
+                    }
+                    break;
+                default: break;
+            }
+            break;
+        default:
+            break;
+    }
+    node->value_type = (uint8_t)type;
+    node->wide = type == TYPE_INT && !range_is_safe(range);
+    push_range(inferrer, range);
+}
+
+/**
+ * @brief ადგენს გამოსახულების ყველა კვანძის ტიპს პოსტ-ორდერში (ცხადი სტეკით).
+ * @param range მთელი შედეგის შუალედი.
+ */
+static ValueType infer_expression(TypeInferrer* inferrer, AstNode* node, IntRange* range) {
+    AstNode* current;
+    ast_stack_push(&inferrer->walk, node);
+    while (ast_stack_next_postorder(&inferrer->walk, &current)) infer_node(inferrer, current);
+    *range = inferrer->range_stack[--inferrer->range_count];
+    return node != NULL ? (ValueType)node->value_type : TYPE_NUMBER;
+}
+
+/** @brief ცვლადს ანიჭებს მნიშვნელობას: ტიპი ფართოვდება, შუალედი იცვლება. */
+/** @brief არაუარყოფითი ჯამი, რომელიც 2^62-ზე ჩერდება (შუალედები ±2^53-ის ფარგლებშია). */
+static int64_t saturating_add(int64_t a, int64_t b) {
+    const int64_t cap = (int64_t)1 << 62;
+    return a >= cap - b ? cap : a + b;
+}
+
+static void assign_variable(TypeInferrer* inferrer, AstNode* node, Symbol* name, AstNode* value) {
+    IntRange range = { 0, 0 };
+    ValueType type = infer_expression(inferrer, value, &range);
+    ValueType joined = join_types((ValueType)inferrer->types[name->id], type);
+    if (joined != inferrer->types[name->id]) {
+        inferrer->types[name->id] = (uint8_t)joined;
+        inferrer->changed = true;
+    }
+    uint8_t kind = is_int_array(inferrer, value) ? ARRAY_KIND_INT : ARRAY_KIND_OTHER;
+    uint8_t* known = &inferrer->array_kinds[name->id];
+    if (*known != kind && *known != ARRAY_KIND_OTHER) {
+        *known = *known == ARRAY_KIND_NONE ? kind : ARRAY_KIND_OTHER;
+        inferrer->changed = true;
+    }
+    if (inferrer->accumulators != NULL && inferrer->accumulators[name->id] == ACCUMULATOR_COUNTED && type == TYPE_INT) {
+        IntRange* growth = &inferrer->growth[name->id];
+        IntRange current = inferrer->ranges[name->id];
+        if (range.high > current.high) growth->high = saturating_add(growth->high, range.high - current.high);
+        if (range.low < current.low) growth->low = saturating_add(growth->low, current.low - range.low);
+    }
+    inferrer->ranges[name->id] = range;
+    node->value_type = (uint8_t)joined;
+}
+
+/** @brief აბრუნებს მიმდინარე შუალედების ასლს. */
+static IntRange* save_ranges(TypeInferrer* inferrer) {
+    IntRange* copy = malloc(sizeof(IntRange) * ((size_t)inferrer->symbol_count + 1));
+    if (!copy) {
+        fprintf(stderr, "FATAL: Memory allocation failed for type inference.\n");
+        exit(1);
+    }
+    memcpy(copy, inferrer->ranges, sizeof(IntRange) * (size_t)inferrer->symbol_count);
+    return copy;
+}
+
+/** @brief `into`-ს აფართოებს ისე, რომ `from`-იც დაიტიოს. */
+static void join_ranges(IntRange* into, const IntRange* from, int count) {
+    for (int i = 0; i < count; i++) {
+        if (from[i].low < into[i].low) into[i].low = from[i].low;
+        if (from[i].high > into[i].high) into[i].high = from[i].high;
+    }
+}
+
+/** @brief აბრუნებს შედარების ოპერატორს, რომელიც ოპერანდების გაცვლისას იგივეს ნიშნავს. */
+static TokenType mirror_comparison(TokenType op) {
+    switch (op) {
+        case TOKEN_LESS: return TOKEN_GREATER;
+        case TOKEN_LESS_EQUAL: return TOKEN_GREATER_EQUAL;
+        case TOKEN_GREATER: return TOKEN_LESS;
+        case TOKEN_GREATER_EQUAL: return TOKEN_LESS_EQUAL;
+        default: return op;
+    }
+}
+
+/** @brief აბრუნებს შედარების უარყოფას (`<` მცდარია ⇔ `>=` ჭეშმარიტია). */
+static TokenType negate_comparison(TokenType op) {
+    switch (op) {
+        case TOKEN_LESS: return TOKEN_GREATER_EQUAL;
+        case TOKEN_LESS_EQUAL: return TOKEN_GREATER;
+        case TOKEN_GREATER: return TOKEN_LESS_EQUAL;
+        case TOKEN_GREATER_EQUAL: return TOKEN_LESS;
+        case TOKEN_EQUAL_EQUAL: return TOKEN_BANG_EQUAL;
+        case TOKEN_BANG_EQUAL: return TOKEN_EQUAL_EQUAL;
+        default: return op;
+    }
+}
+
+/** @brief ავიწროებს მთელი ცვლადის შუალედს `x op bound` ჭეშმარიტობით. */
+static void narrow_variable(TypeInferrer* inferrer, Symbol* name, TokenType op, IntRange bound) {
+    if (inferrer->types[name->id] != TYPE_INT) return;
+    IntRange* range = &inferrer->ranges[name->id];
+    switch (op) {
+        case TOKEN_LESS:
+            if (bound.high - 1 < range->high) range->high = bound.high - 1;
+            break;
+        case TOKEN_LESS_EQUAL:
+            if (bound.high < range->high) range->high = bound.high;
+            break;
+        case TOKEN_GREATER:
+            if (bound.low + 1 > range->low) range->low = bound.low + 1;
+            break;
+        case TOKEN_GREATER_EQUAL:
+            if (bound.low > range->low) range->low = bound.low;
+            break;
+        case TOKEN_EQUAL_EQUAL:
+            if (bound.low > range->low) range->low = bound.low;
+            if (bound.high < range->high) range->high = bound.high;
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief ავიწროებს შუალედებს იმის მიხედვით, რომ პირობა `truth`-ის ტოლია
+ * (`სანამ ი < ნ` ციკლის სხეულში ი < ნ, ციკლის შემდეგ კი ი >= ნ). ასე ციკლის
+ * მთვლელი მთელი რჩება, თუმცა ყოველი იტერაცია მას ზრდის. ერთ-ერთი ოპერანდი
+ * მთელი ცვლადი უნდა იყოს, მეორე — მთელი გამოსახულება; ორივე ოპერანდი
+ * ზუსტად წარმოდგენადია, ამიტომ double-ის შედარება მთელების შედარებას ემთხვევა.
+ * `და`/`ან` ჯაჭვში მხოლოდ პირველი NARROW_MAX_DEPTH დონე განიხილება.
+ */
+static void narrow_condition(TypeInferrer* inferrer, AstNode* condition, bool truth, int depth) {
+    while (condition != NULL && condition->type == NODE_UNARY_OP && condition->as.unary_op.operator == TOKEN_არ) {
+        condition = condition->as.unary_op.right;
+        truth = !truth;
+    }
+    if (condition == NULL || condition->type != NODE_BINARY_OP) return;
+    TokenType op = condition->as.binary_op.operator;
+    AstNode* left = condition->as.binary_op.left;
+    AstNode* right = condition->as.binary_op.right;
+    if (left == NULL || right == NULL) return;
+    if ((op == TOKEN_და && truth) || (op == TOKEN_ან && !truth)) {
+        if (depth >= NARROW_MAX_DEPTH) return;
+        narrow_condition(inferrer, left, truth, depth + 1);
+        narrow_condition(inferrer, right, truth, depth + 1);
+        return;
+    }
+    if (!is_boolean_operator(op) || op == TOKEN_და || op == TOKEN_ან) return;
+    if (!truth) op = negate_comparison(op);
+    IntRange bound;
+    if (left->type == NODE_VARIABLE && right->value_type == TYPE_INT) {
+        infer_expression(inferrer, right, &bound);
+        narrow_variable(inferrer, left->as.variable.name, op, bound);
+    } else if (right->type == NODE_VARIABLE && left->value_type == TYPE_INT) {
+        infer_expression(inferrer, left, &bound);
+        narrow_variable(inferrer, right->as.variable.name, mirror_comparison(op), bound);
+    }
+}
+
+static void infer_statement(TypeInferrer* inferrer, AstNode* node);
+
+/** @brief მიმდინარე ფუნქციის დაბრუნების ტიპს უერთებს მნიშვნელობას (მთელის შუალედი ფართოვდება). */
+static void join_return(TypeInferrer* inferrer, ValueType type, IntRange range) {
+    FunctionInfo* function = inferrer->current;
+    ValueType joined = join_types(function->return_type, type);
+    if (joined == TYPE_INT && type == TYPE_INT) {
+        if (function->return_type == TYPE_UNKNOWN) function->return_range = range;
+        else if (widen_ranges(&function->return_range, &range, 1)) inferrer->changed = true;
+    }
+    if (joined != function->return_type) {
+        function->return_type = joined;
+        inferrer->changed = true;
+    }
+}
+
+/** @brief ადგენს ბლოკის (ან ერთი განცხადების) ტიპებს. */
+static void infer_block(TypeInferrer* inferrer, AstNode* node) {
+    if (node == NULL || node->type != NODE_BLOCK) {
+        infer_statement(inferrer, node);
+        return;
+    }
+    for (int i = 0; i < node->as.block.count; i++) infer_statement(inferrer, node->as.block.statements[i]);
+}
+
+/**
+ * @brief შტოს შემდეგ: თუ შტოს ბოლო მიღწევადია, მისი შუალედები
+ * გაერთიანებას ემატება (`დაბრუნე`-თი დასრულებული შტო მას არ აფართოებს).
+ */
+static void merge_branch(TypeInferrer* inferrer, IntRange** merged, bool* all_unreachable) {
+    if (inferrer->unreachable) return;
+    *all_unreachable = false;
+    if (*merged == NULL) *merged = save_ranges(inferrer);
+    else join_ranges(*merged, inferrer->ranges, inferrer->symbol_count);
+}
+
+/**
+ * @brief `თუ`/`სხვა_თუ`/`სხვა` ჯაჭვი: ყოველი შტო თავისი პირობით დავიწროებული
+ * შუალედებით გაივლება, შედეგი კი ყველა მიღწევადი შტოს გაერთიანებაა.
+ * ჯაჭვის შემდეგი წერტილი მიუღწევადია, თუ ყველა შტო (`სხვა`-ს ჩათვლით) `დაბრუნე`-თი სრულდება.
+ */
+static void infer_if(TypeInferrer* inferrer, AstNode* node) {
+    IntRange range;
+    IntRange* merged = NULL;
+    bool entry_unreachable = inferrer->unreachable;
+    bool all_unreachable = true;
+    while (node != NULL && node->type == NODE_IF) {
+        infer_expression(inferrer, node->as.if_stmt.condition, &range);
+        IntRange* entry = save_ranges(inferrer);
+        narrow_condition(inferrer, node->as.if_stmt.condition, true, 0);
+        inferrer->unreachable = entry_unreachable;
+        infer_block(inferrer, node->as.if_stmt.then_branch);
+        merge_branch(inferrer, &merged, &all_unreachable);
+        memcpy(inferrer->ranges, entry, sizeof(IntRange) * (size_t)inferrer->symbol_count);
+        free(entry);
+        narrow_condition(inferrer, node->as.if_stmt.condition, false, 0);
+        node = node->as.if_stmt.else_branch;
+    }
+    inferrer->unreachable = entry_unreachable;
+    infer_block(inferrer, node);
+    merge_branch(inferrer, &merged, &all_unreachable);
+    if (merged != NULL) {
+        memcpy(inferrer->ranges, merged, sizeof(IntRange) * (size_t)inferrer->symbol_count);
+        free(merged);
+    }
+    inferrer->unreachable = all_unreachable;
+}
+
+/**
+ * @brief `სანამ` ციკლი: სხეული მანამ გაივლება, სანამ ციკლის თავის შუალედები
+ * და ცვლადების ტიპები არ დასტაბილურდება. ბოლო გავლა სტაბილური მდგომარეობით
+ * ხდება, ამიტომ კვანძების ტიპები ციკლის ყველა იტერაციისთვის სწორია.
+ */
+static void infer_while(TypeInferrer* inferrer, AstNode* node) {
+    IntRange range;
+    bool changed = inferrer->changed;
+    bool entry_unreachable = inferrer->unreachable;
+    IntRange* head = save_ranges(inferrer);
+    for (;;) {
+        inferrer->changed = false;
+        infer_expression(inferrer, node->as.while_stmt.condition, &range);
+        narrow_condition(inferrer, node->as.while_stmt.condition, true, 0);
+        infer_block(inferrer, node->as.while_stmt.body);
+        // `დაბრუნე`-თი დასრულებული სხეული ციკლის თავზე არ ბრუნდება.
+        bool widened = !inferrer->unreachable && widen_ranges(head, inferrer->ranges, inferrer->symbol_count);
+        inferrer->unreachable = entry_unreachable;
+        memcpy(inferrer->ranges, head, sizeof(IntRange) * (size_t)inferrer->symbol_count);
+        changed = changed || inferrer->changed;
+        if (!widened && !inferrer->changed) break;
+    }
+    free(head);
+    inferrer->changed = changed;
+    narrow_condition(inferrer, node->as.while_stmt.condition, false, 0);
+}
+
+/**
+ * @brief ჭეშმარიტია `ს = ს + e`, `ს = e + ს`, `ს = ს - e` და მათი `+`/`-`
+ * ჯაჭვების (`ს = ს + ი * 3 - 7`) მინიჭებისთვის, სადაც ს დადებითი წევრია.
+ */
+static bool is_accumulation(AstNode* node) {
+    Symbol* name = node->as.assign.name;
+    for (AstNode* term = node->as.assign.value; term != NULL && term->type == NODE_BINARY_OP;
+         term = term->as.binary_op.left) {
+        TokenType op = term->as.binary_op.operator;
+        if (op != TOKEN_PLUS && op != TOKEN_MINUS) return false;
+        AstNode* left = term->as.binary_op.left;
+        AstNode* right = term->as.binary_op.right;
+        if (op == TOKEN_PLUS && right != NULL && right->type == NODE_VARIABLE && right->as.variable.name == name) return true;
+        if (left != NULL && left->type == NODE_VARIABLE && left->as.variable.name == name) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief ავსებს accumulators-ს `ყოველი`-ს სხეულისთვის. `სანამ`-ის მინიჭება
+ * ერთ იტერაციაში შეუზღუდავად ბევრჯერ სრულდება, ამიტომ მისი ცვლადი
+ * ACCUMULATOR_OTHER-ია; ჩადგმული `ყოველი`-ს აკუმულატორის ზრდას კი
+ * შიდა ციკლი თავად ითვლის (იხ. infer_for).
+ */
+static void find_accumulators(TypeInferrer* inferrer, AstNode* body, uint8_t* accumulators) {
+    AstStack* walk = &inferrer->walk;
+    ast_stack_push(walk, body);
+    while (walk->count > 0) {
+        AstNode* node = walk->frames[--walk->count].node;
+        if (node == NULL) continue;
+        if (node->type == NODE_ASSIGN) {
+            uint8_t* state = &accumulators[node->as.assign.name->id];
+            if (!is_accumulation(node)) *state = ACCUMULATOR_OTHER;
+            else if (*state == ACCUMULATOR_NONE) *state = ACCUMULATOR_COUNTED;
+        } else if (node->type == NODE_WHILE) {
+            int base = walk->count;
+            ast_stack_push(walk, node);
+            while (walk->count > base) {
+                AstNode* inner = walk->frames[--walk->count].node;
+                if (inner == NULL) continue;
+                if (inner->type == NODE_ASSIGN) accumulators[inner->as.assign.name->id] = ACCUMULATOR_OTHER;
+                for (int i = ast_child_count(inner) - 1; i >= 0; i--) ast_stack_push(walk, ast_child(inner, i));
+            }
+            continue;
+        }
+        for (int i = ast_child_count(node) - 1; i >= 0; i--) ast_stack_push(walk, ast_child(node, i));
+    }
+}
+
+/**
+ * @brief ციკლის თავის შუალედების გაფართოება `ყოველი`-სთვის: აკუმულატორი
+ * ერთ იტერაციაში მაქსიმუმ growth-ით იცვლება, ამიტომ `trips` იტერაციის
+ * შემდეგ ის [შესვლა - trips·კლება, შესვლა + trips·ზრდა]-შია. დანარჩენი
+ * ცვლადები widen_ranges-ით ფართოვდება.
+ * @return bool true, თუ რომელიმე საზღვარი შეიცვალა.
+ */
+static bool widen_counted_ranges(TypeInferrer* inferrer, IntRange* head, const IntRange* entry, int64_t trips) {
+    bool changed = false;
+    for (int i = 0; i < inferrer->symbol_count; i++) {
+        if (inferrer->accumulators[i] != ACCUMULATOR_COUNTED || inferrer->types[i] != TYPE_INT) {
+            if (widen_ranges(&head[i], &inferrer->ranges[i], 1)) changed = true;
+            continue;
+        }
+        const IntRange* growth = &inferrer->growth[i];
+        int64_t high = growth->high > 0 && trips > (2 * TYPE_INT_LIMIT) / growth->high
+            ? WIDE_INT_LIMIT : entry[i].high + trips * growth->high;
+        int64_t low = growth->low > 0 && trips > (2 * TYPE_INT_LIMIT) / growth->low
+            ? -WIDE_INT_LIMIT : entry[i].low - trips * growth->low;
+        if (high > TYPE_INT_LIMIT) high = WIDE_INT_LIMIT;
+        if (low < -TYPE_INT_LIMIT) low = -WIDE_INT_LIMIT;
+        if (high > head[i].high) {
+            head[i].high = high;
+            changed = true;
+        }
+        if (low < head[i].low) {
+            head[i].low = low;
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+/**
+ * @brief `ყოველი` ციკლი. ორივე საზღვარი მთელი თუა, ცვლადიც მთელია და მისი
+ * შუალედი [საწყისი, ბოლო - 1]-ია, სხვა შემთხვევაში ის ათწილადია. მასივის
+ * ელემენტებზე ციკლის ცვლადი მთელია, თუ მასივი მთელია (is_int_array). იტერაციები
+ * TYPE_ARRAY_MAX_LENGTH-ითაა შეზღუდული. სხეული
+ * `სანამ`-ის მსგავსად სტაბილურობამდე გაივლება, ოღონდ იტერაციების რაოდენობა
+ * ცნობილია: `ს = ს + ი`-ის მსგავსი აკუმულატორის შუალედი ±2^53-მდე კი არა,
+ * იტერაციების რაოდენობის მიხედვით ფართოვდება, ასე რომ ის მთელი რჩება.
+ * ციკლის ცვლადი მხოლოდ სხეულში ჩანს, ამიტომ მისი ტიპი სხვა, იმავე სახელის
+ * ცვლადს არ უერთდება.
+ */
+static void infer_for(TypeInferrer* inferrer, AstNode* node) {
+    AstNode* range_node = node->as.for_stmt.iterable;
+    ValueType type = TYPE_NUMBER;
+    IntRange range = { 0, 0 };
+    int64_t trips = -1;  // იტერაციების რაოდენობის ზედა საზღვარი (-1 — უცნობი)
+    if (range_node->type != NODE_RANGE) {
+        // მასივის ელემენტი რიცხვია; მასივის ტიპს გაშვებისას ms_array_iterable ამოწმებს.
+        infer_expression(inferrer, range_node, &range);
+        range = (IntRange){ 0, 0 };
+        if (is_int_array(inferrer, range_node)) {
+            type = TYPE_INT;
+            range.low = -TYPE_INT_LIMIT;
+            range.high = TYPE_INT_LIMIT;
+        }
+        trips = TYPE_ARRAY_MAX_LENGTH;
+    } else {
+        IntRange start, end;
+        ValueType start_type = infer_expression(inferrer, range_node->as.range.start, &start);
+        ValueType end_type = infer_expression(inferrer, range_node->as.range.end, &end);
+        if (start_type == TYPE_UNKNOWN || end_type == TYPE_UNKNOWN) {
+            type = TYPE_UNKNOWN;
+        } else if (start_type == TYPE_INT && end_type == TYPE_INT) {
+            type = TYPE_INT;
+            range.low = start.low;
+            range.high = end.high - 1 < start.low ? start.low : end.high - 1;
+            trips = end.high > start.low ? end.high - start.low : 0;
+        }
+        range_node->value_type = (uint8_t)type;
+    }
+    node->value_type = (uint8_t)type;
+
+    int id = node->as.for_stmt.variable->id;
+    uint8_t saved_type = inferrer->types[id];
+    IntRange saved_range = inferrer->ranges[id];
+    inferrer->types[id] = (uint8_t)type;
+    inferrer->ranges[id] = range;
+
+    uint8_t* saved_accumulators = inferrer->accumulators;
+    IntRange* saved_growth = inferrer->growth;
+    size_t count = (size_t)inferrer->symbol_count + 1;
+    inferrer->accumulators = NULL;
+    inferrer->growth = NULL;
+    if (trips >= 0) {
+        inferrer->accumulators = calloc(count, sizeof(uint8_t));
+        inferrer->growth = malloc(sizeof(IntRange) * count);
+        if (!inferrer->accumulators || !inferrer->growth) {
+            fprintf(stderr, "FATAL: Memory allocation failed for type inference.\n");
+            exit(1);
+        }
+        find_accumulators(inferrer, node->as.for_stmt.body, inferrer->accumulators);
+    }
+
+    bool changed = inferrer->changed;
+    bool entry_unreachable = inferrer->unreachable;
+    IntRange* entry = save_ranges(inferrer);
+    IntRange* head = save_ranges(inferrer);
+    int counted_passes = 0;
+    for (;;) {
+        inferrer->changed = false;
+        if (inferrer->growth != NULL) memset(inferrer->growth, 0, sizeof(IntRange) * count);
+        infer_block(inferrer, node->as.for_stmt.body);
+        bool widened = false;
+        if (!inferrer->unreachable) {
+            if (trips >= 0 && counted_passes < COUNTED_WIDEN_PASSES) {
+                widened = widen_counted_ranges(inferrer, head, entry, trips);
+                if (widened) counted_passes++;
+            } else {
+                widened = widen_ranges(head, inferrer->ranges, inferrer->symbol_count);
+            }
+        }
+        inferrer->unreachable = entry_unreachable;
+        memcpy(inferrer->ranges, head, sizeof(IntRange) * (size_t)inferrer->symbol_count);
+        changed = changed || inferrer->changed;
+        if (!widened && !inferrer->changed) break;
+    }
+    // ჩადგმული ციკლი გარე ციკლის აკუმულატორს მთლიანი სვლით ცვლის. ეს სვლა
+    // ყოველი საწყისი მნიშვნელობისთვის მხოლოდ მაშინაა შეზღუდული, როცა
+    // ცვლადი აქაც აკუმულატორია; სხვა შემთხვევაში გარე ციკლი მას ზღვრამდე აფართოებს.
+    for (int i = 0; saved_accumulators != NULL && i < inferrer->symbol_count; i++) {
+        if (saved_accumulators[i] != ACCUMULATOR_COUNTED || inferrer->types[i] != TYPE_INT) continue;
+        IntRange* growth = &saved_growth[i];
+        if (inferrer->accumulators == NULL || inferrer->accumulators[i] != ACCUMULATOR_COUNTED) {
+            if (head[i].high != entry[i].high || head[i].low != entry[i].low) {
+                growth->high = saturating_add(growth->high, TYPE_INT_LIMIT);
+                growth->low = saturating_add(growth->low, TYPE_INT_LIMIT);
+            }
+            continue;
+        }
+        if (head[i].high > entry[i].high) growth->high = saturating_add(growth->high, head[i].high - entry[i].high);
+        if (head[i].low < entry[i].low) growth->low = saturating_add(growth->low, entry[i].low - head[i].low);
+    }
+    free(inferrer->accumulators);
+    free(inferrer->growth);
+    inferrer->accumulators = saved_accumulators;
+    inferrer->growth = saved_growth;
+    free(entry);
+    free(head);
+    inferrer->changed = changed;
+    inferrer->types[id] = saved_type;
+    inferrer->ranges[id] = saved_range;
+}
+
+static void infer_statement(TypeInferrer* inferrer, AstNode* node) {
+    if (node == NULL) return;
+    IntRange range = { 0, 0 };
+    switch (node->type) {
+        case NODE_VAR_DECL:
+            assign_variable(inferrer, node, node->as.var_decl.name, node->as.var_decl.initializer);
+            break;
+        case NODE_ASSIGN:
+            assign_variable(inferrer, node, node->as.assign.name, node->as.assign.value);
+            break;
+        case NODE_PRINT_STMT:
+            infer_expression(inferrer, node->as.print_stmt.expression, &range);
+            break;
+        case NODE_BLOCK:
+            infer_block(inferrer, node);
+            break;
+        case NODE_IF:
+            infer_if(inferrer, node);
+            break;
+        case NODE_WHILE:
+            infer_while(inferrer, node);
+            break;
+        case NODE_FOR:
+        case NODE_PARALLEL_FOR:
+            infer_for(inferrer, node);
+            break;
+        case NODE_EXPRESSION_STMT:
+            infer_expression(inferrer, node->as.expression_stmt.expression, &range);
+            break;
+        case NODE_INDEX_ASSIGN:
+            infer_expression(inferrer, node, &range);
+            break;
+        case NODE_RETURN: {
+            ValueType type = TYPE_VALUE;
+            if (node->as.return_stmt.value != NULL) type = infer_expression(inferrer, node->as.return_stmt.value, &range);
+            join_return(inferrer, type, range);
+            inferrer->unreachable = true;
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief გაივლის ფუნქციის სხეულს: ლოკალურები types/ranges-ში ჩაინაცვლება,
+ * პარამეტრები არგუმენტების გაერთიანებული შუალედით იწყება. ბოლომდე მიღწევადი
+ * სხეული `არარა`-ს აბრუნებს. პარამეტრებისა და ფუნქციის კვანძებს ტიპები ეწერება.
+ */
+static void infer_function(TypeInferrer* inferrer, FunctionInfo* function) {
+    for (int i = 0; i < function->local_count; i++) {
+        int id = function->locals[i]->id;
+        function->saved_types[i] = inferrer->types[id];
+        function->saved_ranges[i] = inferrer->ranges[id];
+        inferrer->types[id] = function->local_types[i];
+        if (i < function->parameter_count) inferrer->ranges[id] = function->parameter_ranges[i];
+    }
+    inferrer->current = function;
+    inferrer->unreachable = false;
+    infer_block(inferrer, function->node->as.function.body);
+    if (!inferrer->unreachable) {
+        IntRange none = { 0, 0 };
+        join_return(inferrer, TYPE_VALUE, none);
+    }
+    AstNode* parameters = function->node->as.function.parameters;
+    for (int i = 0; i < function->parameter_count; i++) {
+        parameters->as.block.statements[i]->value_type = inferrer->types[function->locals[i]->id];
+    }
+    function->node->value_type = (uint8_t)function->return_type;
+    for (int i = 0; i < function->local_count; i++) {
+        int id = function->locals[i]->id;
+        function->local_types[i] = inferrer->types[id];
+        inferrer->types[id] = function->saved_types[i];
+        inferrer->ranges[id] = function->saved_ranges[i];
+    }
+    inferrer->current = NULL;
+    inferrer->unreachable = false;
+}
+
+/** @brief სახელების შემოწმების მდგომარეობა: ხილული ცვლადები და მათი ბლოკები. */
+typedef struct {
+    bool* visible;         // visible[id] — ცვლადი მიმდინარე წერტილში გამოცხადებულია
+    Symbol** scope;        // ხილული ცვლადები გამოცხადების თანმიმდევრობით
+    int scope_count;
+    int scope_capacity;
+    AstNode** functions;   // functions[id] — ფაილის დონის ფუნქცია (NULL — არ არის)
+    bool* loop_variable;   // loop_variable[id] — ხილული `ყოველი`-ს ცვლადი (მინიჭება აკრძალულია)
+    bool in_function;      // მიმდინარე განცხადება ფუნქციის სხეულშია
+    AstStack walk;
+    bool had_error;
+} NameChecker;
+
+static void name_error(NameChecker* checker, const char* message, Symbol* name) {
+    fprintf(stderr, "შეცდომა: %s: '%s'\n", message, name->chars);
+    checker->had_error = true;
+}
+
+/** @brief ამოწმებს, რომ გამოსახულების ყველა ცვლადი და ფუნქცია გამოცხადებულია. */
+static void check_expression(NameChecker* checker, AstNode* node) {
+    AstNode* current;
+    ast_stack_push(&checker->walk, node);
+    while (ast_stack_next_postorder(&checker->walk, &current)) {
+        if (current == NULL) continue;
+        if (current->type == NODE_VARIABLE && !checker->visible[current->as.variable.name->id]) {
+            name_error(checker, "ცვლადი არ არის გამოცხადებული", current->as.variable.name);
+        }
+        if (current->type == NODE_CALL) {
+            AstNode* function = checker->functions[current->as.call.callee->id];
+            if (function == NULL) {
+                name_error(checker, "ფუნქცია არ არის გამოცხადებული", current->as.call.callee);
+            } else if (function->as.function.parameters->as.block.count != current->as.call.count) {
+                name_error(checker, "არგუმენტების რაოდენობა პარამეტრებს არ ემთხვევა", current->as.call.callee);
+            }
+        }
+        if (current->type == NODE_BUILTIN) {
+            BuiltinFunction function = (BuiltinFunction)current->as.builtin.function;
+            if (builtin_arity(function) != current->as.builtin.count) {
+                fprintf(stderr, "შეცდომა: არგუმენტების რაოდენობა პარამეტრებს არ ემთხვევა: '%s'\n", builtin_name(function));
+                checker->had_error = true;
+            }
+        }
+    }
+}
+
+/** @brief აცხადებს ცვლადს მიმდინარე ბლოკში (ხილულის ხელახალი გამოცხადება შეცდომაა). */
+static void declare_name(NameChecker* checker, Symbol* name) {
+    if (checker->visible[name->id]) {
+        name_error(checker, "ცვლადი უკვე გამოცხადებულია", name);
+        return;
+    }
+    if (checker->scope_count >= checker->scope_capacity) {
+        checker->scope_capacity = checker->scope_capacity < 64 ? 64 : checker->scope_capacity * 2;
+        Symbol** scope = realloc(checker->scope, sizeof(Symbol*) * (size_t)checker->scope_capacity);
+        if (!scope) {
+            fprintf(stderr, "FATAL: Memory allocation failed for type inference.\n");
+            exit(1);
+        }
+        checker->scope = scope;
+    }
+    checker->scope[checker->scope_count++] = name;
+    checker->visible[name->id] = true;
+}
+
+static void check_statement(NameChecker* checker, AstNode* node);
+
+/** @brief ამოწმებს ბლოკს; მასში გამოცხადებული ცვლადები ბლოკის შემდეგ აღარ ჩანს. */
+static void check_block(NameChecker* checker, AstNode* node) {
+    int scope_start = checker->scope_count;
+    if (node != NULL && node->type == NODE_BLOCK) {
+        for (int i = 0; i < node->as.block.count; i++) check_statement(checker, node->as.block.statements[i]);
+    } else {
+        check_statement(checker, node);
+    }
+    while (checker->scope_count > scope_start) checker->visible[checker->scope[--checker->scope_count]->id] = false;
+}
+
+/**
+ * @brief ამოწმებს ფაილის დონის ფუნქციას. სხეული მხოლოდ საკუთარ პარამეტრებსა
+ * და ლოკალურებს ხედავს: პროგრამის მანამდე გამოცხადებული ცვლადები დროებით იმალება.
+ */
+static void check_function(NameChecker* checker, AstNode* node) {
+    int outer = checker->scope_count;
+    for (int i = 0; i < outer; i++) checker->visible[checker->scope[i]->id] = false;
+    AstNode* parameters = node->as.function.parameters;
+    for (int i = 0; i < parameters->as.block.count; i++) {
+        declare_name(checker, parameters->as.block.statements[i]->as.variable.name);
+    }
+    checker->in_function = true;
+    check_block(checker, node->as.function.body);
+    checker->in_function = false;
+    while (checker->scope_count > outer) checker->visible[checker->scope[--checker->scope_count]->id] = false;
+    for (int i = 0; i < outer; i++) checker->visible[checker->scope[i]->id] = true;
+}
+
+static void check_statement(NameChecker* checker, AstNode* node) {
+    if (node == NULL) return;
+    switch (node->type) {
+        case NODE_VAR_DECL:
+            check_expression(checker, node->as.var_decl.initializer);
+            declare_name(checker, node->as.var_decl.name);
+            break;
+        case NODE_ASSIGN:
+            check_expression(checker, node->as.assign.value);
+            if (!checker->visible[node->as.assign.name->id]) {
+                name_error(checker, "ცვლადი არ არის გამოცხადებული", node->as.assign.name);
+            } else if (checker->loop_variable[node->as.assign.name->id]) {
+                name_error(checker, "ციკლის ცვლადს მნიშვნელობა ვერ მიენიჭება", node->as.assign.name);
+            }
+            break;
+        case NODE_PRINT_STMT:
+            check_expression(checker, node->as.print_stmt.expression);
+            break;
+        case NODE_EXPRESSION_STMT:
+            check_expression(checker, node->as.expression_stmt.expression);
+            break;
+        case NODE_INDEX_ASSIGN:
+            check_expression(checker, node);
+            break;
+        case NODE_BLOCK:
+            check_block(checker, node);
+            break;
+        case NODE_IF:
+            while (node != NULL && node->type == NODE_IF) {
+                check_expression(checker, node->as.if_stmt.condition);
+                check_block(checker, node->as.if_stmt.then_branch);
+                node = node->as.if_stmt.else_branch;
+            }
+            check_block(checker, node);
+            break;
+        case NODE_WHILE:
+            check_expression(checker, node->as.while_stmt.condition);
+            check_block(checker, node->as.while_stmt.body);
+            break;
+        case NODE_FOR:
+        case NODE_PARALLEL_FOR: {
+            // ციკლის ცვლადი სხეულის ბლოკს ეკუთვნის: ის სხეულის ბოლოს ქრება.
+            Symbol* variable = node->as.for_stmt.variable;
+            int scope_start = checker->scope_count;
+            check_expression(checker, node->as.for_stmt.iterable);
+            declare_name(checker, variable);
+            checker->loop_variable[variable->id] = true;
+            check_block(checker, node->as.for_stmt.body);
+            checker->loop_variable[variable->id] = false;
+            while (checker->scope_count > scope_start) checker->visible[checker->scope[--checker->scope_count]->id] = false;
+            break;
+        }
+        case NODE_RETURN:
+            if (!checker->in_function) {
+                fprintf(stderr, "შეცდომა: 'დაბრუნე' მხოლოდ ფუნქციის შიგნით შეიძლება\n");
+                checker->had_error = true;
+            }
+            check_expression(checker, node->as.return_stmt.value);
+            break;
+        case NODE_FUNCTION:
+            // ფაილის დონის ფუნქციებს check_names ამოწმებს.
+            name_error(checker, "ფუნქცია მხოლოდ ფაილის დონეზე შეიძლება განისაზღვროს", node->as.function.name);
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief ამოწმებს სახელებს: ცვლადი გამოყენებამდე და მინიჭებამდე უნდა იყოს
+ * გამოცხადებული, ხოლო ხილულ ცვლადს ხელახლა ვერ გამოვაცხადებთ. ბლოკში
+ * გამოცხადებული ცვლადი ბლოკის ბოლომდე ჩანს. ფუნქციები ფაილის დონეზე
+ * ცხადდება და ფაილის ნებისმიერი ადგილიდან გამოიძახება (განსაზღვრამდეც).
+ */
+static bool check_names(AstNode* program, AstContext* ctx) {
+    NameChecker checker;
+    checker.visible = calloc((size_t)ctx->symbol_count + 1, sizeof(bool));
+    checker.functions = calloc((size_t)ctx->symbol_count + 1, sizeof(AstNode*));
+    checker.loop_variable = calloc((size_t)ctx->symbol_count + 1, sizeof(bool));
+    if (!checker.visible || !checker.functions || !checker.loop_variable) {
+        fprintf(stderr, "FATAL: Memory allocation failed for type inference.\n");
+        exit(1);
+    }
+    checker.scope = NULL;
+    checker.scope_count = 0;
+    checker.scope_capacity = 0;
+    checker.in_function = false;
+    init_ast_stack(&checker.walk);
+    checker.had_error = false;
+    for (int i = 0; i < program->as.program.count; i++) {
+        AstNode* node = program->as.program.statements[i];
+        if (node == NULL || node->type != NODE_FUNCTION) continue;
+        Symbol* name = node->as.function.name;
+        if (lookup_builtin(name->chars, name->length) >= 0) {
+            name_error(&checker, "სახელი ჩაშენებულ ფუნქციას ეკუთვნის", name);
+        } else if (checker.functions[name->id] != NULL) {
+            name_error(&checker, "ფუნქცია უკვე გამოცხადებულია", name);
+        } else {
+            checker.functions[name->id] = node;
+        }
+    }
+    for (int i = 0; i < program->as.program.count; i++) {
+        AstNode* node = program->as.program.statements[i];
+        if (node != NULL && node->type == NODE_FUNCTION) check_function(&checker, node);
+        else check_statement(&checker, node);
+    }
+    free(checker.visible);
+    free(checker.functions);
+    free(checker.loop_variable);
+    free(checker.scope);
+    free_ast_stack(&checker.walk);
+    return !checker.had_error;
+}
+
+/** @brief ამზადებს ფუნქციის ანალიზის მდგომარეობას: პარამეტრები და სხეულის დეკლარაციები. */
+static void init_function_info(FunctionInfo* function, AstNode* node, bool* seen, AstStack* walk) {
+    AstNode* parameters = node->as.function.parameters;
+    int capacity = parameters->as.block.count + 8;
+    function->node = node;
+    function->locals = malloc(sizeof(Symbol*) * (size_t)capacity);
+    if (!function->locals) {
+        fprintf(stderr, "FATAL: Memory allocation failed for type inference.\n");
+        exit(1);
+    }
+    function->local_count = 0;
+    for (int i = 0; i < parameters->as.block.count; i++) {
+        function->locals[function->local_count++] = parameters->as.block.statements[i]->as.variable.name;
+    }
+    function->parameter_count = function->local_count;
+    AstNode* current;
+    ast_stack_push(walk, node->as.function.body);
+    while (ast_stack_next_postorder(walk, &current)) {
+        if (current == NULL || current->type != NODE_VAR_DECL || seen[current->as.var_decl.name->id]) continue;
+        seen[current->as.var_decl.name->id] = true;
+        if (function->local_count >= capacity) {
+            capacity *= 2;
+            Symbol** locals = realloc(function->locals, sizeof(Symbol*) * (size_t)capacity);
+            if (!locals) {
+                fprintf(stderr, "FATAL: Memory allocation failed for type inference.\n");
+                exit(1);
+            }
+            function->locals = locals;
+        }
+        function->locals[function->local_count++] = current->as.var_decl.name;
+    }
+    for (int i = function->parameter_count; i < function->local_count; i++) seen[function->locals[i]->id] = false;
+    size_t count = (size_t)function->local_count + 1;
+    function->local_types = calloc(count, sizeof(uint8_t));
+    function->saved_types = calloc(count, sizeof(uint8_t));
+    function->parameter_ranges = calloc(count, sizeof(IntRange));
+    function->saved_ranges = calloc(count, sizeof(IntRange));
+    if (!function->local_types || !function->saved_types || !function->parameter_ranges || !function->saved_ranges) {
+        fprintf(stderr, "FATAL: Memory allocation failed for type inference.\n");
+        exit(1);
+    }
+    function->return_type = TYPE_UNKNOWN;
+    function->return_range.low = function->return_range.high = 0;
+}
+
+static void free_function_info(FunctionInfo* function) {
+    free(function->locals);
+    free(function->local_types);
+    free(function->saved_types);
+    free(function->parameter_ranges);
+    free(function->saved_ranges);
+}
+
+/**
+ * @brief გამოძახებების გარეშე დარჩენილ პარამეტრებსა და დაუბრუნებელ ფუნქციებს
+ * (მაგ. უსასრულო რეკურსია) ზოგად ტიპს (TYPE_VALUE) ანიჭებს.
+ * @return bool true, თუ რომელიმე ტიპი შეიცვალა და გავლები უნდა გაგრძელდეს.
+ */
+static bool resolve_unknown_types(TypeInferrer* inferrer) {
+    bool resolved = false;
+    for (int i = 0; i < inferrer->function_count; i++) {
+        FunctionInfo* function = &inferrer->function_infos[i];
+        for (int j = 0; j < function->parameter_count; j++) {
+            if (function->local_types[j] != TYPE_UNKNOWN) continue;
+            function->local_types[j] = TYPE_VALUE;
+            resolved = true;
+        }
+        if (function->return_type == TYPE_UNKNOWN) {
+            function->return_type = TYPE_VALUE;
+            resolved = true;
+        }
+    }
+    return resolved;
+}
+
+/**
+ * @brief ამოწმებს `პარალელური ყოველი` ციკლებს: ციკლი დიაპაზონს უნდა გადიოდეს, საზღვრები მთელი უნდა იყოს,
+ * იტერაციები კი დამოუკიდებელი (იხ. analyze_loop), რომ ნაკადებს შორის
+ * განაწილებამ შედეგი არ შეცვალოს.
+ * @return bool false, თუ რომელიმე ციკლი ამას არ აკმაყოფილებს (შეტყობინება დაბეჭდილია).
+ */
+static bool check_parallel_loops(AstNode* program, AstStack* walk) {
+    AstStack body_walk;
+    init_ast_stack(&body_walk);
+    bool ok = true;
+    AstNode* node;
+    ast_stack_push(walk, program);
+    while (ast_stack_next_postorder(walk, &node)) {
+        if (node == NULL || node->type != NODE_PARALLEL_FOR) continue;
+        const char* variable = node->as.for_stmt.variable->chars;
+        if (node->as.for_stmt.iterable->type != NODE_RANGE) {
+            fprintf(stderr, "შეცდომა: პარალელური ციკლი მხოლოდ დიაპაზონს შეიძლება გადიოდეს: '%s'\n", variable);
+            ok = false;
+            continue;
+        }
+        if (node->value_type != TYPE_INT) {
+            fprintf(stderr, "შეცდომა: პარალელური ციკლის საზღვრები მთელი რიცხვები უნდა იყოს: '%s'\n", variable);
+            ok = false;
+            continue;
+        }
+        LoopAnalysis analysis;
+        if (!analyze_loop(node, &body_walk, true, &analysis)) {
+            if (analysis.culprit != NULL) {
+                fprintf(stderr, "შეცდომა: პარალელური ციკლი გარე ცვლადს მხოლოდ მთელი ჯამით, მინიმუმით ან მაქსიმუმით "
+                                "შეიძლება ცვლიდეს: '%s'\n", analysis.culprit->chars);
+            } else {
+                fprintf(stderr, "შეცდომა: პარალელური ციკლის სხეულში დაუშვებელია %s: '%s'\n", analysis.failure, variable);
+            }
+            ok = false;
+        }
+        free_loop_analysis(&analysis);
+    }
+    free_ast_stack(&body_walk);
+    return ok;
+}
+
+bool infer_types(AstNode* program, AstContext* ctx) {
+    if (program == NULL || program->type != NODE_PROGRAM) return true;
+    if (!check_names(program, ctx)) return false;
+
+    TypeInferrer inferrer;
+    inferrer.symbol_count = ctx->symbol_count;
+    inferrer.types = calloc((size_t)ctx->symbol_count + 1, sizeof(uint8_t));
+    inferrer.ranges = calloc((size_t)ctx->symbol_count + 1, sizeof(IntRange));
+    inferrer.functions = calloc((size_t)ctx->symbol_count + 1, sizeof(FunctionInfo*));
+    inferrer.function_infos = calloc((size_t)program->as.program.count + 1, sizeof(FunctionInfo));
+    if (!inferrer.types || !inferrer.ranges || !inferrer.functions || !inferrer.function_infos) {
+        fprintf(stderr, "FATAL: Memory allocation failed for type inference.\n");
+        exit(1);
+    }
+    init_ast_stack(&inferrer.walk);
+    inferrer.range_stack = NULL;
+    inferrer.range_count = 0;
+    inferrer.range_capacity = 0;
+    inferrer.function_count = 0;
+    inferrer.current = NULL;
+    inferrer.unreachable = false;
+    inferrer.accumulators = NULL;
+    inferrer.growth = NULL;
+    inferrer.array_kinds = calloc((size_t)ctx->symbol_count + 1, sizeof(uint8_t));
+    inferrer.int_stores = true;
+    if (!inferrer.array_kinds) {
+        fprintf(stderr, "FATAL: Memory allocation failed for type inference.\n");
+        exit(1);
+    }
+
+    bool* seen = calloc((size_t)ctx->symbol_count + 1, sizeof(bool));
+    if (!seen) {
+        fprintf(stderr, "FATAL: Memory allocation failed for type inference.\n");
+        exit(1);
+    }
+    for (int i = 0; i < program->as.program.count; i++) {
+        AstNode* node = program->as.program.statements[i];
+        if (node == NULL || node->type != NODE_FUNCTION) continue;
+        FunctionInfo* function = &inferrer.function_infos[inferrer.function_count++];
+        init_function_info(function, node, seen, &inferrer.walk);
+        inferrer.functions[node->as.function.name->id] = function;
+        // პარამეტრის მასივი გამომძახებლიდან მოდის, მისი სახე უცნობია.
+        for (int j = 0; j < function->parameter_count; j++) inferrer.array_kinds[function->locals[j]->id] = ARRAY_KIND_OTHER;
+    }
+    free(seen);
+
+    // ცვლადის ტიპი შეიძლება მოგვიანებით მინიჭებამ გააფართოოს, მაშინ მისი
+    // ადრინდელი გამოყენებებიც ხელახლა უნდა გაიაროს. ტიპები მხოლოდ ფართოვდება,
+    // ამიტომ გავლები რამდენიმეჯერ მეორდება; ბოლო გავლა არაფერს ცვლის.
+    // ფუნქციის პარამეტრები და შედეგი გამოძახებებიდან და `დაბრუნე`-ებიდან
+    // იმავე გავლებში გროვდება.
+    do {
+        do {
+            inferrer.changed = false;
+            for (int i = 0; i < program->as.program.count; i++) {
+                AstNode* node = program->as.program.statements[i];
+                if (node != NULL && node->type == NODE_FUNCTION) {
+                    infer_function(&inferrer, inferrer.functions[node->as.function.name->id]);
+                } else {
+                    infer_statement(&inferrer, node);
+                }
+            }
+        } while (inferrer.changed);
+    } while (resolve_unknown_types(&inferrer));
+    bool ok = check_parallel_loops(program, &inferrer.walk);
+
+    for (int i = 0; i < inferrer.function_count; i++) free_function_info(&inferrer.function_infos[i]);
+    free(inferrer.function_infos);
+    free(inferrer.functions);
+    free(inferrer.types);
+    free(inferrer.ranges);
+    free(inferrer.array_kinds);
+    free_ast_stack(&inferrer.walk);
+    free(inferrer.range_stack);
+    return ok;
+}
@@ -0,0 +1,93 @@
+/**
+ * @file vm.c
+ * @author გიორგი მაღრაძე (magradze.giorgi@gmail.com)
+ * @brief რეგისტრული ვირტუალური მანქანის იმპლემენტაცია.
+ * @version 0.2
+ *
+ * GCC/Clang-ზე გამოიყენება "computed goto" — ყოველი ინსტრუქციის ბოლოს
+ * პირდაპირი გადასვლა შემდეგის დამმუშავებელზე, რაც ტოტების პროგნოზირებას
+ * აუმჯობესებს. სხვა კომპილატორებზე იგივე ციკლი switch-ით სრულდება.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+#include "vm.h"
+
+#if defined(__GNUC__)
+#define VM_COMPUTED_GOTO 1
+#endif
+
+int run_bytecode(Chunk* chunk) {
+    double* registers = calloc((size_t)chunk->register_count + 1, sizeof(double));
+    if (!registers) {
+        fprintf(stderr, "FATAL: Memory allocation failed for VM registers.\n");
+        exit(1);
+    }
+    const double* constants = chunk->constants;
+    const Instruction* ip = chunk->code;
+    const Instruction* in;
+
+#ifdef VM_COMPUTED_GOTO
+    static void* dispatch_table[OP_COUNT] = {
+        [OP_LOADK] = &&op_loadk, [OP_MOVE] = &&op_move,
+        [OP_ADD] = &&op_add, [OP_SUB] = &&op_sub, [OP_MUL] = &&op_mul, [OP_DIV] = &&op_div,
+        [OP_NEG] = &&op_neg, [OP_PRINT] = &&op_print, [OP_PRINT_INT] = &&op_print_int, [OP_HALT] = &&op_halt,
+    };
+#define VM_CASE(name) name:
+#define VM_DISPATCH() do { in = ip++; goto *dispatch_table[in->op]; } while (0)
+    VM_DISPATCH();
+#else
+#define VM_CASE(name) case name##_opcode:
+#define VM_DISPATCH() goto dispatch
+    enum {
+        op_loadk_opcode = OP_LOADK, op_move_opcode = OP_MOVE, op_add_opcode = OP_ADD,
+        op_sub_opcode = OP_SUB, op_mul_opcode = OP_MUL, op_div_opcode = OP_DIV,
+        op_neg_opcode = OP_NEG, op_print_opcode = OP_PRINT, op_print_int_opcode = OP_PRINT_INT,
+        op_halt_opcode = OP_HALT,
+    };
+dispatch:
+    in = ip++;
+    switch (in->op) {
+#endif
+
+    VM_CASE(op_loadk)
+        registers[in->a] = constants[in->b | ((uint32_t)in->c << 16)];
+        VM_DISPATCH();
+    VM_CASE(op_move)
+        registers[in->a] = registers[in->b];
+        VM_DISPATCH();
+    VM_CASE(op_add)
+        registers[in->a] = registers[in->b] + registers[in->c];
+        VM_DISPATCH();
+    VM_CASE(op_sub)
+        registers[in->a] = registers[in->b] - registers[in->c];
+        VM_DISPATCH();
+    VM_CASE(op_mul)
+        registers[in->a] = registers[in->b] * registers[in->c];
+        VM_DISPATCH();
+    VM_CASE(op_div)
+        registers[in->a] = registers[in->b] / registers[in->c];
+        VM_DISPATCH();
+    VM_CASE(op_neg)
+        registers[in->a] = -registers[in->b];
+        VM_DISPATCH();
+    VM_CASE(op_print)
+        // ფორმატი ემთხვევა C ბექენდის `printf("%f\n", ...)`-ს.
+        printf("%f\n", registers[in->a]);
+        VM_DISPATCH();
+    VM_CASE(op_print_int)
+        // მთელი მნიშვნელობა ზუსტია (|x| <= 2^53), ამიტომ int64_t-ად გარდაქმნა უდანაკარგოა;
+        // ფართო მთელი ამ ზღვრის მიღმა double-ზეა გადასული და ისე იბეჭდება (იხ. ms_print_int).
+        if (registers[in->a] >= -9007199254740992.0 && registers[in->a] <= 9007199254740992.0) printf("%" PRId64 "\n", (int64_t)registers[in->a]);
+        else printf("%f\n", registers[in->a]);
+        VM_DISPATCH();
+    VM_CASE(op_halt)
+        free(registers);
+        return 0;
+
+#ifndef VM_COMPUTED_GOTO
+    }
+    free(registers);
+    return 1;
+#endif
+}
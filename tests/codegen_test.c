@@ -0,0 +1,94 @@
+/**
+ * @file codegen_test.c
+ * @author გიორგი მაღრაძე (magradze.giorgi@gmail.com)
+ * @brief C ბექენდის ტესტები: მასივების ინდექსების ციკლის ბირთვი.
+ * @version 0.1
+ *
+ * ყოველი ტესტი წყაროს სრულ კონვეიერს (ლექსერი, პარსერი, ტიპები,
+ * ოპტიმიზატორი) გადის და გენერირებულ C კოდში ტექსტს ეძებს.
+ * გაშვება: make test
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "codegen.h"
+#include "optimizer.h"
+#include "parser.h"
+#include "token_stream.h"
+#include "type_infer.h"
+
+static int failures = 0;
+
+#define CHECK(condition, message)                                              \
+    do {                                                                       \
+        if (!(condition)) {                                                    \
+            fprintf(stderr, "%s:%d: %s\n", __FILE__, __LINE__, message);       \
+            failures++;                                                        \
+        }                                                                      \
+    } while (0)
+
+/** @brief აბრუნებს `source`-ის გენერირებულ C კოდს (გამომძახებელი ათავისუფლებს); შეცდომისას NULL. */
+static char* generate_source(const char* source) {
+    AstContext ast;
+    TokenStream tokens;
+    init_ast_context(&ast);
+    lex_all(&tokens, source, strlen(source));
+    Parser parser;
+    init_parser_from_stream(&parser, &tokens, &ast);
+    AstNode* program = parse(&parser);
+    char* code = NULL;
+    if (!parser.had_error && infer_types(program, &ast)) {
+        OptimizerStats stats;
+        memset(&stats, 0, sizeof(stats));
+        program = optimize_program(program, &ast, &stats);
+        CodeBuffer buffer;
+        init_code_buffer(&buffer);
+        generate_code_to_buffer(program, &buffer);
+        code = buffer.data;
+    }
+    free_ast_context(&ast);
+    free_token_stream(&tokens);
+    return code;
+}
+
+/** @brief `ა[ი] = ბ[ი] * 2` ბუფერებს restrict მაჩვენებლებით, ვექტორიზაციის პრაგმით კითხულობს. */
+static void test_index_loop_kernel(void) {
+    char* code = generate_source("ცვლადი ა = მასივი(100)\n"
+                                 "ცვლადი ბ = მასივი(100)\n"
+                                 "ყოველი ი ში 0..100:\n"
+                                 "    ა[ი] = ბ[ი] * 2\n"
+                                 "დაბეჭდე ა\n");
+    CHECK(code != NULL, "პროგრამა ვერ კომპილირდა");
+    if (code == NULL) return;
+    CHECK(strstr(code, "#pragma GCC ivdep") != NULL, "ბირთვს #pragma GCC ivdep აკლია");
+    CHECK(strstr(code, "#pragma omp simd") != NULL, "ბირთვს #pragma omp simd აკლია");
+    CHECK(strstr(code, "double* restrict") != NULL, "ჩასაწერი ბუფერი restrict არ არის");
+    CHECK(strstr(code, "const double* restrict") != NULL, "წასაკითხი ბუფერი restrict არ არის");
+    CHECK(strstr(code, "ms_array_spans(v_ა, MS_ARRAY_DOUBLE") != NULL, "მასივის საზღვრები არ მოწმდება");
+    free(code);
+}
+
+/** @brief გამოყოფის შემცველი სხეული (`დაამატე`) ბირთვს არ იღებს. */
+static void test_allocating_body_has_no_kernel(void) {
+    char* code = generate_source("ცვლადი ა = მასივი(0)\n"
+                                 "ცვლადი ბ = მასივი(10)\n"
+                                 "ყოველი ი ში 0..10:\n"
+                                 "    დაამატე(ა, ი)\n"
+                                 "    ბ[ი] = ი\n"
+                                 "დაბეჭდე ა\n");
+    CHECK(code != NULL, "პროგრამა ვერ კომპილირდა");
+    if (code == NULL) return;
+    CHECK(strstr(code, "ms_array_spans") == NULL, "გამოყოფის შემცველ ციკლს ბირთვი არ უნდა ჰქონდეს");
+    free(code);
+}
+
+int main(void) {
+    test_index_loop_kernel();
+    test_allocating_body_has_no_kernel();
+    if (failures > 0) {
+        fprintf(stderr, "codegen_test: %d შემოწმება ჩაიშალა\n", failures);
+        return 1;
+    }
+    printf("codegen_test: OK\n");
+    return 0;
+}
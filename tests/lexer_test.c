@@ -0,0 +1,49 @@
+/**
+ * @file lexer_test.c
+ * @author გიორგი მაღრაძე (magradze.giorgi@gmail.com)
+ * @brief ლექსერის ტესტები: საკვანძო სიტყვების სრულყოფილი ჰეში.
+ * @version 0.1
+ *
+ * ცხრილი tools/keyword_hash.c-ით გენერირდება; ტესტი ამოწმებს, რომ ის
+ * TokenType-ის საკვანძო სიტყვებს ემთხვევა.
+ * გაშვება: make test
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "lexer.h"
+
+static int failures = 0;
+
+#define CHECK(condition, message)                                              \
+    do {                                                                       \
+        if (!(condition)) {                                                    \
+            fprintf(stderr, "%s:%d: %s\n", __FILE__, __LINE__, message);       \
+            failures++;                                                        \
+        }                                                                      \
+    } while (0)
+
+/** @brief ყოველი საკვანძო სიტყვა ჰეშის ცხრილის საკუთარ უჯრაშია. */
+static void test_keyword_table(void) {
+    CHECK(check_keyword_table(), "საკვანძო სიტყვების ცხრილი TokenType-ს არ ემთხვევა (make keyword-hash)");
+}
+
+/** @brief საკვანძო სიტყვის მსგავსი სახელები იდენტიფიკატორებად რჩება. */
+static void test_identifiers_are_not_keywords(void) {
+    static const char* names[] = { "თუმცა", "სხვადასხვა", "ცვლადები", "ში_", "ყოველიდღე", "x" };
+    for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); i++) {
+        CHECK(lookup_keyword(names[i], (int)strlen(names[i])) == TOKEN_IDENTIFIER, names[i]);
+    }
+    CHECK(lookup_keyword("ყოველი", (int)strlen("ყოველი")) == TOKEN_ყოველი, "ყოველი საკვანძო სიტყვად არ ამოიცნო");
+}
+
+int main(void) {
+    test_keyword_table();
+    test_identifiers_are_not_keywords();
+    if (failures > 0) {
+        fprintf(stderr, "lexer_test: %d შემოწმება ჩაიშალა\n", failures);
+        return 1;
+    }
+    printf("lexer_test: OK\n");
+    return 0;
+}
@@ -0,0 +1,148 @@
+/**
+ * @file parser_test.c
+ * @author გიორგი მაღრაძე (magradze.giorgi@gmail.com)
+ * @brief პარსერის ტესტები: რიცხვითი ლიტერალები და ჩადგმულობის ზღვარი.
+ * @version 0.2
+ *
+ * ყოველი ტესტი წყაროს სტრიქონს ლექსირებს, არჩევს და AST-ს ამოწმებს.
+ * გაშვება: make test
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "parser.h"
+#include "token_stream.h"
+
+static int failures = 0;
+
+#define CHECK(condition, message)                                              \
+    do {                                                                       \
+        if (!(condition)) {                                                    \
+            fprintf(stderr, "%s:%d: %s\n", __FILE__, __LINE__, message);       \
+            failures++;                                                        \
+        }                                                                      \
+    } while (0)
+
+/** @brief არჩეული პროგრამა და მისი მფლობელი სტრუქტურები. */
+typedef struct {
+    TokenStream tokens;
+    AstContext ast;
+    AstNode* program;
+    bool had_error;
+} Parsed;
+
+/** @brief ლექსირებს და არჩევს `source`-ს ჩადგმულობის `max_depth` ზღვრით. */
+static void parse_source_limited(Parsed* parsed, const char* source, int max_depth) {
+    init_ast_context(&parsed->ast);
+    lex_all(&parsed->tokens, source, strlen(source));
+    Parser parser;
+    init_parser_from_stream(&parser, &parsed->tokens, &parsed->ast);
+    parser.max_depth = max_depth;
+    parsed->program = parse(&parser);
+    parsed->had_error = parser.had_error;
+}
+
+/** @brief ლექსირებს და არჩევს `source`-ს ნაგულისხმევი პარამეტრებით. */
+static void parse_source(Parsed* parsed, const char* source) {
+    parse_source_limited(parsed, source, PARSER_DEFAULT_MAX_DEPTH);
+}
+
+static void free_parsed(Parsed* parsed) {
+    free_ast_context(&parsed->ast);
+    free_token_stream(&parsed->tokens);
+}
+
+/** @brief აბრუნებს პირველი `დაბეჭდე` განცხადების გამოსახულებას. */
+static AstNode* first_print(Parsed* parsed) {
+    if (parsed->program == NULL || parsed->program->as.program.count == 0) return NULL;
+    AstNode* statement = parsed->program->as.program.statements[0];
+    return statement->type == NODE_PRINT_STMT ? statement->as.print_stmt.expression : NULL;
+}
+
+/** @brief 64 ბაიტზე გრძელი ლიტერალი მთლიანად უნდა წაიკითხოს (შეკვეცის გარეშე). */
+static void test_long_number_literal(void) {
+    char source[128] = "დაბეჭდე 1";
+    for (int i = 0; i < 70; i++) strcat(source, "0");
+    strcat(source, "\n");
+    Parsed parsed;
+    parse_source(&parsed, source);
+    AstNode* number = first_print(&parsed);
+    CHECK(!parsed.had_error, "71-ციფრიანი ლიტერალი ვერ გაირჩა");
+    CHECK(number != NULL && number->type == NODE_NUMBER, "მოსალოდნელი იყო რიცხვითი ლიტერალი");
+    if (number != NULL && number->type == NODE_NUMBER) {
+        CHECK(number->as.number.value == 1e70, "71-ციფრიანი ლიტერალი 1e70 არ არის");
+    }
+    free_parsed(&parsed);
+}
+
+/** @brief მოკლე ლიტერალი (სტეკის ბუფერის გზა) უცვლელად რჩება. */
+static void test_short_number_literal(void) {
+    Parsed parsed;
+    parse_source(&parsed, "დაბეჭდე 3.25\n");
+    AstNode* number = first_print(&parsed);
+    CHECK(number != NULL && number->type == NODE_NUMBER && number->as.number.value == 3.25,
+          "3.25 არასწორად გაირჩა");
+    free_parsed(&parsed);
+}
+
+/** @brief აგებს `დაბეჭდე <first><middle><middle>…<last>` პროგრამას (`count` ცალი middle). */
+static char* repeat_source(const char* first, const char* middle, const char* last, int count) {
+    size_t size = strlen("დაბეჭდე ") + strlen(first) + strlen(middle) * (size_t)count + strlen(last) + 2;
+    char* source = malloc(size);
+    if (!source) {
+        fprintf(stderr, "FATAL: Memory allocation failed for test source.\n");
+        exit(1);
+    }
+    char* end = source;
+    end += sprintf(end, "დაბეჭდე %s", first);
+    for (int i = 0; i < count; i++) end += sprintf(end, "%s", middle);
+    sprintf(end, "%s\n", last);
+    return source;
+}
+
+/** @brief 200 000-წევრიანი ბრტყელი `+` ჯაჭვი ნაგულისხმევ ზღვარს (100 000) არ ეჯახება. */
+static void test_flat_chain_within_default_depth(void) {
+    char* source = repeat_source("ა", " + ა", "", 199999);
+    Parsed parsed;
+    parse_source(&parsed, source);
+    AstNode* sum = first_print(&parsed);
+    CHECK(!parsed.had_error, "ბრტყელი `+` ჯაჭვი ჩადგმულობის ზღვარს არ უნდა სცდებოდეს");
+    CHECK(sum != NULL && sum->type == NODE_BINARY_OP, "მოსალოდნელი იყო ორობითი ოპერაცია");
+    free_parsed(&parsed);
+    free(source);
+}
+
+/** @brief ფრჩხილებით მარჯვნივ ჩადგმული ჯაჭვი და ერთმაგი მინუსები ზღვარს კვლავ ეჯახება. */
+static void test_right_nesting_counts(void) {
+    Parsed parsed;
+    char* source = repeat_source("ა", " + (ა", "))))))))))))))))))))", 20);
+    parse_source_limited(&parsed, source, 10);
+    CHECK(parsed.had_error, "20 დონით ჩადგმული ფრჩხილები 10-იან ზღვარს უნდა სცდებოდეს");
+    free_parsed(&parsed);
+    free(source);
+
+    source = repeat_source("", "-", "ა", 20);
+    parse_source_limited(&parsed, source, 10);
+    CHECK(parsed.had_error, "20 ერთმაგი მინუსი 10-იან ზღვარს უნდა სცდებოდეს");
+    free_parsed(&parsed);
+    free(source);
+
+    source = repeat_source("ა", " + ა", "", 50);
+    parse_source_limited(&parsed, source, 10);
+    CHECK(!parsed.had_error, "ბრტყელი ჯაჭვი ზღვარს არ უნდა ზრდიდეს");
+    free_parsed(&parsed);
+    free(source);
+}
+
+int main(void) {
+    test_long_number_literal();
+    test_short_number_literal();
+    test_flat_chain_within_default_depth();
+    test_right_nesting_counts();
+    if (failures > 0) {
+        fprintf(stderr, "parser_test: %d შემოწმება ჩაიშალა\n", failures);
+        return 1;
+    }
+    printf("parser_test: OK\n");
+    return 0;
+}
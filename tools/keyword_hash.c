@@ -0,0 +1,115 @@
+/**
+ * @file keyword_hash.c
+ * @author გიორგი მაღრაძე (magradze.giorgi@gmail.com)
+ * @brief საკვანძო სიტყვების სრულყოფილი ჰეშის გენერატორი.
+ * @version 0.1
+ *
+ * საკვანძო სიტყვებს TokenType-ის TOKEN_FIRST_KEYWORD..TOKEN_LAST_KEYWORD
+ * დიაპაზონიდან იღებს (ტექსტი — token_type_name-ის "KEYWORD_" სუფიქსი),
+ * ეძებს lexer.c-ის keyword_hash ფორმულის მამრავლებს, რომლებზეც ყოველი
+ * სიტყვა საკუთარ უჯრაში ხვდება, და stdout-ზე წერს lexer.c-ში ჩასასმელ
+ * მაკროებსა და keyword_table-ს. ახალი საკვანძო სიტყვის დამატებისას:
+ * `make keyword-hash` და ბლოკის ჩანაცვლება lexer.c-ში.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "lexer.h"
+
+#define MAX_KEYWORDS 64
+#define MAX_COEFFICIENT 15
+#define MAX_TABLE_SIZE 256
+
+typedef struct {
+    const unsigned char* text;
+    int length;
+    TokenType type;
+} Keyword;
+
+/** @brief lexer.c-ის keyword_hash იგივე ფორმულით, პარამეტრიზებული მამრავლებით. */
+static unsigned int hash(const Keyword* keyword, unsigned int size, const unsigned int coefficients[3]) {
+    const unsigned char* str = keyword->text;
+    int length = keyword->length;
+    return (str[2] + coefficients[0] * (unsigned int)length + coefficients[1] * str[length - 1] +
+            coefficients[2] * str[length - 4]) & (size - 1);
+}
+
+/** @brief UTF-8 სიმბოლოების რაოდენობა (ცხრილის სვეტების გასასწორებლად). */
+static int display_width(const unsigned char* text) {
+    int width = 0;
+    for (; *text != '\0'; text++) {
+        if ((*text & 0xC0) != 0x80) width++;
+    }
+    return width;
+}
+
+int main(void) {
+    Keyword keywords[MAX_KEYWORDS];
+    int count = 0;
+    int min_length = 0, max_length = 0;
+    size_t prefix = strlen("KEYWORD_");
+    for (int type = TOKEN_FIRST_KEYWORD; type <= TOKEN_LAST_KEYWORD; type++) {
+        const char* name = token_type_name((TokenType)type);
+        if (count == MAX_KEYWORDS || strncmp(name, "KEYWORD_", prefix) != 0) {
+            fprintf(stderr, "შეცდომა: %s არ არის საკვანძო სიტყვის ტოკენი.\n", name);
+            return 1;
+        }
+        Keyword* keyword = &keywords[count++];
+        keyword->text = (const unsigned char*)name + prefix;
+        keyword->length = (int)strlen(name + prefix);
+        keyword->type = (TokenType)type;
+        // ფორმულა მესამე ბაიტს და ბოლოდან მეოთხეს კითხულობს: მინიმუმ ორი ქართული ასო.
+        if (keyword->length < 6) {
+            fprintf(stderr, "შეცდომა: საკვანძო სიტყვა '%s' ძალიან მოკლეა.\n", keyword->text);
+            return 1;
+        }
+        if (min_length == 0 || keyword->length < min_length) min_length = keyword->length;
+        if (keyword->length > max_length) max_length = keyword->length;
+    }
+
+    // უმცირესი ცხრილი, შემდეგ უმცირესი მამრავლები.
+    unsigned int size = 1;
+    while (size < (unsigned int)count) size *= 2;
+    for (; size <= MAX_TABLE_SIZE; size *= 2) {
+        unsigned int coefficients[3];
+        for (coefficients[0] = 1; coefficients[0] <= MAX_COEFFICIENT; coefficients[0]++) {
+            for (coefficients[1] = 1; coefficients[1] <= MAX_COEFFICIENT; coefficients[1]++) {
+                for (coefficients[2] = 1; coefficients[2] <= MAX_COEFFICIENT; coefficients[2]++) {
+                    const Keyword* slots[MAX_TABLE_SIZE] = { 0 };
+                    bool perfect = true;
+                    for (int i = 0; i < count && perfect; i++) {
+                        unsigned int slot = hash(&keywords[i], size, coefficients);
+                        if (slots[slot] != NULL) perfect = false;
+                        slots[slot] = &keywords[i];
+                    }
+                    if (!perfect) continue;
+
+                    int width = 0;
+                    for (int i = 0; i < count; i++) {
+                        int w = display_width(keywords[i].text);
+                        if (w > width) width = w;
+                    }
+                    printf("// მაკროები და keyword_table გენერირებულია tools/keyword_hash.c-ით (`make keyword-hash`); ხელით არ შეცვალოთ.\n");
+                    printf("#define KEYWORD_MIN_LENGTH %d\n", min_length);
+                    printf("#define KEYWORD_MAX_LENGTH %d\n", max_length);
+                    printf("#define KEYWORD_TABLE_SIZE %u\n", size);
+                    printf("#define KEYWORD_HASH_LENGTH %uu\n", coefficients[0]);
+                    printf("#define KEYWORD_HASH_LAST %uu\n", coefficients[1]);
+                    printf("#define KEYWORD_HASH_FOURTH_LAST %uu\n\n", coefficients[2]);
+                    printf("static const Keyword keyword_table[KEYWORD_TABLE_SIZE] = {\n");
+                    for (unsigned int slot = 0; slot < size; slot++) {
+                        const Keyword* keyword = slots[slot];
+                        if (keyword == NULL) continue;
+                        printf("    [%u]%*s= { \"%s\",%*s%d,%*sTOKEN_%s },\n", slot, slot < 10 ? 2 : 1, "",
+                               keyword->text, width - display_width(keyword->text) + 1, "", keyword->length,
+                               keyword->length < 10 ? 2 : 1, "", keyword->text);
+                    }
+                    printf("};\n");
+                    return 0;
+                }
+            }
+        }
+    }
+    fprintf(stderr, "შეცდომა: %d-უჯრიან ცხრილში სრულყოფილი ჰეში ვერ მოიძებნა.\n", MAX_TABLE_SIZE);
+    return 1;
+}